@@ -32,6 +32,20 @@ if (CONFIG_MCUX_COMPONENT_middleware.multicore.rpmsg-lite.freertos)
     )
 endif()
 
+if (CONFIG_MCUX_COMPONENT_middleware.multicore.rpmsg-lite.posix)
+    mcux_add_include(
+        INCLUDES ../lib/include/environment/posix/
+    )
+
+    mcux_add_source(
+        SOURCES ../lib/include/environment/posix/rpmsg_env_specific.h
+    )
+
+    mcux_add_source(
+        SOURCES ../lib/rpmsg_lite/porting/environment/rpmsg_env_posix.c
+    )
+endif()
+
 if (CONFIG_MCUX_COMPONENT_middleware.multicore.rpmsg-lite.qnx)
     mcux_add_include(
         INCLUDES ../lib/include/environment/qnx/
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2026 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef RPMSG_PLATFORM_H_
+#define RPMSG_PLATFORM_H_
+
+#include <stdint.h>
+#include "rpmsg_default_config.h"
+
+/*
+ * Host platform, the master and the remote are two Linux processes sharing
+ * a POSIX shared memory object. The first page of the object holds the
+ * doorbell words, the rest is the RPMsg-Lite shared memory handed to
+ * rpmsg_lite_master_init()/rpmsg_lite_remote_init(), see platform_get_shmem().
+ * The object outlives the processes, remove it with shm_unlink() when done.
+ */
+
+/* Name of the POSIX shared memory object, both processes have to use the same one.
+ * RL_LINUX_SHM_NAME and RL_LINUX_SHM_SIZE can be set in rpmsg_config.h, included above. */
+#ifndef RL_LINUX_SHM_NAME
+#define RL_LINUX_SHM_NAME "/rpmsg_lite_shm"
+#endif
+
+/* Size of the RPMsg-Lite shared memory (vrings and buffers), without the doorbell page */
+#ifndef RL_LINUX_SHM_SIZE
+#define RL_LINUX_SHM_SIZE (0x100000U)
+#endif
+
+/* Size of the doorbell page placed in front of the RPMsg-Lite shared memory */
+#define RL_LINUX_SHM_CTRL_SIZE (0x1000U)
+
+#ifndef VRING_ALIGN
+#define VRING_ALIGN (0x10U)
+#endif
+
+/* contains pool of descriptors and two circular buffers */
+#ifndef VRING_SIZE
+#define VRING_DESC_SIZE (((RL_BUFFER_COUNT * sizeof(struct vring_desc)) + VRING_ALIGN - 1UL) & ~(VRING_ALIGN - 1UL))
+#define VRING_AVAIL_SIZE                                                                                            \
+    (((sizeof(struct vring_avail) + (RL_BUFFER_COUNT * sizeof(uint16_t)) + sizeof(uint16_t)) + VRING_ALIGN - 1UL) & \
+     ~(VRING_ALIGN - 1UL))
+#define VRING_USED_SIZE                                                                                     \
+    (((sizeof(struct vring_used) + (RL_BUFFER_COUNT * sizeof(struct vring_used_elem)) + sizeof(uint16_t)) + \
+      VRING_ALIGN - 1UL) &                                                                                  \
+     ~(VRING_ALIGN - 1UL))
+#define VRING_SIZE (VRING_DESC_SIZE + VRING_AVAIL_SIZE + VRING_USED_SIZE)
+#endif
+
+/* define shared memory space for VRINGS per one channel */
+#define RL_VRING_OVERHEAD (2UL * VRING_SIZE)
+
+/* Maximum Number of ISR Count. Each vector owns one bit of the 32-bit doorbell word. */
+#ifndef RL_PLATFORM_MAX_ISR_COUNT
+#define RL_PLATFORM_MAX_ISR_COUNT (32U)
+#endif
+
+#define RL_GET_VQ_ID(link_id, queue_id) (((queue_id)&0x1U) | (((link_id) << 1U) & 0xFFFFFFFEU))
+#define RL_GET_LINK_ID(id)              (((id)&0xFFFFFFFEU) >> 1U)
+#define RL_GET_Q_ID(id)                 ((id)&0x1U)
+
+#define RL_PLATFORM_LINUX_SHM_LINK_ID (0U)
+#define RL_PLATFORM_HIGHEST_LINK_ID   (0U)
+
+/* platform interrupt related functions */
+int32_t platform_init_interrupt(uint32_t vector_id, void *isr_data);
+int32_t platform_deinit_interrupt(uint32_t vector_id);
+int32_t platform_interrupt_enable(uint32_t vector_id);
+int32_t platform_interrupt_disable(uint32_t vector_id);
+int32_t platform_in_isr(void);
+void platform_notify(uint32_t vector_id);
+
+/* platform low-level time-delay (busy loop) */
+void platform_time_delay(uint32_t num_msec);
+
+/* platform memory functions */
+void platform_map_mem_region(uint32_t vrt_addr, uint32_t phy_addr, uint32_t size, uint32_t flags);
+void platform_cache_all_flush_invalidate(void);
+void platform_cache_disable(void);
+void platform_cache_invalidate(void *data, uint32_t len);
+void platform_cache_flush(void *data, uint32_t len);
+uintptr_t platform_vatopa(void *addr);
+void *platform_patova(uintptr_t addr);
+void *platform_get_shmem(void);
+
+/* platform init/deinit */
+int32_t platform_init(void);
+int32_t platform_deinit(void);
+
+#endif /* RPMSG_PLATFORM_H_ */
@@ -174,6 +174,318 @@
 #define RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION (0)
 #endif
 
+//! @def RL_USE_TX_BUFFER_WAIT_EVENT
+//!
+//! When enabled, senders blocked in rpmsg_lite_send() / rpmsg_lite_alloc_tx_buffer()
+//! because of no free tx buffer are suspended on a sync lock of the environment
+//! layer instead of polling the vring each RL_MS_PER_INTERVAL. They are woken up
+//! one by one from the tx callback once the other side returns tx buffers, and
+//! a new sender never overtakes the already waiting ones.
+//! The opposite side has to be built with RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION
+//! enabled, otherwise waiting senders are woken up by the timeout only.
+//! The default value is 0 (disabled, polling used).
+#ifndef RL_USE_TX_BUFFER_WAIT_EVENT
+#define RL_USE_TX_BUFFER_WAIT_EVENT (0)
+#endif
+
+//! @def RL_ALLOW_DEFERRED_NOTIFY
+//!
+//! When enabled, the notification of the other side about sent messages can be deferred
+//! (kick coalescing) by rpmsg_lite_set_notify_threshold(). Messages are published in the vring
+//! immediately and the other side is notified once a count of messages is pending, the first
+//! pending message is older than a deadline or rpmsg_lite_flush() is called.
+//! The default value is 0 (disabled, each message notified).
+#ifndef RL_ALLOW_DEFERRED_NOTIFY
+#define RL_ALLOW_DEFERRED_NOTIFY (0)
+#endif
+
+//! @def RL_EPT_TABLE_DIRECT_SIZE
+//!
+//! Number of low endpoint addresses (0 .. RL_EPT_TABLE_DIRECT_SIZE - 1) looked up
+//! directly in a table of the instance, it must be a multiple of 32. A bitmap of the used
+//! direct addresses speeds up the RL_ADDR_ANY address allocation as well.
+//! The default value is 0U (endpoints looked up in the linked list only).
+#ifndef RL_EPT_TABLE_DIRECT_SIZE
+#define RL_EPT_TABLE_DIRECT_SIZE (0U)
+#endif
+
+//! @def RL_EPT_TABLE_HASH_SIZE
+//!
+//! Number of slots of the open addressing hash table used to look up endpoints
+//! with addresses not covered by RL_EPT_TABLE_DIRECT_SIZE, it must be a power of two.
+//! One slot is always kept free, endpoints exceeding the capacity are looked up
+//! in the linked list.
+//! The default value is 0U (endpoints looked up in the linked list only).
+#ifndef RL_EPT_TABLE_HASH_SIZE
+#define RL_EPT_TABLE_HASH_SIZE (0U)
+#endif
+
+//! @def RL_ALLOW_RX_DEFERRED_PROCESSING
+//!
+//! When enabled, the rx ISR calls the rx_cb of the endpoints selected by
+//! rpmsg_lite_set_ept_rx_in_isr() only. Messages for other endpoints are handed over,
+//! together with the rest of the receive vring, to rpmsg_lite_rx_worker() called
+//! by an application task, which processes them in the task context.
+//! The worst case of the rx ISR is reported by rpmsg_lite_get_rx_isr_stats().
+//! The default value is 0 (disabled, all rx_cb called from the ISR).
+#ifndef RL_ALLOW_RX_DEFERRED_PROCESSING
+#define RL_ALLOW_RX_DEFERRED_PROCESSING (0)
+#endif
+
+//! @def RL_RX_ISR_TIMESTAMP
+//!
+//! Time stamp used to measure the duration of the rx ISR when
+//! RL_ALLOW_RX_DEFERRED_PROCESSING is enabled. The env_get_timestamp() resolution
+//! is the RTOS tick in most environments, define it to a cycle counter read
+//! in rpmsg_config.h for a finer measurement.
+#ifndef RL_RX_ISR_TIMESTAMP
+#define RL_RX_ISR_TIMESTAMP() env_get_timestamp()
+#endif
+
+//! @def RL_ALLOW_RX_ADAPTIVE_POLLING
+//!
+//! When enabled, the rx ISR receiving more than one message suppresses the notifications
+//! by the other side (VRING_AVAIL_F_NO_INTERRUPT / VRING_USED_F_NO_NOTIFY) and polls the receive
+//! vring until it stays empty for RL_RX_POLL_SPIN_COUNT polls, then it enables the notifications again.
+//! Interrupts taken and messages received are reported by rpmsg_lite_get_rx_counters().
+//! A remote with the option enabled honours VRING_AVAIL_F_NO_INTERRUPT of the master, which masters
+//! of earlier releases leave set after their initialization, enable it on both sides.
+//! The default value is 0 (disabled, each message notified).
+#ifndef RL_ALLOW_RX_ADAPTIVE_POLLING
+#define RL_ALLOW_RX_ADAPTIVE_POLLING (0)
+#endif
+
+//! @def RL_RX_POLL_SPIN_COUNT
+//!
+//! Number of empty receive vring polls in the rx ISR before falling back to interrupts,
+//! used when RL_ALLOW_RX_ADAPTIVE_POLLING is enabled.
+//! The default value is 100U.
+#ifndef RL_RX_POLL_SPIN_COUNT
+#define RL_RX_POLL_SPIN_COUNT (100U)
+#endif
+
+//! @def RL_ALLOW_VRING_EVENT_IDX
+//!
+//! When enabled, both sides publish their event index at the end of the avail/used ring and
+//! advertise it by the VRING_AVAIL_F_EVENT_IDX / VRING_USED_F_EVENT_IDX flag, like VIRTIO_RING_F_EVENT_IDX.
+//! virtqueue_kick() then notifies the other side only when its event index is crossed.
+//! Falls back to the NO_INTERRUPT/NO_NOTIFY flags while the other side does not advertise it.
+//! The default value is 0 (disabled, every kick notifies).
+#ifndef RL_ALLOW_VRING_EVENT_IDX
+#define RL_ALLOW_VRING_EVENT_IDX (0)
+#endif
+
+//! @def RL_ALLOW_CACHE_COUNTERS
+//!
+//! When enabled, the bytes flushed and invalidated by the cache maintenance of the sent and received
+//! messages are counted, see rpmsg_lite_get_cache_counters(). Meaningful with RL_USE_DCACHE enabled.
+//! The default value is 0 (no counters).
+#ifndef RL_ALLOW_CACHE_COUNTERS
+#define RL_ALLOW_CACHE_COUNTERS (0)
+#endif
+
+//! @def RL_ALLOW_QUEUE_BACKPRESSURE
+//!
+//! This option enables the rpmsg_queue flow control extensions, see rpmsg_queue_set_depth(),
+//! rpmsg_queue_set_watermarks() and rpmsg_queue_get_stats(). In the lossless mode a message
+//! received while the queue is full is parked and its RX buffer held until rpmsg_queue_recv()
+//! or rpmsg_queue_recv_nocopy() frees space, instead of being dropped.
+//! Not supported together with RL_USE_STATIC_API.
+//! The default value is 0 (disabled).
+#ifndef RL_ALLOW_QUEUE_BACKPRESSURE
+#define RL_ALLOW_QUEUE_BACKPRESSURE (0)
+#endif
+
+//! @def RL_ALLOW_FRAGMENTATION
+//!
+//! This option enables sending messages larger than the buffer payload, see rpmsg_lite_send_fragmented(),
+//! and their reassembly on the receiving endpoint, see rpmsg_lite_reassembly_init(). The fragments are
+//! marked in the flags field of the message header, both sides have to enable the option.
+//! The default value is 0 (disabled).
+#ifndef RL_ALLOW_FRAGMENTATION
+#define RL_ALLOW_FRAGMENTATION (0)
+#endif
+
+//! @def RL_ALLOW_MSG_PACKING
+//!
+//! This option enables packing of small messages into one buffer, see rpmsg_lite_send_packed().
+//! The receiving side unpacks them and passes each message to its endpoint callback, both sides
+//! have to enable the option.
+//! The default value is 0 (disabled).
+#ifndef RL_ALLOW_MSG_PACKING
+#define RL_ALLOW_MSG_PACKING (0)
+#endif
+
+//! @def RL_ALLOW_LOCKLESS_TX
+//!
+//! When enabled, rpmsg_lite_send(), rpmsg_lite_alloc_tx_buffer() and rpmsg_lite_send_nocopy()
+//! do not take the tx lock of the instance, the tx lock is taken only to wait for a free tx buffer.
+//! Unless RL_LOCKLESS_TX_MULTI_PRODUCER is enabled, only one task may send on the instance,
+//! name service announcements included.
+//! The default value is 0 (disabled, tx lock taken on every send).
+#ifndef RL_ALLOW_LOCKLESS_TX
+#define RL_ALLOW_LOCKLESS_TX (0)
+#endif
+
+//! @def RL_LOCKLESS_TX_MULTI_PRODUCER
+//!
+//! When enabled together with RL_ALLOW_LOCKLESS_TX, any number of tasks may send on the instance
+//! without the tx lock. Tx buffers are claimed by compare and swap and the vring slots are reserved
+//! and published in order using C11 atomics (stdatomic.h), RL_ALLOW_DEFERRED_NOTIFY is not supported.
+//! The default value is 0 (disabled, single producer).
+#ifndef RL_LOCKLESS_TX_MULTI_PRODUCER
+#define RL_LOCKLESS_TX_MULTI_PRODUCER (0)
+#endif
+
+//! @def RL_ALLOW_TX_STASH
+//!
+//! When enabled, rpmsg_lite_set_ept_tx_stash() lets an endpoint keep tx buffers taken in advance.
+//! rpmsg_lite_send() on such an endpoint takes the buffer from its stash without the tx lock and refills
+//! the stash in the same locked operation which takes the next buffer. The stashes of all endpoints hold
+//! at most half of the tx buffers. Not supported with RL_ALLOW_LOCKLESS_TX.
+//! The default value is 0 (disabled).
+#ifndef RL_ALLOW_TX_STASH
+#define RL_ALLOW_TX_STASH (0)
+#endif
+
+//! @def RL_TX_STASH_SIZE
+//!
+//! Max. number of tx buffers held in the stash of one endpoint, see RL_ALLOW_TX_STASH.
+//! The default value is 4.
+#ifndef RL_TX_STASH_SIZE
+#define RL_TX_STASH_SIZE (4)
+#endif
+
+//! @def RL_ALLOW_TX_LIFO
+//!
+//! When enabled, the tx buffers returned by the other side are moved from the vring to a local stack
+//! and a send takes the most recently returned one, which is likely still in the cache. The vring protocol
+//! does not change, the other side does not need the option. Not supported with RL_LOCKLESS_TX_MULTI_PRODUCER.
+//! The default value is 0 (disabled, tx buffers taken in the vring order).
+#ifndef RL_ALLOW_TX_LIFO
+#define RL_ALLOW_TX_LIFO (0)
+#endif
+
+//! @def RL_ALLOW_DESC_SHADOW
+//!
+//! When enabled, each virtqueue keeps a private copy of the buffer address and length of every vring
+//! descriptor, read from the shared memory the first time the descriptor is used. Received and sent messages
+//! then no longer read the descriptor table nor translate the buffer address, and the rx path keeps the
+//! hold state of the buffers locally instead of writing the buffer index into the shared message header.
+//! The descriptors must not change after the vring initialization. The other side does not need the option.
+//! The default value is 0 (disabled, descriptors read from the shared memory on every message).
+#ifndef RL_ALLOW_DESC_SHADOW
+#define RL_ALLOW_DESC_SHADOW (0)
+#endif
+
+//! @def RL_VRING_BATCH_SIZE
+//!
+//! Maximum number of buffers placed on a vring with one ring index update. The rx drain loop returns
+//! the processed rx buffers and rpmsg_lite_send_batch() sends its messages in batches of up to this size,
+//! each batch with one barrier and one cache flush of the touched ring slots. The batch is kept on the stack.
+//! The default value is 0U (each buffer placed on the vring separately).
+#ifndef RL_VRING_BATCH_SIZE
+#define RL_VRING_BATCH_SIZE (0U)
+#endif
+
+//! @def RL_QUEUE_PAIR_COUNT
+//!
+//! Number of rx/tx virtqueue pairs of an rpmsg_lite instance, carved one after the other from the same shared
+//! memory together with their buffers. Each endpoint sends on the queue pair selected by rpmsg_lite_set_ept_queue(),
+//! the receiving side drains the queue pairs in the order set by rpmsg_lite_set_rx_queue_policy(), queue pair 0 first
+//! by default. All queue pairs share the two notification vectors of the link. Both sides must use the same value.
+//! The default value is 1U (one virtqueue pair).
+#ifndef RL_QUEUE_PAIR_COUNT
+#define RL_QUEUE_PAIR_COUNT (1U)
+#endif
+
+//! @def RL_QUEUE_CORE_ID
+//!
+//! Index of the core the caller runs on, endpoints set to RL_QUEUE_PER_CORE
+//! by rpmsg_lite_set_ept_queue() send on the queue pair of this index modulo
+//! RL_QUEUE_PAIR_COUNT. Define it to read the core id in rpmsg_config.h on SMP hosts.
+#ifndef RL_QUEUE_CORE_ID
+#define RL_QUEUE_CORE_ID() (0U)
+#endif
+
+//! @def RL_ALLOW_TX_QUOTA
+//!
+//! When enabled, every tx buffer is charged to the endpoint sending from it until the other side returns it.
+//! rpmsg_lite_set_ept_tx_quota() reserves tx buffers for an endpoint and caps the buffers it holds in flight,
+//! the endpoints share the buffers not reserved by anybody. A flooding endpoint then cannot take the buffers
+//! reserved for the others. The returned buffers are reused last returned first, as with RL_ALLOW_TX_LIFO.
+//! Not supported with RL_ALLOW_LOCKLESS_TX, RL_ALLOW_TX_STASH and RL_QUEUE_PAIR_COUNT > 1.
+//! The default value is 0 (disabled, tx buffers taken first come, first served).
+#ifndef RL_ALLOW_TX_QUOTA
+#define RL_ALLOW_TX_QUOTA (0)
+#endif
+
+//! @def RL_ALLOW_CREDIT_FLOW_CONTROL
+//!
+//! When enabled, rpmsg_lite_set_ept_flow_control() puts a pair of endpoints under credit-based flow control.
+//! The receiving endpoint grants the sender a window of messages it may hold at a time, and more credits as
+//! the held messages are released. The grants go with the messages sent the other way or as credit messages.
+//! rpmsg_lite_send() to the peer waits for a credit, or fails right away, instead of taking a tx buffer,
+//! rpmsg_lite_send_batch(), rpmsg_lite_send_fragmented() and rpmsg_lite_send_packed() charge a credit per message
+//! (fragment, packed message) as well. A slow consumer then holds at most its window of the shared vring buffers.
+//! The credit messages due from the rx path are sent from the ISR as well, the tx lock masks the interrupt of the link
+//! then. Not supported with RL_ALLOW_LOCKLESS_TX.
+//! The default value is 0 (disabled, no flow control between endpoints).
+#ifndef RL_ALLOW_CREDIT_FLOW_CONTROL
+#define RL_ALLOW_CREDIT_FLOW_CONTROL (0)
+#endif
+
+//! @def RL_ALLOW_ASYNC_SEND
+//!
+//! When enabled, rpmsg_lite_send_async() sends a message without waiting for a tx buffer.
+//! A request that finds no free tx buffer is queued and sent from the tx callback once the other side returns one,
+//! a completion callback reports the result. The tx lock masks the interrupt of the link then.
+//! The opposite side has to be built with RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION enabled to notify the returned buffers.
+//! The default value is 0 (disabled, no asynchronous send).
+#ifndef RL_ALLOW_ASYNC_SEND
+#define RL_ALLOW_ASYNC_SEND (0)
+#endif
+
+//! @def RL_ASYNC_SEND_COPY_SIZE
+//!
+//! Max. payload size, in bytes, copied into the request by rpmsg_lite_send_async(),
+//! larger payloads are referenced and have to stay valid until the completion callback, see RL_ALLOW_ASYNC_SEND.
+//! The default value is 32.
+#ifndef RL_ASYNC_SEND_COPY_SIZE
+#define RL_ASYNC_SEND_COPY_SIZE (32)
+#endif
+
+//! @def RL_ASYNC_SEND_QUEUE_DEPTH
+//!
+//! Max. number of requests rpmsg_lite_send_async() keeps pending, a request finding the queue full is refused
+//! with RL_ERR_NO_MEM, see RL_ALLOW_ASYNC_SEND.
+//! The default value is 16.
+#ifndef RL_ASYNC_SEND_QUEUE_DEPTH
+#define RL_ASYNC_SEND_QUEUE_DEPTH (16)
+#endif
+
+//! @def RL_ALLOW_TX_TOKENS
+//!
+//! When enabled, rpmsg_lite_send_nocopy_token() attaches a completion token to a zero-copy message.
+//! Once the other side returns the tx buffer, the tx callback reports the token as consumed to the callback
+//! registered by rpmsg_lite_set_tx_consumed_cb(), with the send and the return timestamps (env_get_timestamp()).
+//! The returned tx buffers are reused last returned first then and the tx lock masks the interrupt of the link.
+//! The opposite side has to be built with RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION enabled to notify the returned buffers.
+//! The default value is 0 (disabled, no tx tokens).
+#ifndef RL_ALLOW_TX_TOKENS
+#define RL_ALLOW_TX_TOKENS (0)
+#endif
+
+//! @def RL_ALLOW_GROUP_ENDPOINTS
+//!
+//! When enabled, a message received on a group endpoint, created with rpmsg_lite_group_rx_cb(), is handed to each
+//! endpoint subscribed by rpmsg_lite_group_subscribe() without copying. The rx buffer is reference counted,
+//! it goes back to the vring when the last subscriber holding it calls rpmsg_lite_release_rx_buffer().
+//! The default value is 0 (disabled, no group endpoints).
+#ifndef RL_ALLOW_GROUP_ENDPOINTS
+#define RL_ALLOW_GROUP_ENDPOINTS (0)
+#endif
+
 //! @def RL_HANG
 //!
 //! Default implementation of hang assert function
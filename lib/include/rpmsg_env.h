@@ -65,6 +65,10 @@
  *       env_delete_mutex
  *       env_lock_mutex
  *       env_unlock_mutex
+ *       env_create_sync_lock
+ *       env_delete_sync_lock
+ *       env_acquire_sync_lock
+ *       env_release_sync_lock
  *       env_sleep_msec
  *       env_disable_interrupt
  *       env_enable_interrupt
@@ -325,7 +329,7 @@ int32_t env_create_sync_lock(void **lock, int32_t state);
 #endif
 
 /*!
- * env_create_sync_lock
+ * env_delete_sync_lock
  *
  * Deletes given sync lock object.
  *
@@ -335,6 +339,31 @@ int32_t env_create_sync_lock(void **lock, int32_t state);
 
 void env_delete_sync_lock(void *lock);
 
+/*!
+ * env_acquire_sync_lock
+ *
+ * Tries to acquire the sync lock, if the lock is not available then
+ * the calling thread is suspended until the lock is released by
+ * env_release_sync_lock() or until the timeout expires.
+ *
+ * @param lock        - sync lock to acquire
+ * @param timeout_ms  - timeout in ms, RL_BLOCK to wait forever
+ *
+ * @return - 0 when the lock has been acquired, -1 on timeout
+ */
+
+int32_t env_acquire_sync_lock(void *lock, uintptr_t timeout_ms);
+
+/*!
+ * env_release_sync_lock
+ *
+ * Releases the given sync lock. Can be called from the interrupt context.
+ *
+ * @param lock  - sync lock to release
+ */
+
+void env_release_sync_lock(void *lock);
+
 /*!
  * env_sleep_msec
  *
@@ -449,6 +478,29 @@ void env_map_memory(uint32_t pa, uint32_t va, uint32_t size, uint32_t flags);
  */
 uint64_t env_get_timestamp(void);
 
+/*!
+ * env_timestamp_to_msec
+ *
+ * Converts a difference of two env_get_timestamp() values to msecs.
+ *
+ * @param timestamp - time stamp difference
+ *
+ * @return - time in msecs
+ */
+uint32_t env_timestamp_to_msec(uint64_t timestamp);
+
+/*!
+ * env_timestamp_to_usec
+ *
+ * Converts a difference of two env_get_timestamp() values to usecs,
+ * the resolution is the one of env_get_timestamp().
+ *
+ * @param timestamp - time stamp difference
+ *
+ * @return - time in usecs
+ */
+uint64_t env_timestamp_to_usec(uint64_t timestamp);
+
 /*!
  * env_disable_cache
  *
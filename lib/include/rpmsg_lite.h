@@ -110,6 +110,46 @@ extern "C" {
 /*! @brief No initialization flags */
 #define RL_NO_FLAGS (0U)
 
+#if (RL_QUEUE_PAIR_COUNT > 1)
+/* Queue pair selection */
+/*! @brief Endpoint sends on the queue pair of the sending core, see RL_QUEUE_CORE_ID */
+#define RL_QUEUE_PER_CORE (0xFFFFFFFFU)
+/*! @brief Received messages are taken from the lowest queue pair with a message, queue pair 0 first */
+#define RL_QUEUE_POLICY_PRIORITY (0U)
+/*! @brief Received messages are taken from the queue pairs in turns, up to the weight of each one */
+#define RL_QUEUE_POLICY_WRR (1U)
+#endif
+
+#if defined(RL_ALLOW_FRAGMENTATION) && (RL_ALLOW_FRAGMENTATION == 1)
+/* Message header flags */
+/*! @brief Message is a fragment of a message larger than the buffer payload */
+#define RL_MSG_FLAG_FRAG          (0x8000U)
+/*! @brief First fragment, its payload starts with struct rpmsg_lite_frag_hdr */
+#define RL_MSG_FLAG_FRAG_FIRST    (0x4000U)
+/*! @brief Last fragment */
+#define RL_MSG_FLAG_FRAG_LAST     (0x2000U)
+/*! @brief Sequence number of the fragmented message, per sending endpoint */
+#define RL_MSG_FLAG_FRAG_SEQ_MASK (0x00FFU)
+#endif
+
+#if defined(RL_ALLOW_MSG_PACKING) && (RL_ALLOW_MSG_PACKING == 1)
+/* Message header flags */
+/*! @brief Message is a container of packed messages, each one starting with its struct rpmsg_std_hdr */
+#define RL_MSG_FLAG_PACKED     (0x1000U)
+/*! @brief Message is packed in a container, set by the receiving side */
+#define RL_MSG_FLAG_PACKED_REC (0x0800U)
+#endif
+
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+/* Message header flags */
+/*! @brief reserved.rfu carries the credit limit granted by the source endpoint to the destination one */
+#define RL_MSG_FLAG_CREDIT      (0x0400U)
+/*! @brief Source endpoint (re)starts the flow control, the count of the messages sent to it restarts */
+#define RL_MSG_FLAG_CREDIT_SYNC (0x0200U)
+/*! @brief Message carries the credit limit only, it is not passed to the endpoint */
+#define RL_MSG_FLAG_CREDIT_ONLY (0x0100U)
+#endif
+
 /*!
  * @brief Reserved field structure used in rpmsg_std_hdr
  *
@@ -153,6 +193,20 @@ struct rpmsg_std_msg
 */
 typedef int32_t (*rl_ept_rx_cb_t)(void *payload, uint32_t payload_len, uint32_t src, void *priv);
 
+#if (defined(RL_ALLOW_TX_STASH) && (RL_ALLOW_TX_STASH == 1)) ||                                                  \
+    (defined(RL_ALLOW_TX_LIFO) && (RL_ALLOW_TX_LIFO == 1)) || (defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)) || \
+    (defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1))
+/*!
+ * Free tx buffer taken from the tvq
+ */
+struct rpmsg_lite_tx_buffer
+{
+    void *buf;    /*!< buffer address */
+    uint32_t len; /*!< buffer length */
+    uint16_t idx; /*!< descriptor index */
+};
+#endif
+
 /*!
  * RPMsg Lite Endpoint structure
  */
@@ -163,6 +217,51 @@ struct rpmsg_lite_endpoint
     void *rx_cb_data;     /*!< ISR callback data */
     void *rfu;            /*!< reserved for future usage */
     /* 16 bytes aligned on 32bit architecture */
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+    uint32_t rx_in_isr;   /*!< RL_TRUE to call rx_cb from the ISR instead of the rx worker */
+#endif
+#if defined(RL_ALLOW_FRAGMENTATION) && (RL_ALLOW_FRAGMENTATION == 1)
+    uint32_t tx_frag_seq; /*!< sequence number of the next fragmented message */
+#endif
+#if (RL_QUEUE_PAIR_COUNT > 1)
+    uint32_t tx_queue;    /*!< queue pair the messages are sent on, RL_QUEUE_PER_CORE to select it by the core */
+#endif
+#if defined(RL_ALLOW_TX_STASH) && (RL_ALLOW_TX_STASH == 1)
+    uint32_t tx_stash_size;  /*!< max. number of stashed tx buffers, 0 when the stash is disabled */
+    uint32_t tx_stash_cnt;   /*!< number of tx buffers in the stash */
+    uint32_t tx_stash_grant; /*!< tx buffers counted in the instance tx_stashed since the last refill */
+    struct rpmsg_lite_tx_buffer tx_stash[RL_TX_STASH_SIZE]; /*!< stashed tx buffers */
+#endif
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+    uint32_t tx_reserved;  /*!< tx buffers reserved for the endpoint */
+    uint32_t tx_max;       /*!< max. number of tx buffers in flight, 0 for no limit */
+    uint32_t tx_in_flight; /*!< tx buffers taken by the endpoint and not returned by the other side yet */
+    uint32_t tx_denied;    /*!< number of buffer requests refused by the quota */
+#endif
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    uint32_t fc_peer;         /*!< peer endpoint under flow control, RL_ADDR_ANY when disabled */
+    uint32_t fc_sync_src;     /*!< source of the last sync from an endpoint other than fc_peer, RL_ADDR_ANY for none */
+    uint16_t fc_sync_limit;   /*!< credit limit of the last sync from an endpoint other than fc_peer */
+    uint16_t fc_window;       /*!< max. number of messages of the peer held by the endpoint */
+    uint16_t fc_tx_sent;      /*!< messages sent to the peer since its sync */
+    uint16_t fc_tx_limit;     /*!< credit limit granted by the peer, fc_tx_sent it allows */
+    uint16_t fc_rx_received;  /*!< messages of the peer received since the own sync */
+    uint16_t fc_rx_consumed;  /*!< messages of the peer released since the own sync */
+    uint16_t fc_rx_granted;   /*!< credit limit last granted to the peer */
+    uint16_t fc_gen;          /*!< incremented with each sync, a credit is not given back across it */
+    uint32_t fc_tx_waiters;   /*!< number of senders waiting for a credit */
+    uint32_t fc_tx_blocked;   /*!< sends to the peer that found no credit */
+    uint32_t fc_rx_overruns;  /*!< messages of the peer received beyond the window */
+    uint32_t fc_credit_count; /*!< credit messages sent */
+    uint32_t fc_credit_queued; /*!< RL_TRUE while a credit message is queued by the rx path */
+    struct rpmsg_lite_endpoint *fc_credit_next; /*!< next endpoint with a queued credit message */
+    LOCK *fc_lock;            /*!< excludes the rx path from the flow control state */
+    LOCK *fc_wait_lock;       /*!< sync lock signalled when the peer grants credits */
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    LOCK_STATIC_CONTEXT fc_lock_static_ctxt;      /*!< Static context for fc_lock object creation */
+    LOCK_STATIC_CONTEXT fc_wait_lock_static_ctxt; /*!< Static context for fc_wait_lock object creation */
+#endif
+#endif
 };
 
 /*!
@@ -174,20 +273,225 @@ struct rpmsg_lite_ept_static_context
     struct llist node;              /*!< memory for linked list node structure */
 };
 
+/*!
+ * RPMsg Lite batch send entry, describes one message
+ * passed to rpmsg_lite_send_batch() / rpmsg_lite_send_nocopy_batch()
+ */
+struct rpmsg_lite_batch_entry
+{
+    struct rpmsg_lite_endpoint *ept; /*!< sender endpoint */
+    uint32_t dst;                    /*!< remote endpoint address */
+    void *data;                      /*!< payload buffer, tx buffer in case of the nocopy batch */
+    uint32_t size;                   /*!< size of payload, in bytes */
+};
+
+#if defined(RL_ALLOW_FRAGMENTATION) && (RL_ALLOW_FRAGMENTATION == 1)
+RL_PACKED_BEGIN
+/*!
+ * Header at the beginning of the payload of the first fragment
+ */
+struct rpmsg_lite_frag_hdr
+{
+    uint32_t total_len; /*!< length of the whole message, in bytes */
+} RL_PACKED_END;
+
+/*!
+ * Fragment of a reassembled message handed over without copying,
+ * see rpmsg_lite_reassembly_init_nocopy()
+ */
+struct rpmsg_lite_frag
+{
+    void *data;   /*!< fragment data */
+    uint32_t len; /*!< length of the fragment data, in bytes */
+    void *buffer; /*!< held rx buffer to release with rpmsg_lite_release_rx_buffer() */
+};
+
+/*! \typedef rl_frag_rx_cb_t
+    \brief Reassembled message callback function type, the data are valid until the callback returns.
+*/
+typedef void (*rl_frag_rx_cb_t)(void *data, uint32_t len, uint32_t src, void *priv);
+
+/*! \typedef rl_frag_chain_cb_t
+    \brief Reassembled message callback function type for the zero-copy reassembly,
+    the callback takes over the held rx buffers of all count fragments.
+*/
+typedef void (*rl_frag_chain_cb_t)(struct rpmsg_lite_frag *frags, uint32_t count, uint32_t src, void *priv);
+
+/*!
+ * Reassembly context of one receiving endpoint, passed as the rx_cb_data
+ * of the endpoint created with the rpmsg_lite_reassembly_rx_cb() callback
+ */
+struct rpmsg_lite_reassembly
+{
+    struct rpmsg_lite_instance *rpmsg_lite_dev; /*!< RPMsg Lite instance */
+    rl_frag_rx_cb_t rx_cb;                      /*!< reassembled message callback, copy mode */
+    rl_frag_chain_cb_t chain_cb;                /*!< reassembled message callback, zero-copy mode */
+    void *cb_data;                              /*!< callback data */
+    char *buffer;                               /*!< caller-provided buffer, RL_NULL to allocate per message */
+    uint32_t buffer_size;                       /*!< size of the caller-provided buffer */
+    struct rpmsg_lite_frag *frags;              /*!< fragments held in zero-copy mode */
+    uint32_t frags_size;                        /*!< length of the frags array */
+    char *data;                                 /*!< message being reassembled, copy mode */
+    uint32_t total_len;                         /*!< length of the message being reassembled */
+    uint32_t offset;                            /*!< bytes of the message received so far */
+    uint32_t count;                             /*!< fragments held so far, zero-copy mode */
+    uint32_t src;                               /*!< source address of the message being reassembled */
+    uint32_t seq;                               /*!< sequence number of the message being reassembled */
+    uint32_t active;                            /*!< RL_TRUE while a message is being reassembled */
+    uint32_t completed_count;                   /*!< number of reassembled messages */
+    uint32_t aborted_count;                     /*!< number of incomplete messages and stray fragments dropped */
+};
+#endif
+
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+/*!
+ * RPMsg Lite endpoint flow control state and counters, see rpmsg_lite_get_ept_fc_stats()
+ */
+struct rpmsg_lite_fc_stats
+{
+    uint32_t tx_credits;     /*!< messages the endpoint may send to the peer now */
+    uint32_t tx_blocked;     /*!< sends to the peer that found no credit */
+    uint32_t rx_outstanding; /*!< messages of the peer received and not released yet */
+    uint32_t rx_overruns;    /*!< messages of the peer received beyond the window */
+    uint32_t credit_count;   /*!< credit messages sent, grants carried by other messages not included */
+};
+#endif
+
+#if defined(RL_ALLOW_ASYNC_SEND) && (RL_ALLOW_ASYNC_SEND == 1)
+struct rpmsg_lite_async_req;
+
+/*! \typedef rl_async_done_cb_t
+    \brief Asynchronous send completion callback type, status is RL_SUCCESS once the message is enqueued
+    on the vring, an error when the request is dropped. The request may be reused from the callback.
+*/
+typedef void (*rl_async_done_cb_t)(struct rpmsg_lite_async_req *req, int32_t status, void *priv);
+
+/*!
+ * Asynchronous send request passed to rpmsg_lite_send_async(),
+ * owned by the instance until its completion callback is called
+ */
+struct rpmsg_lite_async_req
+{
+    struct rpmsg_lite_async_req *next; /*!< next request in the pending list */
+    struct rpmsg_lite_endpoint *ept;   /*!< sender endpoint */
+    uint32_t dst;                      /*!< remote endpoint address */
+    char *data;                        /*!< payload, the caller's buffer or copy */
+    uint32_t size;                     /*!< size of payload, in bytes */
+    rl_async_done_cb_t done_cb;        /*!< completion callback */
+    void *done_cb_data;                /*!< completion callback data */
+    uint64_t queued_at;                /*!< env_get_timestamp() when the request was queued */
+#if (RL_ASYNC_SEND_COPY_SIZE > 0)
+    char copy[RL_ASYNC_SEND_COPY_SIZE]; /*!< copy of a payload of up to RL_ASYNC_SEND_COPY_SIZE bytes */
+#endif
+};
+
+/*!
+ * RPMsg Lite asynchronous send counters, see rpmsg_lite_get_async_stats()
+ */
+struct rpmsg_lite_async_stats
+{
+    uint32_t depth;       /*!< requests pending now */
+    uint32_t max_depth;   /*!< max. number of requests pending at once */
+    uint32_t sent_direct; /*!< requests sent right away, a tx buffer was free */
+    uint32_t sent_queued; /*!< requests queued and sent from the tx callback */
+    uint32_t failed;      /*!< queued requests dropped, endpoint destroyed or instance deinitialized */
+    uint64_t wait_total;  /*!< time the sent_queued requests spent pending, in env_get_timestamp() units */
+    uint64_t wait_max;    /*!< max. time one request spent pending, in env_get_timestamp() units */
+};
+#endif
+
+#if defined(RL_ALLOW_GROUP_ENDPOINTS) && (RL_ALLOW_GROUP_ENDPOINTS == 1)
+/*!
+ * Group context of one group endpoint, passed as the rx_cb_data
+ * of the endpoint created with the rpmsg_lite_group_rx_cb() callback
+ */
+struct rpmsg_lite_group
+{
+    struct rpmsg_lite_instance *rpmsg_lite_dev; /*!< RPMsg Lite instance */
+    struct rpmsg_lite_endpoint **subs;          /*!< subscribed endpoints, RL_NULL for a free slot */
+    uint32_t subs_size;                         /*!< length of the subs array */
+    uint32_t subs_count;                        /*!< slots used so far, free ones included */
+};
+#endif
+
+#if defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)
+/*! \typedef rl_tx_consumed_cb_t
+    \brief Tx consumed callback type, reports the token of a message sent by rpmsg_lite_send_nocopy_token()
+    once the other side has returned its tx buffer. The timestamps are in env_get_timestamp() units.
+*/
+typedef void (*rl_tx_consumed_cb_t)(void *token, uint64_t sent_at, uint64_t consumed_at, void *priv);
+
+/*!
+ * Consumed tx token waiting to be reported
+ */
+struct rpmsg_lite_tx_report
+{
+    void *token;          /*!< token passed to rpmsg_lite_send_nocopy_token() */
+    uint64_t sent_at;     /*!< env_get_timestamp() when the message was enqueued on the vring */
+    uint64_t consumed_at; /*!< env_get_timestamp() when the returned tx buffer was taken back */
+};
+#endif
+
+#if defined(RL_ALLOW_CACHE_COUNTERS) && (RL_ALLOW_CACHE_COUNTERS == 1)
+/*!
+ * RPMsg Lite cache maintenance counters, bytes flushed and invalidated
+ * for the messages sent and received, see rpmsg_lite_get_cache_counters()
+ */
+struct rpmsg_lite_cache_counters
+{
+    uint32_t tx_count;          /*!< number of messages flushed before sending */
+    uint32_t flushed_bytes;     /*!< bytes flushed, sent messages and cleared rx buffers */
+    uint32_t rx_count;          /*!< number of messages invalidated when received */
+    uint32_t invalidated_bytes; /*!< bytes invalidated, received messages */
+};
+#endif
+
 /*!
  * Structure describing the local instance
  * of RPMSG lite communication stack and
  * holds all runtime variables needed internally
  * by the stack.
+ *
+ * Senders and receivers do not share a lock, the tvq is protected by tx_lock,
+ * the rvq by rx_lock and the endpoint list by lock. When more than one of them
+ * is needed, they are taken in the order rx_lock, lock, tx_lock.
+ * With RL_QUEUE_PAIR_COUNT > 1 the locks cover the virtqueues of all queue pairs.
  */
 struct rpmsg_lite_instance
 {
-    struct virtqueue *rvq;                /*!< receive virtqueue */
-    struct virtqueue *tvq;                /*!< transmit virtqueue */
+    struct virtqueue *rvq;                       /*!< receive virtqueue of queue pair 0 */
+    struct virtqueue *tvq;                       /*!< transmit virtqueue of queue pair 0 */
+    struct virtqueue *rvqs[RL_QUEUE_PAIR_COUNT]; /*!< receive virtqueues of all queue pairs */
+    struct virtqueue *tvqs[RL_QUEUE_PAIR_COUNT]; /*!< transmit virtqueues of all queue pairs */
+#if (RL_QUEUE_PAIR_COUNT > 1)
+    uint32_t rx_policy;                       /*!< order of taking messages from the rvqs, RL_QUEUE_POLICY_xxx */
+    uint32_t rx_weights[RL_QUEUE_PAIR_COUNT]; /*!< messages taken from each rvq per round, RL_QUEUE_POLICY_WRR */
+    uint32_t rx_queue;                        /*!< rvq served in the current round, RL_QUEUE_POLICY_WRR */
+    uint32_t rx_credit;                       /*!< messages left to take from rx_queue, RL_QUEUE_POLICY_WRR */
+#endif
     struct llist *rl_endpoints;           /*!< linked list of endpoints */
-    LOCK *lock;                           /*!< local RPMsg Lite mutex lock */
+#if (RL_EPT_TABLE_DIRECT_SIZE > 0)
+    struct llist *ept_direct[RL_EPT_TABLE_DIRECT_SIZE]; /*!< endpoint nodes indexed by address */
+    uint32_t ept_direct_used[RL_EPT_TABLE_DIRECT_SIZE / 32U]; /*!< bitmap of used direct addresses */
+#endif
+#if (RL_EPT_TABLE_HASH_SIZE > 0)
+    struct llist *ept_hash[RL_EPT_TABLE_HASH_SIZE]; /*!< open addressing hash of endpoint nodes */
+    uint32_t ept_hash_count;              /*!< number of endpoint nodes in the hash */
+#endif
+#if (RL_EPT_TABLE_DIRECT_SIZE > 0) || (RL_EPT_TABLE_HASH_SIZE > 0)
+    uint32_t ept_overflow_count;          /*!< number of endpoints found in rl_endpoints list only */
+#endif
+    LOCK *lock;                           /*!< endpoint list mutex lock */
 #if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
     LOCK_STATIC_CONTEXT lock_static_ctxt; /*!< Static context for lock object creation */
+#endif
+    LOCK *tx_lock;                        /*!< tvq mutex lock */
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    LOCK_STATIC_CONTEXT tx_lock_static_ctxt; /*!< Static context for tx_lock object creation */
+#endif
+    LOCK *rx_lock;                        /*!< rvq mutex lock */
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    LOCK_STATIC_CONTEXT rx_lock_static_ctxt; /*!< Static context for rx_lock object creation */
 #endif
     uint32_t link_state;                  /*!< state of the link, up/down*/
     char *sh_mem_base;                    /*!< base address of the shared memory */
@@ -197,9 +501,103 @@ struct rpmsg_lite_instance
 #if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
     void *env;                            /*!< pointer to the environment layer context */
 #endif
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+    LOCK *tx_wait_lock[RL_QUEUE_PAIR_COUNT]; /*!< sync locks signalled when the other side returns tx buffers */
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    LOCK_STATIC_CONTEXT tx_wait_lock_static_ctxt[RL_QUEUE_PAIR_COUNT]; /*!< Static contexts of tx_wait_lock */
+#endif
+    volatile uint32_t tx_waiters[RL_QUEUE_PAIR_COUNT]; /*!< number of senders waiting for a free tx buffer, per tvq */
+#endif
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+    LOCK *rx_worker_lock;                 /*!< sync lock signalled when the rx worker has messages to process */
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    LOCK_STATIC_CONTEXT rx_worker_lock_static_ctxt; /*!< Static context for rx_worker_lock object creation */
+#endif
+    volatile uint32_t rx_deferred;        /*!< RL_TRUE while the rvq is processed by the rx worker */
+    struct rpmsg_std_msg *rx_carry_msg;   /*!< message taken from the rvq by the ISR for the rx worker */
+    uint32_t rx_carry_queue;              /*!< queue pair of the rx_carry_msg buffer */
+    uint32_t rx_carry_len;                /*!< length of the rx_carry_msg buffer */
+    uint16_t rx_carry_idx;                /*!< descriptor index of the rx_carry_msg buffer */
+    uint32_t rx_isr_max_count;            /*!< max. number of messages processed by one rx ISR */
+    uint64_t rx_isr_max_time;             /*!< max. duration of one rx ISR, in RL_RX_ISR_TIMESTAMP() units */
+#endif
+#if defined(RL_ALLOW_RX_ADAPTIVE_POLLING) && (RL_ALLOW_RX_ADAPTIVE_POLLING == 1)
+    uint32_t rx_irq_count;                /*!< number of rx interrupts taken */
+    uint32_t rx_msg_count;                /*!< number of messages received in the rx ISR */
+#endif
+#if defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1)
+    uint32_t notify_threshold;            /*!< number of pending tx messages triggering the notification */
+    uint32_t notify_deadline_us;          /*!< max. delay of the notification in microseconds, 0 for none */
+    uint32_t notify_pending;              /*!< RL_TRUE when tx messages wait for the notification */
+    uint64_t notify_pending_since;        /*!< timestamp of the first tx message waiting for the notification */
+    uint32_t notify_kick_count;           /*!< number of notifications of the remote side */
+    uint32_t notify_msg_count;            /*!< number of messages covered by the notifications */
+    LOCK *notify_worker_lock;             /*!< sync lock signalled when a message starts waiting for the notification */
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    LOCK_STATIC_CONTEXT notify_worker_lock_static_ctxt; /*!< Static context for notify_worker_lock object creation */
+#endif
+#endif
+#if defined(RL_ALLOW_CACHE_COUNTERS) && (RL_ALLOW_CACHE_COUNTERS == 1)
+    struct rpmsg_lite_cache_counters cache_counters; /*!< cache maintenance counters */
+#endif
+#if defined(RL_ALLOW_MSG_PACKING) && (RL_ALLOW_MSG_PACKING == 1)
+    struct rpmsg_std_msg *pack_msg;       /*!< container open for packing, RL_NULL when none */
+    uint32_t pack_buff_len;               /*!< length of the pack_msg buffer */
+    uint16_t pack_idx;                    /*!< descriptor index of the pack_msg buffer */
+    uint32_t pack_len;                    /*!< bytes of the messages packed in pack_msg */
+    uint32_t pack_deadline_us;            /*!< max. time a container stays open in microseconds, 0 for none */
+    uint64_t pack_since;                  /*!< timestamp of the first message packed in pack_msg */
+#endif
+#if defined(RL_ALLOW_TX_STASH) && (RL_ALLOW_TX_STASH == 1)
+    uint32_t tx_stashed;                  /*!< tx buffers granted to the endpoint stashes */
+    uint32_t tx_stash_limit;              /*!< max. tx buffers granted to the endpoint stashes */
+#endif
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+    uint32_t tx_reserved;                 /*!< tx buffers reserved for the endpoints in total */
+    uint32_t tx_shared_used;              /*!< tx buffers in flight beyond the reservations of their endpoints */
+    uint32_t tx_charged[(RL_BUFFER_COUNT + 31U) / 32U]; /*!< bitmap of the tx buffers charged to a sender */
+    struct rpmsg_lite_endpoint *tx_owner[RL_BUFFER_COUNT]; /*!< endpoint charged for each tx buffer, RL_NULL for none */
+#endif
+#if (defined(RL_ALLOW_TX_LIFO) && (RL_ALLOW_TX_LIFO == 1)) || (defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)) || \
+    (defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1))
+    uint32_t tx_free_cnt;                 /*!< number of tx buffers in tx_free */
+    struct rpmsg_lite_tx_buffer tx_free[RL_BUFFER_COUNT]; /*!< free tx buffers taken out of the tvq, last returned on top */
+#elif defined(RL_ALLOW_TX_STASH) && (RL_ALLOW_TX_STASH == 1)
+    uint32_t tx_free_cnt;                 /*!< number of tx buffers in tx_free */
+    struct rpmsg_lite_tx_buffer tx_free[RL_BUFFER_COUNT / 2U]; /*!< tx buffers returned by the endpoint stashes */
+#endif
+#if defined(RL_ALLOW_FRAGMENTATION) && (RL_ALLOW_FRAGMENTATION == 1)
+    LOCK *frag_lock;                      /*!< serializes the fragmented messages sent by this instance */
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    LOCK_STATIC_CONTEXT frag_lock_static_ctxt; /*!< Static context for frag_lock object creation */
+#endif
+#endif
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    uint32_t fc_sync_src;                 /*!< source of the last sync to a missing endpoint, RL_ADDR_ANY for none */
+    uint32_t fc_sync_dst;                 /*!< destination of the last sync to a missing endpoint */
+    uint16_t fc_sync_limit;               /*!< credit limit of the last sync to a missing endpoint */
+    struct rpmsg_lite_endpoint *fc_credit_head; /*!< endpoints with a credit message queued by the rx path */
+#endif
+#if defined(RL_ALLOW_ASYNC_SEND) && (RL_ALLOW_ASYNC_SEND == 1)
+    struct rpmsg_lite_async_req *async_head;   /*!< oldest pending asynchronous send, RL_NULL when none */
+    struct rpmsg_lite_async_req *async_tail;   /*!< newest pending asynchronous send */
+    struct rpmsg_lite_async_stats async_stats; /*!< asynchronous send counters */
+#endif
+#if defined(RL_ALLOW_GROUP_ENDPOINTS) && (RL_ALLOW_GROUP_ENDPOINTS == 1)
+    uint16_t rx_group_refs[RL_QUEUE_PAIR_COUNT * RL_BUFFER_COUNT]; /*!< group subscribers holding each rx buffer */
+#endif
+#if defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)
+    rl_tx_consumed_cb_t tx_consumed_cb;   /*!< callback reporting the consumed tx tokens, RL_NULL for none */
+    void *tx_consumed_cb_data;            /*!< tx_consumed_cb data */
+    void *tx_token[RL_BUFFER_COUNT];      /*!< token of each tx buffer in flight, RL_NULL for none */
+    uint64_t tx_sent_at[RL_BUFFER_COUNT]; /*!< send timestamp of each tx buffer holding a token */
+    struct rpmsg_lite_tx_report tx_report[RL_BUFFER_COUNT]; /*!< consumed tokens not reported yet, FIFO */
+    uint32_t tx_report_head;              /*!< oldest entry of tx_report */
+    uint32_t tx_report_cnt;               /*!< number of entries in tx_report */
+#endif
 
 #if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
-    struct vq_static_context vq_ctxt[2];
+    struct vq_static_context vq_ctxt[2U * RL_QUEUE_PAIR_COUNT];
 #endif
     uint32_t link_id; /*!< linkID of this rpmsg_lite instance */
 };
@@ -342,6 +740,9 @@ int32_t rpmsg_lite_destroy_ept(struct rpmsg_lite_instance *rpmsg_lite_dev, struc
  * @param timeout           Timeout in ms, 0 if nonblocking
  *
  * @return Status of function execution, RL_SUCCESS on success.
+ * @if RL_ALLOW_CREDIT_FLOW_CONTROL
+ *         RL_ERR_NO_BUFF when dst is the flow control peer of ept and grants no credit within the timeout.
+ * @endif
  *
  */
 int32_t rpmsg_lite_send(struct rpmsg_lite_instance *rpmsg_lite_dev,
@@ -361,6 +762,589 @@ int32_t rpmsg_lite_send(struct rpmsg_lite_instance *rpmsg_lite_dev,
  */
 uint32_t rpmsg_lite_is_link_up(struct rpmsg_lite_instance *rpmsg_lite_dev);
 
+/*!
+ *
+ * @brief Sends a batch of messages, the remote side is notified
+ * only once for the whole batch.
+ *
+ * All tx buffers are allocated, filled and enqueued on the virtqueue
+ * under a single tx lock of the instance followed by one virtqueue_kick().
+ * The function does not block, when the vring runs out of free tx buffers
+ * the messages enqueued so far are sent and the rest of the batch is not.
+ * With RL_ALLOW_CREDIT_FLOW_CONTROL the batch stops as well at the first
+ * message to a flow control peer that has not granted a credit.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param entries           Array of messages to send
+ * @param count             Number of entries in the array
+ * @param sent              Pointer to store the number of messages sent
+ *
+ * @return Status of function execution, RL_SUCCESS when all messages are sent,
+ * RL_ERR_NO_MEM when only the first *sent messages are sent,
+ * RL_ERR_NO_BUFF when they are because of a missing credit.
+ *
+ */
+int32_t rpmsg_lite_send_batch(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                              const struct rpmsg_lite_batch_entry *entries,
+                              uint32_t count,
+                              uint32_t *sent);
+
+#if defined(RL_ALLOW_FRAGMENTATION) && (RL_ALLOW_FRAGMENTATION == 1)
+/*!
+ * @brief Sends a message of any size, split into fragments of the buffer payload size.
+ *
+ * The fragments are filled into as many free tx buffers as available and the remote
+ * side is notified once per such window, then the function waits for the next free buffer.
+ * Fragmented messages sent by the instance are serialized, the fragments of one message
+ * are never interleaved with the fragments of another one. The receiving endpoint has
+ * to reassemble them, see rpmsg_lite_reassembly_init().
+ * When a wait for a free buffer times out the fragments already sent are dropped
+ * by the receiving side once it gets the first fragment of the next message.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param ept               Sender endpoint
+ * @param dst               Remote endpoint address
+ * @param data              Message data
+ * @param size              Size of the message, in bytes
+ * @param timeout           Timeout in ms for each wait for a free tx buffer, 0 if nonblocking
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_send_fragmented(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                   struct rpmsg_lite_endpoint *ept,
+                                   uint32_t dst,
+                                   char *data,
+                                   uint32_t size,
+                                   uintptr_t timeout);
+
+/*!
+ * @brief Initializes the reassembly of fragmented messages, copy mode.
+ *
+ * Register the endpoint with rpmsg_lite_reassembly_rx_cb() and the reassembly context as its
+ * callback data. Each message is reassembled into the buffer and passed to the callback,
+ * messages sent unfragmented are passed to the callback directly from the rx buffer.
+ * The callback is called from the context of the endpoint rx callback.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param reassembly        Reassembly context to initialize
+ * @param buffer            Buffer to reassemble the messages into,
+ *                          RL_NULL to allocate it for each message with env_allocate_memory()
+ * @param buffer_size       Size of the buffer, messages larger than that are dropped
+ * @param rx_cb             Reassembled message callback
+ * @param cb_data           Callback data
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_reassembly_init(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                   struct rpmsg_lite_reassembly *reassembly,
+                                   char *buffer,
+                                   uint32_t buffer_size,
+                                   rl_frag_rx_cb_t rx_cb,
+                                   void *cb_data);
+
+#if defined(RL_API_HAS_ZEROCOPY) && (RL_API_HAS_ZEROCOPY == 1)
+/*!
+ * @brief Initializes the reassembly of fragmented messages, zero-copy mode.
+ *
+ * The rx buffers of the fragments are held until the last fragment is received,
+ * then the chain is passed to the callback which has to release each buffer
+ * with rpmsg_lite_release_rx_buffer() once processed. The frags array is reused
+ * for the next message after the callback returns. Messages with more fragments
+ * than frags_size are dropped. The held buffers limit the message size to the
+ * number of rx buffers as well, frags_size is capped at one less than that.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param reassembly        Reassembly context to initialize
+ * @param frags             Array to collect the fragments in
+ * @param frags_size        Length of the frags array
+ * @param chain_cb          Reassembled message callback
+ * @param cb_data           Callback data
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_reassembly_init_nocopy(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                          struct rpmsg_lite_reassembly *reassembly,
+                                          struct rpmsg_lite_frag *frags,
+                                          uint32_t frags_size,
+                                          rl_frag_chain_cb_t chain_cb,
+                                          void *cb_data);
+#endif /* RL_API_HAS_ZEROCOPY */
+
+/*!
+ * @brief Endpoint rx callback reassembling the fragmented messages,
+ * to be registered with the reassembly context as the callback data.
+ *
+ * @param payload           Pointer to the buffer containing received data
+ * @param payload_len       Size of data received, in bytes
+ * @param src               Address of the endpoint from which data is received
+ * @param priv              Reassembly context
+ *
+ * @return RL_HOLD or RL_RELEASE to release or hold the buffer in payload
+ */
+int32_t rpmsg_lite_reassembly_rx_cb(void *payload, uint32_t payload_len, uint32_t src, void *priv);
+
+/*!
+ * @brief Drops the message being reassembled, to be called once the endpoint is destroyed.
+ *
+ * @param reassembly        Reassembly context
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_reassembly_deinit(struct rpmsg_lite_reassembly *reassembly);
+#endif /* RL_ALLOW_FRAGMENTATION */
+
+#if defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1)
+/*!
+ * @brief Configures the deferred notification of the remote side (kick coalescing).
+ *
+ * Messages sent by the rpmsg_lite_send(), rpmsg_lite_send_nocopy() and batch functions
+ * are published in the vring immediately but the remote side is notified only once
+ * count messages are pending or the first pending message is older than deadline_us.
+ * The deadline is evaluated when a message is sent, with the resolution of env_get_timestamp().
+ * When the sending stops, rpmsg_lite_notify_worker() running in a task of the application keeps
+ * the deadline, otherwise the application has to call rpmsg_lite_flush().
+ * Pending messages are notified as well before a sender starts waiting for a free tx buffer.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param count             Number of pending messages triggering the notification,
+ *                          0 or 1 to notify every message (default)
+ * @param deadline_us       Max. delay of the notification in microseconds, 0 for none
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_set_notify_threshold(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                        uint32_t count,
+                                        uint32_t deadline_us);
+
+/*!
+ * @brief Notifies the remote side about all messages pending due to the deferred notification.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ * @see rpmsg_lite_set_notify_threshold
+ */
+int32_t rpmsg_lite_flush(struct rpmsg_lite_instance *rpmsg_lite_dev);
+
+/*!
+ * @brief Keeps the notification deadline on an idle link, to be called in a loop
+ * from a dedicated task of the application.
+ *
+ * Waits until a sent message starts waiting for the deferred notification, then sleeps
+ * until its deadline and notifies the remote side unless a later message did it already.
+ * The sleep has the resolution of env_sleep_msec().
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param timeout           Timeout in ms to wait for a pending message, 0 if nonblocking
+ *
+ * @return Status of function execution, RL_SUCCESS when a pending message was handled,
+ * RL_ERR_NO_BUFF when no message started waiting within the timeout.
+ *
+ * @see rpmsg_lite_set_notify_threshold
+ */
+int32_t rpmsg_lite_notify_worker(struct rpmsg_lite_instance *rpmsg_lite_dev, uintptr_t timeout);
+
+/*!
+ * @brief Returns the number of notifications of the remote side and the number
+ * of messages covered by them since the instance initialization,
+ * msg_count / kick_count gives the average number of messages per interrupt.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param kick_count        Pointer to store the number of notifications
+ * @param msg_count         Pointer to store the number of notified messages
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_get_notify_counters(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                       uint32_t *kick_count,
+                                       uint32_t *msg_count);
+#endif /* RL_ALLOW_DEFERRED_NOTIFY */
+
+#if defined(RL_ALLOW_MSG_PACKING) && (RL_ALLOW_MSG_PACKING == 1)
+/*!
+ * @brief Sends a small message packed together with other ones into one buffer.
+ *
+ * The message is copied into the container buffer open for packing, the container is sent
+ * once the next message does not fit into it, once it is older than the deadline
+ * configured by rpmsg_lite_set_pack_deadline() or when rpmsg_lite_flush_packed() is called.
+ * The deadline is evaluated when a message is packed, there is no timer behind it,
+ * the application has to call rpmsg_lite_flush_packed() when it stops sending.
+ * Each packed message takes its struct rpmsg_std_hdr and the payload aligned up to
+ * RL_WORD_SIZE from the container. Packed messages are not ordered with messages
+ * sent by the other send functions.
+ * The receiving side passes the packed messages to the endpoint callbacks one by one,
+ * held ones keep the container until all of them are released. Note a queue created
+ * by rpmsg_queue_create() holds as many messages as there are rx buffers only.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param ept               Sender endpoint
+ * @param dst               Remote endpoint address
+ * @param data              Payload buffer
+ * @param size              Size of payload, in bytes
+ * @param timeout           Timeout in ms, 0 if nonblocking
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_send_packed(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                               struct rpmsg_lite_endpoint *ept,
+                               uint32_t dst,
+                               char *data,
+                               uint32_t size,
+                               uintptr_t timeout);
+
+/*!
+ * @brief Configures the max. time a container stays open for packing.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param deadline_us       Max. time since the first message packed in microseconds,
+ *                          0 to send the container only when full or flushed (default)
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_set_pack_deadline(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t deadline_us);
+
+/*!
+ * @brief Sends the container open for packing, if any.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ * @see rpmsg_lite_send_packed
+ */
+int32_t rpmsg_lite_flush_packed(struct rpmsg_lite_instance *rpmsg_lite_dev);
+#endif /* RL_ALLOW_MSG_PACKING */
+
+#if defined(RL_ALLOW_TX_STASH) && (RL_ALLOW_TX_STASH == 1)
+/*!
+ * @brief Sets the number of tx buffers the endpoint keeps in its stash.
+ *
+ * rpmsg_lite_send() on the endpoint takes the tx buffer from the stash without
+ * taking the tx lock. An empty stash is refilled in the same locked operation
+ * which takes the buffer for the message, so the tx lock is taken once per
+ * count + 1 messages to get buffers, plus once per message to enqueue it.
+ * The stashes of all endpoints hold at most half of the tx buffers of the
+ * instance, the other senders are not starved. The stash is owned by one task,
+ * only that task may send on the endpoint and flush the stash.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param ept               Endpoint
+ * @param count             Max. number of stashed buffers, up to RL_TX_STASH_SIZE, 0 to disable the stash
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ * @see rpmsg_lite_flush_ept_tx_stash
+ */
+int32_t rpmsg_lite_set_ept_tx_stash(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                    struct rpmsg_lite_endpoint *ept,
+                                    uint32_t count);
+
+/*!
+ * @brief Returns the tx buffers stashed by the endpoint to the instance,
+ * to be called when the task stops sending for a while.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param ept               Endpoint
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ * @see rpmsg_lite_set_ept_tx_stash
+ */
+int32_t rpmsg_lite_flush_ept_tx_stash(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_lite_endpoint *ept);
+#endif /* RL_ALLOW_TX_STASH */
+
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+/*!
+ * @brief Sets the tx buffer quota of the endpoint, to be called right after
+ * the endpoint creation.
+ *
+ * The reserved buffers are kept for the endpoint alone, the endpoint gets one
+ * of them without waiting for the other senders as long as it holds less than
+ * reserved buffers in flight. Beyond that, the endpoint takes the buffers from
+ * the pool shared by all senders, which holds the tx buffers not reserved by
+ * any endpoint, up to max_in_flight buffers in total. Endpoints have neither a
+ * reservation nor a limit by default. A buffer is in flight from its allocation
+ * until the other side returns it. The buffers taken by rpmsg_lite_alloc_tx_buffer()
+ * and for the packed messages come from the shared pool.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param ept               Endpoint
+ * @param reserved          Number of tx buffers reserved for the endpoint
+ * @param max_in_flight     Max. number of tx buffers in flight, at least reserved, 0 for no limit
+ *
+ * @return RL_SUCCESS on success, RL_ERR_NO_MEM when the tx buffers of the instance
+ *         cannot cover the reservations of all endpoints.
+ *
+ * @see rpmsg_lite_get_ept_tx_quota_stats
+ */
+int32_t rpmsg_lite_set_ept_tx_quota(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                    struct rpmsg_lite_endpoint *ept,
+                                    uint32_t reserved,
+                                    uint32_t max_in_flight);
+
+/*!
+ * @brief Returns the number of tx buffers the endpoint holds in flight and the
+ * number of its buffer requests refused by the quota since its creation.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param ept               Endpoint
+ * @param in_flight         Pointer to store the number of tx buffers in flight
+ * @param denied            Pointer to store the number of refused buffer requests
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ * @see rpmsg_lite_set_ept_tx_quota
+ */
+int32_t rpmsg_lite_get_ept_tx_quota_stats(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                          struct rpmsg_lite_endpoint *ept,
+                                          uint32_t *in_flight,
+                                          uint32_t *denied);
+#endif /* RL_ALLOW_TX_QUOTA */
+
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+/*!
+ * @brief Puts the endpoint and its peer endpoint under credit-based flow control.
+ *
+ * Both endpoints of the pair have to call this function, each one with the address of the other one.
+ * The endpoint lets the peer hold up to window of its messages: the peer sends only while it has
+ * a credit, and gets a new one as the endpoint releases each message, by returning RL_RELEASE from
+ * the rx callback or by rpmsg_lite_release_rx_buffer(), e.g. from rpmsg_queue_recv(). The credits
+ * are granted with the messages the endpoint sends to the peer, or by credit messages once half of
+ * the window is released. Credit messages are not sent from a callback running in the ISR, release
+ * the messages from a task or use the rx worker when the endpoint sends no messages to the peer.
+ * With a rpmsg_queue, keep the window within the queue depth so that no message is dropped.
+ * Messages sent by rpmsg_lite_send() and rpmsg_lite_send_nocopy() to the peer are flow controlled,
+ * the batch, fragmented and packed ones are not.
+ *
+ * The function sends a sync granting the window to the peer, the peer keeps it until it calls this
+ * function too when its endpoint does not exist yet. Call it again with a new window to resize the
+ * window, messages of the peer in flight at the time of the sync may be counted against the new
+ * window once. After one of the endpoints has been re-created, call it again on both of them.
+ * A window of 0 stops the flow control of the endpoint only, disable it on both endpoints.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param ept               Endpoint
+ * @param peer              Address of the peer endpoint
+ * @param window            Max. number of messages of the peer held by the endpoint, up to the number
+ *                          of rx buffers, 0 to disable the flow control
+ * @param timeout           Timeout in ms to get a tx buffer for the sync, 0 if nonblocking
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_set_ept_flow_control(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                        struct rpmsg_lite_endpoint *ept,
+                                        uint32_t peer,
+                                        uint32_t window,
+                                        uintptr_t timeout);
+
+/*!
+ * @brief Gets the flow control state and counters of the endpoint.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param ept               Endpoint
+ * @param stats             Pointer to the counters to fill
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_get_ept_fc_stats(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                    struct rpmsg_lite_endpoint *ept,
+                                    struct rpmsg_lite_fc_stats *stats);
+#endif /* RL_ALLOW_CREDIT_FLOW_CONTROL */
+
+#if defined(RL_ALLOW_ASYNC_SEND) && (RL_ALLOW_ASYNC_SEND == 1)
+/*!
+ * @brief Sends a message without waiting for a tx buffer.
+ *
+ * When a tx buffer is free the message is copied into it and sent right away, otherwise the request
+ * is queued and sent from the tx callback once the other side returns tx buffers. The other side has
+ * to be built with RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION enabled for that, without it the pending
+ * requests are sent by the next call of this function only. The queued requests are sent in order,
+ * a message sent by this function does not overtake the pending ones, messages sent by the other
+ * send functions do. done_cb is called exactly once for each request accepted by the function, before
+ * the function returns when the message is sent right away, otherwise from the tx callback, possibly
+ * in the ISR, or from a later call of this function. Pending requests are dropped with RL_NOT_READY
+ * when their endpoint is destroyed or the instance is deinitialized.
+ *
+ * A payload of up to RL_ASYNC_SEND_COPY_SIZE bytes is copied into the request, a larger one is
+ * referenced and the data buffer has to stay valid until done_cb is called. The request is owned by
+ * the instance until done_cb is called.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param ept               Sender endpoint
+ * @param dst               Remote endpoint address
+ * @param data              Payload buffer
+ * @param size              Size of payload, in bytes
+ * @param req               Request storage
+ * @param done_cb           Completion callback
+ * @param done_cb_data      Completion callback data
+ *
+ * @return Status of function execution, RL_SUCCESS when the request is sent or queued,
+ *         RL_ERR_NO_MEM when RL_ASYNC_SEND_QUEUE_DEPTH requests are pending already,
+ *         done_cb is not called on any other status than RL_SUCCESS.
+ *
+ */
+int32_t rpmsg_lite_send_async(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                              struct rpmsg_lite_endpoint *ept,
+                              uint32_t dst,
+                              char *data,
+                              uint32_t size,
+                              struct rpmsg_lite_async_req *req,
+                              rl_async_done_cb_t done_cb,
+                              void *done_cb_data);
+
+/*!
+ * @brief Returns the asynchronous send counters since the instance initialization.
+ * wait_total / sent_queued gives the average time a queued request spent pending,
+ * convert it with env_timestamp_to_msec().
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param stats             Pointer to store the counters
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_get_async_stats(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_lite_async_stats *stats);
+#endif /* RL_ALLOW_ASYNC_SEND */
+
+#if (RL_QUEUE_PAIR_COUNT > 1)
+/*!
+ * @brief Selects the queue pair the endpoint sends its messages on.
+ *
+ * Each queue pair has its own vrings and tx buffers, a bulk transfer filling
+ * one queue pair does not hold back the messages sent on the others. The
+ * receiving side takes the messages from its queue pairs in the order set by
+ * rpmsg_lite_set_rx_queue_policy(). Endpoints send on queue pair 0 by default.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param ept               Endpoint
+ * @param queue             Queue pair, less than RL_QUEUE_PAIR_COUNT, or RL_QUEUE_PER_CORE
+ *                          to send on the queue pair of the sending core, see RL_QUEUE_CORE_ID
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ * @see rpmsg_lite_set_rx_queue_policy
+ */
+int32_t rpmsg_lite_set_ept_queue(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                 struct rpmsg_lite_endpoint *ept,
+                                 uint32_t queue);
+
+/*!
+ * @brief Sets the order the received messages are taken from the queue pairs.
+ *
+ * With RL_QUEUE_POLICY_PRIORITY, the default, every message is taken from the
+ * lowest queue pair holding one, a message received on queue pair 0 is delivered
+ * next even while the other queue pairs are full. With RL_QUEUE_POLICY_WRR the
+ * queue pairs are served in turns, up to weights[i] messages from queue pair i
+ * per turn, so a busy queue pair cannot starve the others.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param policy            RL_QUEUE_POLICY_PRIORITY or RL_QUEUE_POLICY_WRR
+ * @param weights           RL_QUEUE_PAIR_COUNT weights, at least 1, for RL_QUEUE_POLICY_WRR only
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ * @see rpmsg_lite_set_ept_queue
+ */
+int32_t rpmsg_lite_set_rx_queue_policy(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                       uint32_t policy,
+                                       const uint32_t *weights);
+#endif /* (RL_QUEUE_PAIR_COUNT > 1) */
+
+#if defined(RL_ALLOW_RX_ADAPTIVE_POLLING) && (RL_ALLOW_RX_ADAPTIVE_POLLING == 1)
+/*!
+ * @brief Returns the number of rx interrupts taken and the number of messages
+ * received in them since the instance initialization.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param irq_count         Pointer to store the number of rx interrupts
+ * @param msg_count         Pointer to store the number of received messages
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_get_rx_counters(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                   uint32_t *irq_count,
+                                   uint32_t *msg_count);
+#endif /* RL_ALLOW_RX_ADAPTIVE_POLLING */
+
+#if defined(RL_ALLOW_CACHE_COUNTERS) && (RL_ALLOW_CACHE_COUNTERS == 1)
+/*!
+ * @brief Returns the cache maintenance counters since the instance initialization.
+ * Only the header and the payload of each message is flushed or invalidated,
+ * flushed_bytes / tx_count and invalidated_bytes / rx_count give the average per message.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param counters          Pointer to store the counters
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_get_cache_counters(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                      struct rpmsg_lite_cache_counters *counters);
+#endif /* RL_ALLOW_CACHE_COUNTERS */
+
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+/*!
+ * @brief Processes received messages handed over by the rx ISR, to be called
+ * in a loop from a dedicated task of the application.
+ *
+ * The rx ISR calls the rx_cb of the endpoints enabled by rpmsg_lite_set_ept_rx_in_isr() only.
+ * At the first message for another endpoint it stops taking messages from the vring
+ * and signals the worker which calls the rx_cb of up to budget messages in the task context.
+ * Once the vring is empty the worker returns the vring processing back to the ISR.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param budget            Max. number of messages processed in one call, 0 for no limit
+ * @param timeout           Timeout in ms to wait for the messages, 0 if nonblocking
+ *
+ * @return Status of function execution, RL_SUCCESS when messages were processed,
+ * RL_ERR_NO_BUFF when no message arrived within the timeout.
+ *
+ */
+int32_t rpmsg_lite_rx_worker(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t budget, uintptr_t timeout);
+
+/*!
+ * @brief Selects whether the rx_cb of the endpoint is called from the rx ISR
+ * or from rpmsg_lite_rx_worker(), default is the rx worker.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param ept               Endpoint
+ * @param rx_in_isr         RL_TRUE to call the rx_cb from the ISR
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_set_ept_rx_in_isr(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                     struct rpmsg_lite_endpoint *ept,
+                                     uint32_t rx_in_isr);
+
+/*!
+ * @brief Returns the worst case of the rx ISR measured since the last call.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param max_count         Pointer to store the max. number of messages processed by one rx ISR
+ * @param max_time          Pointer to store the max. duration of one rx ISR,
+ *                          in units of RL_RX_ISR_TIMESTAMP()
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_get_rx_isr_stats(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                    uint32_t *max_count,
+                                    uint64_t *max_time);
+#endif /* RL_ALLOW_RX_DEFERRED_PROCESSING */
+
 /*!
  * @brief Function to wait until the link is up. Returns RL_TRUE
  * once the link_state is set or RL_FALSE in case of timeout.
@@ -405,6 +1389,30 @@ int32_t rpmsg_lite_release_rx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev,
  */
 void *rpmsg_lite_alloc_tx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t *size, uintptr_t timeout);
 
+#if (RL_QUEUE_PAIR_COUNT > 1) || (defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1))
+/*!
+ * @brief Allocates the tx buffer for message payload on behalf of the endpoint.
+ *
+ * Same as rpmsg_lite_alloc_tx_buffer(), which takes the buffers from queue pair 0,
+ * the message is sent on the queue pair selected by rpmsg_lite_set_ept_queue().
+ * rpmsg_lite_send_nocopy() sends a message on the queue pair its buffer belongs to.
+ * With RL_ALLOW_TX_QUOTA the buffer is charged to the quota of the endpoint.
+ *
+ * @param     rpmsg_lite_dev    RPMsg-Lite instance
+ * @param     ept               Sender endpoint pointer
+ * @param[in] size              Pointer to store maximum payload size available
+ * @param[in] timeout           Integer, wait upto timeout ms or not for buffer to become available
+ *
+ * @return The tx buffer address on success and RL_NULL on failure.
+ *
+ * @see rpmsg_lite_send_nocopy
+ */
+void *rpmsg_lite_alloc_ept_tx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                     struct rpmsg_lite_endpoint *ept,
+                                     uint32_t *size,
+                                     uintptr_t timeout);
+#endif
+
 /*!
  * @brief Sends a message in tx buffer allocated by rpmsg_lite_alloc_tx_buffer()
  *
@@ -427,6 +1435,9 @@ void *rpmsg_lite_alloc_tx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev, uin
  * @param[in] size          Length of payload
  *
  * @return 0 on success and an appropriate error value on failure.
+ * @if RL_ALLOW_CREDIT_FLOW_CONTROL
+ *         RL_ERR_NO_BUFF when dst is the flow control peer of ept and has granted no credit, the send does not wait.
+ * @endif
  *
  * @see rpmsg_lite_alloc_tx_buffer
  */
@@ -435,6 +1446,155 @@ int32_t rpmsg_lite_send_nocopy(struct rpmsg_lite_instance *rpmsg_lite_dev,
                                uint32_t dst,
                                void *data,
                                uint32_t size);
+
+/*!
+ * @brief Sends a batch of messages in tx buffers allocated by rpmsg_lite_alloc_tx_buffer(),
+ * the remote side is notified only once for the whole batch.
+ *
+ * The same rules as for rpmsg_lite_send_nocopy() apply to each tx buffer of the batch.
+ * All buffers are enqueued on the virtqueue under a single tx lock of the instance
+ * followed by one virtqueue_kick(). Tx buffers of entries not sent in case of an error
+ * are still owned by the application.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param[in] entries       Array of messages to send, data pointing to the tx buffers
+ * @param[in] count         Number of entries in the array
+ * @param[out] sent         Pointer to store the number of messages sent
+ *
+ * @return 0 on success and an appropriate error value on failure.
+ *
+ * @see rpmsg_lite_alloc_tx_buffer
+ * @see rpmsg_lite_send_nocopy
+ */
+int32_t rpmsg_lite_send_nocopy_batch(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                     const struct rpmsg_lite_batch_entry *entries,
+                                     uint32_t count,
+                                     uint32_t *sent);
+
+#if defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)
+/*!
+ * @brief Sends a message in tx buffer allocated by rpmsg_lite_alloc_tx_buffer()
+ * and reports its token once the other side has consumed it.
+ *
+ * The same rules as for rpmsg_lite_send_nocopy() apply. When the other side returns
+ * the tx buffer (the used ring on the master, the avail ring on the remote), the
+ * callback registered by rpmsg_lite_set_tx_consumed_cb() is called with the token,
+ * the send timestamp and the timestamp of the buffer return. The reports are made
+ * from the tx callback, i.e. possibly in the ISR, which requires the other side to be
+ * built with RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION, or from rpmsg_lite_poll_tx_consumed().
+ * Tokens are reported in the order the buffers come back.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param[in] ept           Sender endpoint pointer
+ * @param[in] dst           Destination address
+ * @param[in] data          TX buffer with message filled
+ * @param[in] size          Length of payload
+ * @param[in] token         Completion token, RL_NULL for none (same as rpmsg_lite_send_nocopy())
+ *
+ * @return 0 on success and an appropriate error value on failure, the token is not
+ *         reported on failure.
+ *
+ * @see rpmsg_lite_set_tx_consumed_cb
+ */
+int32_t rpmsg_lite_send_nocopy_token(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                     struct rpmsg_lite_endpoint *ept,
+                                     uint32_t dst,
+                                     void *data,
+                                     uint32_t size,
+                                     void *token);
+
+/*!
+ * @brief Registers the callback reporting the consumed tx tokens, RL_NULL to stop the reports.
+ * Tokens consumed while no callback is registered are discarded.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param cb                Tx consumed callback, RL_NULL for none
+ * @param cb_data           Callback data
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_set_tx_consumed_cb(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                      rl_tx_consumed_cb_t cb,
+                                      void *cb_data);
+
+/*!
+ * @brief Takes back the tx buffers returned by the other side and reports their
+ * tokens, for the systems where the other side does not notify the returned buffers.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_poll_tx_consumed(struct rpmsg_lite_instance *rpmsg_lite_dev);
+#endif /* RL_ALLOW_TX_TOKENS */
+
+#if defined(RL_ALLOW_GROUP_ENDPOINTS) && (RL_ALLOW_GROUP_ENDPOINTS == 1)
+/*!
+ * @brief Initializes a group (topic) endpoint context.
+ *
+ * Create the group endpoint with rpmsg_lite_group_rx_cb() and the group context as
+ * its callback data. Each message received on the group endpoint is passed to the
+ * rx callback of every subscribed endpoint in subscription order, from the same rx
+ * buffer. A subscriber returning RL_HOLD takes a reference to the buffer and releases
+ * it with rpmsg_lite_release_rx_buffer() (rpmsg_queue_nocopy_free() for an rpmsg_queue
+ * endpoint), the buffer goes back to the vring with the last reference.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param group             Group context to initialize
+ * @param subs              Array of the subscribed endpoints
+ * @param subs_size         Length of the subs array, max. number of subscribers
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+int32_t rpmsg_lite_group_init(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                              struct rpmsg_lite_group *group,
+                              struct rpmsg_lite_endpoint **subs,
+                              uint32_t subs_size);
+
+/*!
+ * @brief Subscribes a local endpoint to the group, the endpoint gets the
+ * messages received on the group endpoint from now on.
+ * Not to be called from the rx callback of a subscriber.
+ *
+ * @param group             Group context
+ * @param ept               Subscribed endpoint
+ *
+ * @return Status of function execution, RL_SUCCESS on success,
+ *         RL_ERR_NO_MEM when the subs array is full.
+ *
+ */
+int32_t rpmsg_lite_group_subscribe(struct rpmsg_lite_group *group, struct rpmsg_lite_endpoint *ept);
+
+/*!
+ * @brief Unsubscribes a local endpoint from the group, to be called before the
+ * endpoint is destroyed. The buffers it holds have to be released still.
+ * Not to be called from the rx callback of a subscriber.
+ *
+ * @param group             Group context
+ * @param ept               Subscribed endpoint
+ *
+ * @return Status of function execution, RL_SUCCESS on success,
+ *         RL_ERR_PARAM when the endpoint is not subscribed.
+ *
+ */
+int32_t rpmsg_lite_group_unsubscribe(struct rpmsg_lite_group *group, struct rpmsg_lite_endpoint *ept);
+
+/*!
+ * @brief Group endpoint rx callback handing the received message over to the
+ * subscribers, to be registered with the group context as the callback data.
+ *
+ * @param payload           Pointer to the buffer containing received data
+ * @param payload_len       Size of data received, in bytes
+ * @param src               Address of the endpoint from which data is received
+ * @param priv              Group context
+ *
+ * @return RL_HOLD while a subscriber holds the buffer, RL_RELEASE otherwise
+ */
+int32_t rpmsg_lite_group_rx_cb(void *payload, uint32_t payload_len, uint32_t src, void *priv);
+#endif /* RL_ALLOW_GROUP_ENDPOINTS */
 #endif /* RL_API_HAS_ZEROCOPY */
 
 //! @}
@@ -2,7 +2,7 @@
  * Copyright (c) 2014, Mentor Graphics Corporation
  * Copyright (c) 2015 Xilinx, Inc.
  * Copyright (c) 2016 Freescale Semiconductor, Inc.
- * Copyright 2016-2022 NXP
+ * Copyright 2016-2026 NXP
  * Copyright 2021 ACRIOS Systems s.r.o.
  * All rights reserved.
  *
@@ -47,6 +47,24 @@ typedef void *rpmsg_queue_handle;
 /* RL_API_HAS_ZEROCOPY has to be enabled for RPMsg Queue to work */
 #if defined(RL_API_HAS_ZEROCOPY) && (RL_API_HAS_ZEROCOPY == 1)
 
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+/*! \typedef rpmsg_queue_watermark_cb
+    \brief Queue watermark callback type, above_high is RL_TRUE when the high watermark
+    is reached and RL_FALSE when the queue drains down to the low watermark.
+*/
+typedef void (*rpmsg_queue_watermark_cb)(rpmsg_queue_handle q, uint32_t above_high, void *priv);
+
+/*!
+ * RPMsg queue statistics, see rpmsg_queue_get_stats()
+ */
+struct rpmsg_queue_stats
+{
+    uint32_t dropped_count; /*!< Messages dropped because the queue was full */
+    uint32_t parked_count;  /*!< Messages parked because the queue was full (lossless mode) */
+    uint32_t max_depth;     /*!< Highest number of messages held by the queue, parked ones included */
+};
+#endif /* RL_ALLOW_QUEUE_BACKPRESSURE */
+
 /*******************************************************************************
  * API
  ******************************************************************************/
@@ -186,6 +204,7 @@ int32_t rpmsg_queue_nocopy_free(struct rpmsg_lite_instance *rpmsg_lite_dev, void
 
 /*!
  * @brief This function returns the number of pending messages in the queue.
+ * With RL_ALLOW_QUEUE_BACKPRESSURE enabled the parked messages are included.
  *
  * @param[in] q             RPMsg queue handle
  *
@@ -193,6 +212,65 @@ int32_t rpmsg_queue_nocopy_free(struct rpmsg_lite_instance *rpmsg_lite_dev, void
  */
 int32_t rpmsg_queue_get_current_size(rpmsg_queue_handle q);
 
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+/*!
+ * @brief Set the depth of the queue and the way a message received while the queue is full is handled.
+ *
+ * In the lossless mode the message is parked, its RX buffer is held and all the following messages
+ * of the queue are parked behind it to keep the order. The parked messages are moved into the queue
+ * by rpmsg_queue_recv()/rpmsg_queue_recv_nocopy() as the space frees up. The held buffers are not
+ * returned to the other side, so the sender is throttled by running out of the TX buffers.
+ * Otherwise the message is dropped and counted, see rpmsg_queue_get_stats().
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param[in] q             RPMsg queue handle
+ * @param[in] depth         Maximum number of messages in the queue, 0 for the full queue length
+ * @param[in] lossless      RL_TRUE to park, RL_FALSE to drop the messages received while the queue is full
+ *
+ * @return Status of function execution, RL_ERR_PARAM when depth exceeds the queue length.
+ */
+int32_t rpmsg_queue_set_depth(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                              rpmsg_queue_handle q,
+                              uint32_t depth,
+                              uint32_t lossless);
+
+/*!
+ * @brief Register the queue watermark callback.
+ *
+ * The callback is invoked with above_high set to RL_TRUE from the endpoint rx callback context
+ * once the number of messages held by the queue, parked ones included, reaches the high watermark,
+ * and with RL_FALSE from the receiving task once it drains down to the low watermark.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param[in] q             RPMsg queue handle
+ * @param[in] high          High watermark, 0 disables the callback
+ * @param[in] low           Low watermark, has to be lower than high
+ * @param[in] cb            Watermark callback function
+ * @param[in] cb_data       Private data passed to the callback function
+ *
+ * @return Status of function execution.
+ */
+int32_t rpmsg_queue_set_watermarks(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                   rpmsg_queue_handle q,
+                                   uint32_t high,
+                                   uint32_t low,
+                                   rpmsg_queue_watermark_cb cb,
+                                   void *cb_data);
+
+/*!
+ * @brief Get the queue statistics, the counters accumulate since the queue creation.
+ *
+ * @param rpmsg_lite_dev    RPMsg-Lite instance
+ * @param[in] q             RPMsg queue handle
+ * @param[out] stats        Pointer to the statistics structure to fill
+ *
+ * @return Status of function execution.
+ */
+int32_t rpmsg_queue_get_stats(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                              rpmsg_queue_handle q,
+                              struct rpmsg_queue_stats *stats);
+#endif /* RL_ALLOW_QUEUE_BACKPRESSURE */
+
 //! @}
 
 #if defined(__cplusplus)
@@ -48,6 +48,12 @@
  * interrupt me when you consume a buffer.  It's unreliable, so it's
  * simply an optimization.  */
 #define VRING_AVAIL_F_NO_INTERRUPT 1U
+/* RPMsg-Lite extension of the flags above: the owner of avail->flags (Guest)
+ * or used->flags (Host) sets this bit once it publishes its event index, so
+ * the other side may rely on it instead of the NO_INTERRUPT/NO_NOTIFY flags.
+ * This takes the place of VIRTIO_RING_F_EVENT_IDX feature negotiation. */
+#define VRING_AVAIL_F_EVENT_IDX 0x8000U
+#define VRING_USED_F_EVENT_IDX  0x8000U
 
 /* VirtIO ring descriptors: 16 bytes.
  * These can chain together via "next". */
@@ -145,7 +151,9 @@ static inline void vring_init(struct vring *vr, uint32_t num, uint8_t *p, uint32
     vr->num   = num;
     vr->desc  = (struct vring_desc *)(void *)p;
     vr->avail = (struct vring_avail *)(void *)(p + num * sizeof(struct vring_desc));
-    vr->used  = (struct vring_used *)(((uintptr_t)&vr->avail->ring[num] + align - 1UL) & ~(align - 1UL));
+    /* Keep the trailing used_event_idx of the avail ring out of the used ring */
+    vr->used  = (struct vring_used *)(((uintptr_t)&vr->avail->ring[num] + sizeof(uint16_t) + align - 1UL) &
+                                     ~(align - 1UL));
 }
 
 /*
@@ -155,15 +163,10 @@ static inline void vring_init(struct vring *vr, uint32_t num, uint8_t *p, uint32
  * just incremented index from old to new_idx, should we trigger an
  * event?
  */
-/*
- * $Line Coverage Justification$
- * This function does not need to be tested because it is not used in rpmsg_lite
- * implementation (only called from unused part of vq_ring_must_notify_host() ).
- */
-/* GCOVR_EXCL_START */
 static inline int32_t vring_need_event(uint16_t event_idx, uint16_t new_idx, uint16_t old)
 {
-    if (((uint16_t)new_idx - (uint16_t)event_idx - (uint16_t)1U) < ((uint16_t)new_idx - (uint16_t)old))
+    /* Compare modulo 2^16, the operands are promoted to int before the subtraction */
+    if ((uint16_t)(new_idx - event_idx - 1U) < (uint16_t)(new_idx - old))
     {
         return 1;
     }
@@ -172,5 +175,4 @@ static inline int32_t vring_need_event(uint16_t event_idx, uint16_t new_idx, uin
         return 0;
     }
 }
-/* GCOVR_EXCL_STOP */
 #endif /* VIRTIO_RING_H */
@@ -38,6 +38,10 @@
 #include "virtio_ring.h"
 #include "llist.h"
 
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+#include <stdatomic.h>
+#endif
+
 /*Error Codes*/
 #define VQ_ERROR_BASE            (-3000)
 #define ERROR_VRING_FULL         (VQ_ERROR_BASE - 1)
@@ -64,10 +68,20 @@
  * in the descriptor table. This is used to verify we are correctly
  * handling vq_free_cnt.
  */
-#define VQ_RING_DESC_CHAIN_END   (32768)
-#define VIRTQUEUE_FLAG_INDIRECT  (0x0001U)
-#define VIRTQUEUE_FLAG_EVENT_IDX (0x0002U)
-#define VIRTQUEUE_MAX_NAME_SZ    (32) /* mind the alignment */
+#define VQ_RING_DESC_CHAIN_END     (32768)
+#define VIRTQUEUE_FLAG_INDIRECT    (0x0001U)
+#define VIRTQUEUE_FLAG_EVENT_IDX   (0x0002U)
+/* This side consumes the avail ring and fills the used ring (remote role) */
+#define VIRTQUEUE_FLAG_DEVICE      (0x0004U)
+/* Callbacks suppressed by virtqueue_disable_cb(), the event index is not re-armed */
+#define VIRTQUEUE_FLAG_CB_DISABLED (0x0008U)
+/* Buffers taken and added by several producers without a lock, see virtqueue_enable_multi_producer() */
+#define VIRTQUEUE_FLAG_MULTI_PRODUCER (0x0010U)
+/* vq_prod_shadow_idx holds the index of the ring written by this side */
+#define VIRTQUEUE_FLAG_PROD_IDX_VALID (0x0020U)
+/* Device side honours VRING_AVAIL_F_NO_INTERRUPT, a driver not clearing it after its initialization is not notified */
+#define VIRTQUEUE_FLAG_DRIVER_NO_INTERRUPT (0x0040U)
+#define VIRTQUEUE_MAX_NAME_SZ      (32) /* mind the alignment */
 
 /* Support for indirect buffer descriptors. */
 #define VIRTIO_RING_F_INDIRECT_DESC (1 << 28)
@@ -94,6 +108,17 @@ typedef enum
     VQ_POSTPONE_EMPTIED /* Until all available desc are used. */
 } vq_postpone_t;
 
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+/* local copy of a vring descriptor, see RL_ALLOW_DESC_SHADOW */
+struct vq_desc_shadow
+{
+    void *addr;    /* buffer virtual address, VQ_NULL until the descriptor is read */
+    uint32_t len;  /* buffer length */
+    uint16_t held; /* nonzero while the upper layer holds the buffer */
+    uint16_t pad;
+};
+#endif
+
 /* local virtqueue representation, not in shared memory */
 struct virtqueue
 {
@@ -141,12 +166,33 @@ struct virtqueue
     bool used_read;   /* 8bit wide */
     bool used_write;  /* 8bit wide */
 
-    uint16_t padd;       /* aligned to 32bits after this: */
+    /*
+     * Local copy of the index of the ring written by this side, avail->idx
+     * as the driver, used->idx as the device. This side is the only writer,
+     * the shared index is read once only.
+     */
+    uint16_t vq_prod_shadow_idx; /* aligned to 32bits after this: */
 
     void *priv;          /* private pointer, upper layer instance pointer */
 #if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
     void *env;           /* private pointer to environment layer internal context */
 #endif
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+    /*
+     * Multi producer state, replaces vq_used_cons_idx/vq_available_idx
+     * and vq_queued_cnt when VIRTQUEUE_FLAG_MULTI_PRODUCER is set.
+     */
+    _Atomic uint16_t vq_cons_claim; /* next entry to take, claimed by compare and swap */
+    _Atomic uint16_t vq_prod_claim; /* next ring slot reserved by a producer */
+    _Atomic uint16_t vq_prod_idx;   /* ring index published to the other side */
+    _Atomic uint16_t vq_kick_idx;   /* ring index covered by the last virtqueue_kick() */
+    atomic_flag vq_prod_busy;       /* set while a producer publishes the ring index */
+    _Atomic uint16_t vq_prod_ready[RL_BUFFER_COUNT]; /* ring index + 1 once the slot is filled */
+#endif
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+    struct vq_desc_shadow vq_shadow[RL_BUFFER_COUNT]; /* indexed by the descriptor index */
+    uint16_t vq_shadow_hash[2U * RL_BUFFER_COUNT];    /* buffer address to descriptor index + 1, 0 when empty */
+#endif
 };
 
 /* struct to hold vring specific information */
@@ -242,12 +288,22 @@ void *virtqueue_get_available_buffer(struct virtqueue *vq, uint16_t *avail_idx,
 
 int32_t virtqueue_add_consumed_buffer(struct virtqueue *vq, uint16_t head_idx, uint32_t len);
 
+int32_t virtqueue_add_buffers(struct virtqueue *vq, const struct vring_used_elem *elems, uint16_t count);
+
+int32_t virtqueue_add_consumed_buffers(struct virtqueue *vq, const struct vring_used_elem *elems, uint16_t count);
+
 void virtqueue_disable_cb(struct virtqueue *vq);
 
 int32_t virtqueue_enable_cb(struct virtqueue *vq);
 
+void virtqueue_enable_event_idx(struct virtqueue *vq);
+
 void virtqueue_kick(struct virtqueue *vq);
 
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+int32_t virtqueue_enable_multi_producer(struct virtqueue *vq);
+#endif
+
 #if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
 void virtqueue_free_static(struct virtqueue *vq);
 #else
@@ -262,6 +318,12 @@ uint32_t virtqueue_get_desc_size(struct virtqueue *vq);
 
 uint32_t virtqueue_get_buffer_length(struct virtqueue *vq, uint16_t idx);
 
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+int32_t virtqueue_get_buffer_index(struct virtqueue *vq, void *buffer, uint16_t *idx);
+
+void virtqueue_reset_desc_shadow(struct virtqueue *vq);
+#endif
+
 void vq_ring_init(struct virtqueue *vq);
 
 #endif /* VIRTQUEUE_H_ */
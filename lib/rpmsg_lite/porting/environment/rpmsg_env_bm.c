@@ -53,6 +53,9 @@
 
 static int32_t env_init_counter = 0;
 
+/* BM has no time base, time stamps count the time spent in env_sleep_msec() */
+static uint64_t env_sleep_time_ms = 0U;
+
 /* Max supported ISR counts */
 #define ISR_COUNT RL_PLATFORM_MAX_ISR_COUNT
 /*!
@@ -358,6 +361,87 @@ void env_unlock_mutex(void *lock)
      * since the API is not shared with ISR context. */
 }
 
+/*!
+ * env_create_sync_lock
+ *
+ * Creates a synchronization lock primitive. It is used
+ * when signal has to be sent from the interrupt context to main
+ * thread context. BM implementation is a flag set from the ISR.
+ */
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+int32_t env_create_sync_lock(void **lock, int32_t state, void *context)
+#else
+int32_t env_create_sync_lock(void **lock, int32_t state)
+#endif
+{
+    volatile uint8_t *flag_ptr;
+
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    flag_ptr = (volatile uint8_t *)context;
+#else
+    flag_ptr = (volatile uint8_t *)env_allocate_memory(sizeof(uint8_t));
+#endif
+    if (flag_ptr == ((void *)0))
+    {
+        return -1;
+    }
+
+    *flag_ptr = (state == UNLOCKED) ? 1U : 0U;
+    *lock     = (void *)flag_ptr;
+    return 0;
+}
+
+/*!
+ * env_delete_sync_lock
+ *
+ * Deletes the given lock
+ *
+ */
+void env_delete_sync_lock(void *lock)
+{
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+    if (lock != ((void *)0))
+    {
+        env_free_memory(lock);
+    }
+#endif
+}
+
+/*!
+ * env_acquire_sync_lock
+ *
+ * Polls the sync lock flag. There is nothing to suspend on in the BM
+ * environment, so the caller is delayed by at most RL_MS_PER_INTERVAL
+ * and has to re-check its condition after each return.
+ */
+int32_t env_acquire_sync_lock(void *lock, uintptr_t timeout_ms)
+{
+    volatile uint8_t *flag_ptr = (volatile uint8_t *)lock;
+
+    if ((*flag_ptr == 0U) && (timeout_ms != 0U))
+    {
+        env_sleep_msec((timeout_ms < (uintptr_t)RL_MS_PER_INTERVAL) ? (uint32_t)timeout_ms :
+                                                                      (uint32_t)RL_MS_PER_INTERVAL);
+    }
+
+    if (*flag_ptr != 0U)
+    {
+        *flag_ptr = 0U;
+        return 0;
+    }
+    return -1;
+}
+
+/*!
+ * env_release_sync_lock
+ *
+ * Releases the given sync lock, can be called from the ISR.
+ */
+void env_release_sync_lock(void *lock)
+{
+    *(volatile uint8_t *)lock = 1U;
+}
+
 /*!
  * env_sleep_msec
  *
@@ -366,6 +450,7 @@ void env_unlock_mutex(void *lock)
 void env_sleep_msec(uint32_t num_msec)
 {
     platform_time_delay(num_msec);
+    env_sleep_time_ms += num_msec;
 }
 
 /*!
@@ -470,6 +555,43 @@ void env_cache_invalidate(void *data, uint32_t len)
 #endif
 }
 
+/*!
+ *
+ * env_get_timestamp
+ *
+ * Returns a 64 bit time stamp, the time in msecs spent in env_sleep_msec().
+ *
+ *
+ */
+uint64_t env_get_timestamp(void)
+{
+    return env_sleep_time_ms;
+}
+
+/*!
+ *
+ * env_timestamp_to_msec
+ *
+ * Converts a time stamp difference to msecs.
+ *
+ */
+uint32_t env_timestamp_to_msec(uint64_t timestamp)
+{
+    return (uint32_t)timestamp;
+}
+
+/*!
+ *
+ * env_timestamp_to_usec
+ *
+ * Converts a time stamp difference to usecs.
+ *
+ */
+uint64_t env_timestamp_to_usec(uint64_t timestamp)
+{
+    return timestamp * 1000ULL;
+}
+
 /*========================================================= */
 /* Util data / functions for BM */
 
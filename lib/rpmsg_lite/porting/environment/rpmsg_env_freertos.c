@@ -76,6 +76,12 @@ StaticEventGroup_t event_group_static_context;
  */
 #define RL_ENV_MAX_MUTEX_COUNT (10)
 
+/* Converts a timeout in ms to ticks, rounded up so that a timeout shorter than one tick
+   still waits instead of expiring right away */
+#define RL_ENV_MS_TO_TICKS(timeout_ms)                  \
+    ((portMAX_DELAY == (timeout_ms)) ? portMAX_DELAY : \
+                                       (TickType_t)(((timeout_ms) + portTICK_PERIOD_MS - 1U) / portTICK_PERIOD_MS))
+
 /* Max supported ISR counts */
 #define ISR_COUNT RL_PLATFORM_MAX_ISR_COUNT
 /*!
@@ -131,7 +137,7 @@ uint32_t env_wait_for_link_up(volatile uint32_t *link_state, uint32_t link_id, u
     {
         EventBits_t uxBits;
         uxBits = xEventGroupWaitBits(event_group, (EventBits_t)(1UL << link_id), pdFALSE, pdTRUE,
-                                     ((portMAX_DELAY == timeout_ms) ? portMAX_DELAY : timeout_ms / portTICK_PERIOD_MS));
+                                     RL_ENV_MS_TO_TICKS(timeout_ms));
         if (uxBits == (EventBits_t)(1UL << link_id))
         {
             return 1U;
@@ -525,6 +531,42 @@ void env_delete_sync_lock(void *lock)
     }
 }
 
+/*!
+ * env_acquire_sync_lock
+ *
+ * Tries to acquire the sync lock, suspends the calling task until the lock
+ * is released or the timeout expires.
+ */
+int32_t env_acquire_sync_lock(void *lock, uintptr_t timeout_ms)
+{
+    SemaphoreHandle_t xSemaphore = (SemaphoreHandle_t)lock;
+    if (xSemaphoreTake(xSemaphore, RL_ENV_MS_TO_TICKS(timeout_ms)) == pdTRUE)
+    {
+        return 0;
+    }
+    return -1;
+}
+
+/*!
+ * env_release_sync_lock
+ *
+ * Releases the given sync lock, can be called from the ISR.
+ */
+void env_release_sync_lock(void *lock)
+{
+    SemaphoreHandle_t xSemaphore = (SemaphoreHandle_t)lock;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    if (env_in_isr() != 0)
+    {
+        (void)xSemaphoreGiveFromISR(xSemaphore, &xHigherPriorityTaskWoken);
+        portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
+    }
+    else
+    {
+        (void)xSemaphoreGive(xSemaphore);
+    }
+}
+
 /*!
  * env_sleep_msec
  *
@@ -532,7 +574,7 @@ void env_delete_sync_lock(void *lock)
  */
 void env_sleep_msec(uint32_t num_msec)
 {
-    vTaskDelay(num_msec / portTICK_PERIOD_MS);
+    vTaskDelay(RL_ENV_MS_TO_TICKS(num_msec));
 }
 
 /*!
@@ -657,6 +699,30 @@ uint64_t env_get_timestamp(void)
     }
 }
 
+/*!
+ *
+ * env_timestamp_to_msec
+ *
+ * Converts a time stamp difference (RTOS ticks) to msecs.
+ *
+ */
+uint32_t env_timestamp_to_msec(uint64_t timestamp)
+{
+    return (uint32_t)((timestamp * 1000ULL) / (uint64_t)configTICK_RATE_HZ);
+}
+
+/*!
+ *
+ * env_timestamp_to_usec
+ *
+ * Converts a time stamp difference (FreeRTOS ticks) to usecs.
+ *
+ */
+uint64_t env_timestamp_to_usec(uint64_t timestamp)
+{
+    return (timestamp * 1000000ULL) / (uint64_t)configTICK_RATE_HZ;
+}
+
 /*========================================================= */
 /* Util data / functions  */
 
@@ -759,8 +825,7 @@ int32_t env_put_queue(void *queue, void *msg, uintptr_t timeout_ms)
     }
     else
     {
-        if (xQueueSend(queue, msg, ((portMAX_DELAY == timeout_ms) ? portMAX_DELAY : timeout_ms / portTICK_PERIOD_MS)) ==
-            pdPASS)
+        if (xQueueSend(queue, msg, RL_ENV_MS_TO_TICKS(timeout_ms)) == pdPASS)
         {
             return 1;
         }
@@ -793,8 +858,7 @@ int32_t env_get_queue(void *queue, void *msg, uintptr_t timeout_ms)
     }
     else
     {
-        if (xQueueReceive(queue, msg,
-                          ((portMAX_DELAY == timeout_ms) ? portMAX_DELAY : timeout_ms / portTICK_PERIOD_MS)) == pdPASS)
+        if (xQueueReceive(queue, msg, RL_ENV_MS_TO_TICKS(timeout_ms)) == pdPASS)
         {
             return 1;
         }
@@ -53,6 +53,12 @@
 
 extern EventGroupHandle_t event_group;
 
+/* Converts a timeout in ms to ticks, rounded up so that a timeout shorter than one tick
+   still waits instead of expiring right away */
+#define RL_ENV_MS_TO_TICKS(timeout_ms)                  \
+    ((portMAX_DELAY == (timeout_ms)) ? portMAX_DELAY : \
+                                       (TickType_t)(((timeout_ms) + portTICK_PERIOD_MS - 1U) / portTICK_PERIOD_MS))
+
 /*!
  * env_tx_callback
  *
@@ -87,7 +93,7 @@ uint32_t env_wait_for_link_up(volatile uint32_t *link_state, uint32_t link_id, u
     {
         EventBits_t uxBits;
         uxBits = xEventGroupWaitBits(event_group, (EventBits_t)(1UL << link_id), pdFALSE, pdTRUE,
-                                     ((portMAX_DELAY == timeout_ms) ? portMAX_DELAY : timeout_ms / portTICK_PERIOD_MS));
+                                     RL_ENV_MS_TO_TICKS(timeout_ms));
         if (uxBits == (EventBits_t)(1UL << link_id))
         {
             return 1U;
@@ -128,8 +134,7 @@ int32_t env_put_queue(void *queue, void *msg, uintptr_t timeout_ms)
     }
     else
     {
-        if (xQueueSend(queue, msg, ((portMAX_DELAY == timeout_ms) ? portMAX_DELAY : timeout_ms / portTICK_PERIOD_MS)) ==
-            pdPASS)
+        if (xQueueSend(queue, msg, RL_ENV_MS_TO_TICKS(timeout_ms)) == pdPASS)
         {
             return 1;
         }
@@ -162,8 +167,7 @@ int32_t env_get_queue(void *queue, void *msg, uintptr_t timeout_ms)
     }
     else
     {
-        if (xQueueReceive(queue, msg,
-                          ((portMAX_DELAY == timeout_ms) ? portMAX_DELAY : timeout_ms / portTICK_PERIOD_MS)) == pdPASS)
+        if (xQueueReceive(queue, msg, RL_ENV_MS_TO_TICKS(timeout_ms)) == pdPASS)
         {
             return 1;
         }
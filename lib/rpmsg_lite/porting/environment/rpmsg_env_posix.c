@@ -0,0 +1,941 @@
+/*
+ * Copyright 2026 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**************************************************************************
+ * FILE NAME
+ *
+ *       rpmsg_env_posix.c
+ *
+ *
+ * DESCRIPTION
+ *
+ *       This file is POSIX (pthread) Implementation of env layer, it allows
+ *       to run RPMsg-Lite master and remote as ordinary host processes.
+ *       Interrupts are emulated by the platform layer, which invokes
+ *       env_isr() from its dispatcher thread.
+ *
+ *
+ **************************************************************************/
+
+#define _GNU_SOURCE
+
+#include "rpmsg_env.h"
+#include "rpmsg_lite.h"
+#include "rpmsg_platform.h"
+#include "virtqueue.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* RL_ENV_MAX_MUTEX_COUNT is an arbitrary count greater than 'count'
+   if the inital count is 1, this function behaves as a mutex
+   if it is greater than 1, it acts as a "resource allocator" with
+   the maximum of 'count' resources available.
+   Currently, only the first use-case is applicable/applied in RPMsg-Lite.
+ */
+#define RL_ENV_MAX_MUTEX_COUNT (10)
+
+/* Max supported ISR counts */
+#define ISR_COUNT RL_PLATFORM_MAX_ISR_COUNT
+
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+#error "This RPMsg-Lite port requires RL_USE_ENVIRONMENT_CONTEXT set to 0"
+#endif
+
+/*!
+ * Structure to keep track of registered ISR's.
+ */
+struct isr_info
+{
+    void *data;
+};
+static struct isr_info isr_table[ISR_COUNT];
+
+/*!
+ * Structure to hold queue information
+ */
+typedef struct env_queue
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    uint8_t *storage;
+    uint32_t element_size;
+    uint32_t length;
+    uint32_t head;
+    uint32_t count;
+} env_queue_t;
+
+static int32_t env_init_counter       = 0;
+static pthread_mutex_t env_init_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t env_link_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t env_link_cond;
+
+/*!
+ * env_get_abs_timeout
+ *
+ * Converts a relative timeout in msecs to an absolute time of the given clock.
+ */
+static void env_get_abs_timeout(clockid_t clock_id, uintptr_t timeout_ms, struct timespec *abs_timeout)
+{
+    (void)clock_gettime(clock_id, abs_timeout);
+    abs_timeout->tv_sec += (time_t)(timeout_ms / 1000U);
+    abs_timeout->tv_nsec += (long)((timeout_ms % 1000U) * 1000000U);
+    if (abs_timeout->tv_nsec >= 1000000000L)
+    {
+        abs_timeout->tv_sec++;
+        abs_timeout->tv_nsec -= 1000000000L;
+    }
+}
+
+/*!
+ * env_init_monotonic_cond
+ *
+ * Initializes the condition variable to measure timeouts on CLOCK_MONOTONIC,
+ * so that wall clock adjustments do not shorten or extend the waits.
+ */
+static int32_t env_init_monotonic_cond(pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+    int32_t status = -1;
+
+    if (0 == pthread_condattr_init(&attr))
+    {
+        if ((0 == pthread_condattr_setclock(&attr, CLOCK_MONOTONIC)) && (0 == pthread_cond_init(cond, &attr)))
+        {
+            status = 0;
+        }
+        (void)pthread_condattr_destroy(&attr);
+    }
+    return status;
+}
+
+/*!
+ * env_wait_for_link_up
+ *
+ * Wait until the link_state parameter of the rpmsg_lite_instance is set.
+ * The waiting thread is woken up by env_tx_callback().
+ *
+ */
+uint32_t env_wait_for_link_up(volatile uint32_t *link_state, uint32_t link_id, uint32_t timeout_ms)
+{
+    struct timespec abs_timeout;
+    uint32_t status = 1U;
+
+    if ((uint32_t)RL_BLOCK != timeout_ms)
+    {
+        env_get_abs_timeout(CLOCK_MONOTONIC, timeout_ms, &abs_timeout);
+    }
+
+    (void)pthread_mutex_lock(&env_link_mutex);
+    while (*link_state != 1U)
+    {
+        if ((uint32_t)RL_BLOCK == timeout_ms)
+        {
+            (void)pthread_cond_wait(&env_link_cond, &env_link_mutex);
+        }
+        else if (ETIMEDOUT == pthread_cond_timedwait(&env_link_cond, &env_link_mutex, &abs_timeout))
+        {
+            status = (*link_state == 1U) ? 1U : 0U;
+            break;
+        }
+        else
+        {
+            /* Woken up or spurious wake-up, check the link state again */
+        }
+    }
+    (void)pthread_mutex_unlock(&env_link_mutex);
+
+    return status;
+}
+
+/*!
+ * env_tx_callback
+ *
+ * Wake up threads waiting in env_wait_for_link_up().
+ *
+ */
+void env_tx_callback(uint32_t link_id)
+{
+    (void)pthread_mutex_lock(&env_link_mutex);
+    (void)pthread_cond_broadcast(&env_link_cond);
+    (void)pthread_mutex_unlock(&env_link_mutex);
+}
+
+/*!
+ * env_init
+ *
+ * Initializes OS/BM environment.
+ *
+ */
+int32_t env_init(void)
+{
+    int32_t retval = 0;
+
+    (void)pthread_mutex_lock(&env_init_mutex);
+    RL_ASSERT(env_init_counter >= 0);
+    if (env_init_counter < 0)
+    {
+        (void)pthread_mutex_unlock(&env_init_mutex);
+        return -1;
+    }
+    env_init_counter++;
+    /* multiple call of 'env_init' - return ok */
+    if (env_init_counter == 1)
+    {
+        /* first call, platform_init() is serialized by the init mutex so that
+           other threads do not use the platform before it is ready */
+        (void)memset(isr_table, 0, sizeof(isr_table));
+        retval = env_init_monotonic_cond(&env_link_cond);
+        if (retval == 0)
+        {
+            retval = platform_init();
+            if (retval != 0)
+            {
+                (void)pthread_cond_destroy(&env_link_cond);
+            }
+        }
+        if (retval != 0)
+        {
+            env_init_counter--;
+        }
+    }
+    (void)pthread_mutex_unlock(&env_init_mutex);
+
+    return retval;
+}
+
+/*!
+ * env_deinit
+ *
+ * Uninitializes OS/BM environment.
+ *
+ * @returns - execution status
+ */
+int32_t env_deinit(void)
+{
+    int32_t retval = 0;
+
+    (void)pthread_mutex_lock(&env_init_mutex);
+    RL_ASSERT(env_init_counter > 0);
+    if (env_init_counter <= 0)
+    {
+        (void)pthread_mutex_unlock(&env_init_mutex);
+        return -1;
+    }
+
+    /* counter on zero - call platform deinit */
+    env_init_counter--;
+    /* multiple call of 'env_deinit' - return ok */
+    if (env_init_counter <= 0)
+    {
+        /* last call, platform_deinit() stops the interrupt dispatcher first */
+        retval = platform_deinit();
+        (void)memset(isr_table, 0, sizeof(isr_table));
+        (void)pthread_cond_destroy(&env_link_cond);
+    }
+    (void)pthread_mutex_unlock(&env_init_mutex);
+
+    return retval;
+}
+
+/*!
+ * env_allocate_memory - implementation
+ *
+ * @param size
+ */
+void *env_allocate_memory(uint32_t size)
+{
+    return malloc(size);
+}
+
+/*!
+ * env_free_memory - implementation
+ *
+ * @param ptr
+ */
+void env_free_memory(void *ptr)
+{
+    free(ptr);
+}
+
+/*!
+ *
+ * env_memset - implementation
+ *
+ * @param ptr
+ * @param value
+ * @param size
+ */
+void env_memset(void *ptr, int32_t value, uint32_t size)
+{
+    /* Mask to byte range for memset */
+    uint32_t masked = ((uint32_t)value) & 0xFFU;
+    (void)memset(ptr, (int)masked, size);
+}
+
+/*!
+ *
+ * env_memcpy - implementation
+ *
+ * @param dst
+ * @param src
+ * @param len
+ */
+void env_memcpy(void *dst, void const *src, uint32_t len)
+{
+    (void)memcpy(dst, src, len);
+}
+
+/*!
+ *
+ * env_strcmp - implementation
+ *
+ * @param dst
+ * @param src
+ */
+
+int32_t env_strcmp(const char *dst, const char *src)
+{
+    return (strcmp(dst, src));
+}
+
+/*!
+ *
+ * env_strncpy - implementation
+ *
+ * @param dest
+ * @param src
+ * @param len
+ */
+void env_strncpy(char *dest, const char *src, uint32_t len)
+{
+    (void)strncpy(dest, src, len);
+}
+
+/*!
+ *
+ * env_strncmp - implementation
+ *
+ * @param dest
+ * @param src
+ * @param len
+ */
+int32_t env_strncmp(char *dest, const char *src, uint32_t len)
+{
+    return (strncmp(dest, src, len));
+}
+
+/*!
+ *
+ * env_mb - implementation
+ *
+ */
+void env_mb(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/*!
+ * env_rmb - implementation
+ */
+void env_rmb(void)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+}
+
+/*!
+ * env_wmb - implementation
+ */
+void env_wmb(void)
+{
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+/*!
+ * env_map_vatopa - implementation
+ *
+ * @param address
+ */
+uint32_t env_map_vatopa(void *address)
+{
+    return (uint32_t)platform_vatopa(address);
+}
+
+/*!
+ * env_map_patova - implementation
+ *
+ * @param address
+ */
+void *env_map_patova(uint32_t address)
+{
+    return platform_patova(address);
+}
+
+/*!
+ * env_create_mutex
+ *
+ * Creates a mutex with the given initial count.
+ * The mutex is recursive, the emulated ISR skips it like the ISR context
+ * of the RTOS ports does, see env_lock_mutex().
+ *
+ */
+int32_t env_create_mutex(void **lock, int32_t count)
+{
+    pthread_mutexattr_t attr;
+    int32_t status = -1;
+
+    if (count > RL_ENV_MAX_MUTEX_COUNT)
+    {
+        return -1;
+    }
+
+    *lock = env_allocate_memory(sizeof(pthread_mutex_t));
+    if (*lock == ((void *)0))
+    {
+        return -1;
+    }
+    if (0 == pthread_mutexattr_init(&attr))
+    {
+        if ((0 == pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE)) &&
+            (0 == pthread_mutex_init((pthread_mutex_t *)*lock, &attr)))
+        {
+            status = 0;
+        }
+        (void)pthread_mutexattr_destroy(&attr);
+    }
+    if (status != 0)
+    {
+        env_free_memory(*lock);
+        *lock = ((void *)0);
+    }
+    return status;
+}
+
+/*!
+ * env_delete_mutex
+ *
+ * Deletes the given lock
+ *
+ */
+void env_delete_mutex(void *lock)
+{
+    (void)pthread_mutex_destroy((pthread_mutex_t *)lock);
+    env_free_memory(lock);
+}
+
+/*!
+ * env_lock_mutex
+ *
+ * Tries to acquire the lock, if lock is not available then call to
+ * this function will suspend.
+ * No-op on the interrupt dispatcher thread, as in the ISR context of the
+ * RTOS ports the tasks exclude the ISR by env_disable_interrupt().
+ */
+void env_lock_mutex(void *lock)
+{
+    if (platform_in_isr() == 0)
+    {
+        (void)pthread_mutex_lock((pthread_mutex_t *)lock);
+    }
+}
+
+/*!
+ * env_unlock_mutex
+ *
+ * Releases the given lock.
+ */
+void env_unlock_mutex(void *lock)
+{
+    if (platform_in_isr() == 0)
+    {
+        (void)pthread_mutex_unlock((pthread_mutex_t *)lock);
+    }
+}
+
+/*!
+ * env_create_sync_lock
+ *
+ * Creates a synchronization lock primitive. It is used
+ * when signal has to be sent from the interrupt context to main
+ * thread context.
+ */
+int32_t env_create_sync_lock(void **lock, int32_t state)
+{
+    if ((state < 0) || (state > RL_ENV_MAX_MUTEX_COUNT))
+    {
+        return -1;
+    }
+
+    *lock = env_allocate_memory(sizeof(sem_t));
+    if (*lock == ((void *)0))
+    {
+        return -1;
+    }
+    if (0 == sem_init((sem_t *)*lock, 0, (unsigned int)state)) /* state=1 .. initially free */
+    {
+        return 0;
+    }
+    else
+    {
+        env_free_memory(*lock);
+        *lock = ((void *)0);
+        return -1;
+    }
+}
+
+/*!
+ * env_delete_sync_lock
+ *
+ * Deletes the given lock
+ *
+ */
+void env_delete_sync_lock(void *lock)
+{
+    if (lock != ((void *)0))
+    {
+        (void)sem_destroy((sem_t *)lock);
+        env_free_memory(lock);
+    }
+}
+
+/*!
+ * env_acquire_sync_lock
+ *
+ * Tries to acquire the sync lock, suspends the calling thread until the lock
+ * is released or the timeout expires.
+ */
+int32_t env_acquire_sync_lock(void *lock, uintptr_t timeout_ms)
+{
+    struct timespec abs_timeout;
+    int status;
+
+    if (RL_BLOCK == timeout_ms)
+    {
+        do
+        {
+            status = sem_wait((sem_t *)lock);
+        } while ((status != 0) && (errno == EINTR));
+        return (0 == status) ? 0 : -1;
+    }
+
+    /* sem_timedwait() measures the timeout against CLOCK_REALTIME */
+    env_get_abs_timeout(CLOCK_REALTIME, timeout_ms, &abs_timeout);
+    do
+    {
+        status = sem_timedwait((sem_t *)lock, &abs_timeout);
+    } while ((status != 0) && (errno == EINTR));
+    return (0 == status) ? 0 : -1;
+}
+
+/*!
+ * env_release_sync_lock
+ *
+ * Releases the given sync lock, can be called from the emulated ISR.
+ */
+void env_release_sync_lock(void *lock)
+{
+    int value;
+
+    /* Keep the sync lock count bounded, extra releases carry no information */
+    if ((0 == sem_getvalue((sem_t *)lock, &value)) && (value < RL_ENV_MAX_MUTEX_COUNT))
+    {
+        (void)sem_post((sem_t *)lock);
+    }
+}
+
+/*!
+ * env_sleep_msec
+ *
+ * Suspends the calling thread for given time , in msecs.
+ */
+void env_sleep_msec(uint32_t num_msec)
+{
+    struct timespec req;
+    struct timespec rem;
+
+    req.tv_sec  = (time_t)(num_msec / 1000U);
+    req.tv_nsec = (long)((num_msec % 1000U) * 1000000U);
+    while ((0 != nanosleep(&req, &rem)) && (errno == EINTR))
+    {
+        req = rem;
+    }
+}
+
+/*!
+ * env_register_isr
+ *
+ * Registers interrupt handler data for the given interrupt vector.
+ *
+ * @param vector_id - virtual interrupt vector number
+ * @param data      - interrupt handler data (virtqueue)
+ */
+void env_register_isr(uint32_t vector_id, void *data)
+{
+    if (vector_id < ISR_COUNT)
+    {
+        __atomic_store_n(&isr_table[vector_id].data, data, __ATOMIC_RELEASE);
+    }
+    RL_ASSERT(vector_id < ISR_COUNT);
+}
+
+/*!
+ * env_unregister_isr
+ *
+ * Unregisters interrupt handler data for the given interrupt vector.
+ *
+ * @param vector_id - virtual interrupt vector number
+ */
+void env_unregister_isr(uint32_t vector_id)
+{
+    if (vector_id < ISR_COUNT)
+    {
+        __atomic_store_n(&isr_table[vector_id].data, ((void *)0), __ATOMIC_RELEASE);
+    }
+    RL_ASSERT(vector_id < ISR_COUNT);
+}
+
+/*!
+ * env_enable_interrupt
+ *
+ * Enables the given interrupt
+ *
+ * @param vector_id   - virtual interrupt vector number
+ */
+
+void env_enable_interrupt(uint32_t vector_id)
+{
+    (void)platform_interrupt_enable(vector_id);
+}
+
+/*!
+ * env_disable_interrupt
+ *
+ * Disables the given interrupt
+ *
+ * @param vector_id   - virtual interrupt vector number
+ */
+
+void env_disable_interrupt(uint32_t vector_id)
+{
+    (void)platform_interrupt_disable(vector_id);
+}
+
+/*!
+ * env_map_memory
+ *
+ * Enables memory mapping for given memory region.
+ *
+ * @param pa   - physical address of memory
+ * @param va   - logical address of memory
+ * @param size - memory size
+ * param flags - flags for cache/uncached  and access type
+ */
+
+void env_map_memory(uint32_t pa, uint32_t va, uint32_t size, uint32_t flags)
+{
+    platform_map_mem_region(va, pa, size, flags);
+}
+
+/*!
+ * env_disable_cache
+ *
+ * Disables system caches.
+ *
+ */
+
+void env_disable_cache(void)
+{
+    platform_cache_all_flush_invalidate();
+    platform_cache_disable();
+}
+
+void env_cache_flush(void *data, uint32_t len)
+{
+#if defined(RL_USE_DCACHE) && (RL_USE_DCACHE == 1)
+    platform_cache_flush(data, len);
+#endif
+}
+
+void env_cache_invalidate(void *data, uint32_t len)
+{
+#if defined(RL_USE_DCACHE) && (RL_USE_DCACHE == 1)
+    platform_cache_invalidate(data, len);
+#endif
+}
+
+/*!
+ *
+ * env_get_timestamp
+ *
+ * Returns a 64 bit time stamp.
+ *
+ *
+ */
+uint64_t env_get_timestamp(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/*!
+ *
+ * env_timestamp_to_msec
+ *
+ * Converts a time stamp difference (nsecs) to msecs.
+ *
+ */
+uint32_t env_timestamp_to_msec(uint64_t timestamp)
+{
+    return (uint32_t)(timestamp / 1000000ULL);
+}
+
+/*!
+ *
+ * env_timestamp_to_usec
+ *
+ * Converts a time stamp difference (nsecs) to usecs.
+ *
+ */
+uint64_t env_timestamp_to_usec(uint64_t timestamp)
+{
+    return timestamp / 1000ULL;
+}
+
+/*========================================================= */
+/* Util data / functions  */
+
+/**
+ * Called from the platform interrupt dispatcher thread
+ *
+ * @param vector Vector ID.
+ */
+void env_isr(uint32_t vector)
+{
+    struct virtqueue *vq;
+
+    if (vector < ISR_COUNT)
+    {
+        /* Doorbells may outlive the instance they were rung for, ignore them */
+        vq = (struct virtqueue *)__atomic_load_n(&isr_table[vector].data, __ATOMIC_ACQUIRE);
+        if (vq != ((void *)0))
+        {
+            virtqueue_notification(vq);
+        }
+    }
+    RL_ASSERT(vector < ISR_COUNT);
+}
+
+/*
+ * env_create_queue
+ *
+ * Creates a message queue.
+ *
+ * @param queue -  pointer to created queue
+ * @param length -  maximum number of elements in the queue
+ * @param element_size - queue element size in bytes
+ *
+ * @return - status of function execution
+ */
+int32_t env_create_queue(void **queue, int32_t length, int32_t element_size)
+{
+    env_queue_t *q;
+
+    if ((length <= 0) || (element_size < 0))
+    {
+        /* Length should be positive and size should not be negative */
+        *queue = NULL;
+        return -1;
+    }
+
+    q = env_allocate_memory(sizeof(env_queue_t));
+    if (q == ((void *)0))
+    {
+        return -1;
+    }
+    (void)memset(q, 0, sizeof(env_queue_t));
+    q->element_size = (uint32_t)element_size;
+    q->length       = (uint32_t)length;
+    q->storage      = env_allocate_memory((uint32_t)length * (uint32_t)element_size);
+    if (q->storage == ((void *)0))
+    {
+        env_free_memory(q);
+        return -1;
+    }
+    if (0 != pthread_mutex_init(&q->mutex, ((void *)0)))
+    {
+        env_free_memory(q->storage);
+        env_free_memory(q);
+        return -1;
+    }
+    if (0 != env_init_monotonic_cond(&q->not_empty))
+    {
+        (void)pthread_mutex_destroy(&q->mutex);
+        env_free_memory(q->storage);
+        env_free_memory(q);
+        return -1;
+    }
+    if (0 != env_init_monotonic_cond(&q->not_full))
+    {
+        (void)pthread_cond_destroy(&q->not_empty);
+        (void)pthread_mutex_destroy(&q->mutex);
+        env_free_memory(q->storage);
+        env_free_memory(q);
+        return -1;
+    }
+
+    *queue = q;
+    return 0;
+}
+
+/*!
+ * env_delete_queue
+ *
+ * Deletes the message queue.
+ *
+ * @param queue - queue to delete
+ */
+
+void env_delete_queue(void *queue)
+{
+    env_queue_t *q = queue;
+
+    (void)pthread_cond_destroy(&q->not_full);
+    (void)pthread_cond_destroy(&q->not_empty);
+    (void)pthread_mutex_destroy(&q->mutex);
+    env_free_memory(q->storage);
+    env_free_memory(q);
+}
+
+/*!
+ * env_queue_wait
+ *
+ * Waits on the queue condition variable, the queue mutex must be held.
+ *
+ * @return - 0 when woken up, -1 on timeout
+ */
+static int32_t env_queue_wait(env_queue_t *q, pthread_cond_t *cond, uintptr_t timeout_ms, struct timespec *abs_timeout)
+{
+    if (0U == timeout_ms)
+    {
+        return -1;
+    }
+    if (RL_BLOCK == timeout_ms)
+    {
+        (void)pthread_cond_wait(cond, &q->mutex);
+        return 0;
+    }
+    return (ETIMEDOUT == pthread_cond_timedwait(cond, &q->mutex, abs_timeout)) ? -1 : 0;
+}
+
+/*!
+ * env_put_queue
+ *
+ * Put an element in a queue.
+ *
+ * @param queue - queue to put element in
+ * @param msg - pointer to the message to be put into the queue
+ * @param timeout_ms - timeout in ms
+ *
+ * @return - status of function execution
+ */
+
+int32_t env_put_queue(void *queue, void *msg, uintptr_t timeout_ms)
+{
+    env_queue_t *q = queue;
+    struct timespec abs_timeout;
+    uint32_t tail;
+
+    if ((0U != timeout_ms) && (RL_BLOCK != timeout_ms))
+    {
+        env_get_abs_timeout(CLOCK_MONOTONIC, timeout_ms, &abs_timeout);
+    }
+
+    (void)pthread_mutex_lock(&q->mutex);
+    while (q->count == q->length)
+    {
+        if (0 != env_queue_wait(q, &q->not_full, timeout_ms, &abs_timeout))
+        {
+            (void)pthread_mutex_unlock(&q->mutex);
+            return 0;
+        }
+    }
+    tail = (q->head + q->count) % q->length;
+    (void)memcpy(&q->storage[tail * q->element_size], msg, q->element_size);
+    q->count++;
+    (void)pthread_cond_signal(&q->not_empty);
+    (void)pthread_mutex_unlock(&q->mutex);
+
+    return 1;
+}
+
+/*!
+ * env_get_queue
+ *
+ * Get an element out of a queue.
+ *
+ * @param queue - queue to get element from
+ * @param msg - pointer to a memory to save the message
+ * @param timeout_ms - timeout in ms
+ *
+ * @return - status of function execution
+ */
+
+int32_t env_get_queue(void *queue, void *msg, uintptr_t timeout_ms)
+{
+    env_queue_t *q = queue;
+    struct timespec abs_timeout;
+
+    if ((0U != timeout_ms) && (RL_BLOCK != timeout_ms))
+    {
+        env_get_abs_timeout(CLOCK_MONOTONIC, timeout_ms, &abs_timeout);
+    }
+
+    (void)pthread_mutex_lock(&q->mutex);
+    while (q->count == 0U)
+    {
+        if (0 != env_queue_wait(q, &q->not_empty, timeout_ms, &abs_timeout))
+        {
+            (void)pthread_mutex_unlock(&q->mutex);
+            return 0;
+        }
+    }
+    (void)memcpy(msg, &q->storage[q->head * q->element_size], q->element_size);
+    q->head = (q->head + 1U) % q->length;
+    q->count--;
+    (void)pthread_cond_signal(&q->not_full);
+    (void)pthread_mutex_unlock(&q->mutex);
+
+    return 1;
+}
+
+/*!
+ * env_get_current_queue_size
+ *
+ * Get current queue size.
+ *
+ * @param queue - queue pointer
+ *
+ * @return - Number of queued items in the queue
+ */
+
+int32_t env_get_current_queue_size(void *queue)
+{
+    env_queue_t *q = queue;
+    uint32_t count;
+
+    (void)pthread_mutex_lock(&q->mutex);
+    count = q->count;
+    (void)pthread_mutex_unlock(&q->mutex);
+
+    return (int32_t)count;
+}
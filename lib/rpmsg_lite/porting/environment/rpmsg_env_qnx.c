@@ -51,6 +51,8 @@
 #include <string.h>
 #include <pthread.h>
 #include <mqueue.h>
+#include <semaphore.h>
+#include <time.h>
 
 #if __PTR_BITS__ > 32
 #include <fcntl.h>
@@ -417,17 +419,28 @@ void env_unlock_mutex(void *lock)
  * when signal has to be sent from the interrupt context to main
  * thread context.
  */
-#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
-int32_t env_create_sync_lock(void **lock, int32_t state, void *context)
-{
-    return env_create_mutex(lock, state, context); /* state=1 .. initially free */
-}
-#else
 int32_t env_create_sync_lock(void **lock, int32_t state)
 {
-    return env_create_mutex(lock, state); /* state=1 .. initially free */
+    if (state > RL_ENV_MAX_MUTEX_COUNT)
+    {
+        return -1;
+    }
+
+    *lock = env_allocate_memory(sizeof(sem_t));
+    if (*lock == ((void *)0))
+    {
+        return -1;
+    }
+    if (0 == sem_init((sem_t *)*lock, 0, (unsigned int)state)) /* state=1 .. initially free */
+    {
+        return 0;
+    }
+    else
+    {
+        env_free_memory(*lock);
+        return -1;
+    }
 }
-#endif
 
 /*!
  * env_delete_sync_lock
@@ -439,7 +452,50 @@ void env_delete_sync_lock(void *lock)
 {
     if (lock != ((void *)0))
     {
-        env_delete_mutex(lock);
+        (void)sem_destroy((sem_t *)lock);
+        env_free_memory(lock);
+    }
+}
+
+/*!
+ * env_acquire_sync_lock
+ *
+ * Tries to acquire the sync lock, suspends the calling thread until the lock
+ * is released or the timeout expires.
+ */
+int32_t env_acquire_sync_lock(void *lock, uintptr_t timeout_ms)
+{
+    struct timespec abs_timeout;
+
+    if (RL_BLOCK == timeout_ms)
+    {
+        return (0 == sem_wait((sem_t *)lock)) ? 0 : -1;
+    }
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &abs_timeout);
+    abs_timeout.tv_sec += (time_t)(timeout_ms / 1000U);
+    abs_timeout.tv_nsec += (long)((timeout_ms % 1000U) * 1000000U);
+    if (abs_timeout.tv_nsec >= 1000000000L)
+    {
+        abs_timeout.tv_sec++;
+        abs_timeout.tv_nsec -= 1000000000L;
+    }
+    return (0 == sem_timedwait_monotonic((sem_t *)lock, &abs_timeout)) ? 0 : -1;
+}
+
+/*!
+ * env_release_sync_lock
+ *
+ * Releases the given sync lock.
+ */
+void env_release_sync_lock(void *lock)
+{
+    int value;
+
+    /* Keep the sync lock count bounded, extra releases carry no information */
+    if ((0 == sem_getvalue((sem_t *)lock, &value)) && (value < RL_ENV_MAX_MUTEX_COUNT))
+    {
+        (void)sem_post((sem_t *)lock);
     }
 }
 
@@ -578,8 +634,34 @@ void env_cache_invalidate(void *data, uint32_t len)
  */
 uint64_t env_get_timestamp(void)
 {
-    fprintf(stderr, "%s unsupported\n", __FUNCTION__);
-    return 0;
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/*!
+ *
+ * env_timestamp_to_msec
+ *
+ * Converts a time stamp difference (nsecs) to msecs.
+ *
+ */
+uint32_t env_timestamp_to_msec(uint64_t timestamp)
+{
+    return (uint32_t)(timestamp / 1000000ULL);
+}
+
+/*!
+ *
+ * env_timestamp_to_usec
+ *
+ * Converts a time stamp difference (nsecs) to usecs.
+ *
+ */
+uint64_t env_timestamp_to_usec(uint64_t timestamp)
+{
+    return timestamp / 1000ULL;
 }
 
 /*========================================================= */
@@ -71,6 +71,19 @@ static int32_t env_in_isr(void)
     return platform_in_isr();
 }
 
+/*!
+ * env_msec_to_ticks
+ *
+ * Converts a timeout in ms to timer ticks, rounded up so that a timeout
+ * shorter than one tick still waits instead of expiring right away.
+ *
+ */
+static ULONG env_msec_to_ticks(uintptr_t msec)
+{
+    return (ULONG)(((msec / 1000UL) * TX_TIMER_TICKS_PER_SECOND) +
+                   ((((msec % 1000UL) * TX_TIMER_TICKS_PER_SECOND) + 999UL) / 1000UL));
+}
+
 /*!
  * env_wait_for_link_up
  *
@@ -94,7 +107,7 @@ uint32_t env_wait_for_link_up(volatile uint32_t *link_state, uint32_t link_id, u
         else
         {
             if (TX_SUCCESS == tx_event_flags_get(&event_group, (1UL << link_id), TX_AND, &actual_events,
-                                                 ((timeout_ms * TX_TIMER_TICKS_PER_SECOND) / 1000UL)))
+                                                 env_msec_to_ticks(timeout_ms)))
             {
                 return 1U;
             }
@@ -465,6 +478,46 @@ void env_delete_sync_lock(void *lock)
     }
 }
 
+/*!
+ * env_acquire_sync_lock
+ *
+ * Tries to acquire the sync lock, suspends the calling thread until the lock
+ * is released or the timeout expires.
+ */
+int32_t env_acquire_sync_lock(void *lock, uintptr_t timeout_ms)
+{
+    ULONG wait_option;
+
+    if (env_in_isr() != 0)
+    {
+        wait_option = TX_NO_WAIT;
+    }
+    else if (RL_BLOCK == timeout_ms)
+    {
+        wait_option = TX_WAIT_FOREVER;
+    }
+    else
+    {
+        wait_option = env_msec_to_ticks(timeout_ms);
+    }
+
+    if (TX_SUCCESS == tx_semaphore_get((TX_SEMAPHORE *)lock, wait_option))
+    {
+        return 0;
+    }
+    return -1;
+}
+
+/*!
+ * env_release_sync_lock
+ *
+ * Releases the given sync lock, can be called from the ISR.
+ */
+void env_release_sync_lock(void *lock)
+{
+    (void)tx_semaphore_ceiling_put((TX_SEMAPHORE *)lock, RL_ENV_MAX_MUTEX_COUNT);
+}
+
 /*!
  * env_sleep_msec
  *
@@ -472,9 +525,7 @@ void env_delete_sync_lock(void *lock)
  */
 void env_sleep_msec(uint32_t num_msec)
 {
-    // (void)tx_thread_sleep((num_msec * TX_TIMER_TICKS_PER_SECOND) / 1000UL);
-    (void)tx_thread_sleep((num_msec / 1000UL) * TX_TIMER_TICKS_PER_SECOND +
-                          ((num_msec % 1000UL) * TX_TIMER_TICKS_PER_SECOND) / 1000UL);
+    (void)tx_thread_sleep(env_msec_to_ticks(num_msec));
 }
 
 /*!
@@ -592,6 +643,30 @@ uint64_t env_get_timestamp(void)
     return tx_time_get();
 }
 
+/*!
+ *
+ * env_timestamp_to_msec
+ *
+ * Converts a time stamp difference (ThreadX timer ticks) to msecs.
+ *
+ */
+uint32_t env_timestamp_to_msec(uint64_t timestamp)
+{
+    return (uint32_t)((timestamp * 1000ULL) / (uint64_t)TX_TIMER_TICKS_PER_SECOND);
+}
+
+/*!
+ *
+ * env_timestamp_to_usec
+ *
+ * Converts a time stamp difference (ThreadX timer ticks) to usecs.
+ *
+ */
+uint64_t env_timestamp_to_usec(uint64_t timestamp)
+{
+    return (timestamp * 1000000ULL) / (uint64_t)TX_TIMER_TICKS_PER_SECOND;
+}
+
 /*========================================================= */
 /* Util data / functions  */
 
@@ -713,7 +788,7 @@ int32_t env_put_queue(void *queue, void *msg, uintptr_t timeout_ms)
     }
     else
     {
-        if (TX_SUCCESS == tx_queue_send((TX_QUEUE *)(queue), msg, ((timeout_ms * TX_TIMER_TICKS_PER_SECOND) / 1000UL)))
+        if (TX_SUCCESS == tx_queue_send((TX_QUEUE *)(queue), msg, env_msec_to_ticks(timeout_ms)))
         {
             return 1;
         }
@@ -744,7 +819,7 @@ int32_t env_get_queue(void *queue, void *msg, uintptr_t timeout_ms)
     }
     else
     {
-        if (TX_SUCCESS == tx_queue_receive((TX_QUEUE *)(queue), msg, ((timeout_ms * TX_TIMER_TICKS_PER_SECOND) / 1000UL)))
+        if (TX_SUCCESS == tx_queue_receive((TX_QUEUE *)(queue), msg, env_msec_to_ticks(timeout_ms)))
         {
             return 1;
         }
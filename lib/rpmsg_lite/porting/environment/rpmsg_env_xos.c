@@ -475,6 +475,41 @@ void env_delete_sync_lock(void *lock)
     }
 }
 
+/*!
+ * env_acquire_sync_lock
+ *
+ * Tries to acquire the sync lock, suspends the calling thread until the lock
+ * is released or the timeout expires.
+ */
+int32_t env_acquire_sync_lock(void *lock, uintptr_t timeout_ms)
+{
+    if (RL_BLOCK == timeout_ms)
+    {
+        if (XOS_OK == xos_sem_get((struct XosSem *)lock))
+        {
+            return 0;
+        }
+    }
+    else
+    {
+        if (XOS_OK == xos_sem_get_timeout((struct XosSem *)lock, xos_msecs_to_cycles(timeout_ms)))
+        {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/*!
+ * env_release_sync_lock
+ *
+ * Releases the given sync lock, can be called from the ISR.
+ */
+void env_release_sync_lock(void *lock)
+{
+    (void)xos_sem_put_max((struct XosSem *)lock, RL_ENV_MAX_MUTEX_COUNT);
+}
+
 /*!
  * env_sleep_msec
  *
@@ -600,6 +635,30 @@ uint64_t env_get_timestamp(void)
     return xos_get_system_cycles();
 }
 
+/*!
+ *
+ * env_timestamp_to_msec
+ *
+ * Converts a time stamp difference (system cycles) to msecs.
+ *
+ */
+uint32_t env_timestamp_to_msec(uint64_t timestamp)
+{
+    return (uint32_t)xos_cycles_to_msecs(timestamp);
+}
+
+/*!
+ *
+ * env_timestamp_to_usec
+ *
+ * Converts a time stamp difference (system cycles) to usecs.
+ *
+ */
+uint64_t env_timestamp_to_usec(uint64_t timestamp)
+{
+    return (uint64_t)xos_cycles_to_usecs(timestamp);
+}
+
 /*========================================================= */
 /* Util data / functions  */
 
@@ -44,6 +44,7 @@
 
 #include "rpmsg_compiler.h"
 #include "rpmsg_env.h"
+#include "rpmsg_lite.h"
 #include <zephyr/kernel.h>
 #include <zephyr/cache.h>
 #include <zephyr/sys_clock.h>
@@ -463,6 +464,36 @@ void env_delete_sync_lock(void *lock)
     }
 }
 
+/*!
+ * env_acquire_sync_lock
+ *
+ * Tries to acquire the sync lock, suspends the calling thread until the lock
+ * is released or the timeout expires.
+ */
+int32_t env_acquire_sync_lock(void *lock, uintptr_t timeout_ms)
+{
+    if (env_in_isr() != 0)
+    {
+        timeout_ms = 0; /* force timeout == 0 when in ISR */
+    }
+
+    if (0 == k_sem_take((struct k_sem *)lock, (RL_BLOCK == timeout_ms) ? K_FOREVER : K_MSEC(timeout_ms)))
+    {
+        return 0;
+    }
+    return -1;
+}
+
+/*!
+ * env_release_sync_lock
+ *
+ * Releases the given sync lock, can be called from the ISR.
+ */
+void env_release_sync_lock(void *lock)
+{
+    k_sem_give((struct k_sem *)lock);
+}
+
 /*!
  * env_sleep_msec
  *
@@ -575,6 +606,43 @@ void env_cache_invalidate(void *data, uint32_t len)
 #endif
 }
 
+/*!
+ *
+ * env_get_timestamp
+ *
+ * Returns a 64 bit time stamp.
+ *
+ *
+ */
+uint64_t env_get_timestamp(void)
+{
+    return (uint64_t)k_uptime_ticks();
+}
+
+/*!
+ *
+ * env_timestamp_to_msec
+ *
+ * Converts a time stamp difference (kernel ticks) to msecs.
+ *
+ */
+uint32_t env_timestamp_to_msec(uint64_t timestamp)
+{
+    return (uint32_t)k_ticks_to_ms_floor64(timestamp);
+}
+
+/*!
+ *
+ * env_timestamp_to_usec
+ *
+ * Converts a time stamp difference (kernel ticks) to usecs.
+ *
+ */
+uint64_t env_timestamp_to_usec(uint64_t timestamp)
+{
+    return k_ticks_to_us_floor64(timestamp);
+}
+
 /*========================================================= */
 /* Util data / functions  */
 
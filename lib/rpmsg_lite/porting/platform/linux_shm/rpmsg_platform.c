@@ -0,0 +1,472 @@
+/*
+ * Copyright 2026 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include "rpmsg_platform.h"
+#include "rpmsg_env.h"
+
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+#error "This RPMsg-Lite port requires RL_USE_ENVIRONMENT_CONTEXT set to 0"
+#endif
+
+#ifndef RL_LINUX_SHM_SIDE
+#error "RL_LINUX_SHM_SIDE is NOT defined, define it in rpmsg_config.h (0 for the master, 1 for the remote process)!"
+#endif
+
+#define RL_LINUX_SHM_PEER (1U - (uint32_t)(RL_LINUX_SHM_SIDE))
+
+/* Dispatcher wake-up period, only bounds the time platform_deinit() waits for the thread to exit */
+#define RL_LINUX_SHM_ISR_POLL_MS (100U)
+
+/*
+ * Doorbell page layout:
+ *
+ * DOORBELL[n]: pending vector bitmask of side n (0 master, 1 remote), used as
+ * a process-shared futex word.
+ *
+ * To notify the peer:
+ * Set the vector bit in the peer doorbell, wake the peer only when the
+ * doorbell was empty, a non-empty doorbell has a wake-up already in flight.
+ *
+ * The dispatcher thread of each side exchanges its doorbell with zero and
+ * calls env_isr() for every bit set, it sleeps on the futex while the
+ * doorbell is empty. This thread is the emulated interrupt context.
+ * Vectors rung while masked or before their ISR data is registered stay
+ * pending, like an interrupt line, the peer may have kicked us before
+ * this process even started.
+ */
+struct linux_shm_ctrl
+{
+    uint32_t doorbell[2];
+};
+
+static int32_t disable_counter = 0;
+static uint32_t isr_pending    = 0U;
+static uint32_t isr_registered = 0U;
+
+static pthread_mutex_t isr_mutex        = PTHREAD_MUTEX_INITIALIZER;
+/* Held by the dispatcher while it calls env_isr(), an ISR may unregister itself */
+static pthread_mutex_t dispatch_mutex   = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static pthread_mutex_t shm_mutex        = PTHREAD_MUTEX_INITIALIZER;
+static volatile uint32_t isr_thread_run = 0U;
+static pthread_t isr_thread;
+
+static uint8_t *shm_base               = ((void *)0);
+static struct linux_shm_ctrl *shm_ctrl = ((void *)0);
+static void *platform_lock;
+
+static void linux_shm_futex_wait(uint32_t *addr, uint32_t value, uint32_t timeout_ms)
+{
+    struct timespec timeout;
+
+    timeout.tv_sec  = (time_t)(timeout_ms / 1000U);
+    timeout.tv_nsec = (long)((timeout_ms % 1000U) * 1000000U);
+    /* EAGAIN (value changed), EINTR and ETIMEDOUT are all handled by the caller loop */
+    (void)syscall(SYS_futex, addr, FUTEX_WAIT, value, &timeout, ((void *)0), 0);
+}
+
+static void linux_shm_futex_wake(uint32_t *addr)
+{
+    (void)syscall(SYS_futex, addr, FUTEX_WAKE, 1, ((void *)0), ((void *)0), 0);
+}
+
+static void linux_shm_ring(uint32_t side, uint32_t vectors)
+{
+    uint32_t *doorbell = &shm_ctrl->doorbell[side];
+
+    /* The bits must be visible before the peer can observe a non-empty doorbell */
+    if (0U == __atomic_fetch_or(doorbell, vectors, __ATOMIC_SEQ_CST))
+    {
+        linux_shm_futex_wake(doorbell);
+    }
+}
+
+static void linux_shm_dispatch(uint32_t pending)
+{
+    uint32_t vector_id;
+
+    /* Taken before the mask is checked, platform_interrupt_disable() waits for it */
+    (void)pthread_mutex_lock(&dispatch_mutex);
+    (void)pthread_mutex_lock(&isr_mutex);
+    pending |= isr_pending;
+    if (disable_counter > 0)
+    {
+        /* Interrupt masked, latch the vectors until platform_interrupt_enable() */
+        isr_pending = pending;
+        (void)pthread_mutex_unlock(&isr_mutex);
+        (void)pthread_mutex_unlock(&dispatch_mutex);
+        return;
+    }
+    /* Latch the vectors without ISR data until platform_init_interrupt() */
+    isr_pending = pending & ~isr_registered;
+    pending &= isr_registered;
+    (void)pthread_mutex_unlock(&isr_mutex);
+
+    for (vector_id = 0U; vector_id < RL_PLATFORM_MAX_ISR_COUNT; vector_id++)
+    {
+        if ((pending & (1UL << vector_id)) != 0U)
+        {
+            env_isr(vector_id);
+        }
+    }
+    (void)pthread_mutex_unlock(&dispatch_mutex);
+}
+
+static void *linux_shm_isr_thread(void *arg)
+{
+    uint32_t *doorbell = &shm_ctrl->doorbell[RL_LINUX_SHM_SIDE];
+    uint32_t pending;
+
+    while (isr_thread_run != 0U)
+    {
+        pending = __atomic_exchange_n(doorbell, 0U, __ATOMIC_ACQ_REL);
+        if (pending == 0U)
+        {
+            linux_shm_futex_wait(doorbell, 0U, RL_LINUX_SHM_ISR_POLL_MS);
+        }
+        else if (isr_thread_run != 0U)
+        {
+            linux_shm_dispatch(pending);
+        }
+        else
+        {
+            /* Shutting down, drop the notifications */
+        }
+    }
+
+    return ((void *)0);
+}
+
+/**
+ * platform_get_shmem
+ *
+ * Maps the shared memory object (creating it when it does not exist yet)
+ * and returns the RPMsg-Lite shared memory of RL_LINUX_SHM_SIZE bytes
+ * to be passed to rpmsg_lite_master_init()/rpmsg_lite_remote_init().
+ * Both processes may map it at different addresses, the vrings carry
+ * offsets into the object, see platform_vatopa()/platform_patova().
+ *
+ * @return Pointer to the RPMsg-Lite shared memory, NULL on failure
+ */
+void *platform_get_shmem(void)
+{
+    const size_t total_size = (size_t)RL_LINUX_SHM_CTRL_SIZE + (size_t)RL_LINUX_SHM_SIZE;
+    struct stat shm_stat;
+    void *base;
+    int fd;
+
+    (void)pthread_mutex_lock(&shm_mutex);
+    if (shm_base == ((void *)0))
+    {
+        /* Whichever process comes first creates the object, new objects are zero-filled */
+        fd = shm_open(RL_LINUX_SHM_NAME, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+        if (fd < 0)
+        {
+            fprintf(stderr, "shm_open(%s) failed: %s\n", RL_LINUX_SHM_NAME, strerror(errno));
+            (void)pthread_mutex_unlock(&shm_mutex);
+            return ((void *)0);
+        }
+        if ((0 != fstat(fd, &shm_stat)) ||
+            (((size_t)shm_stat.st_size < total_size) && (0 != ftruncate(fd, (off_t)total_size))))
+        {
+            fprintf(stderr, "sizing %s failed: %s\n", RL_LINUX_SHM_NAME, strerror(errno));
+            (void)close(fd);
+            (void)pthread_mutex_unlock(&shm_mutex);
+            return ((void *)0);
+        }
+        base = mmap(((void *)0), total_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        (void)close(fd);
+        if (base == MAP_FAILED)
+        {
+            fprintf(stderr, "mmap(%s) failed: %s\n", RL_LINUX_SHM_NAME, strerror(errno));
+            (void)pthread_mutex_unlock(&shm_mutex);
+            return ((void *)0);
+        }
+        shm_base = (uint8_t *)base;
+        shm_ctrl = (struct linux_shm_ctrl *)base;
+    }
+    (void)pthread_mutex_unlock(&shm_mutex);
+
+    return &shm_base[RL_LINUX_SHM_CTRL_SIZE];
+}
+
+int32_t platform_init_interrupt(uint32_t vector_id, void *isr_data)
+{
+    uint32_t pending;
+
+    env_lock_mutex(platform_lock);
+    /* Register ISR to environment layer */
+    env_register_isr(vector_id, isr_data);
+    (void)pthread_mutex_lock(&isr_mutex);
+    isr_registered |= (uint32_t)(1UL << vector_id);
+    pending = isr_pending & (uint32_t)(1UL << vector_id);
+    isr_pending &= ~pending;
+    (void)pthread_mutex_unlock(&isr_mutex);
+    env_unlock_mutex(platform_lock);
+
+    /* Deliver the notification that arrived before the registration */
+    if (pending != 0U)
+    {
+        linux_shm_ring(RL_LINUX_SHM_SIDE, pending);
+    }
+
+    return 0;
+}
+
+int32_t platform_deinit_interrupt(uint32_t vector_id)
+{
+    env_lock_mutex(platform_lock);
+    (void)pthread_mutex_lock(&isr_mutex);
+    isr_registered &= ~(uint32_t)(1UL << vector_id);
+    (void)pthread_mutex_unlock(&isr_mutex);
+    /* Unregister ISR from environment layer, wait for the ISR running on the dispatcher,
+       the caller frees the ISR data once this returns */
+    (void)pthread_mutex_lock(&dispatch_mutex);
+    env_unregister_isr(vector_id);
+    (void)pthread_mutex_unlock(&dispatch_mutex);
+    env_unlock_mutex(platform_lock);
+
+    return 0;
+}
+
+void platform_notify(uint32_t vector_id)
+{
+    RL_ASSERT(vector_id < RL_PLATFORM_MAX_ISR_COUNT);
+    linux_shm_ring(RL_LINUX_SHM_PEER, (uint32_t)(1UL << vector_id));
+}
+
+/**
+ * platform_in_isr
+ *
+ * Return whether the caller runs on the interrupt dispatcher thread
+ */
+int32_t platform_in_isr(void)
+{
+    return ((isr_thread_run != 0U) && (0 != pthread_equal(pthread_self(), isr_thread))) ? 1 : 0;
+}
+
+/**
+ * platform_time_delay
+ *
+ * @param num_msec Delay time in ms.
+ *
+ * Sleeps instead of busy looping, it ensures at least num_msec passed when return.
+ */
+void platform_time_delay(uint32_t num_msec)
+{
+    struct timespec req;
+    struct timespec rem;
+
+    req.tv_sec  = (time_t)(num_msec / 1000U);
+    req.tv_nsec = (long)((num_msec % 1000U) * 1000000U);
+    while ((0 != nanosleep(&req, &rem)) && (errno == EINTR))
+    {
+        req = rem;
+    }
+}
+
+/**
+ * platform_interrupt_enable
+ *
+ * Enable peripheral-related interrupt
+ *
+ * @param vector_id Virtual vector ID that needs to be converted to IRQ number
+ *
+ * @return vector_id Return value is never checked.
+ *
+ */
+int32_t platform_interrupt_enable(uint32_t vector_id)
+{
+    uint32_t pending = 0U;
+
+    (void)pthread_mutex_lock(&isr_mutex);
+    RL_ASSERT(0 < disable_counter);
+    disable_counter--;
+    if (disable_counter == 0)
+    {
+        pending     = isr_pending;
+        isr_pending = 0U;
+    }
+    (void)pthread_mutex_unlock(&isr_mutex);
+
+    /* Replay the vectors latched while masked through our own doorbell,
+       so that they are handled in the dispatcher (interrupt) context */
+    if (pending != 0U)
+    {
+        linux_shm_ring(RL_LINUX_SHM_SIDE, pending);
+    }
+
+    return 0;
+}
+
+/**
+ * platform_interrupt_disable
+ *
+ * Disable peripheral-related interrupt.
+ *
+ * @param vector_id Virtual vector ID that needs to be converted to IRQ number
+ *
+ * @return vector_id Return value is never checked.
+ *
+ */
+int32_t platform_interrupt_disable(uint32_t vector_id)
+{
+    /* Like a masked interrupt, the ISR does not run on the dispatcher meanwhile, wait for the running one.
+       The lock is recursive, the ISR itself may mask the interrupt */
+    (void)pthread_mutex_lock(&dispatch_mutex);
+    (void)pthread_mutex_lock(&isr_mutex);
+    RL_ASSERT(0 <= disable_counter);
+    /* virtqueues use the same doorbell
+       if counter is set - the interrupts are disabled */
+    disable_counter++;
+    (void)pthread_mutex_unlock(&isr_mutex);
+    (void)pthread_mutex_unlock(&dispatch_mutex);
+
+    return 0;
+}
+
+/**
+ * platform_map_mem_region
+ *
+ * Dummy implementation
+ *
+ */
+void platform_map_mem_region(uint32_t vrt_addr, uint32_t phy_addr, uint32_t size, uint32_t flags)
+{
+}
+
+/**
+ * platform_cache_all_flush_invalidate
+ *
+ * Dummy implementation
+ *
+ */
+void platform_cache_all_flush_invalidate(void)
+{
+}
+
+/**
+ * platform_cache_disable
+ *
+ * Dummy implementation
+ *
+ */
+void platform_cache_disable(void)
+{
+}
+
+/**
+ * platform_cache_flush
+ *
+ * Empty implementation, host caches are coherent
+ *
+ */
+void platform_cache_flush(void *data, uint32_t len)
+{
+}
+
+/**
+ * platform_cache_invalidate
+ *
+ * Empty implementation, host caches are coherent
+ *
+ */
+void platform_cache_invalidate(void *data, uint32_t len)
+{
+}
+
+/**
+ * platform_vatopa
+ *
+ * Translate CM address to the offset within the shared memory object
+ *
+ */
+uintptr_t platform_vatopa(void *addr)
+{
+    return (uintptr_t)((uint8_t *)addr - shm_base);
+}
+
+/**
+ * platform_patova
+ *
+ * Translate the offset within the shared memory object to CM address
+ *
+ */
+void *platform_patova(uintptr_t addr)
+{
+    return (void *)&shm_base[addr];
+}
+
+/**
+ * platform_init
+ *
+ * platform/environment init
+ */
+int32_t platform_init(void)
+{
+    if (platform_get_shmem() == ((void *)0))
+    {
+        return -1;
+    }
+
+    disable_counter = 0;
+    isr_pending     = 0U;
+    isr_registered  = 0U;
+
+    /* Create lock used in multi-instanced RPMsg */
+    if (0 != env_create_mutex(&platform_lock, 1))
+    {
+        return -1;
+    }
+
+    isr_thread_run = 1U;
+    if (0 != pthread_create(&isr_thread, ((void *)0), linux_shm_isr_thread, ((void *)0)))
+    {
+        isr_thread_run = 0U;
+        env_delete_mutex(platform_lock);
+        platform_lock = ((void *)0);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * platform_deinit
+ *
+ * platform/environment deinit process
+ */
+int32_t platform_deinit(void)
+{
+    /* Stop the dispatcher, no env_isr() call is made once it is joined */
+    isr_thread_run = 0U;
+    linux_shm_futex_wake(&shm_ctrl->doorbell[RL_LINUX_SHM_SIDE]);
+    (void)pthread_join(isr_thread, ((void *)0));
+
+    /* Delete lock used in multi-instanced RPMsg */
+    env_delete_mutex(platform_lock);
+    platform_lock = ((void *)0);
+
+    (void)pthread_mutex_lock(&shm_mutex);
+    (void)munmap(shm_base, (size_t)RL_LINUX_SHM_CTRL_SIZE + (size_t)RL_LINUX_SHM_SIZE);
+    shm_base = ((void *)0);
+    shm_ctrl = ((void *)0);
+    (void)pthread_mutex_unlock(&shm_mutex);
+
+    return 0;
+}
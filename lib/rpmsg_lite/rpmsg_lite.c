@@ -43,11 +43,34 @@ struct virtqueue_ops
     void *(*vq_tx_alloc)(struct virtqueue *vq, uint32_t *len, uint16_t *idx);
     void *(*vq_rx)(struct virtqueue *vq, uint32_t *len, uint16_t *idx);
     void (*vq_rx_free)(struct virtqueue *vq, void *buffer, uint32_t len, uint16_t idx);
+#if (RL_VRING_BATCH_SIZE > 0)
+    void (*vq_add_batch)(struct virtqueue *vq, const struct vring_used_elem *elems, uint16_t count);
+#endif
+};
+
+#if (RL_VRING_BATCH_SIZE > 0)
+/* Buffers collected on the stack and placed on the vring with one ring index update */
+struct rpmsg_lite_vq_batch
+{
+    struct virtqueue *vq;
+    uint16_t count;
+    struct vring_used_elem elems[RL_VRING_BATCH_SIZE];
 };
+#else
+struct rpmsg_lite_vq_batch;
+#endif
 
 /* Zero-Copy extension macros */
 #define RPMSG_STD_MSG_FROM_BUF(buf) (struct rpmsg_std_msg *)(void *)((char *)(buf)-offsetof(struct rpmsg_std_msg, data))
 
+/* Cache maintenance counters of the instance owning the virtqueue */
+#if defined(RL_ALLOW_CACHE_COUNTERS) && (RL_ALLOW_CACHE_COUNTERS == 1)
+#define RL_CACHE_COUNT(vq, counter, value) \
+    (((struct rpmsg_lite_instance *)(vq)->priv)->cache_counters.counter += (uint32_t)(value))
+#else
+#define RL_CACHE_COUNT(vq, counter, value)
+#endif
+
 /**
  * @brief Safely calculate the maximum number of buffers that can fit in the shared memory
  *
@@ -120,6 +143,140 @@ struct virtqueue_ops
     #error "RL_PLATFORM_HIGHEST_LINK_ID must be <= 0x7FFF to ensure compatibility with 16-bit VQ IDs"
 #endif
 
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+#if !(defined(RL_ALLOW_LOCKLESS_TX) && (RL_ALLOW_LOCKLESS_TX == 1))
+#error "RL_LOCKLESS_TX_MULTI_PRODUCER requires RL_ALLOW_LOCKLESS_TX set to 1"
+#endif
+#if defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1)
+#error "RL_LOCKLESS_TX_MULTI_PRODUCER is not supported with RL_ALLOW_DEFERRED_NOTIFY"
+#endif
+#endif
+
+#if defined(RL_ALLOW_TX_LIFO) && (RL_ALLOW_TX_LIFO == 1) && defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && \
+    (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+#error "RL_ALLOW_TX_LIFO is not supported with RL_LOCKLESS_TX_MULTI_PRODUCER"
+#endif
+
+#if defined(RL_ALLOW_TX_STASH) && (RL_ALLOW_TX_STASH == 1) && defined(RL_ALLOW_LOCKLESS_TX) && \
+    (RL_ALLOW_LOCKLESS_TX == 1)
+#error "RL_ALLOW_TX_STASH is not supported with RL_ALLOW_LOCKLESS_TX"
+#endif
+
+#if (RL_QUEUE_PAIR_COUNT < 1) || (RL_QUEUE_PAIR_COUNT > 32)
+#error "RL_QUEUE_PAIR_COUNT must be between 1 and 32"
+#endif
+
+#if (RL_QUEUE_PAIR_COUNT > 1)
+#if defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1)
+#error "RL_QUEUE_PAIR_COUNT > 1 is not supported with RL_ALLOW_CUSTOM_SHMEM_CONFIG"
+#endif
+#if defined(RL_ALLOW_TX_STASH) && (RL_ALLOW_TX_STASH == 1)
+#error "RL_QUEUE_PAIR_COUNT > 1 is not supported with RL_ALLOW_TX_STASH"
+#endif
+#if defined(RL_ALLOW_TX_LIFO) && (RL_ALLOW_TX_LIFO == 1)
+#error "RL_QUEUE_PAIR_COUNT > 1 is not supported with RL_ALLOW_TX_LIFO"
+#endif
+#endif
+
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+#if defined(RL_ALLOW_LOCKLESS_TX) && (RL_ALLOW_LOCKLESS_TX == 1)
+#error "RL_ALLOW_TX_QUOTA is not supported with RL_ALLOW_LOCKLESS_TX"
+#endif
+#if defined(RL_ALLOW_TX_STASH) && (RL_ALLOW_TX_STASH == 1)
+#error "RL_ALLOW_TX_QUOTA is not supported with RL_ALLOW_TX_STASH"
+#endif
+#if (RL_QUEUE_PAIR_COUNT > 1)
+#error "RL_ALLOW_TX_QUOTA is not supported with RL_QUEUE_PAIR_COUNT > 1"
+#endif
+#endif
+
+#if defined(RL_ALLOW_ASYNC_SEND) && (RL_ALLOW_ASYNC_SEND == 1)
+#if defined(RL_ALLOW_LOCKLESS_TX) && (RL_ALLOW_LOCKLESS_TX == 1)
+#error "RL_ALLOW_ASYNC_SEND is not supported with RL_ALLOW_LOCKLESS_TX"
+#endif
+#endif
+
+#if defined(RL_ALLOW_GROUP_ENDPOINTS) && (RL_ALLOW_GROUP_ENDPOINTS == 1)
+#if !defined(RL_API_HAS_ZEROCOPY) || (RL_API_HAS_ZEROCOPY != 1)
+#error "RL_ALLOW_GROUP_ENDPOINTS requires RL_API_HAS_ZEROCOPY"
+#endif
+#endif
+
+#if defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)
+#if !defined(RL_API_HAS_ZEROCOPY) || (RL_API_HAS_ZEROCOPY != 1)
+#error "RL_ALLOW_TX_TOKENS requires RL_API_HAS_ZEROCOPY"
+#endif
+#if defined(RL_ALLOW_LOCKLESS_TX) && (RL_ALLOW_LOCKLESS_TX == 1)
+#error "RL_ALLOW_TX_TOKENS is not supported with RL_ALLOW_LOCKLESS_TX"
+#endif
+#if defined(RL_ALLOW_TX_STASH) && (RL_ALLOW_TX_STASH == 1)
+#error "RL_ALLOW_TX_TOKENS is not supported with RL_ALLOW_TX_STASH"
+#endif
+#if (RL_QUEUE_PAIR_COUNT > 1)
+#error "RL_ALLOW_TX_TOKENS is not supported with RL_QUEUE_PAIR_COUNT > 1"
+#endif
+#endif
+
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+#if defined(RL_ALLOW_LOCKLESS_TX) && (RL_ALLOW_LOCKLESS_TX == 1)
+#error "RL_ALLOW_CREDIT_FLOW_CONTROL is not supported with RL_ALLOW_LOCKLESS_TX"
+#endif
+#endif
+
+/*
+ * The tx lock of the instance. The pending asynchronous sends are enqueued
+ * and the returned tx buffers taken back from the tx callback, the credit
+ * messages of the endpoints sent from the rx path, i.e. from the ISR where
+ * the mutex is not taken, so with RL_ALLOW_ASYNC_SEND, RL_ALLOW_TX_TOKENS or
+ * RL_ALLOW_CREDIT_FLOW_CONTROL the lock masks the interrupt of the link as well.
+ */
+#if (defined(RL_ALLOW_ASYNC_SEND) && (RL_ALLOW_ASYNC_SEND == 1)) ||   \
+    (defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)) || \
+    (defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1))
+static void rpmsg_lite_tx_lock(struct rpmsg_lite_instance *rpmsg_lite_dev);
+static void rpmsg_lite_tx_unlock(struct rpmsg_lite_instance *rpmsg_lite_dev);
+#if defined(RL_ALLOW_ASYNC_SEND) && (RL_ALLOW_ASYNC_SEND == 1)
+static void rpmsg_lite_async_drain(struct rpmsg_lite_instance *rpmsg_lite_dev);
+static void rpmsg_lite_async_drop(struct rpmsg_lite_instance *rpmsg_lite_dev, const struct rpmsg_lite_endpoint *ept);
+#endif
+#if defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)
+static void rpmsg_lite_tx_report(struct rpmsg_lite_instance *rpmsg_lite_dev);
+#endif
+#define RL_TX_MUTEX_LOCK(dev)   rpmsg_lite_tx_lock(dev)
+#define RL_TX_MUTEX_UNLOCK(dev) rpmsg_lite_tx_unlock(dev)
+#else
+#define RL_TX_MUTEX_LOCK(dev)   env_lock_mutex((dev)->tx_lock)
+#define RL_TX_MUTEX_UNLOCK(dev) env_unlock_mutex((dev)->tx_lock)
+#endif
+
+/*
+ * The tx lock around taking a free buffer and enqueuing a message. The
+ * lockless tx leaves the ordering to the virtqueue, the ring index is stored
+ * after the ring entry (env_wmb) and read before it (env_rmb). A single
+ * producer needs nothing more, several ones go through the atomic claim and
+ * publish of the multi producer virtqueue.
+ */
+#if defined(RL_ALLOW_LOCKLESS_TX) && (RL_ALLOW_LOCKLESS_TX == 1)
+#define RL_TX_LOCK(dev)
+#define RL_TX_UNLOCK(dev)
+#else
+#define RL_TX_LOCK(dev)   RL_TX_MUTEX_LOCK(dev)
+#define RL_TX_UNLOCK(dev) RL_TX_MUTEX_UNLOCK(dev)
+#endif
+
+#if (RL_EPT_TABLE_DIRECT_SIZE > 0) && ((RL_EPT_TABLE_DIRECT_SIZE % 32) != 0)
+#error "RL_EPT_TABLE_DIRECT_SIZE must be a multiple of 32"
+#endif
+
+#if (RL_EPT_TABLE_HASH_SIZE > 0) && ((RL_EPT_TABLE_HASH_SIZE & (RL_EPT_TABLE_HASH_SIZE - 1)) != 0)
+#error "RL_EPT_TABLE_HASH_SIZE must be a power of two"
+#endif
+
+#if (RL_EPT_TABLE_HASH_SIZE > 0)
+/* Fibonacci hashing of the endpoint address to the hash table slot */
+#define RL_EPT_HASH_SLOT(addr) ((((addr)*0x9E3779B1U) >> 16U) & ((uint32_t)RL_EPT_TABLE_HASH_SIZE - 1U))
+#endif
+
 /*!
  * @brief
  * Traverse the linked list of endpoints to get the one with defined address.
@@ -130,7 +287,7 @@ struct virtqueue_ops
  * @return       RL_NULL if not found, node pointer containing the ept on success
  *
  */
-static struct llist *rpmsg_lite_get_endpoint_from_addr(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t addr)
+static struct llist *rpmsg_lite_get_endpoint_from_list(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t addr)
 {
     struct llist *rl_ept_lut_head;
 
@@ -147,650 +304,5091 @@ static struct llist *rpmsg_lite_get_endpoint_from_addr(struct rpmsg_lite_instanc
     return RL_NULL;
 }
 
-/***************************************************************
-   mmm    mm   m      m      mmmmm    mm     mmm  m    m  mmmm
- m"   "   ##   #      #      #    #   ##   m"   " #  m"  #"   "
- #       #  #  #      #      #mmmm"  #  #  #      #m#    "#mmm
- #       #mm#  #      #      #    #  #mm#  #      #  #m      "#
-  "mmm" #    # #mmmmm #mmmmm #mmmm" #    #  "mmm" #   "m "mmm#"
-****************************************************************/
-
 /*!
  * @brief
- * Called when remote side calls virtqueue_kick()
- * at its transmit virtqueue.
- * In this callback, the buffer is read-out
- * of the rvq and user callback is called.
+ * Get the endpoint with defined address, from the endpoint tables
+ * when enabled, from the linked list of endpoints otherwise.
  *
- * @param vq  Virtqueue affected by the kick
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param addr              Local endpoint address
+ *
+ * @return       RL_NULL if not found, node pointer containing the ept on success
  *
  */
-static void rpmsg_lite_rx_callback(struct virtqueue *vq)
+static struct llist *rpmsg_lite_get_endpoint_from_addr(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t addr)
 {
-    struct rpmsg_std_msg *rpmsg_msg = RL_NULL;
-    struct rpmsg_lite_endpoint *ept = RL_NULL;
-    struct llist *node              = RL_NULL;
-    uint32_t len;
-    uint16_t idx;
-    int32_t cb_ret;
-    struct rpmsg_lite_instance *rpmsg_lite_dev = (struct rpmsg_lite_instance *)vq->priv;
-#if defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
-    uint32_t rx_freed = RL_FALSE;
+#if (RL_EPT_TABLE_HASH_SIZE > 0)
+    struct llist *node;
+    uint32_t slot;
 #endif
 
-    RL_ASSERT(rpmsg_lite_dev != RL_NULL);
-
-#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
-    env_lock_mutex(rpmsg_lite_dev->lock);
+#if (RL_EPT_TABLE_DIRECT_SIZE > 0)
+    if (addr < (uint32_t)RL_EPT_TABLE_DIRECT_SIZE)
+    {
+        return rpmsg_lite_dev->ept_direct[addr];
+    }
 #endif
 
-    /* Process the received data from remote node */
-    rpmsg_msg = (struct rpmsg_std_msg *)rpmsg_lite_dev->vq_ops->vq_rx(rpmsg_lite_dev->rvq, &len, &idx);
-
-    while (rpmsg_msg != RL_NULL)
+#if (RL_EPT_TABLE_HASH_SIZE > 0)
+    /* One slot is always free, the probing ends at the latest there */
+    slot = RL_EPT_HASH_SLOT(addr);
+    node = rpmsg_lite_dev->ept_hash[slot];
+    while (node != RL_NULL)
     {
-        node = rpmsg_lite_get_endpoint_from_addr(rpmsg_lite_dev, rpmsg_msg->hdr.dst);
-
-        cb_ret = RL_RELEASE;
-        if (node != RL_NULL)
-        {
-            ept    = (struct rpmsg_lite_endpoint *)node->data;
-            cb_ret = ept->rx_cb(rpmsg_msg->data, rpmsg_msg->hdr.len, rpmsg_msg->hdr.src, ept->rx_cb_data);
-        }
-
-        if (cb_ret == RL_HOLD)
-        {
-            rpmsg_msg->hdr.reserved.idx = idx;
-        }
-        else
-        {
-            rpmsg_lite_dev->vq_ops->vq_rx_free(rpmsg_lite_dev->rvq, rpmsg_msg, len, idx);
-#if defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
-            rx_freed = RL_TRUE;
-#endif
-        }
-        rpmsg_msg = (struct rpmsg_std_msg *)rpmsg_lite_dev->vq_ops->vq_rx(rpmsg_lite_dev->rvq, &len, &idx);
-#if defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
-        if ((rpmsg_msg == RL_NULL) && (rx_freed == RL_TRUE))
+        if (((struct rpmsg_lite_endpoint *)node->data)->addr == addr)
         {
-            /* Let the remote device know that some buffers have been freed */
-            virtqueue_kick(rpmsg_lite_dev->rvq);
+            return node;
         }
-#endif
+        slot = (slot + 1U) & ((uint32_t)RL_EPT_TABLE_HASH_SIZE - 1U);
+        node = rpmsg_lite_dev->ept_hash[slot];
     }
+#endif
 
-#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
-    env_unlock_mutex(rpmsg_lite_dev->lock);
+#if (RL_EPT_TABLE_DIRECT_SIZE > 0) || (RL_EPT_TABLE_HASH_SIZE > 0)
+    if (rpmsg_lite_dev->ept_overflow_count == 0U)
+    {
+        return RL_NULL;
+    }
 #endif
+
+    return rpmsg_lite_get_endpoint_from_list(rpmsg_lite_dev, addr);
 }
 
+#if (RL_EPT_TABLE_DIRECT_SIZE > 0) || (RL_EPT_TABLE_HASH_SIZE > 0)
 /*!
  * @brief
- * Called when remote side calls virtqueue_kick()
- * at its receive virtqueue.
+ * Register the endpoint node in the endpoint tables,
+ * called with the lock held.
  *
- * @param vq  Virtqueue affected by the kick
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param node              Node of the endpoint to register
  *
  */
-static void rpmsg_lite_tx_callback(struct virtqueue *vq)
+static void rpmsg_lite_ept_table_add(struct rpmsg_lite_instance *rpmsg_lite_dev, struct llist *node)
 {
-    struct rpmsg_lite_instance *rpmsg_lite_dev = (struct rpmsg_lite_instance *)vq->priv;
+    uint32_t addr = ((struct rpmsg_lite_endpoint *)node->data)->addr;
+#if (RL_EPT_TABLE_HASH_SIZE > 0)
+    uint32_t slot;
+#endif
 
-    RL_ASSERT(rpmsg_lite_dev != RL_NULL);
-    rpmsg_lite_dev->link_state = 1U;
-    env_tx_callback(rpmsg_lite_dev->link_id);
-}
+#if (RL_EPT_TABLE_DIRECT_SIZE > 0)
+    if (addr < (uint32_t)RL_EPT_TABLE_DIRECT_SIZE)
+    {
+        rpmsg_lite_dev->ept_direct[addr] = node;
+        rpmsg_lite_dev->ept_direct_used[addr / 32U] |= (1UL << (addr % 32U));
+        return;
+    }
+#endif
 
-/****************************************************************************
+#if (RL_EPT_TABLE_HASH_SIZE > 0)
+    /* Keep one slot free to terminate the probing */
+    if (rpmsg_lite_dev->ept_hash_count < ((uint32_t)RL_EPT_TABLE_HASH_SIZE - 1U))
+    {
+        slot = RL_EPT_HASH_SLOT(addr);
+        while (rpmsg_lite_dev->ept_hash[slot] != RL_NULL)
+        {
+            slot = (slot + 1U) & ((uint32_t)RL_EPT_TABLE_HASH_SIZE - 1U);
+        }
+        rpmsg_lite_dev->ept_hash[slot] = node;
+        rpmsg_lite_dev->ept_hash_count++;
+        return;
+    }
+#endif
+
+    /* Not in the tables, found in the linked list only */
+    rpmsg_lite_dev->ept_overflow_count++;
+}
 
- m    m  mmmm         m    m   mm   mm   m mmmm   m      mmmmm  mm   m   mmm
- "m  m" m"  "m        #    #   ##   #"m  # #   "m #        #    #"m  # m"   "
-  #  #  #    #        #mmmm#  #  #  # #m # #    # #        #    # #m # #   mm
-  "mm"  #    #        #    #  #mm#  #  # # #    # #        #    #  # # #    #
-   ##    #mm#"        #    # #    # #   ## #mmm"  #mmmmm mm#mm  #   ##  "mmm"
-            #
- In case this processor has the REMOTE role
-*****************************************************************************/
 /*!
  * @brief
- * Places buffer on the virtqueue for consumption by the other side.
- *
- * @param vq      Virtqueue to use
- * @param buffer  Buffer pointer
- * @param len     Buffer length
- * @idx           Buffer index
+ * Unregister the endpoint node from the endpoint tables,
+ * called with the lock held.
  *
- * @return Status of function execution
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param node              Node of the endpoint to unregister
  *
  */
-static void vq_tx_remote(struct virtqueue *tvq, void *buffer, uint32_t len, uint16_t idx)
+static void rpmsg_lite_ept_table_remove(struct rpmsg_lite_instance *rpmsg_lite_dev, struct llist *node)
 {
-    int32_t status;
+    uint32_t addr = ((struct rpmsg_lite_endpoint *)node->data)->addr;
+#if (RL_EPT_TABLE_HASH_SIZE > 0)
+    uint32_t slot;
+    uint32_t next;
+    uint32_t home;
+#endif
 
-    env_cache_flush(buffer, len);
+#if (RL_EPT_TABLE_DIRECT_SIZE > 0)
+    if (addr < (uint32_t)RL_EPT_TABLE_DIRECT_SIZE)
+    {
+        rpmsg_lite_dev->ept_direct[addr] = RL_NULL;
+        rpmsg_lite_dev->ept_direct_used[addr / 32U] &= ~(1UL << (addr % 32U));
+        return;
+    }
+#endif
 
-    status = virtqueue_add_consumed_buffer(tvq, idx, len);
-    RL_ASSERT(status == VQUEUE_SUCCESS); /* must success here */
+#if (RL_EPT_TABLE_HASH_SIZE > 0)
+    slot = RL_EPT_HASH_SLOT(addr);
+    while ((rpmsg_lite_dev->ept_hash[slot] != RL_NULL) && (rpmsg_lite_dev->ept_hash[slot] != node))
+    {
+        slot = (slot + 1U) & ((uint32_t)RL_EPT_TABLE_HASH_SIZE - 1U);
+    }
 
-    /* As long as the length of the virtqueue ring buffer is not shorter
-     * than the number of buffers in the pool, this function should not fail.
-     * This condition is always met, so we don't need to return anything here */
+    if (rpmsg_lite_dev->ept_hash[slot] == node)
+    {
+        /* Shift back the following entries of the probe sequence, no tombstones needed */
+        next = slot;
+        for (;;)
+        {
+            next = (next + 1U) & ((uint32_t)RL_EPT_TABLE_HASH_SIZE - 1U);
+            if (rpmsg_lite_dev->ept_hash[next] == RL_NULL)
+            {
+                break;
+            }
+            home = RL_EPT_HASH_SLOT(((struct rpmsg_lite_endpoint *)rpmsg_lite_dev->ept_hash[next]->data)->addr);
+            /* Entry stays when its home slot lies cyclically in (slot, next] */
+            if ((slot <= next) ? ((slot < home) && (home <= next)) : ((slot < home) || (home <= next)))
+            {
+                continue;
+            }
+            rpmsg_lite_dev->ept_hash[slot] = rpmsg_lite_dev->ept_hash[next];
+            slot                           = next;
+        }
+        rpmsg_lite_dev->ept_hash[slot] = RL_NULL;
+        rpmsg_lite_dev->ept_hash_count--;
+        return;
+    }
+#endif
+
+    rpmsg_lite_dev->ept_overflow_count--;
 }
+#endif /* (RL_EPT_TABLE_DIRECT_SIZE > 0) || (RL_EPT_TABLE_HASH_SIZE > 0) */
 
 /*!
  * @brief
- * Provides buffer to transmit messages.
+ * Find the lowest free endpoint address.
  *
- * @param vq      Virtqueue to use
- * @param len     Length of returned buffer
- * @param idx     Buffer index
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ *
+ * @return       RL_ADDR_ANY if no address is free, the address otherwise
  *
- * return Pointer to buffer.
  */
-static void *vq_tx_alloc_remote(struct virtqueue *tvq, uint32_t *len, uint16_t *idx)
+static uint32_t rpmsg_lite_get_free_addr(struct rpmsg_lite_instance *rpmsg_lite_dev)
 {
-    void *data = RL_NULL;
+    uint32_t i = 1U;
+#if (RL_EPT_TABLE_DIRECT_SIZE > 0)
+    uint32_t free_mask;
+    uint32_t word;
 
-    data = virtqueue_get_available_buffer(tvq, idx, len);
-    if (data != RL_NULL)
+    for (word = 0U; word < ((uint32_t)RL_EPT_TABLE_DIRECT_SIZE / 32U); word++)
     {
-        env_cache_invalidate(data, *len);
+        free_mask = ~rpmsg_lite_dev->ept_direct_used[word];
+        if (word == 0U)
+        {
+            /* Address 0 is never allocated */
+            free_mask &= ~1UL;
+        }
+        if (free_mask != 0U)
+        {
+            i = word * 32U;
+            while ((free_mask & 1UL) == 0U)
+            {
+                free_mask >>= 1U;
+                i++;
+            }
+            return i;
+        }
     }
-    return data;
+    i = (uint32_t)RL_EPT_TABLE_DIRECT_SIZE;
+#endif
+
+    for (; i < 0xFFFFFFFFU; i++)
+    {
+        if (rpmsg_lite_get_endpoint_from_addr(rpmsg_lite_dev, i) == RL_NULL)
+        {
+            return i;
+        }
+    }
+    return RL_ADDR_ANY;
 }
 
 /*!
  * @brief
- * Retrieves the received buffer from the virtqueue.
+ * Get the destination endpoint of a received message. The endpoint list
+ * lock is taken unless called from the rx ISR, where the list is accessed
+ * without locking as the ISR cannot wait for the lock.
  *
- * @param vq   Virtqueue to use
- * @param len  Size of received buffer
- * @param idx  Index of buffer
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param addr              Destination address of the message
  *
- * @return  Pointer to received buffer
+ * @return       RL_NULL if not found, endpoint pointer on success
  *
  */
-static void *vq_rx_remote(struct virtqueue *rvq, uint32_t *len, uint16_t *idx)
+static struct rpmsg_lite_endpoint *rpmsg_lite_rx_get_endpoint(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                                              uint32_t addr)
 {
-    void *data = RL_NULL;
+    struct llist *node;
+    uint32_t locked = RL_FALSE;
 
-    data = virtqueue_get_available_buffer(rvq, idx, len);
-    if (data != RL_NULL)
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    locked = RL_TRUE;
+#elif defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+    locked = rpmsg_lite_dev->rx_deferred;
+#endif
+
+    if (locked == RL_TRUE)
     {
-        env_cache_invalidate(data, *len);
+        env_lock_mutex(rpmsg_lite_dev->lock);
+    }
+    node = rpmsg_lite_get_endpoint_from_addr(rpmsg_lite_dev, addr);
+    if (locked == RL_TRUE)
+    {
+        env_unlock_mutex(rpmsg_lite_dev->lock);
     }
 
-    return data;
+    return (node != RL_NULL) ? (struct rpmsg_lite_endpoint *)node->data : RL_NULL;
 }
 
+/***************************************************************
+   mmm    mm   m      m      mmmmm    mm     mmm  m    m  mmmm
+ m"   "   ##   #      #      #    #   ##   m"   " #  m"  #"   "
+ #       #  #  #      #      #mmmm"  #  #  #      #m#    "#mmm
+ #       #mm#  #      #      #    #  #mm#  #      #  #m      "#
+  "mmm" #    # #mmmmm #mmmmm #mmmm" #    #  "mmm" #   "m "mmm#"
+****************************************************************/
+
+#if defined(RL_CLEAR_USED_BUFFERS) && (RL_CLEAR_USED_BUFFERS == 1) && (RL_VRING_BATCH_SIZE > 0)
+static void rpmsg_lite_clear_msg(struct virtqueue *vq, void *buffer, uint32_t len);
+#endif
+
+#if (RL_VRING_BATCH_SIZE > 0)
 /*!
  * @brief
- * Places the used buffer back on the virtqueue.
+ * Places the collected buffers on their virtqueue with one ring index update.
  *
- * @param vq   Virtqueue to use
- * @param len  Size of received buffer
- * @param idx  Index of buffer
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param batch             Collected buffers, emptied
  *
  */
-static void vq_rx_free_remote(struct virtqueue *rvq, void *buffer, uint32_t len, uint16_t idx)
+static void rpmsg_lite_batch_flush(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_lite_vq_batch *batch)
 {
-    int32_t status;
-#if defined(RL_CLEAR_USED_BUFFERS) && (RL_CLEAR_USED_BUFFERS == 1)
-    env_memset(buffer, 0x00, len);
-    env_cache_flush(buffer, len);
-#endif
-    status = virtqueue_add_consumed_buffer(rvq, idx, len);
-    RL_ASSERT(status == VQUEUE_SUCCESS); /* must success here */
-                                         /* As long as the length of the virtqueue ring buffer is not shorter
-                                          * than the number of buffers in the pool, this function should not fail.
-                                          * This condition is always met, so we don't need to return anything here */
+    if (batch->count > 0U)
+    {
+        rpmsg_lite_dev->vq_ops->vq_add_batch(batch->vq, batch->elems, batch->count);
+        batch->count = 0U;
+    }
 }
 
-/****************************************************************************
-
- m    m  mmmm         m    m   mm   mm   m mmmm   m      mmmmm  mm   m   mmm
- "m  m" m"  "m        #    #   ##   #"m  # #   "m #        #    #"m  # m"   "
-  #  #  #    #        #mmmm#  #  #  # #m # #    # #        #    # #m # #   mm
-  "mm"  #    #        #    #  #mm#  #  # # #    # #        #    #  # # #    #
-   ##    #mm#"        #    # #    # #   ## #mmm"  #mmmmm mm#mm  #   ##  "mmm"
-            #
- In case this processor has the MASTER role
-*****************************************************************************/
-
 /*!
  * @brief
- * Places buffer on the virtqueue for consumption by the other side.
+ * Adds a buffer to the batch, places the batch on its virtqueue first
+ * when full or when collected for another virtqueue.
  *
- * @param tvq     Virtqueue to use
- * @param buffer  Buffer pointer
- * @param len     Buffer length
- * @param idx     Buffer index
- *
- * @return Status of function execution
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param vq                Virtqueue to use
+ * @param batch             Collected buffers
+ * @param len               Buffer length
+ * @param idx               Buffer index
  *
  */
-static void vq_tx_master(struct virtqueue *tvq, void *buffer, uint32_t len, uint16_t idx)
+static void rpmsg_lite_batch_add(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                 struct virtqueue *vq,
+                                 struct rpmsg_lite_vq_batch *batch,
+                                 uint32_t len,
+                                 uint16_t idx)
 {
-    int32_t status;
-
-    env_cache_flush(buffer, len);
-
-    status = virtqueue_add_buffer(tvq, idx);
-    RL_ASSERT(status == VQUEUE_SUCCESS); /* must success here */
+    if ((batch->count == (uint16_t)RL_VRING_BATCH_SIZE) || ((batch->count > 0U) && (batch->vq != vq)))
+    {
+        rpmsg_lite_batch_flush(rpmsg_lite_dev, batch);
+    }
+    batch->vq                      = vq;
+    batch->elems[batch->count].id  = idx;
+    batch->elems[batch->count].len = len;
+    batch->count++;
+}
+#endif /* RL_VRING_BATCH_SIZE */
 
-    /* As long as the length of the virtqueue ring buffer is not shorter
-     * than the number of buffers in the pool, this function should not fail.
-     * This condition is always met, so we don't need to return anything here */
+/*!
+ * @brief
+ * Returns a processed rx buffer to the vring, or to the batch of the rx drain loop.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param rvq               Virtqueue the message has been received from
+ * @param rx_batch          Batch of the rx drain loop, RL_NULL to return the buffer at once
+ * @param rpmsg_msg         Received message
+ * @param len               Buffer length
+ * @param idx               Buffer index
+ *
+ */
+static void rpmsg_lite_rx_free(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                               struct virtqueue *rvq,
+                               struct rpmsg_lite_vq_batch *rx_batch,
+                               struct rpmsg_std_msg *rpmsg_msg,
+                               uint32_t len,
+                               uint16_t idx)
+{
+#if (RL_VRING_BATCH_SIZE > 0)
+    if (rx_batch != RL_NULL)
+    {
+#if defined(RL_CLEAR_USED_BUFFERS) && (RL_CLEAR_USED_BUFFERS == 1)
+        rpmsg_lite_clear_msg(rvq, rpmsg_msg, len);
+#endif
+        rpmsg_lite_batch_add(rpmsg_lite_dev, rvq, rx_batch, len, idx);
+        return;
+    }
+#else
+    (void)rx_batch;
+#endif
+    rpmsg_lite_dev->vq_ops->vq_rx_free(rvq, rpmsg_msg, len, idx);
 }
 
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+static uint32_t rpmsg_lite_fc_rx(struct rpmsg_lite_endpoint *ept, const struct rpmsg_std_hdr *hdr);
+static uint32_t rpmsg_lite_fc_consumed(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                       struct rpmsg_lite_endpoint *ept,
+                                       uint32_t in_rx);
+static void rpmsg_lite_fc_queue_credit(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_lite_endpoint *ept);
+static void rpmsg_lite_fc_send_queued(struct rpmsg_lite_instance *rpmsg_lite_dev);
+#endif
+
+#if defined(RL_ALLOW_MSG_PACKING) && (RL_ALLOW_MSG_PACKING == 1)
 /*!
  * @brief
- * Provides buffer to transmit messages.
+ * Updates the number of references to a received container of packed messages,
+ * called in the rx ISR or by the rx worker. The references are counted in the
+ * reserved.rfu field of the container header.
  *
- * @param tvq     Virtqueue to use
- * @param len     Length of returned buffer
- * @param idx     Buffer index
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param container         Received container
+ * @param add               RL_TRUE to add a reference, RL_FALSE to drop one
+ *
+ * @return Number of references left
  *
- * return Pointer to buffer.
  */
-static void *vq_tx_alloc_master(struct virtqueue *tvq, uint32_t *len, uint16_t *idx)
+static uint32_t rpmsg_lite_rx_container_ref(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                            struct rpmsg_std_msg *container,
+                                            uint32_t add)
 {
-    void *data = RL_NULL;
+    uint32_t refs;
 
-    data = virtqueue_get_buffer(tvq, len, idx);
-    if (data != RL_NULL)
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+    /* The rx worker runs in a task, exclude rpmsg_lite_release_rx_buffer() */
+    if (rpmsg_lite_dev->rx_deferred == RL_TRUE)
     {
-        env_cache_invalidate(data, *len);
+        env_lock_mutex(rpmsg_lite_dev->rx_lock);
+    }
+#endif
+    if (add == RL_TRUE)
+    {
+        container->hdr.reserved.rfu++;
+    }
+    else
+    {
+        container->hdr.reserved.rfu--;
     }
+    refs = container->hdr.reserved.rfu;
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+    if (rpmsg_lite_dev->rx_deferred == RL_TRUE)
+    {
+        env_unlock_mutex(rpmsg_lite_dev->rx_lock);
+    }
+#endif
 
-    return data;
+    return refs;
 }
 
 /*!
  * @brief
- * Retrieves the received buffer from the virtqueue.
+ * Delivers the messages packed in a received container to their endpoints
+ * and returns the container to the vring once none of them is held.
  *
- * @param rvq  Virtqueue to use
- * @param len  Size of received buffer
- * @param idx  Index of buffer
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param rvq               Virtqueue the container has been received from
+ * @param rx_batch          Batch of the rx drain loop, RL_NULL to return the buffer at once
+ * @param container         Received container
+ * @param len               Buffer length
+ * @param idx               Buffer index
  *
- * @return  Pointer to received buffer
+ * @return RL_TRUE when the buffer has been returned to the vring
  *
  */
-static void *vq_rx_master(struct virtqueue *rvq, uint32_t *len, uint16_t *idx)
+static uint32_t rpmsg_lite_rx_unpack(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                     struct virtqueue *rvq,
+                                     struct rpmsg_lite_vq_batch *rx_batch,
+                                     struct rpmsg_std_msg *container,
+                                     uint32_t len,
+                                     uint16_t idx)
 {
-    void *data = RL_NULL;
+    struct rpmsg_std_msg *rpmsg_msg;
+    struct rpmsg_lite_endpoint *ept;
+    uint32_t total  = container->hdr.len;
+    uint32_t offset = 0U;
+    uint32_t msg_len;
+    uint32_t rec_flags;
+    int32_t cb_ret;
 
-    data = virtqueue_get_buffer(rvq, len, idx);
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+    rvq->vq_shadow[idx].held = 1U;
+#else
+    container->hdr.reserved.idx = idx;
+#endif
+    /* Own reference, keeps the container until all the packed messages are delivered */
+    container->hdr.reserved.rfu = 1U;
 
-    if (data != RL_NULL)
+    /* The last record of a full container may end unaligned, offset then passes total */
+    while ((offset + (uint32_t)sizeof(struct rpmsg_std_hdr)) <= total)
     {
-        env_cache_invalidate(data, *len);
+        rpmsg_msg = (struct rpmsg_std_msg *)(void *)&container->data[offset];
+        msg_len   = rpmsg_msg->hdr.len;
+        if (msg_len > (total - offset - (uint32_t)sizeof(struct rpmsg_std_hdr)))
+        {
+            /* Malformed container, drop the rest */
+            break;
+        }
+
+        ept       = rpmsg_lite_rx_get_endpoint(rpmsg_lite_dev, rpmsg_msg->hdr.dst);
+        rec_flags = RL_MSG_FLAG_PACKED_REC;
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+        /* The credit limit of the record is in reserved.rfu, taken before it is overwritten,
+           the flag is kept for rpmsg_lite_release_rx_buffer() on the records counted in the window */
+        if (((rpmsg_msg->hdr.flags & RL_MSG_FLAG_CREDIT) != 0U) && (ept != RL_NULL) &&
+            (rpmsg_lite_fc_rx(ept, &rpmsg_msg->hdr) == RL_TRUE))
+        {
+            rec_flags |= RL_MSG_FLAG_CREDIT;
+        }
+#endif
+
+        /* Let rpmsg_lite_release_rx_buffer() find the container of a held message */
+        rpmsg_msg->hdr.flags        = (uint16_t)rec_flags;
+        rpmsg_msg->hdr.reserved.rfu = (uint16_t)(((uint32_t)sizeof(struct rpmsg_std_hdr) + offset) & 0xFFFFU);
+
+        if (ept != RL_NULL)
+        {
+            /* Referenced before the callback, a held message can be released before it returns */
+            (void)rpmsg_lite_rx_container_ref(rpmsg_lite_dev, container, RL_TRUE);
+            cb_ret = ept->rx_cb(rpmsg_msg->data, msg_len, rpmsg_msg->hdr.src, ept->rx_cb_data);
+            if (cb_ret != RL_HOLD)
+            {
+                (void)rpmsg_lite_rx_container_ref(rpmsg_lite_dev, container, RL_FALSE);
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+                if (((rec_flags & RL_MSG_FLAG_CREDIT) != 0U) &&
+                    (rpmsg_lite_fc_consumed(rpmsg_lite_dev, ept, RL_TRUE) == RL_TRUE))
+                {
+                    rpmsg_lite_fc_queue_credit(rpmsg_lite_dev, ept);
+                }
+#endif
+            }
+        }
+
+        offset += (uint32_t)RL_WORD_ALIGN_UP(sizeof(struct rpmsg_std_hdr) + msg_len);
     }
 
-    return data;
+    if (rpmsg_lite_rx_container_ref(rpmsg_lite_dev, container, RL_FALSE) != 0U)
+    {
+        return RL_FALSE;
+    }
+
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+    rvq->vq_shadow[idx].held = 0U;
+#endif
+    rpmsg_lite_rx_free(rpmsg_lite_dev, rvq, rx_batch, container, len, idx);
+    return RL_TRUE;
 }
+#endif /* RL_ALLOW_MSG_PACKING */
 
+#if defined(RL_API_HAS_ZEROCOPY) && (RL_API_HAS_ZEROCOPY == 1)
 /*!
  * @brief
- * Places the used buffer back on the virtqueue.
+ * Returns the buffer index of a held rx buffer and marks the buffer
+ * as no longer held, called with the rx lock taken.
  *
- * @param rvq    Virtqueue to use
- * @param buffer Buffer pointer
- * @param len    Size of received buffer
- * @param idx    Index of buffer
+ * @param rvq               Virtqueue the message has been received from
+ * @param rpmsg_msg         Held message
+ *
+ * @return Buffer index
  *
  */
-static void vq_rx_free_master(struct virtqueue *rvq, void *buffer, uint32_t len, uint16_t idx)
+static uint16_t rpmsg_lite_rx_unhold(struct virtqueue *rvq, struct rpmsg_std_msg *rpmsg_msg)
 {
-    int32_t status;
-#if defined(RL_CLEAR_USED_BUFFERS) && (RL_CLEAR_USED_BUFFERS == 1)
-    env_memset(buffer, 0x00, len);
-    env_cache_flush(buffer, len);
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+    uint16_t idx   = 0U;
+    int32_t status = virtqueue_get_buffer_index(rvq, rpmsg_msg, &idx);
+
+    /* Not an rx buffer or released twice */
+    RL_ASSERT(status == VQUEUE_SUCCESS);
+    RL_ASSERT(rvq->vq_shadow[idx].held != 0U);
+    rvq->vq_shadow[idx].held = 0U;
+    return idx;
+#else
+    (void)rvq;
+    return rpmsg_msg->hdr.reserved.idx;
 #endif
+}
+#endif /* RL_API_HAS_ZEROCOPY */
 
-    status = virtqueue_add_buffer(rvq, idx);
-    RL_ASSERT(status == VQUEUE_SUCCESS); /* must success here */
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+/*!
+ * @brief
+ * Internal function to create the locks of the flow control state of a new endpoint.
+ *
+ * @param ept               Endpoint being created
+ *
+ * @return  Status of function execution, none of the locks is left created on failure
+ *
+ */
+static int32_t rpmsg_lite_fc_create_locks(struct rpmsg_lite_endpoint *ept)
+{
+    int32_t status;
 
-    /* As long as the length of the virtqueue ring buffer is not shorter
-     * than the number of buffers in the pool, this function should not fail.
-     * This condition is always met, so we don't need to return anything here */
-}
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    status = env_create_mutex((LOCK *)&ept->fc_lock, 1, &ept->fc_lock_static_ctxt);
+#else
+    status = env_create_mutex((LOCK *)&ept->fc_lock, 1);
+#endif
+    if (status != RL_SUCCESS)
+    {
+        return status;
+    }
 
-/* Interface used in case this processor is MASTER */
-static const struct virtqueue_ops master_vq_ops = {
-    vq_tx_master,
-    vq_tx_alloc_master,
-    vq_rx_master,
-    vq_rx_free_master,
-};
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    status = env_create_sync_lock((LOCK *)&ept->fc_wait_lock, LOCKED, &ept->fc_wait_lock_static_ctxt);
+#else
+    status = env_create_sync_lock((LOCK *)&ept->fc_wait_lock, LOCKED);
+#endif
+    if (status != RL_SUCCESS)
+    {
+        env_delete_mutex(ept->fc_lock);
+    }
+    return status;
+}
 
-/* Interface used in case this processor is REMOTE */
-static const struct virtqueue_ops remote_vq_ops = {
-    vq_tx_remote,
-    vq_tx_alloc_remote,
-    vq_rx_remote,
-    vq_rx_free_remote,
-};
+/*!
+ * @brief
+ * Takes the flow control state of the endpoint in a task,
+ * the rx path may update it from the ISR.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Endpoint
+ *
+ */
+static void rpmsg_lite_fc_enter(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_lite_endpoint *ept)
+{
+    env_lock_mutex(ept->fc_lock);
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    env_disable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->rvq->vq_queue_index);
+#else
+    env_disable_interrupt(rpmsg_lite_dev->rvq->vq_queue_index);
+#endif
+}
 
-/* helper function for virtqueue notification */
-static void virtqueue_notify(struct virtqueue *vq)
+/*!
+ * @brief
+ * Gives the flow control state of the endpoint back, see rpmsg_lite_fc_enter().
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Endpoint
+ *
+ */
+static void rpmsg_lite_fc_leave(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_lite_endpoint *ept)
 {
 #if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
-    struct rpmsg_lite_instance *inst = vq->priv;
-    platform_notify(inst->env ? env_get_platform_context(inst->env) : RL_NULL, vq->vq_queue_index);
+    env_enable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->rvq->vq_queue_index);
 #else
-    platform_notify(vq->vq_queue_index);
+    env_enable_interrupt(rpmsg_lite_dev->rvq->vq_queue_index);
 #endif
+    env_unlock_mutex(ept->fc_lock);
 }
 
-/*************************************************
+/*!
+ * @brief
+ * Compares two credit limits, the limits wrap around at 16 bits.
+ *
+ * @param a                 Credit limit
+ * @param b                 Credit limit
+ *
+ * @return RL_TRUE when a is ahead of b
+ *
+ */
+static uint32_t rpmsg_lite_fc_after(uint16_t a, uint16_t b)
+{
+    uint16_t diff = (uint16_t)(a - b);
 
- mmmmmm mmmmm mmmmmmm        mm   m mmmmmmm     m
- #      #   "#   #           #"m  # #     #  #  #
- #mmmmm #mmm#"   #           # #m # #mmmmm" #"# #
- #      #        #           #  # # #      ## ##"
- #mmmmm #        #           #   ## #mmmmm #   #
+    return ((diff != 0U) && (diff <= 0x7FFFU)) ? RL_TRUE : RL_FALSE;
+}
 
-**************************************************/
-#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
-struct rpmsg_lite_endpoint *rpmsg_lite_create_ept(struct rpmsg_lite_instance *rpmsg_lite_dev,
-                                                  uint32_t addr,
-                                                  rl_ept_rx_cb_t rx_cb,
-                                                  void *rx_cb_data,
-                                                  struct rpmsg_lite_ept_static_context *ept_context)
-#else
-struct rpmsg_lite_endpoint *rpmsg_lite_create_ept(struct rpmsg_lite_instance *rpmsg_lite_dev,
-                                                  uint32_t addr,
-                                                  rl_ept_rx_cb_t rx_cb,
-                                                  void *rx_cb_data)
-#endif
+/*!
+ * @brief
+ * Returns the number of messages the endpoint may still send to its peer.
+ *
+ * @param ept               Endpoint
+ *
+ * @return Number of credits
+ *
+ */
+static uint32_t rpmsg_lite_fc_credits(const struct rpmsg_lite_endpoint *ept)
 {
-    struct rpmsg_lite_endpoint *rl_ept;
-    struct llist *node;
-    uint32_t i;
+    uint16_t credits = (uint16_t)(ept->fc_tx_limit - ept->fc_tx_sent);
 
-    if (rpmsg_lite_dev == RL_NULL)
+    /* A limit behind the sent count is a grant older than the messages sent */
+    return (credits > 0x7FFFU) ? 0U : (uint32_t)credits;
+}
+
+/*!
+ * @brief
+ * Checks whether the endpoint owes its peer a credit message,
+ * half of the window has been released since the last grant.
+ *
+ * @param ept               Endpoint
+ *
+ * @return RL_TRUE when a credit message is due
+ *
+ */
+static uint32_t rpmsg_lite_fc_grant_due(const struct rpmsg_lite_endpoint *ept)
+{
+    uint16_t limit = (uint16_t)(ept->fc_rx_consumed + ept->fc_window);
+
+    if (ept->fc_peer == RL_ADDR_ANY)
     {
-        return RL_NULL;
+        return RL_FALSE;
     }
+    return ((uint16_t)(limit - ept->fc_rx_granted) >= (uint16_t)((ept->fc_window + 1U) / 2U)) ? RL_TRUE : RL_FALSE;
+}
 
-    env_lock_mutex(rpmsg_lite_dev->lock);
+/*!
+ * @brief
+ * Queues the endpoint for sending the credit message due from the rx path.
+ * The message is sent by rpmsg_lite_fc_send_queued() once the rx path is done,
+ * from the ISR as well, so a receiver without a task still grants credits.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Endpoint
+ *
+ */
+static void rpmsg_lite_fc_queue_credit(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_lite_endpoint *ept)
+{
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    if (ept->fc_credit_queued == RL_FALSE)
     {
-        if (addr == RL_ADDR_ANY)
+        ept->fc_credit_queued          = RL_TRUE;
+        ept->fc_credit_next            = rpmsg_lite_dev->fc_credit_head;
+        rpmsg_lite_dev->fc_credit_head = ept;
+    }
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+}
+
+/*!
+ * @brief
+ * Removes an endpoint being destroyed from the queue of the credit messages.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Endpoint
+ *
+ */
+static void rpmsg_lite_fc_unqueue_credit(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_lite_endpoint *ept)
+{
+    struct rpmsg_lite_endpoint **link;
+
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    if (ept->fc_credit_queued == RL_TRUE)
+    {
+        link = &rpmsg_lite_dev->fc_credit_head;
+        while (*link != ept)
         {
-            /* find lowest free address */
-            for (i = 1; i < 0xFFFFFFFFU; i++)
-            {
-                if (rpmsg_lite_get_endpoint_from_addr(rpmsg_lite_dev, i) == RL_NULL)
-                {
-                    addr = i;
-                    break;
-                }
-            }
-            /*
-            * $Branch Coverage Justification$
-            * Not able to reach the true condition,
-            * not possible to use all 2^32 endpoints/addresses.
-            */
-            if (addr == RL_ADDR_ANY) /* GCOVR_EXCL_BR_LINE */
+            link = &(*link)->fc_credit_next;
+        }
+        *link                 = ept->fc_credit_next;
+        ept->fc_credit_queued = RL_FALSE;
+    }
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+}
+
+/*!
+ * @brief
+ * Takes the credit information of a received message, called by the rx path.
+ *
+ * @param ept               Destination endpoint
+ * @param hdr               Header of the received message
+ *
+ * @return RL_TRUE when the message counts against the window of the endpoint
+ *
+ */
+static uint32_t rpmsg_lite_fc_rx(struct rpmsg_lite_endpoint *ept, const struct rpmsg_std_hdr *hdr)
+{
+    uint32_t flags   = (uint32_t)hdr->flags;
+    uint16_t limit   = hdr->reserved.rfu;
+    uint32_t counted = RL_FALSE;
+    uint32_t wake    = RL_FALSE;
+
+    /* Interrupts are off for the tasks holding the state, the mutex is for the rx worker */
+    env_lock_mutex(ept->fc_lock);
+    if (ept->fc_peer != hdr->src)
+    {
+        if ((flags & RL_MSG_FLAG_CREDIT_SYNC) != 0U)
+        {
+            /* Kept for rpmsg_lite_set_ept_flow_control() called after the peer */
+            ept->fc_sync_src   = hdr->src;
+            ept->fc_sync_limit = limit;
+        }
+    }
+    else
+    {
+        if ((flags & RL_MSG_FLAG_CREDIT_SYNC) != 0U)
+        {
+            /* The peer has (re)started its window, the messages sent to it count from zero */
+            ept->fc_gen++;
+            ept->fc_tx_sent  = 0U;
+            ept->fc_tx_limit = limit;
+            wake             = RL_TRUE;
+        }
+        else if (rpmsg_lite_fc_after(limit, ept->fc_tx_limit) == RL_TRUE)
+        {
+            ept->fc_tx_limit = limit;
+            wake             = RL_TRUE;
+        }
+        else
+        {
+            /* No new credit */
+        }
+
+        if ((flags & RL_MSG_FLAG_CREDIT_ONLY) == 0U)
+        {
+            counted = RL_TRUE;
+            ept->fc_rx_received++;
+            if ((uint16_t)(ept->fc_rx_received - ept->fc_rx_consumed) > ept->fc_window)
             {
-                /* no address is free, cannot happen normally */
-                /*
-                 * $Line Coverage Justification$
-                 * Lines never reached, not possible to use all 2^32 endpoints/addresses.
-                 */
-                env_unlock_mutex(rpmsg_lite_dev->lock); /* GCOVR_EXCL_LINE */
-                return RL_NULL; /* GCOVR_EXCL_LINE */
+                ept->fc_rx_overruns++;
             }
         }
+    }
+    if ((wake == RL_TRUE) && (ept->fc_tx_waiters != 0U))
+    {
+        env_release_sync_lock(ept->fc_wait_lock);
+    }
+    env_unlock_mutex(ept->fc_lock);
+
+    return counted;
+}
+
+/*!
+ * @brief
+ * Keeps a sync sent to an endpoint not created yet,
+ * for rpmsg_lite_set_ept_flow_control() called on it later.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param hdr               Header of the received sync
+ *
+ */
+static void rpmsg_lite_fc_rx_orphan(struct rpmsg_lite_instance *rpmsg_lite_dev, const struct rpmsg_std_hdr *hdr)
+{
+    /* Not taken in the ISR, excludes rpmsg_lite_set_ept_flow_control() when called by the rx worker */
+    env_lock_mutex(rpmsg_lite_dev->lock);
+    rpmsg_lite_dev->fc_sync_src   = hdr->src;
+    rpmsg_lite_dev->fc_sync_dst   = hdr->dst;
+    rpmsg_lite_dev->fc_sync_limit = hdr->reserved.rfu;
+    env_unlock_mutex(rpmsg_lite_dev->lock);
+}
+
+/*!
+ * @brief
+ * Counts a message of the peer released by the endpoint.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Endpoint
+ * @param in_rx             RL_TRUE when called by the rx path
+ *
+ * @return RL_TRUE when a credit message is due
+ *
+ */
+static uint32_t rpmsg_lite_fc_consumed(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                       struct rpmsg_lite_endpoint *ept,
+                                       uint32_t in_rx)
+{
+    uint32_t due;
+
+    if (in_rx == RL_TRUE)
+    {
+        env_lock_mutex(ept->fc_lock);
+    }
+    else
+    {
+        rpmsg_lite_fc_enter(rpmsg_lite_dev, ept);
+    }
+    ept->fc_rx_consumed++;
+    due = rpmsg_lite_fc_grant_due(ept);
+    if (in_rx == RL_TRUE)
+    {
+        env_unlock_mutex(ept->fc_lock);
+    }
+    else
+    {
+        rpmsg_lite_fc_leave(rpmsg_lite_dev, ept);
+    }
+    return due;
+}
+
+#if defined(RL_API_HAS_ZEROCOPY) && (RL_API_HAS_ZEROCOPY == 1)
+/*!
+ * @brief
+ * Returns the endpoint a held message counts for, RL_NULL when the message
+ * is not flow controlled.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param hdr               Header of the held message
+ *
+ * @return Destination endpoint of the message
+ *
+ */
+static struct rpmsg_lite_endpoint *rpmsg_lite_fc_held_ept(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                                          const struct rpmsg_std_hdr *hdr)
+{
+    struct rpmsg_lite_endpoint *ept = RL_NULL;
+    struct llist *node;
+
+    if (((uint32_t)hdr->flags & (RL_MSG_FLAG_CREDIT | RL_MSG_FLAG_CREDIT_ONLY)) != RL_MSG_FLAG_CREDIT)
+    {
+        return RL_NULL;
+    }
+
+    env_lock_mutex(rpmsg_lite_dev->lock);
+    node = rpmsg_lite_get_endpoint_from_addr(rpmsg_lite_dev, hdr->dst);
+    if (node != RL_NULL)
+    {
+        ept = (struct rpmsg_lite_endpoint *)node->data;
+        if (ept->fc_peer != hdr->src)
+        {
+            ept = RL_NULL;
+        }
+    }
+    env_unlock_mutex(rpmsg_lite_dev->lock);
+    return ept;
+}
+
+/*!
+ * @brief
+ * Counts a held message released by the application
+ * and sends the credit message when due.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Endpoint the message counts for, as returned by rpmsg_lite_fc_held_ept()
+ *
+ */
+static void rpmsg_lite_fc_released(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_lite_endpoint *ept)
+{
+    if ((ept != RL_NULL) && (rpmsg_lite_fc_consumed(rpmsg_lite_dev, ept, RL_FALSE) == RL_TRUE))
+    {
+        rpmsg_lite_fc_queue_credit(rpmsg_lite_dev, ept);
+        rpmsg_lite_fc_send_queued(rpmsg_lite_dev);
+    }
+}
+#endif /* RL_API_HAS_ZEROCOPY */
+#endif /* RL_ALLOW_CREDIT_FLOW_CONTROL */
+
+/*!
+ * @brief
+ * Delivers one received message to the destination endpoint
+ * and returns the buffer to the vring unless held by the endpoint.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param rvq               Virtqueue the message has been received from
+ * @param rx_batch          Batch of the rx drain loop, RL_NULL to return the buffer at once
+ * @param ept               Destination endpoint, RL_NULL if not found
+ * @param rpmsg_msg         Received message
+ * @param len               Buffer length
+ * @param idx               Buffer index
+ *
+ * @return RL_TRUE when the buffer has been returned to the vring
+ *
+ */
+static uint32_t rpmsg_lite_rx_dispatch(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                       struct virtqueue *rvq,
+                                       struct rpmsg_lite_vq_batch *rx_batch,
+                                       struct rpmsg_lite_endpoint *ept,
+                                       struct rpmsg_std_msg *rpmsg_msg,
+                                       uint32_t len,
+                                       uint16_t idx)
+{
+    int32_t cb_ret = RL_RELEASE;
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    uint32_t fc_counted = RL_FALSE;
+#endif
+
+#if defined(RL_ALLOW_MSG_PACKING) && (RL_ALLOW_MSG_PACKING == 1)
+    if ((rpmsg_msg->hdr.flags & RL_MSG_FLAG_PACKED) != 0U)
+    {
+        return rpmsg_lite_rx_unpack(rpmsg_lite_dev, rvq, rx_batch, rpmsg_msg, len, idx);
+    }
+#endif
+
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    if ((rpmsg_msg->hdr.flags & RL_MSG_FLAG_CREDIT) != 0U)
+    {
+        if (ept != RL_NULL)
+        {
+            fc_counted = rpmsg_lite_fc_rx(ept, &rpmsg_msg->hdr);
+        }
+        else if ((rpmsg_msg->hdr.flags & RL_MSG_FLAG_CREDIT_SYNC) != 0U)
+        {
+            rpmsg_lite_fc_rx_orphan(rpmsg_lite_dev, &rpmsg_msg->hdr);
+        }
         else
         {
-            if (rpmsg_lite_get_endpoint_from_addr(rpmsg_lite_dev, addr) != RL_NULL)
+            /* Dropped as any message to a missing endpoint */
+        }
+        if ((rpmsg_msg->hdr.flags & RL_MSG_FLAG_CREDIT_ONLY) != 0U)
+        {
+            /* Credit messages are not delivered */
+            ept = RL_NULL;
+        }
+    }
+#endif
+
+    if (ept != RL_NULL)
+    {
+        /* Store the buffer index before the callback hands the buffer over, the receiving task
+         * can release a held buffer before the callback returns when it does not run in an ISR */
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+        rvq->vq_shadow[idx].held = 1U;
+#else
+        rpmsg_msg->hdr.reserved.idx = idx;
+#endif
+        cb_ret = ept->rx_cb(rpmsg_msg->data, rpmsg_msg->hdr.len, rpmsg_msg->hdr.src, ept->rx_cb_data);
+    }
+
+    if (cb_ret == RL_HOLD)
+    {
+        return RL_FALSE;
+    }
+
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+    rvq->vq_shadow[idx].held = 0U;
+#endif
+
+    rpmsg_lite_rx_free(rpmsg_lite_dev, rvq, rx_batch, rpmsg_msg, len, idx);
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    if ((fc_counted == RL_TRUE) && (rpmsg_lite_fc_consumed(rpmsg_lite_dev, ept, RL_TRUE) == RL_TRUE))
+    {
+        rpmsg_lite_fc_queue_credit(rpmsg_lite_dev, ept);
+    }
+#endif
+    return RL_TRUE;
+}
+
+#if defined(RL_API_HAS_ZEROCOPY) && (RL_API_HAS_ZEROCOPY == 1)
+/*!
+ * @brief
+ * Returns the queue pair owning a buffer of the shared memory.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param buffer            Tx or rx buffer
+ *
+ * @return Queue pair of the buffer
+ *
+ */
+static uint32_t rpmsg_lite_buffer_queue(struct rpmsg_lite_instance *rpmsg_lite_dev, const void *buffer)
+{
+#if (RL_QUEUE_PAIR_COUNT > 1)
+    uint32_t queue;
+
+    /* The master carves the buffers of the rvq and the tvq of each queue pair in turn */
+    queue = (uint32_t)(((uintptr_t)buffer - (uintptr_t)rpmsg_lite_dev->sh_mem_base) /
+                       (2U * (uint32_t)RL_BUFFER_COUNT * (uint32_t)RL_BUFFER_SIZE));
+    RL_ASSERT(queue < (uint32_t)RL_QUEUE_PAIR_COUNT);
+    return queue;
+#else
+    (void)rpmsg_lite_dev;
+    (void)buffer;
+    return 0U;
+#endif
+}
+#endif /* RL_API_HAS_ZEROCOPY */
+
+/*!
+ * @brief
+ * Returns the queue pair an endpoint sends on.
+ *
+ * @param ept    Sender endpoint
+ *
+ * @return Queue pair of the tvq to use
+ *
+ */
+static uint32_t rpmsg_lite_ept_queue(const struct rpmsg_lite_endpoint *ept)
+{
+#if (RL_QUEUE_PAIR_COUNT > 1)
+    if (ept->tx_queue == RL_QUEUE_PER_CORE)
+    {
+        return (uint32_t)RL_QUEUE_CORE_ID() % (uint32_t)RL_QUEUE_PAIR_COUNT;
+    }
+    return ept->tx_queue;
+#else
+    (void)ept;
+    return 0U;
+#endif
+}
+
+/*!
+ * @brief
+ * Takes the next received message, from the rvq selected
+ * by the rx queue policy when there is more than one queue pair.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param queue             Pointer to store the queue pair of the message
+ * @param len               Pointer to store the buffer length
+ * @param idx               Pointer to store the buffer index
+ *
+ * @return Received message, RL_NULL when all rvqs are empty
+ *
+ */
+static struct rpmsg_std_msg *rpmsg_lite_rx_get(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                               uint32_t *queue,
+                                               uint32_t *len,
+                                               uint16_t *idx)
+{
+#if (RL_QUEUE_PAIR_COUNT > 1)
+    struct rpmsg_std_msg *rpmsg_msg;
+    uint32_t q;
+
+    if (rpmsg_lite_dev->rx_policy == RL_QUEUE_POLICY_PRIORITY)
+    {
+        for (q = 0U; q < (uint32_t)RL_QUEUE_PAIR_COUNT; q++)
+        {
+            rpmsg_msg =
+                (struct rpmsg_std_msg *)rpmsg_lite_dev->vq_ops->vq_rx(rpmsg_lite_dev->rvqs[q], len, idx);
+            if (rpmsg_msg != RL_NULL)
             {
-                /* Already exists! */
-                env_unlock_mutex(rpmsg_lite_dev->lock);
-                return RL_NULL;
+                *queue = q;
+                return rpmsg_msg;
+            }
+        }
+        return RL_NULL;
+    }
+
+    /* Weighted round-robin, the rvq of the current turn is visited again with a new credit after the others */
+    for (q = 0U; q <= (uint32_t)RL_QUEUE_PAIR_COUNT; q++)
+    {
+        if (rpmsg_lite_dev->rx_credit != 0U)
+        {
+            rpmsg_msg = (struct rpmsg_std_msg *)rpmsg_lite_dev->vq_ops->vq_rx(
+                rpmsg_lite_dev->rvqs[rpmsg_lite_dev->rx_queue], len, idx);
+            if (rpmsg_msg != RL_NULL)
+            {
+                rpmsg_lite_dev->rx_credit--;
+                *queue = rpmsg_lite_dev->rx_queue;
+                return rpmsg_msg;
             }
         }
+        rpmsg_lite_dev->rx_queue  = (rpmsg_lite_dev->rx_queue + 1U) % (uint32_t)RL_QUEUE_PAIR_COUNT;
+        rpmsg_lite_dev->rx_credit = rpmsg_lite_dev->rx_weights[rpmsg_lite_dev->rx_queue];
+    }
+    return RL_NULL;
+#else
+    *queue = 0U;
+    return (struct rpmsg_std_msg *)rpmsg_lite_dev->vq_ops->vq_rx(rpmsg_lite_dev->rvq, len, idx);
+#endif
+}
+
+#if defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
+/*!
+ * @brief
+ * Lets the other side know about the rx buffers returned to the rvqs.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param rx_freed          Bit mask of the queue pairs with returned buffers
+ *
+ */
+static void rpmsg_lite_rx_kick(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t rx_freed)
+{
+    uint32_t q;
+
+    for (q = 0U; q < (uint32_t)RL_QUEUE_PAIR_COUNT; q++)
+    {
+        if ((rx_freed & (1UL << q)) != 0U)
+        {
+            virtqueue_kick(rpmsg_lite_dev->rvqs[q]);
+        }
+    }
+}
+#endif
+
+#if defined(RL_ALLOW_RX_ADAPTIVE_POLLING) && (RL_ALLOW_RX_ADAPTIVE_POLLING == 1)
+/*!
+ * @brief
+ * Suppresses the notifications of messages sent to the rvqs.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ *
+ */
+static void rpmsg_lite_rx_disable_cb(struct rpmsg_lite_instance *rpmsg_lite_dev)
+{
+    uint32_t q;
+
+    for (q = 0U; q < (uint32_t)RL_QUEUE_PAIR_COUNT; q++)
+    {
+        virtqueue_disable_cb(rpmsg_lite_dev->rvqs[q]);
+    }
+}
+
+/*!
+ * @brief
+ * Enables the notifications of messages sent to the rvqs again.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ *
+ * @return Non-zero when a message has been sent while the notifications were suppressed
+ *
+ */
+static int32_t rpmsg_lite_rx_enable_cb(struct rpmsg_lite_instance *rpmsg_lite_dev)
+{
+    int32_t pending = 0;
+    uint32_t q;
+
+    for (q = 0U; q < (uint32_t)RL_QUEUE_PAIR_COUNT; q++)
+    {
+        if (virtqueue_enable_cb(rpmsg_lite_dev->rvqs[q]) != 0)
+        {
+            pending = 1;
+        }
+    }
+
+    return pending;
+}
+#endif
+
+/*!
+ * @brief
+ * Called when remote side calls virtqueue_kick()
+ * at its transmit virtqueue.
+ * In this callback, the buffer is read-out
+ * of the rvq and user callback is called.
+ * All queue pairs share the notification, the rvqs
+ * of all of them are drained.
+ *
+ * @param vq  Virtqueue affected by the kick
+ *
+ */
+static void rpmsg_lite_rx_callback(struct virtqueue *vq)
+{
+    struct rpmsg_std_msg *rpmsg_msg = RL_NULL;
+    struct rpmsg_lite_endpoint *ept = RL_NULL;
+    uint32_t len;
+    uint16_t idx;
+    uint32_t queue;
+    uint32_t rx_freed = 0U;
+    struct rpmsg_lite_instance *rpmsg_lite_dev = (struct rpmsg_lite_instance *)vq->priv;
+#if (RL_VRING_BATCH_SIZE > 0)
+    struct rpmsg_lite_vq_batch rx_batch_buf;
+    struct rpmsg_lite_vq_batch *rx_batch = &rx_batch_buf;
+#else
+    struct rpmsg_lite_vq_batch *rx_batch = RL_NULL;
+#endif
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+    uint64_t start_time = RL_RX_ISR_TIMESTAMP();
+    uint64_t duration;
+    uint32_t rx_count = 0U;
+#endif
+#if defined(RL_ALLOW_RX_ADAPTIVE_POLLING) && (RL_ALLOW_RX_ADAPTIVE_POLLING == 1)
+    uint32_t pass_count = 0U;
+    uint32_t polling    = RL_FALSE;
+    uint32_t spin;
+#endif
+
+    RL_ASSERT(rpmsg_lite_dev != RL_NULL);
+
+    /* Until the master notifies the link up, the vrings may still hold the messages of a previous session,
+       the master sends only after that notification */
+    if (rpmsg_lite_dev->link_state == 0U)
+    {
+        return;
+    }
+
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+    /* The rx worker owns the rvq until it finds it empty */
+    if (rpmsg_lite_dev->rx_deferred == RL_TRUE)
+    {
+        return;
+    }
+#endif
+
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    env_lock_mutex(rpmsg_lite_dev->rx_lock);
+#endif
+
+#if defined(RL_ALLOW_RX_ADAPTIVE_POLLING) && (RL_ALLOW_RX_ADAPTIVE_POLLING == 1)
+    rpmsg_lite_dev->rx_irq_count++;
+#endif
+
+#if (RL_VRING_BATCH_SIZE > 0)
+    rx_batch_buf.count = 0U;
+#endif
+
+    /* Process the received data from remote node */
+    rpmsg_msg = rpmsg_lite_rx_get(rpmsg_lite_dev, &queue, &len, &idx);
+
+    while (rpmsg_msg != RL_NULL)
+    {
+        ept = rpmsg_lite_rx_get_endpoint(rpmsg_lite_dev, rpmsg_msg->hdr.dst);
+
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+#if defined(RL_ALLOW_MSG_PACKING) && (RL_ALLOW_MSG_PACKING == 1)
+        /* The endpoints of packed messages are not known before unpacking, leave them to the rx worker */
+        if (((ept != RL_NULL) && (ept->rx_in_isr != RL_TRUE)) || ((rpmsg_msg->hdr.flags & RL_MSG_FLAG_PACKED) != 0U))
+#else
+        if ((ept != RL_NULL) && (ept->rx_in_isr != RL_TRUE))
+#endif
+        {
+            /* Hand the message and the rest of the rvq over to the rx worker */
+#if (RL_VRING_BATCH_SIZE > 0)
+            rpmsg_lite_batch_flush(rpmsg_lite_dev, rx_batch);
+#endif
+            rpmsg_lite_dev->rx_carry_msg   = rpmsg_msg;
+            rpmsg_lite_dev->rx_carry_len   = len;
+            rpmsg_lite_dev->rx_carry_idx   = idx;
+            rpmsg_lite_dev->rx_carry_queue = queue;
+            rpmsg_lite_dev->rx_deferred    = RL_TRUE;
+            env_release_sync_lock(rpmsg_lite_dev->rx_worker_lock);
+            break;
+        }
+        rx_count++;
+#endif
+#if defined(RL_ALLOW_RX_ADAPTIVE_POLLING) && (RL_ALLOW_RX_ADAPTIVE_POLLING == 1)
+        rpmsg_lite_dev->rx_msg_count++;
+        pass_count++;
+#endif
+
+        if (rpmsg_lite_rx_dispatch(rpmsg_lite_dev, rpmsg_lite_dev->rvqs[queue], rx_batch, ept, rpmsg_msg, len, idx) ==
+            RL_TRUE)
+        {
+            rx_freed |= 1UL << queue;
+        }
+        rpmsg_msg = rpmsg_lite_rx_get(rpmsg_lite_dev, &queue, &len, &idx);
+
+#if defined(RL_ALLOW_RX_ADAPTIVE_POLLING) && (RL_ALLOW_RX_ADAPTIVE_POLLING == 1)
+        if (rpmsg_msg == RL_NULL)
+        {
+            if ((polling == RL_FALSE) && (pass_count > 1U))
+            {
+                /* Sustained traffic, suppress the notifications by the other side and poll the rvq */
+                rpmsg_lite_rx_disable_cb(rpmsg_lite_dev);
+                polling = RL_TRUE;
+            }
+
+            if (polling == RL_TRUE)
+            {
+#if (RL_VRING_BATCH_SIZE > 0)
+                rpmsg_lite_batch_flush(rpmsg_lite_dev, rx_batch);
+#endif
+#if defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
+                if (rx_freed != 0U)
+                {
+                    /* Return the buffers before spinning, the other side may be waiting for them */
+                    rpmsg_lite_rx_kick(rpmsg_lite_dev, rx_freed);
+                    rx_freed = 0U;
+                }
+#endif
+                for (spin = 0U; (spin < (uint32_t)RL_RX_POLL_SPIN_COUNT) && (rpmsg_msg == RL_NULL); spin++)
+                {
+                    rpmsg_msg = rpmsg_lite_rx_get(rpmsg_lite_dev, &queue, &len, &idx);
+                }
+
+                if (rpmsg_msg == RL_NULL)
+                {
+                    /* Idle, back to interrupts, re-check the rvq for messages sent while suppressed */
+                    polling    = RL_FALSE;
+                    pass_count = 0U;
+                    if (rpmsg_lite_rx_enable_cb(rpmsg_lite_dev) != 0)
+                    {
+                        rpmsg_msg = rpmsg_lite_rx_get(rpmsg_lite_dev, &queue, &len, &idx);
+                    }
+                }
+            }
+        }
+#endif
+    }
+
+#if defined(RL_ALLOW_RX_ADAPTIVE_POLLING) && (RL_ALLOW_RX_ADAPTIVE_POLLING == 1)
+    if (polling == RL_TRUE)
+    {
+        /* Left the loop with the rvq handed over to the rx worker */
+        (void)rpmsg_lite_rx_enable_cb(rpmsg_lite_dev);
+    }
+#endif
+
+#if (RL_VRING_BATCH_SIZE > 0)
+    rpmsg_lite_batch_flush(rpmsg_lite_dev, rx_batch);
+#endif
+
+#if defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
+    if (rx_freed != 0U)
+    {
+        /* Let the remote device know that some buffers have been freed */
+        rpmsg_lite_rx_kick(rpmsg_lite_dev, rx_freed);
+    }
+#else
+    (void)rx_freed;
+#endif
+
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    env_unlock_mutex(rpmsg_lite_dev->rx_lock);
+#endif
+
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    /* Grant the credits of the messages released by the rx callbacks */
+    rpmsg_lite_fc_send_queued(rpmsg_lite_dev);
+#endif
+
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+    duration = RL_RX_ISR_TIMESTAMP() - start_time;
+    if (duration > rpmsg_lite_dev->rx_isr_max_time)
+    {
+        rpmsg_lite_dev->rx_isr_max_time = duration;
+    }
+    if (rx_count > rpmsg_lite_dev->rx_isr_max_count)
+    {
+        rpmsg_lite_dev->rx_isr_max_count = rx_count;
+    }
+#endif
+}
+
+/*!
+ * @brief
+ * Called when remote side calls virtqueue_kick()
+ * at its receive virtqueue.
+ * All queue pairs share the notification.
+ *
+ * @param vq  Virtqueue affected by the kick
+ *
+ */
+static void rpmsg_lite_tx_callback(struct virtqueue *vq)
+{
+    struct rpmsg_lite_instance *rpmsg_lite_dev = (struct rpmsg_lite_instance *)vq->priv;
+    uint32_t q;
+
+    RL_ASSERT(rpmsg_lite_dev != RL_NULL);
+    for (q = 0U; (q < (uint32_t)RL_QUEUE_PAIR_COUNT) && (rpmsg_lite_dev->link_state == 0U); q++)
+    {
+        /* The master has just initialized the vrings, read our ring indexes again on their next use */
+        rpmsg_lite_dev->rvqs[q]->vq_flags &= ~(uint32_t)VIRTQUEUE_FLAG_PROD_IDX_VALID;
+        rpmsg_lite_dev->tvqs[q]->vq_flags &= ~(uint32_t)VIRTQUEUE_FLAG_PROD_IDX_VALID;
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+        /* The master has just initialized the vrings, the buffers may have moved */
+        virtqueue_reset_desc_shadow(rpmsg_lite_dev->rvqs[q]);
+        virtqueue_reset_desc_shadow(rpmsg_lite_dev->tvqs[q]);
+#endif
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+        /* Start producing on the vring as the master has just initialized it, nobody sends before the link is up */
+        (void)virtqueue_enable_multi_producer(rpmsg_lite_dev->tvqs[q]);
+#endif
+#if defined(RL_ALLOW_VRING_EVENT_IDX) && (RL_ALLOW_VRING_EVENT_IDX == 1)
+        /* The master has just initialized the vrings, advertise our event indexes again */
+        virtqueue_enable_event_idx(rpmsg_lite_dev->rvqs[q]);
+        virtqueue_enable_event_idx(rpmsg_lite_dev->tvqs[q]);
+#endif
+    }
+    rpmsg_lite_dev->link_state = 1U;
+    env_tx_callback(rpmsg_lite_dev->link_id);
+#if defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)
+    /* Report the tokens of the tx buffers the other side has consumed */
+    rpmsg_lite_tx_report(rpmsg_lite_dev);
+#endif
+#if defined(RL_ALLOW_ASYNC_SEND) && (RL_ALLOW_ASYNC_SEND == 1)
+    /* The pending asynchronous sends take the returned tx buffers first */
+    rpmsg_lite_async_drain(rpmsg_lite_dev);
+#endif
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    /* Credit messages that found no tx buffer in the rx path */
+    rpmsg_lite_fc_send_queued(rpmsg_lite_dev);
+#endif
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+    /* Tx buffers returned by the other side, wake up the first waiting sender of each tvq */
+    for (q = 0U; q < (uint32_t)RL_QUEUE_PAIR_COUNT; q++)
+    {
+        if (rpmsg_lite_dev->tx_waiters[q] != 0U)
+        {
+            env_release_sync_lock(rpmsg_lite_dev->tx_wait_lock[q]);
+        }
+    }
+#endif
+}
+
+/*!
+ * @brief
+ * Returns the length of the message held in the buffer, header and payload,
+ * the cache maintenance of the buffer is limited to it.
+ *
+ * @param buffer  Buffer holding the message
+ * @param len     Buffer length
+ *
+ * @return Message length, at most the buffer length
+ */
+static uint32_t rpmsg_lite_msg_len(const void *buffer, uint32_t len)
+{
+    uint32_t msg_len =
+        (uint32_t)sizeof(struct rpmsg_std_hdr) + (uint32_t)((const struct rpmsg_std_msg *)buffer)->hdr.len;
+
+    return (msg_len < len) ? msg_len : len;
+}
+
+/*!
+ * @brief
+ * Flushes the message to be sent, header and payload only.
+ *
+ * @param vq      Virtqueue the buffer is sent on
+ * @param buffer  Buffer holding the message
+ * @param len     Buffer length
+ *
+ */
+static void rpmsg_lite_cache_flush_msg(struct virtqueue *vq, void *buffer, uint32_t len)
+{
+    uint32_t msg_len = rpmsg_lite_msg_len(buffer, len);
+
+    env_cache_flush(buffer, msg_len);
+    RL_CACHE_COUNT(vq, tx_count, 1U);
+    RL_CACHE_COUNT(vq, flushed_bytes, msg_len);
+}
+
+/*!
+ * @brief
+ * Invalidates the received message, the header first to learn
+ * the payload length and then the payload only.
+ *
+ * @param vq      Virtqueue the buffer is received from
+ * @param buffer  Buffer holding the message
+ * @param len     Buffer length
+ *
+ */
+static void rpmsg_lite_cache_invalidate_msg(struct virtqueue *vq, void *buffer, uint32_t len)
+{
+    uint32_t msg_len;
+
+    env_cache_invalidate(buffer, (uint32_t)sizeof(struct rpmsg_std_hdr));
+    msg_len = rpmsg_lite_msg_len(buffer, len);
+    if (msg_len > (uint32_t)sizeof(struct rpmsg_std_hdr))
+    {
+        env_cache_invalidate((char *)buffer + sizeof(struct rpmsg_std_hdr),
+                             msg_len - (uint32_t)sizeof(struct rpmsg_std_hdr));
+    }
+    RL_CACHE_COUNT(vq, rx_count, 1U);
+    RL_CACHE_COUNT(vq, invalidated_bytes, msg_len);
+}
+
+#if defined(RL_CLEAR_USED_BUFFERS) && (RL_CLEAR_USED_BUFFERS == 1)
+/*!
+ * @brief
+ * Clears the received message before the buffer is returned to the other side.
+ * The rest of the buffer has been cleared already when it was used last time.
+ *
+ * @param vq      Virtqueue the buffer is returned to
+ * @param buffer  Buffer holding the message
+ * @param len     Buffer length
+ *
+ */
+static void rpmsg_lite_clear_msg(struct virtqueue *vq, void *buffer, uint32_t len)
+{
+    uint32_t msg_len = rpmsg_lite_msg_len(buffer, len);
+
+    env_memset(buffer, 0x00, msg_len);
+    env_cache_flush(buffer, msg_len);
+    RL_CACHE_COUNT(vq, flushed_bytes, msg_len);
+}
+#endif /* RL_CLEAR_USED_BUFFERS */
+
+/****************************************************************************
+
+ m    m  mmmm         m    m   mm   mm   m mmmm   m      mmmmm  mm   m   mmm
+ "m  m" m"  "m        #    #   ##   #"m  # #   "m #        #    #"m  # m"   "
+  #  #  #    #        #mmmm#  #  #  # #m # #    # #        #    # #m # #   mm
+  "mm"  #    #        #    #  #mm#  #  # # #    # #        #    #  # # #    #
+   ##    #mm#"        #    # #    # #   ## #mmm"  #mmmmm mm#mm  #   ##  "mmm"
+            #
+ In case this processor has the REMOTE role
+*****************************************************************************/
+/*!
+ * @brief
+ * Places buffer on the virtqueue for consumption by the other side.
+ *
+ * @param vq      Virtqueue to use
+ * @param buffer  Buffer pointer
+ * @param len     Buffer length
+ * @idx           Buffer index
+ *
+ * @return Status of function execution
+ *
+ */
+static void vq_tx_remote(struct virtqueue *tvq, void *buffer, uint32_t len, uint16_t idx)
+{
+    int32_t status;
+
+    rpmsg_lite_cache_flush_msg(tvq, buffer, len);
+
+    status = virtqueue_add_consumed_buffer(tvq, idx, len);
+    RL_ASSERT(status == VQUEUE_SUCCESS); /* must success here */
+
+    /* As long as the length of the virtqueue ring buffer is not shorter
+     * than the number of buffers in the pool, this function should not fail.
+     * This condition is always met, so we don't need to return anything here */
+}
+
+/*!
+ * @brief
+ * Provides buffer to transmit messages.
+ *
+ * @param vq      Virtqueue to use
+ * @param len     Length of returned buffer
+ * @param idx     Buffer index
+ *
+ * return Pointer to buffer.
+ */
+static void *vq_tx_alloc_remote(struct virtqueue *tvq, uint32_t *len, uint16_t *idx)
+{
+    void *data = RL_NULL;
+
+    data = virtqueue_get_available_buffer(tvq, idx, len);
+#if defined(RL_CLEAR_USED_BUFFERS) && (RL_CLEAR_USED_BUFFERS == 1)
+    /* The buffer is only written by this side, drop stale lines hiding the cleared content */
+    if (data != RL_NULL)
+    {
+        env_cache_invalidate(data, *len);
+    }
+#endif
+    return data;
+}
+
+/*!
+ * @brief
+ * Retrieves the received buffer from the virtqueue.
+ *
+ * @param vq   Virtqueue to use
+ * @param len  Size of received buffer
+ * @param idx  Index of buffer
+ *
+ * @return  Pointer to received buffer
+ *
+ */
+static void *vq_rx_remote(struct virtqueue *rvq, uint32_t *len, uint16_t *idx)
+{
+    void *data = RL_NULL;
+
+    data = virtqueue_get_available_buffer(rvq, idx, len);
+    if (data != RL_NULL)
+    {
+        rpmsg_lite_cache_invalidate_msg(rvq, data, *len);
+    }
+
+    return data;
+}
+
+/*!
+ * @brief
+ * Places the used buffer back on the virtqueue.
+ *
+ * @param vq   Virtqueue to use
+ * @param len  Size of received buffer
+ * @param idx  Index of buffer
+ *
+ */
+static void vq_rx_free_remote(struct virtqueue *rvq, void *buffer, uint32_t len, uint16_t idx)
+{
+    int32_t status;
+#if defined(RL_CLEAR_USED_BUFFERS) && (RL_CLEAR_USED_BUFFERS == 1)
+    rpmsg_lite_clear_msg(rvq, buffer, len);
+#endif
+    status = virtqueue_add_consumed_buffer(rvq, idx, len);
+    RL_ASSERT(status == VQUEUE_SUCCESS); /* must success here */
+                                         /* As long as the length of the virtqueue ring buffer is not shorter
+                                          * than the number of buffers in the pool, this function should not fail.
+                                          * This condition is always met, so we don't need to return anything here */
+}
+
+#if (RL_VRING_BATCH_SIZE > 0)
+/*!
+ * @brief
+ * Places a batch of sent or released buffers on the virtqueue
+ * for the other side, the messages have been flushed already.
+ *
+ * @param vq      Virtqueue to use
+ * @param elems   Buffer indexes and lengths
+ * @param count   Number of buffers
+ *
+ */
+static void vq_add_batch_remote(struct virtqueue *vq, const struct vring_used_elem *elems, uint16_t count)
+{
+    int32_t status;
+
+    status = virtqueue_add_consumed_buffers(vq, elems, count);
+    RL_ASSERT(status == VQUEUE_SUCCESS); /* must success here */
+}
+#endif /* RL_VRING_BATCH_SIZE */
+
+/****************************************************************************
+
+ m    m  mmmm         m    m   mm   mm   m mmmm   m      mmmmm  mm   m   mmm
+ "m  m" m"  "m        #    #   ##   #"m  # #   "m #        #    #"m  # m"   "
+  #  #  #    #        #mmmm#  #  #  # #m # #    # #        #    # #m # #   mm
+  "mm"  #    #        #    #  #mm#  #  # # #    # #        #    #  # # #    #
+   ##    #mm#"        #    # #    # #   ## #mmm"  #mmmmm mm#mm  #   ##  "mmm"
+            #
+ In case this processor has the MASTER role
+*****************************************************************************/
+
+/*!
+ * @brief
+ * Places buffer on the virtqueue for consumption by the other side.
+ *
+ * @param tvq     Virtqueue to use
+ * @param buffer  Buffer pointer
+ * @param len     Buffer length
+ * @param idx     Buffer index
+ *
+ * @return Status of function execution
+ *
+ */
+static void vq_tx_master(struct virtqueue *tvq, void *buffer, uint32_t len, uint16_t idx)
+{
+    int32_t status;
+
+    rpmsg_lite_cache_flush_msg(tvq, buffer, len);
+
+    status = virtqueue_add_buffer(tvq, idx);
+    RL_ASSERT(status == VQUEUE_SUCCESS); /* must success here */
+
+    /* As long as the length of the virtqueue ring buffer is not shorter
+     * than the number of buffers in the pool, this function should not fail.
+     * This condition is always met, so we don't need to return anything here */
+}
+
+/*!
+ * @brief
+ * Provides buffer to transmit messages.
+ *
+ * @param tvq     Virtqueue to use
+ * @param len     Length of returned buffer
+ * @param idx     Buffer index
+ *
+ * return Pointer to buffer.
+ */
+static void *vq_tx_alloc_master(struct virtqueue *tvq, uint32_t *len, uint16_t *idx)
+{
+    void *data = RL_NULL;
+
+    data = virtqueue_get_buffer(tvq, len, idx);
+#if defined(RL_CLEAR_USED_BUFFERS) && (RL_CLEAR_USED_BUFFERS == 1)
+    /* The buffer is only written by this side, drop stale lines hiding the cleared content */
+    if (data != RL_NULL)
+    {
+        env_cache_invalidate(data, *len);
+    }
+#endif
+
+    return data;
+}
+
+/*!
+ * @brief
+ * Retrieves the received buffer from the virtqueue.
+ *
+ * @param rvq  Virtqueue to use
+ * @param len  Size of received buffer
+ * @param idx  Index of buffer
+ *
+ * @return  Pointer to received buffer
+ *
+ */
+static void *vq_rx_master(struct virtqueue *rvq, uint32_t *len, uint16_t *idx)
+{
+    void *data = RL_NULL;
+
+    data = virtqueue_get_buffer(rvq, len, idx);
+
+    if (data != RL_NULL)
+    {
+        rpmsg_lite_cache_invalidate_msg(rvq, data, *len);
+    }
+
+    return data;
+}
+
+/*!
+ * @brief
+ * Places the used buffer back on the virtqueue.
+ *
+ * @param rvq    Virtqueue to use
+ * @param buffer Buffer pointer
+ * @param len    Size of received buffer
+ * @param idx    Index of buffer
+ *
+ */
+static void vq_rx_free_master(struct virtqueue *rvq, void *buffer, uint32_t len, uint16_t idx)
+{
+    int32_t status;
+#if defined(RL_CLEAR_USED_BUFFERS) && (RL_CLEAR_USED_BUFFERS == 1)
+    rpmsg_lite_clear_msg(rvq, buffer, len);
+#endif
+
+    status = virtqueue_add_buffer(rvq, idx);
+    RL_ASSERT(status == VQUEUE_SUCCESS); /* must success here */
+
+    /* As long as the length of the virtqueue ring buffer is not shorter
+     * than the number of buffers in the pool, this function should not fail.
+     * This condition is always met, so we don't need to return anything here */
+}
+
+#if (RL_VRING_BATCH_SIZE > 0)
+/*!
+ * @brief
+ * Places a batch of sent or released buffers on the virtqueue
+ * for the other side, the messages have been flushed already.
+ *
+ * @param vq      Virtqueue to use
+ * @param elems   Buffer indexes, the lengths are not used
+ * @param count   Number of buffers
+ *
+ */
+static void vq_add_batch_master(struct virtqueue *vq, const struct vring_used_elem *elems, uint16_t count)
+{
+    int32_t status;
+
+    status = virtqueue_add_buffers(vq, elems, count);
+    RL_ASSERT(status == VQUEUE_SUCCESS); /* must success here */
+}
+#endif /* RL_VRING_BATCH_SIZE */
+
+/* Interface used in case this processor is MASTER */
+static const struct virtqueue_ops master_vq_ops = {
+    vq_tx_master,
+    vq_tx_alloc_master,
+    vq_rx_master,
+    vq_rx_free_master,
+#if (RL_VRING_BATCH_SIZE > 0)
+    vq_add_batch_master,
+#endif
+};
+
+/* Interface used in case this processor is REMOTE */
+static const struct virtqueue_ops remote_vq_ops = {
+    vq_tx_remote,
+    vq_tx_alloc_remote,
+    vq_rx_remote,
+    vq_rx_free_remote,
+#if (RL_VRING_BATCH_SIZE > 0)
+    vq_add_batch_remote,
+#endif
+};
+
+/* helper function for virtqueue notification */
+static void virtqueue_notify(struct virtqueue *vq)
+{
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    struct rpmsg_lite_instance *inst = vq->priv;
+    platform_notify(inst->env ? env_get_platform_context(inst->env) : RL_NULL, vq->vq_queue_index);
+#else
+    platform_notify(vq->vq_queue_index);
+#endif
+}
+
+/*************************************************
+
+ mmmmmm mmmmm mmmmmmm        mm   m mmmmmmm     m
+ #      #   "#   #           #"m  # #     #  #  #
+ #mmmmm #mmm#"   #           # #m # #mmmmm" #"# #
+ #      #        #           #  # # #      ## ##"
+ #mmmmm #        #           #   ## #mmmmm #   #
+
+**************************************************/
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+struct rpmsg_lite_endpoint *rpmsg_lite_create_ept(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                                  uint32_t addr,
+                                                  rl_ept_rx_cb_t rx_cb,
+                                                  void *rx_cb_data,
+                                                  struct rpmsg_lite_ept_static_context *ept_context)
+#else
+struct rpmsg_lite_endpoint *rpmsg_lite_create_ept(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                                  uint32_t addr,
+                                                  rl_ept_rx_cb_t rx_cb,
+                                                  void *rx_cb_data)
+#endif
+{
+    struct rpmsg_lite_endpoint *rl_ept;
+    struct llist *node;
+
+    if (rpmsg_lite_dev == RL_NULL)
+    {
+        return RL_NULL;
+    }
+
+    env_lock_mutex(rpmsg_lite_dev->lock);
+    {
+        if (addr == RL_ADDR_ANY)
+        {
+            /* find lowest free address */
+            addr = rpmsg_lite_get_free_addr(rpmsg_lite_dev);
+            /*
+            * $Branch Coverage Justification$
+            * Not able to reach the true condition,
+            * not possible to use all 2^32 endpoints/addresses.
+            */
+            if (addr == RL_ADDR_ANY) /* GCOVR_EXCL_BR_LINE */
+            {
+                /* no address is free, cannot happen normally */
+                /*
+                 * $Line Coverage Justification$
+                 * Lines never reached, not possible to use all 2^32 endpoints/addresses.
+                 */
+                env_unlock_mutex(rpmsg_lite_dev->lock); /* GCOVR_EXCL_LINE */
+                return RL_NULL; /* GCOVR_EXCL_LINE */
+            }
+        }
+        else
+        {
+            if (rpmsg_lite_get_endpoint_from_addr(rpmsg_lite_dev, addr) != RL_NULL)
+            {
+                /* Already exists! */
+                env_unlock_mutex(rpmsg_lite_dev->lock);
+                return RL_NULL;
+            }
+        }
+
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+        if (ept_context == RL_NULL)
+        {
+            env_unlock_mutex(rpmsg_lite_dev->lock);
+            return RL_NULL;
+        }
+
+        rl_ept = &(ept_context->ept);
+        node   = &(ept_context->node);
+#else
+        rl_ept = env_allocate_memory(sizeof(struct rpmsg_lite_endpoint));
+        if (rl_ept == RL_NULL)
+        {
+            env_unlock_mutex(rpmsg_lite_dev->lock);
+            return RL_NULL;
+        }
+        node = env_allocate_memory(sizeof(struct llist));
+        if (node == RL_NULL)
+        {
+            env_free_memory(rl_ept);
+            env_unlock_mutex(rpmsg_lite_dev->lock);
+            return RL_NULL;
+        }
+#endif /* RL_USE_STATIC_API */
+
+        env_memset(rl_ept, 0x00, sizeof(struct rpmsg_lite_endpoint));
+
+        rl_ept->addr       = addr;
+        rl_ept->rx_cb      = rx_cb;
+        rl_ept->rx_cb_data = rx_cb_data;
+
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+        rl_ept->fc_peer     = RL_ADDR_ANY;
+        rl_ept->fc_sync_src = RL_ADDR_ANY;
+        if (rpmsg_lite_fc_create_locks(rl_ept) != RL_SUCCESS)
+        {
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+            env_free_memory(node);
+            env_free_memory(rl_ept);
+#endif
+            env_unlock_mutex(rpmsg_lite_dev->lock);
+            return RL_NULL;
+        }
+#endif
+
+        node->data = rl_ept;
+
+        add_to_list((struct llist **)&rpmsg_lite_dev->rl_endpoints, node);
+#if (RL_EPT_TABLE_DIRECT_SIZE > 0) || (RL_EPT_TABLE_HASH_SIZE > 0)
+        rpmsg_lite_ept_table_add(rpmsg_lite_dev, node);
+#endif
+    }
+    env_unlock_mutex(rpmsg_lite_dev->lock);
+
+    return rl_ept;
+}
+
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+/*!
+ * @brief
+ * Internal function to hand the tx buffers of an endpoint being
+ * destroyed over to the shared pool, together with its reservation.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Endpoint being destroyed
+ *
+ */
+static void rpmsg_lite_tx_quota_drop_ept(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_lite_endpoint *ept)
+{
+    uint32_t idx;
+
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    /* The buffers in flight come back after the endpoint is gone */
+    for (idx = 0U; idx < (uint32_t)RL_BUFFER_COUNT; idx++)
+    {
+        if (rpmsg_lite_dev->tx_owner[idx] == ept)
+        {
+            rpmsg_lite_dev->tx_owner[idx] = RL_NULL;
+        }
+    }
+    rpmsg_lite_dev->tx_shared_used += (ept->tx_in_flight < ept->tx_reserved) ? ept->tx_in_flight : ept->tx_reserved;
+    rpmsg_lite_dev->tx_reserved -= ept->tx_reserved;
+    ept->tx_reserved  = 0U;
+    ept->tx_in_flight = 0U;
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+}
+#endif /* RL_ALLOW_TX_QUOTA */
+
+/*************************************************
+
+ mmmmmm mmmmm mmmmmmm        mmmm   mmmmmm m
+ #      #   "#   #           #   "m #      #
+ #mmmmm #mmm#"   #           #    # #mmmmm #
+ #      #        #           #    # #      #
+ #mmmmm #        #           #mmm"  #mmmmm #mmmmm
+
+**************************************************/
+
+int32_t rpmsg_lite_destroy_ept(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_lite_endpoint *rl_ept)
+{
+    struct llist *node;
+
+    if (rpmsg_lite_dev == RL_NULL)
+    {
+        return RL_ERR_PARAM;
+    }
+
+    if (rl_ept == RL_NULL)
+    {
+        return RL_ERR_PARAM;
+    }
+
+#if defined(RL_ALLOW_TX_STASH) && (RL_ALLOW_TX_STASH == 1)
+    (void)rpmsg_lite_flush_ept_tx_stash(rpmsg_lite_dev, rl_ept);
+#endif
+#if defined(RL_ALLOW_ASYNC_SEND) && (RL_ALLOW_ASYNC_SEND == 1)
+    rpmsg_lite_async_drop(rpmsg_lite_dev, rl_ept);
+#endif
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+    rpmsg_lite_tx_quota_drop_ept(rpmsg_lite_dev, rl_ept);
+#endif
+
+    env_lock_mutex(rpmsg_lite_dev->lock);
+    node = rpmsg_lite_get_endpoint_from_addr(rpmsg_lite_dev, rl_ept->addr);
+    if (node != RL_NULL)
+    {
+#if (RL_EPT_TABLE_DIRECT_SIZE > 0) || (RL_EPT_TABLE_HASH_SIZE > 0)
+        rpmsg_lite_ept_table_remove(rpmsg_lite_dev, node);
+#endif
+        remove_from_list((struct llist **)&rpmsg_lite_dev->rl_endpoints, node);
+        env_unlock_mutex(rpmsg_lite_dev->lock);
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+        rpmsg_lite_fc_unqueue_credit(rpmsg_lite_dev, rl_ept);
+        env_delete_sync_lock(rl_ept->fc_wait_lock);
+        env_delete_mutex(rl_ept->fc_lock);
+#endif
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+        env_free_memory(node);
+        env_free_memory(rl_ept);
+#endif
+        return RL_SUCCESS;
+    }
+    else
+    {
+        env_unlock_mutex(rpmsg_lite_dev->lock);
+        return RL_ERR_PARAM;
+    }
+}
+
+/******************************************
+
+mmmmmmm m    m          mm   mmmmm  mmmmm
+   #     #  #           ##   #   "#   #
+   #      ##           #  #  #mmm#"   #
+   #     m""m          #mm#  #        #
+   #    m"  "m        #    # #      mm#mm
+
+*******************************************/
+
+uint32_t rpmsg_lite_is_link_up(struct rpmsg_lite_instance *rpmsg_lite_dev)
+{
+    if (rpmsg_lite_dev == RL_NULL)
+    {
+        return 0U;
+    }
+
+    return (RL_TRUE == rpmsg_lite_dev->link_state ? RL_TRUE : RL_FALSE);
+}
+
+uint32_t rpmsg_lite_wait_for_link_up(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t timeout)
+{
+    if (rpmsg_lite_dev == RL_NULL)
+    {
+        return 0U;
+    }
+
+    return env_wait_for_link_up(&rpmsg_lite_dev->link_state, rpmsg_lite_dev->link_id, timeout);
+}
+
+#if defined(RL_ALLOW_RX_ADAPTIVE_POLLING) && (RL_ALLOW_RX_ADAPTIVE_POLLING == 1)
+int32_t rpmsg_lite_get_rx_counters(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                   uint32_t *irq_count,
+                                   uint32_t *msg_count)
+{
+    if ((rpmsg_lite_dev == RL_NULL) || (irq_count == RL_NULL) || (msg_count == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    *irq_count = rpmsg_lite_dev->rx_irq_count;
+    *msg_count = rpmsg_lite_dev->rx_msg_count;
+
+    return RL_SUCCESS;
+}
+#endif /* defined(RL_ALLOW_RX_ADAPTIVE_POLLING) && (RL_ALLOW_RX_ADAPTIVE_POLLING == 1) */
+
+#if defined(RL_ALLOW_CACHE_COUNTERS) && (RL_ALLOW_CACHE_COUNTERS == 1)
+int32_t rpmsg_lite_get_cache_counters(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                      struct rpmsg_lite_cache_counters *counters)
+{
+    if ((rpmsg_lite_dev == RL_NULL) || (counters == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    env_lock_mutex(rpmsg_lite_dev->rx_lock);
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    *counters = rpmsg_lite_dev->cache_counters;
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+    env_unlock_mutex(rpmsg_lite_dev->rx_lock);
+
+    return RL_SUCCESS;
+}
+#endif /* defined(RL_ALLOW_CACHE_COUNTERS) && (RL_ALLOW_CACHE_COUNTERS == 1) */
+
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+int32_t rpmsg_lite_rx_worker(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t budget, uintptr_t timeout)
+{
+    struct rpmsg_std_msg *rpmsg_msg;
+    struct rpmsg_lite_endpoint *ept;
+    uint32_t len;
+    uint16_t idx;
+    uint32_t queue;
+    uint32_t count    = 0U;
+    uint32_t rx_freed = 0U;
+#if (RL_VRING_BATCH_SIZE > 0)
+    struct rpmsg_lite_vq_batch rx_batch_buf;
+    struct rpmsg_lite_vq_batch *rx_batch = &rx_batch_buf;
+#else
+    struct rpmsg_lite_vq_batch *rx_batch = RL_NULL;
+#endif
+
+    if (rpmsg_lite_dev == RL_NULL)
+    {
+        return RL_ERR_PARAM;
+    }
+
+    if (env_acquire_sync_lock(rpmsg_lite_dev->rx_worker_lock, timeout) != 0)
+    {
+        return RL_ERR_NO_BUFF;
+    }
+
+    env_lock_mutex(rpmsg_lite_dev->rx_lock);
+    rpmsg_msg                    = rpmsg_lite_dev->rx_carry_msg;
+    len                          = rpmsg_lite_dev->rx_carry_len;
+    idx                          = rpmsg_lite_dev->rx_carry_idx;
+    queue                        = rpmsg_lite_dev->rx_carry_queue;
+    rpmsg_lite_dev->rx_carry_msg = RL_NULL;
+#if (RL_VRING_BATCH_SIZE > 0)
+    rx_batch_buf.count = 0U;
+#endif
+
+    for (;;)
+    {
+        if (rpmsg_msg == RL_NULL)
+        {
+#if (RL_VRING_BATCH_SIZE > 0)
+            rpmsg_lite_batch_flush(rpmsg_lite_dev, rx_batch);
+#endif
+            /* Return the rvq to the ISR once empty, checked with the interrupt masked to not miss
+             * a message whose notification was ignored while the rvq was owned by the worker */
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+            env_disable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->rvq->vq_queue_index);
+#else
+            env_disable_interrupt(rpmsg_lite_dev->rvq->vq_queue_index);
+#endif
+            rpmsg_msg = rpmsg_lite_rx_get(rpmsg_lite_dev, &queue, &len, &idx);
+            if (rpmsg_msg == RL_NULL)
+            {
+                rpmsg_lite_dev->rx_deferred = RL_FALSE;
+            }
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+            env_enable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->rvq->vq_queue_index);
+#else
+            env_enable_interrupt(rpmsg_lite_dev->rvq->vq_queue_index);
+#endif
+            if (rpmsg_msg == RL_NULL)
+            {
+                break;
+            }
+        }
+
+        ept = rpmsg_lite_rx_get_endpoint(rpmsg_lite_dev, rpmsg_msg->hdr.dst);
+        /* The rx_cb is free to call the rpmsg_lite API */
+        env_unlock_mutex(rpmsg_lite_dev->rx_lock);
+        if (rpmsg_lite_rx_dispatch(rpmsg_lite_dev, rpmsg_lite_dev->rvqs[queue], rx_batch, ept, rpmsg_msg, len, idx) ==
+            RL_TRUE)
+        {
+            rx_freed |= 1UL << queue;
+        }
+        count++;
+        env_lock_mutex(rpmsg_lite_dev->rx_lock);
+
+        if ((budget != 0U) && (count >= budget))
+        {
+            /* Budget spent, keep the rvq and run again in the next call */
+#if (RL_VRING_BATCH_SIZE > 0)
+            rpmsg_lite_batch_flush(rpmsg_lite_dev, rx_batch);
+#endif
+            env_release_sync_lock(rpmsg_lite_dev->rx_worker_lock);
+            break;
+        }
+
+        rpmsg_msg = rpmsg_lite_rx_get(rpmsg_lite_dev, &queue, &len, &idx);
+    }
+
+#if defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
+    if (rx_freed != 0U)
+    {
+        /* Let the remote device know that some buffers have been freed */
+        rpmsg_lite_rx_kick(rpmsg_lite_dev, rx_freed);
+    }
+#else
+    (void)rx_freed;
+#endif
+    env_unlock_mutex(rpmsg_lite_dev->rx_lock);
+
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    rpmsg_lite_fc_send_queued(rpmsg_lite_dev);
+#endif
+
+    return RL_SUCCESS;
+}
+
+int32_t rpmsg_lite_set_ept_rx_in_isr(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                     struct rpmsg_lite_endpoint *ept,
+                                     uint32_t rx_in_isr)
+{
+    if ((rpmsg_lite_dev == RL_NULL) || (ept == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    env_lock_mutex(rpmsg_lite_dev->lock);
+    ept->rx_in_isr = (rx_in_isr == RL_TRUE) ? RL_TRUE : RL_FALSE;
+    env_unlock_mutex(rpmsg_lite_dev->lock);
+
+    return RL_SUCCESS;
+}
+
+int32_t rpmsg_lite_get_rx_isr_stats(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                    uint32_t *max_count,
+                                    uint64_t *max_time)
+{
+    if ((rpmsg_lite_dev == RL_NULL) || (max_count == RL_NULL) || (max_time == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    env_disable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->rvq->vq_queue_index);
+#else
+    env_disable_interrupt(rpmsg_lite_dev->rvq->vq_queue_index);
+#endif
+    *max_count                       = rpmsg_lite_dev->rx_isr_max_count;
+    *max_time                        = rpmsg_lite_dev->rx_isr_max_time;
+    rpmsg_lite_dev->rx_isr_max_count = 0U;
+    rpmsg_lite_dev->rx_isr_max_time  = 0U;
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    env_enable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->rvq->vq_queue_index);
+#else
+    env_enable_interrupt(rpmsg_lite_dev->rvq->vq_queue_index);
+#endif
+
+    return RL_SUCCESS;
+}
+#endif /* defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1) */
+
+/*!
+ * @brief
+ * Internal function to notify the other side about
+ * the messages enqueued on the tvq, called with the lock held.
+ * With the deferred notification enabled the kick is postponed
+ * until the count or time threshold is reached unless forced.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param queue             Queue pair of the tvq
+ * @param force             RL_TRUE to notify regardless of the thresholds
+ *
+ */
+static void rpmsg_lite_notify_tx(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t queue, uint32_t force)
+{
+    struct virtqueue *tvq = rpmsg_lite_dev->tvqs[queue];
+#if defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1)
+    uint64_t now;
+    uint64_t elapsed_us;
+#endif
+
+#if !(defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1))
+    /* Nothing enqueued since the last notification, the multi producer kick checks the ring index instead */
+    if ((uint32_t)tvq->vq_queued_cnt == 0U)
+    {
+        return;
+    }
+#endif
+
+#if defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1)
+    if ((force == RL_FALSE) && (rpmsg_lite_dev->notify_threshold > 1U))
+    {
+        now = env_get_timestamp();
+        if (rpmsg_lite_dev->notify_pending == RL_FALSE)
+        {
+            rpmsg_lite_dev->notify_pending       = RL_TRUE;
+            rpmsg_lite_dev->notify_pending_since = now;
+            if (rpmsg_lite_dev->notify_deadline_us != 0U)
+            {
+                /* Let rpmsg_lite_notify_worker() keep the deadline if no other message is sent */
+                env_release_sync_lock(rpmsg_lite_dev->notify_worker_lock);
+            }
+        }
+        elapsed_us = env_timestamp_to_usec(now - rpmsg_lite_dev->notify_pending_since);
+        if (((uint32_t)tvq->vq_queued_cnt < rpmsg_lite_dev->notify_threshold) &&
+            ((rpmsg_lite_dev->notify_deadline_us == 0U) || (elapsed_us < rpmsg_lite_dev->notify_deadline_us)))
+        {
+            return;
+        }
+    }
+    rpmsg_lite_dev->notify_pending = RL_FALSE;
+    rpmsg_lite_dev->notify_kick_count++;
+    rpmsg_lite_dev->notify_msg_count += (uint32_t)tvq->vq_queued_cnt;
+#else
+    (void)force;
+#endif /* defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1) */
+
+    /* Let the other side know that there is a job to process. */
+    virtqueue_kick(tvq);
+}
+
+#if defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1)
+int32_t rpmsg_lite_set_notify_threshold(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                        uint32_t count,
+                                        uint32_t deadline_us)
+{
+    uint32_t queue;
+
+    if (rpmsg_lite_dev == RL_NULL)
+    {
+        return RL_ERR_PARAM;
+    }
+
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    /* More pending messages than tx buffers would never reach the count */
+    if (count > (uint32_t)rpmsg_lite_dev->tvq->vq_nentries)
+    {
+        count = (uint32_t)rpmsg_lite_dev->tvq->vq_nentries;
+    }
+    rpmsg_lite_dev->notify_threshold   = count;
+    rpmsg_lite_dev->notify_deadline_us = deadline_us;
+    /* Notify messages deferred under the previous setting */
+    for (queue = 0U; queue < (uint32_t)RL_QUEUE_PAIR_COUNT; queue++)
+    {
+        rpmsg_lite_notify_tx(rpmsg_lite_dev, queue, RL_FALSE);
+    }
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+    return RL_SUCCESS;
+}
+
+int32_t rpmsg_lite_flush(struct rpmsg_lite_instance *rpmsg_lite_dev)
+{
+    uint32_t queue;
+
+    if (rpmsg_lite_dev == RL_NULL)
+    {
+        return RL_ERR_PARAM;
+    }
+
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    for (queue = 0U; queue < (uint32_t)RL_QUEUE_PAIR_COUNT; queue++)
+    {
+        rpmsg_lite_notify_tx(rpmsg_lite_dev, queue, RL_TRUE);
+    }
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+    return RL_SUCCESS;
+}
+
+int32_t rpmsg_lite_notify_worker(struct rpmsg_lite_instance *rpmsg_lite_dev, uintptr_t timeout)
+{
+    uint64_t elapsed_us;
+    uint32_t queue;
+
+    if (rpmsg_lite_dev == RL_NULL)
+    {
+        return RL_ERR_PARAM;
+    }
+
+    if (env_acquire_sync_lock(rpmsg_lite_dev->notify_worker_lock, timeout) != 0)
+    {
+        return RL_ERR_NO_BUFF;
+    }
+
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    /* Messages sent meanwhile may have reached the count threshold and notified already */
+    while ((rpmsg_lite_dev->notify_pending == RL_TRUE) && (rpmsg_lite_dev->notify_deadline_us != 0U))
+    {
+        elapsed_us = env_timestamp_to_usec(env_get_timestamp() - rpmsg_lite_dev->notify_pending_since);
+        if (elapsed_us >= rpmsg_lite_dev->notify_deadline_us)
+        {
+            for (queue = 0U; queue < (uint32_t)RL_QUEUE_PAIR_COUNT; queue++)
+            {
+                rpmsg_lite_notify_tx(rpmsg_lite_dev, queue, RL_TRUE);
+            }
+            rpmsg_lite_dev->notify_pending = RL_FALSE;
+            break;
+        }
+        /* Sleep until the deadline without the tx lock, the senders go on meanwhile */
+        RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+        env_sleep_msec((uint32_t)((rpmsg_lite_dev->notify_deadline_us - elapsed_us + 999U) / 1000U));
+        RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    }
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+    return RL_SUCCESS;
+}
+
+int32_t rpmsg_lite_get_notify_counters(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                       uint32_t *kick_count,
+                                       uint32_t *msg_count)
+{
+    if ((rpmsg_lite_dev == RL_NULL) || (kick_count == RL_NULL) || (msg_count == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    *kick_count = rpmsg_lite_dev->notify_kick_count;
+    *msg_count  = rpmsg_lite_dev->notify_msg_count;
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+    return RL_SUCCESS;
+}
+#endif /* defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1) */
+
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+/*!
+ * @brief
+ * Internal function to check the quota of a sender before it takes
+ * a tx buffer, called with the tx lock held.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Sender endpoint, RL_NULL for the buffers taken without an endpoint
+ *
+ * @return  RL_TRUE when the sender may take a buffer
+ *
+ */
+static uint32_t rpmsg_lite_tx_quota_admit(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                          const struct rpmsg_lite_endpoint *ept)
+{
+    uint32_t shared = (uint32_t)rpmsg_lite_dev->tvq->vq_nentries - rpmsg_lite_dev->tx_reserved;
+
+    if (ept != RL_NULL)
+    {
+        if ((ept->tx_max != 0U) && (ept->tx_in_flight >= ept->tx_max))
+        {
+            return RL_FALSE;
+        }
+        if (ept->tx_in_flight < ept->tx_reserved)
+        {
+            return RL_TRUE;
+        }
+    }
+
+    /* Beyond its reservation the sender takes the buffers nobody reserved */
+    return (rpmsg_lite_dev->tx_shared_used < shared) ? RL_TRUE : RL_FALSE;
+}
+
+/*!
+ * @brief
+ * Internal function to charge a tx buffer to its sender,
+ * called with the tx lock held.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Sender endpoint, RL_NULL for the buffers taken without an endpoint
+ * @param idx               Buffer index
+ *
+ */
+static void rpmsg_lite_tx_quota_charge(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                       struct rpmsg_lite_endpoint *ept,
+                                       uint16_t idx)
+{
+    RL_ASSERT(idx < (uint16_t)RL_BUFFER_COUNT);
+    if ((ept == RL_NULL) || (ept->tx_in_flight >= ept->tx_reserved))
+    {
+        rpmsg_lite_dev->tx_shared_used++;
+    }
+    if (ept != RL_NULL)
+    {
+        ept->tx_in_flight++;
+    }
+    rpmsg_lite_dev->tx_owner[idx] = ept;
+    rpmsg_lite_dev->tx_charged[idx / 32U] |= 1UL << (idx % 32U);
+}
+
+/*!
+ * @brief
+ * Internal function to credit a tx buffer returned by the other side
+ * to its sender, called with the tx lock held.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param idx               Buffer index
+ *
+ */
+static void rpmsg_lite_tx_quota_credit(struct rpmsg_lite_instance *rpmsg_lite_dev, uint16_t idx)
+{
+    struct rpmsg_lite_endpoint *ept;
+
+    RL_ASSERT(idx < (uint16_t)RL_BUFFER_COUNT);
+    /* The buffers handed over by the vring initialization were never charged */
+    if ((rpmsg_lite_dev->tx_charged[idx / 32U] & (1UL << (idx % 32U))) == 0U)
+    {
+        return;
+    }
+
+    rpmsg_lite_dev->tx_charged[idx / 32U] &= ~(1UL << (idx % 32U));
+    ept = rpmsg_lite_dev->tx_owner[idx];
+    if ((ept == RL_NULL) || (ept->tx_in_flight > ept->tx_reserved))
+    {
+        rpmsg_lite_dev->tx_shared_used--;
+    }
+    if (ept != RL_NULL)
+    {
+        ept->tx_in_flight--;
+    }
+}
+
+/*!
+ * @brief
+ * Internal function to count a buffer request of the endpoint refused
+ * by its quota, called with the tx lock held after a failed rpmsg_lite_tx_alloc().
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Sender endpoint
+ *
+ */
+static void rpmsg_lite_tx_quota_denied(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_lite_endpoint *ept)
+{
+    /* Buffers left free, the quota has refused the request */
+    if ((ept != RL_NULL) && (rpmsg_lite_dev->tx_free_cnt != 0U))
+    {
+        ept->tx_denied++;
+    }
+}
+#endif /* RL_ALLOW_TX_QUOTA */
+
+#if defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)
+/*!
+ * @brief
+ * Internal function to queue the report of the token of a tx buffer
+ * returned by the other side, called with the tx lock held.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param idx               Buffer index
+ *
+ */
+static void rpmsg_lite_tx_token_consumed(struct rpmsg_lite_instance *rpmsg_lite_dev, uint16_t idx)
+{
+    struct rpmsg_lite_tx_report *report;
+    void *token;
+
+    RL_ASSERT(idx < (uint16_t)RL_BUFFER_COUNT);
+    token = rpmsg_lite_dev->tx_token[idx];
+    if (token == RL_NULL)
+    {
+        return;
+    }
+
+    rpmsg_lite_dev->tx_token[idx] = RL_NULL;
+    if (rpmsg_lite_dev->tx_consumed_cb == RL_NULL)
+    {
+        return;
+    }
+
+    report = &rpmsg_lite_dev->tx_report[(rpmsg_lite_dev->tx_report_head + rpmsg_lite_dev->tx_report_cnt) %
+                                        (uint32_t)RL_BUFFER_COUNT];
+    report->token       = token;
+    report->sent_at     = rpmsg_lite_dev->tx_sent_at[idx];
+    report->consumed_at = env_get_timestamp();
+    rpmsg_lite_dev->tx_report_cnt++;
+}
+#endif /* RL_ALLOW_TX_TOKENS */
+
+#if (defined(RL_ALLOW_TX_LIFO) && (RL_ALLOW_TX_LIFO == 1)) || (defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)) || \
+    (defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1))
+/*!
+ * @brief
+ * Internal function to move the tx buffers returned by the other side
+ * from the tvq to the tx_free stack, the last returned one ends on top.
+ * Called with the tx lock held.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param queue             Queue pair of the tvq
+ *
+ */
+static void rpmsg_lite_tx_reclaim(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t queue)
+{
+    struct rpmsg_lite_tx_buffer *entry;
+
+    while (rpmsg_lite_dev->tx_free_cnt < (uint32_t)RL_BUFFER_COUNT)
+    {
+#if defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)
+        /* Leave the buffers in the tvq until the reports are taken, none is lost */
+        if (rpmsg_lite_dev->tx_report_cnt >= (uint32_t)RL_BUFFER_COUNT)
+        {
+            break;
+        }
+#endif
+        entry      = &rpmsg_lite_dev->tx_free[rpmsg_lite_dev->tx_free_cnt];
+        entry->buf = rpmsg_lite_dev->vq_ops->vq_tx_alloc(rpmsg_lite_dev->tvqs[queue], &entry->len, &entry->idx);
+        if (entry->buf == RL_NULL)
+        {
+            break;
+        }
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+        rpmsg_lite_tx_quota_credit(rpmsg_lite_dev, entry->idx);
+#endif
+#if defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)
+        rpmsg_lite_tx_token_consumed(rpmsg_lite_dev, entry->idx);
+#endif
+        rpmsg_lite_dev->tx_free_cnt++;
+    }
+}
+#endif
+
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+/*!
+ * @brief
+ * Internal function to check whether a sender has to queue behind the senders
+ * waiting for a tx buffer, called with the tx lock held.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Sender endpoint, RL_NULL for the buffers taken without an endpoint
+ * @param queue             Queue pair of the tvq
+ *
+ * @return  RL_TRUE when the sender must not overtake the waiting senders
+ *
+ */
+static uint32_t rpmsg_lite_tx_must_queue(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                         const struct rpmsg_lite_endpoint *ept,
+                                         uint32_t queue)
+{
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+    /* The waiting senders cannot take the buffers reserved for the endpoint,
+       credit the returned ones first to see whether one of them is free */
+    if ((ept != RL_NULL) && (ept->tx_reserved != 0U))
+    {
+        rpmsg_lite_tx_reclaim(rpmsg_lite_dev, queue);
+        if (ept->tx_in_flight < ept->tx_reserved)
+        {
+            return RL_FALSE;
+        }
+    }
+#else
+    (void)ept;
+#endif
+
+    return (rpmsg_lite_dev->tx_waiters[queue] != 0U) ? RL_TRUE : RL_FALSE;
+}
+#endif
+
+/*!
+ * @brief
+ * Internal function to take a free tx buffer,
+ * called with the tx lock held.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Sender endpoint, RL_NULL for the buffers taken without an endpoint
+ * @param queue             Queue pair of the tvq
+ * @param len               Pointer to store the buffer length
+ * @param idx               Pointer to store the buffer index
+ *
+ * @return  Buffer pointer, RL_NULL when no buffer available
+ *
+ */
+static void *rpmsg_lite_tx_alloc(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                 struct rpmsg_lite_endpoint *ept,
+                                 uint32_t queue,
+                                 uint32_t *len,
+                                 uint16_t *idx)
+{
+#if (defined(RL_ALLOW_TX_STASH) && (RL_ALLOW_TX_STASH == 1)) ||                                                  \
+    (defined(RL_ALLOW_TX_LIFO) && (RL_ALLOW_TX_LIFO == 1)) || (defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)) || \
+    (defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1))
+    struct rpmsg_lite_tx_buffer *entry;
+
+#if (defined(RL_ALLOW_TX_LIFO) && (RL_ALLOW_TX_LIFO == 1)) || (defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)) || \
+    (defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1))
+    rpmsg_lite_tx_reclaim(rpmsg_lite_dev, queue);
+#endif
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+    /* All the returned buffers are on the stack now */
+    if ((rpmsg_lite_dev->tx_free_cnt == 0U) || (rpmsg_lite_tx_quota_admit(rpmsg_lite_dev, ept) == RL_FALSE))
+    {
+        return RL_NULL;
+    }
+#else
+    (void)ept;
+#endif
+
+    /* The most recently used buffer goes first */
+    if (rpmsg_lite_dev->tx_free_cnt != 0U)
+    {
+        rpmsg_lite_dev->tx_free_cnt--;
+        entry = &rpmsg_lite_dev->tx_free[rpmsg_lite_dev->tx_free_cnt];
+        *len  = entry->len;
+        *idx  = entry->idx;
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+        rpmsg_lite_tx_quota_charge(rpmsg_lite_dev, ept, entry->idx);
+#endif
+        return entry->buf;
+    }
+#if defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)
+    /* The buffers left in the tvq wait for the reports of the consumed tokens */
+    return RL_NULL;
+#endif
+#else
+    (void)ept;
+#endif
+
+    return rpmsg_lite_dev->vq_ops->vq_tx_alloc(rpmsg_lite_dev->tvqs[queue], len, idx);
+}
+
+/*!
+ * @brief
+ * Internal function to get a free tx buffer, waits
+ * for the buffer up to the given timeout.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Sender endpoint, RL_NULL for the buffers taken without an endpoint
+ * @param queue             Queue pair of the tvq
+ * @param len               Pointer to store the buffer length
+ * @param idx               Pointer to store the buffer index
+ * @param timeout           Timeout in ms, 0 if nonblocking
+ *
+ * @return  Buffer pointer, RL_NULL when no buffer available within the timeout
+ *
+ */
+static void *rpmsg_lite_get_tx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                      struct rpmsg_lite_endpoint *ept,
+                                      uint32_t queue,
+                                      uint32_t *len,
+                                      uint16_t *idx,
+                                      uintptr_t timeout)
+{
+    void *buffer = RL_NULL;
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+    uint64_t start_time;
+    uint32_t elapsed_ms;
+    uintptr_t wait_ms = timeout;
+    uintptr_t slice_ms;
+
+#if defined(RL_ALLOW_LOCKLESS_TX) && (RL_ALLOW_LOCKLESS_TX == 1)
+    /* Lockless fast path, the lock is needed only to wait for a buffer */
+    if (rpmsg_lite_dev->tx_waiters[queue] == 0U)
+    {
+        buffer = rpmsg_lite_tx_alloc(rpmsg_lite_dev, ept, queue, len, idx);
+        if (buffer != RL_NULL)
+        {
+            return buffer;
+        }
+    }
+#endif
+
+    /* Lock the device to enable exclusive access to virtqueues */
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    /* Do not overtake senders already waiting for a buffer */
+    if (rpmsg_lite_tx_must_queue(rpmsg_lite_dev, ept, queue) == RL_FALSE)
+    {
+        /* Get rpmsg buffer for sending message. */
+        buffer = rpmsg_lite_tx_alloc(rpmsg_lite_dev, ept, queue, len, idx);
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+        if (buffer == RL_NULL)
+        {
+            rpmsg_lite_tx_quota_denied(rpmsg_lite_dev, ept);
+        }
+#endif
+    }
+
+    if ((buffer == RL_NULL) && (timeout != RL_DONT_BLOCK))
+    {
+        /* Buffers are returned only for notified messages, do not wait on deferred ones */
+        rpmsg_lite_notify_tx(rpmsg_lite_dev, queue, RL_TRUE);
+        rpmsg_lite_dev->tx_waiters[queue]++;
+        start_time = env_get_timestamp();
+        if (rpmsg_lite_dev->tx_waiters[queue] == 1U)
+        {
+            /* Retry once registered as a waiter, buffers returned in between would not be signalled otherwise */
+            buffer = rpmsg_lite_tx_alloc(rpmsg_lite_dev, ept, queue, len, idx);
+        }
+        while ((buffer == RL_NULL) && (wait_ms != 0U))
+        {
+            slice_ms = wait_ms;
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+            /* Held back by the quota while buffers are free, the sender may consume
+               the wake-up meant for another waiting sender, look again soon */
+            if ((rpmsg_lite_dev->tx_free_cnt != 0U) && (slice_ms > (uintptr_t)RL_MS_PER_INTERVAL))
+            {
+                slice_ms = (uintptr_t)RL_MS_PER_INTERVAL;
+            }
+#endif
+            RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+            (void)env_acquire_sync_lock(rpmsg_lite_dev->tx_wait_lock[queue], slice_ms);
+            if (timeout != RL_BLOCK)
+            {
+                elapsed_ms = env_timestamp_to_msec(env_get_timestamp() - start_time);
+                wait_ms    = (elapsed_ms < timeout) ? (timeout - elapsed_ms) : 0U;
+            }
+            RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+            buffer = rpmsg_lite_tx_alloc(rpmsg_lite_dev, ept, queue, len, idx);
+        }
+        rpmsg_lite_dev->tx_waiters[queue]--;
+
+        /* More buffers could be returned by one notification, pass the wake-up to the next waiting sender */
+        if ((buffer != RL_NULL) && (rpmsg_lite_dev->tx_waiters[queue] != 0U))
+        {
+            env_release_sync_lock(rpmsg_lite_dev->tx_wait_lock[queue]);
+        }
+    }
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+#else
+    uint32_t tick_count = 0U;
+
+#if defined(RL_ALLOW_LOCKLESS_TX) && (RL_ALLOW_LOCKLESS_TX == 1)
+    /* Lockless fast path, the lock is needed only to wait for a buffer */
+    buffer = rpmsg_lite_tx_alloc(rpmsg_lite_dev, ept, queue, len, idx);
+    if (buffer != RL_NULL)
+    {
+        return buffer;
+    }
+#endif
+
+    /* Lock the device to enable exclusive access to virtqueues */
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    /* Get rpmsg buffer for sending message. */
+    buffer = rpmsg_lite_tx_alloc(rpmsg_lite_dev, ept, queue, len, idx);
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+    if (buffer == RL_NULL)
+    {
+        rpmsg_lite_tx_quota_denied(rpmsg_lite_dev, ept);
+    }
+#endif
+    if ((buffer == RL_NULL) && (timeout != RL_DONT_BLOCK))
+    {
+        /* Buffers are returned only for notified messages, do not wait on deferred ones */
+        rpmsg_lite_notify_tx(rpmsg_lite_dev, queue, RL_TRUE);
+    }
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+    if ((buffer == RL_NULL) && (timeout == RL_FALSE))
+    {
+        return RL_NULL;
+    }
+
+    while (buffer == RL_NULL)
+    {
+        env_sleep_msec(RL_MS_PER_INTERVAL);
+        RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+        buffer = rpmsg_lite_tx_alloc(rpmsg_lite_dev, ept, queue, len, idx);
+        RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+        tick_count += (uint32_t)RL_MS_PER_INTERVAL;
+        if ((tick_count >= timeout) && (buffer == RL_NULL))
+        {
+            return RL_NULL;
+        }
+    }
+#endif /* defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1) */
+
+    return buffer;
+}
+
+#if defined(RL_ALLOW_TX_STASH) && (RL_ALLOW_TX_STASH == 1)
+/*!
+ * @brief
+ * Internal function to get a free tx buffer from the stash of the endpoint.
+ * An empty stash is refilled together with taking the buffer for the
+ * message, falls back to waiting up to the timeout when no buffer is free.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Sender endpoint
+ * @param len               Pointer to store the buffer length
+ * @param idx               Pointer to store the buffer index
+ * @param timeout           Timeout in ms, 0 if nonblocking
+ *
+ * @return  Buffer pointer, RL_NULL when no buffer available within the timeout
+ *
+ */
+static void *rpmsg_lite_stash_get_tx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                            struct rpmsg_lite_endpoint *ept,
+                                            uint32_t *len,
+                                            uint16_t *idx,
+                                            uintptr_t timeout)
+{
+    struct rpmsg_lite_tx_buffer *entry;
+    void *buffer = RL_NULL;
+
+    /* The stash is owned by the sending task, no lock needed */
+    if (ept->tx_stash_cnt != 0U)
+    {
+        ept->tx_stash_cnt--;
+        entry = &ept->tx_stash[ept->tx_stash_cnt];
+        *len  = entry->len;
+        *idx  = entry->idx;
+        return entry->buf;
+    }
+
+    if (ept->tx_stash_size == 0U)
+    {
+        return rpmsg_lite_get_tx_buffer(rpmsg_lite_dev, ept, 0U, len, idx, timeout);
+    }
+
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+    /* Buffers are short when senders wait, do not overtake them */
+    if (rpmsg_lite_dev->tx_waiters[0] == 0U)
+#endif
+    {
+        RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+        /* The previous grant has been used up */
+        rpmsg_lite_dev->tx_stashed -= ept->tx_stash_grant;
+        ept->tx_stash_grant = 0U;
+        buffer              = rpmsg_lite_tx_alloc(rpmsg_lite_dev, ept, 0U, len, idx);
+        while ((buffer != RL_NULL) && (ept->tx_stash_cnt < ept->tx_stash_size) &&
+               (rpmsg_lite_dev->tx_stashed < rpmsg_lite_dev->tx_stash_limit))
+        {
+            entry      = &ept->tx_stash[ept->tx_stash_cnt];
+            entry->buf = rpmsg_lite_tx_alloc(rpmsg_lite_dev, ept, 0U, &entry->len, &entry->idx);
+            if (entry->buf == RL_NULL)
+            {
+                break;
+            }
+            ept->tx_stash_cnt++;
+            ept->tx_stash_grant++;
+            rpmsg_lite_dev->tx_stashed++;
+        }
+        RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+    }
+
+    if (buffer == RL_NULL)
+    {
+        buffer = rpmsg_lite_get_tx_buffer(rpmsg_lite_dev, ept, 0U, len, idx, timeout);
+    }
+
+    return buffer;
+}
+
+int32_t rpmsg_lite_flush_ept_tx_stash(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_lite_endpoint *ept)
+{
+    if ((rpmsg_lite_dev == RL_NULL) || (ept == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    /* Less buffers than the tx_free array holds are granted to the stashes */
+    while (ept->tx_stash_cnt != 0U)
+    {
+        ept->tx_stash_cnt--;
+        rpmsg_lite_dev->tx_free[rpmsg_lite_dev->tx_free_cnt] = ept->tx_stash[ept->tx_stash_cnt];
+        rpmsg_lite_dev->tx_free_cnt++;
+    }
+    rpmsg_lite_dev->tx_stashed -= ept->tx_stash_grant;
+    ept->tx_stash_grant = 0U;
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+    if ((rpmsg_lite_dev->tx_free_cnt != 0U) && (rpmsg_lite_dev->tx_waiters[0] != 0U))
+    {
+        env_release_sync_lock(rpmsg_lite_dev->tx_wait_lock[0]);
+    }
+#endif
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+    return RL_SUCCESS;
+}
+
+int32_t rpmsg_lite_set_ept_tx_stash(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                    struct rpmsg_lite_endpoint *ept,
+                                    uint32_t count)
+{
+    int32_t status;
+
+    if (count > (uint32_t)RL_TX_STASH_SIZE)
+    {
+        return RL_ERR_PARAM;
+    }
+
+    status = rpmsg_lite_flush_ept_tx_stash(rpmsg_lite_dev, ept);
+    if (status == RL_SUCCESS)
+    {
+        ept->tx_stash_size = count;
+    }
+
+    return status;
+}
+#endif /* RL_ALLOW_TX_STASH */
+
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+int32_t rpmsg_lite_set_ept_tx_quota(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                    struct rpmsg_lite_endpoint *ept,
+                                    uint32_t reserved,
+                                    uint32_t max_in_flight)
+{
+    uint32_t shared_before;
+    uint32_t shared_after;
+
+    if ((rpmsg_lite_dev == RL_NULL) || (ept == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    if ((max_in_flight != 0U) && (max_in_flight < reserved))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    if ((rpmsg_lite_dev->tx_reserved - ept->tx_reserved + reserved) > (uint32_t)rpmsg_lite_dev->tvq->vq_nentries)
+    {
+        RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+        return RL_ERR_NO_MEM;
+    }
+
+    /* The buffers in flight beyond the reservation are counted in the shared pool */
+    shared_before = (ept->tx_in_flight > ept->tx_reserved) ? (ept->tx_in_flight - ept->tx_reserved) : 0U;
+    shared_after  = (ept->tx_in_flight > reserved) ? (ept->tx_in_flight - reserved) : 0U;
+    rpmsg_lite_dev->tx_shared_used = rpmsg_lite_dev->tx_shared_used - shared_before + shared_after;
+    rpmsg_lite_dev->tx_reserved    = rpmsg_lite_dev->tx_reserved - ept->tx_reserved + reserved;
+    ept->tx_reserved               = reserved;
+    ept->tx_max                    = max_in_flight;
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+    /* A waiting sender may fit into the new quota */
+    if (rpmsg_lite_dev->tx_waiters[0] != 0U)
+    {
+        env_release_sync_lock(rpmsg_lite_dev->tx_wait_lock[0]);
+    }
+#endif
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+    return RL_SUCCESS;
+}
+
+int32_t rpmsg_lite_get_ept_tx_quota_stats(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                          struct rpmsg_lite_endpoint *ept,
+                                          uint32_t *in_flight,
+                                          uint32_t *denied)
+{
+    if ((rpmsg_lite_dev == RL_NULL) || (ept == RL_NULL) || (in_flight == RL_NULL) || (denied == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    /* Credit the buffers the other side has returned so far */
+    rpmsg_lite_tx_reclaim(rpmsg_lite_dev, 0U);
+    *in_flight = ept->tx_in_flight;
+    *denied    = ept->tx_denied;
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+    return RL_SUCCESS;
+}
+#endif /* RL_ALLOW_TX_QUOTA */
+
+#if (RL_QUEUE_PAIR_COUNT > 1)
+int32_t rpmsg_lite_set_ept_queue(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                 struct rpmsg_lite_endpoint *ept,
+                                 uint32_t queue)
+{
+    if ((rpmsg_lite_dev == RL_NULL) || (ept == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    if ((queue >= (uint32_t)RL_QUEUE_PAIR_COUNT) && (queue != RL_QUEUE_PER_CORE))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    env_lock_mutex(rpmsg_lite_dev->lock);
+    ept->tx_queue = queue;
+    env_unlock_mutex(rpmsg_lite_dev->lock);
+
+    return RL_SUCCESS;
+}
+
+int32_t rpmsg_lite_set_rx_queue_policy(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                       uint32_t policy,
+                                       const uint32_t *weights)
+{
+    uint32_t q;
+
+    if (rpmsg_lite_dev == RL_NULL)
+    {
+        return RL_ERR_PARAM;
+    }
+
+    if (policy == RL_QUEUE_POLICY_WRR)
+    {
+        if (weights == RL_NULL)
+        {
+            return RL_ERR_PARAM;
+        }
+        for (q = 0U; q < (uint32_t)RL_QUEUE_PAIR_COUNT; q++)
+        {
+            if (weights[q] == 0U)
+            {
+                return RL_ERR_PARAM;
+            }
+        }
+    }
+    else if (policy != RL_QUEUE_POLICY_PRIORITY)
+    {
+        return RL_ERR_PARAM;
+    }
+    else
+    {
+        /* No weights for the strict priority */
+    }
+
+    /* The rvqs are drained from the ISR, switch the policy with the interrupt masked */
+    env_lock_mutex(rpmsg_lite_dev->rx_lock);
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    env_disable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->rvq->vq_queue_index);
+#else
+    env_disable_interrupt(rpmsg_lite_dev->rvq->vq_queue_index);
+#endif
+    rpmsg_lite_dev->rx_policy = policy;
+    for (q = 0U; q < (uint32_t)RL_QUEUE_PAIR_COUNT; q++)
+    {
+        rpmsg_lite_dev->rx_weights[q] = (policy == RL_QUEUE_POLICY_WRR) ? weights[q] : 1U;
+    }
+    rpmsg_lite_dev->rx_queue  = 0U;
+    rpmsg_lite_dev->rx_credit = rpmsg_lite_dev->rx_weights[0];
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    env_enable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->rvq->vq_queue_index);
+#else
+    env_enable_interrupt(rpmsg_lite_dev->rvq->vq_queue_index);
+#endif
+    env_unlock_mutex(rpmsg_lite_dev->rx_lock);
+
+    return RL_SUCCESS;
+}
+#endif /* (RL_QUEUE_PAIR_COUNT > 1) */
+
+/*!
+ * @brief
+ * Internal function to format a RPMsg compatible
+ * message and sends it
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Sender endpoint
+ * @param dst               Remote endpoint address
+ * @param data              Payload buffer
+ * @param size              Size of payload, in bytes
+ * @param flags             Value of flags field
+ * @param timeout           Timeout in ms, 0 if nonblocking
+ *
+ * @return  Status of function execution, RL_SUCCESS on success
+ *
+ */
+static int32_t rpmsg_lite_format_message(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                         struct rpmsg_lite_endpoint *ept,
+                                         uint32_t dst,
+                                         char *data,
+                                         uint32_t size,
+                                         uint32_t flags,
+                                         uint32_t timeout)
+{
+    struct rpmsg_std_msg *rpmsg_msg;
+    void *buffer;
+    uint16_t idx;
+    uint32_t buff_len;
+    uint32_t queue;
+
+    if (data == RL_NULL)
+    {
+        return RL_ERR_PARAM;
+    }
+
+    if (rpmsg_lite_dev->link_state != RL_TRUE)
+    {
+        return RL_NOT_READY;
+    }
+
+    queue = rpmsg_lite_ept_queue(ept);
+    /* Get rpmsg buffer for sending message. */
+#if defined(RL_ALLOW_TX_STASH) && (RL_ALLOW_TX_STASH == 1)
+    buffer = rpmsg_lite_stash_get_tx_buffer(rpmsg_lite_dev, ept, &buff_len, &idx, timeout);
+#else
+    buffer = rpmsg_lite_get_tx_buffer(rpmsg_lite_dev, ept, queue, &buff_len, &idx, timeout);
+#endif
+    if (buffer == RL_NULL)
+    {
+        return RL_ERR_NO_MEM;
+    }
+
+    rpmsg_msg = (struct rpmsg_std_msg *)buffer;
+
+    /* Initialize RPMSG header. */
+    rpmsg_msg->hdr.dst   = dst;
+    rpmsg_msg->hdr.src   = ept->addr;
+    rpmsg_msg->hdr.len   = (uint16_t)(size & 0xFFFFU);
+    rpmsg_msg->hdr.flags = (uint16_t)(flags & 0xFFFFU);
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    if ((flags & RL_MSG_FLAG_CREDIT) != 0U)
+    {
+        /* Credit limit granted to the destination endpoint */
+        rpmsg_msg->hdr.reserved.rfu = (uint16_t)(flags >> 16U);
+    }
+#endif
+
+    /* Copy data to rpmsg buffer. */
+    env_memcpy(rpmsg_msg->data, data, size);
+
+    RL_TX_LOCK(rpmsg_lite_dev);
+    /* Enqueue buffer on virtqueue. */
+    rpmsg_lite_dev->vq_ops->vq_tx(rpmsg_lite_dev->tvqs[queue], buffer, buff_len, idx);
+    /* Let the other side know that there is a job to process. */
+    rpmsg_lite_notify_tx(rpmsg_lite_dev, queue, RL_FALSE);
+    RL_TX_UNLOCK(rpmsg_lite_dev);
+
+    return RL_SUCCESS;
+}
+
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+/*!
+ * @brief
+ * Takes a credit for a message of the endpoint to its flow control peer,
+ * waits up to the timeout for the peer to grant one.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Sender endpoint
+ * @param dst               Remote endpoint address
+ * @param timeout           Timeout in ms, updated with the time left after waiting
+ * @param flags             Pointer to store the header flags, the credit limit for the peer in the upper half
+ * @param gen               Pointer to store the sync generation the credit belongs to
+ *
+ * @return RL_SUCCESS, RL_ERR_NO_BUFF when no credit has been granted in time
+ *
+ */
+static int32_t rpmsg_lite_fc_take(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                  struct rpmsg_lite_endpoint *ept,
+                                  uint32_t dst,
+                                  uintptr_t *timeout,
+                                  uint32_t *flags,
+                                  uint16_t *gen)
+{
+    uint64_t start_time = 0U;
+    uint32_t elapsed_ms;
+    uintptr_t wait_ms = *timeout;
+    uint32_t blocked  = RL_FALSE;
+    uint32_t limit;
+
+    *flags = RL_NO_FLAGS;
+    *gen   = 0U;
+    if (ept->fc_peer != dst)
+    {
+        return RL_SUCCESS;
+    }
+
+    rpmsg_lite_fc_enter(rpmsg_lite_dev, ept);
+    while ((ept->fc_peer == dst) && (rpmsg_lite_fc_credits(ept) == 0U))
+    {
+        if (blocked == RL_FALSE)
+        {
+            blocked    = RL_TRUE;
+            start_time = env_get_timestamp();
+            ept->fc_tx_blocked++;
+        }
+        if (wait_ms == 0U)
+        {
+            rpmsg_lite_fc_leave(rpmsg_lite_dev, ept);
+            return RL_ERR_NO_BUFF;
+        }
+        ept->fc_tx_waiters++;
+        rpmsg_lite_fc_leave(rpmsg_lite_dev, ept);
+        (void)env_acquire_sync_lock(ept->fc_wait_lock, wait_ms);
+        if (*timeout != RL_BLOCK)
+        {
+            elapsed_ms = env_timestamp_to_msec(env_get_timestamp() - start_time);
+            wait_ms    = (elapsed_ms < *timeout) ? (*timeout - elapsed_ms) : 0U;
+        }
+        rpmsg_lite_fc_enter(rpmsg_lite_dev, ept);
+        ept->fc_tx_waiters--;
+    }
+    if (ept->fc_peer == dst)
+    {
+        ept->fc_tx_sent++;
+        /* Every message to the peer carries the current grant of the endpoint */
+        limit  = (uint32_t)(uint16_t)(ept->fc_rx_consumed + ept->fc_window);
+        *flags = RL_MSG_FLAG_CREDIT | (limit << 16U);
+        *gen   = ept->fc_gen;
+        /* One grant may cover several messages, pass the wake-up to the next waiting sender */
+        if ((rpmsg_lite_fc_credits(ept) != 0U) && (ept->fc_tx_waiters != 0U))
+        {
+            env_release_sync_lock(ept->fc_wait_lock);
+        }
+    }
+    rpmsg_lite_fc_leave(rpmsg_lite_dev, ept);
+
+    if (*timeout != RL_BLOCK)
+    {
+        *timeout = wait_ms;
+    }
+    return RL_SUCCESS;
+}
+
+/*!
+ * @brief
+ * Accounts a flow controlled message once sent, or gives its credit back on failure.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Sender endpoint
+ * @param status            Status of the send
+ * @param flags             Flags of the message, as returned by rpmsg_lite_fc_take()
+ * @param gen               Sync generation of the message
+ *
+ */
+static void rpmsg_lite_fc_sent(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                               struct rpmsg_lite_endpoint *ept,
+                               int32_t status,
+                               uint32_t flags,
+                               uint16_t gen)
+{
+    uint16_t limit = (uint16_t)(flags >> 16U);
+
+    if ((flags & RL_MSG_FLAG_CREDIT) == 0U)
+    {
+        return;
+    }
+
+    rpmsg_lite_fc_enter(rpmsg_lite_dev, ept);
+    /* A sync in between has restarted the counting */
+    if (gen == ept->fc_gen)
+    {
+        if (status == RL_SUCCESS)
+        {
+            if (rpmsg_lite_fc_after(limit, ept->fc_rx_granted) == RL_TRUE)
+            {
+                ept->fc_rx_granted = limit;
+            }
+        }
+        else if ((flags & RL_MSG_FLAG_CREDIT_ONLY) == 0U)
+        {
+            ept->fc_tx_sent--;
+            if (ept->fc_tx_waiters != 0U)
+            {
+                env_release_sync_lock(ept->fc_wait_lock);
+            }
+        }
+        else
+        {
+            /* Credit message not sent, the grant stays due */
+        }
+    }
+    if ((status == RL_SUCCESS) && ((flags & RL_MSG_FLAG_CREDIT_ONLY) != 0U))
+    {
+        ept->fc_credit_count++;
+    }
+    rpmsg_lite_fc_leave(rpmsg_lite_dev, ept);
+}
+
+/*!
+ * @brief
+ * Sends a credit message to the peer of the endpoint when a grant is due,
+ * does not wait for a tx buffer.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Endpoint
+ *
+ * @return RL_SUCCESS when sent or not due, RL_ERR_NO_MEM when no tx buffer is free
+ *
+ */
+static int32_t rpmsg_lite_fc_send_credit(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_lite_endpoint *ept)
+{
+    char dummy = 0;
+    uint32_t peer;
+    uint32_t flags;
+    uint32_t due;
+    uint16_t gen;
+    int32_t status = RL_SUCCESS;
+
+    rpmsg_lite_fc_enter(rpmsg_lite_dev, ept);
+    due   = rpmsg_lite_fc_grant_due(ept);
+    peer  = ept->fc_peer;
+    flags = RL_MSG_FLAG_CREDIT | RL_MSG_FLAG_CREDIT_ONLY |
+            ((uint32_t)(uint16_t)(ept->fc_rx_consumed + ept->fc_window) << 16U);
+    gen   = ept->fc_gen;
+    rpmsg_lite_fc_leave(rpmsg_lite_dev, ept);
+
+    if (due == RL_TRUE)
+    {
+        status = rpmsg_lite_format_message(rpmsg_lite_dev, ept, peer, &dummy, 0U, flags, RL_DONT_BLOCK);
+        rpmsg_lite_fc_sent(rpmsg_lite_dev, ept, status, flags, gen);
+    }
+    return status;
+}
+
+/*!
+ * @brief
+ * Sends the credit messages queued by rpmsg_lite_fc_queue_credit(),
+ * called from the ISR or a task once the rx path is done. The endpoints
+ * that find no tx buffer stay queued for the next call, the tx callback
+ * sends them once the other side returns buffers.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ *
+ */
+static void rpmsg_lite_fc_send_queued(struct rpmsg_lite_instance *rpmsg_lite_dev)
+{
+    struct rpmsg_lite_endpoint *ept;
+
+    do
+    {
+        RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+        ept = rpmsg_lite_dev->fc_credit_head;
+        if (ept != RL_NULL)
+        {
+            rpmsg_lite_dev->fc_credit_head = ept->fc_credit_next;
+            ept->fc_credit_queued          = RL_FALSE;
+        }
+        RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+        if ((ept != RL_NULL) && (rpmsg_lite_fc_send_credit(rpmsg_lite_dev, ept) != RL_SUCCESS))
+        {
+            rpmsg_lite_fc_queue_credit(rpmsg_lite_dev, ept);
+            ept = RL_NULL;
+        }
+    } while (ept != RL_NULL);
+}
+#endif /* RL_ALLOW_CREDIT_FLOW_CONTROL */
+
+int32_t rpmsg_lite_send(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                        struct rpmsg_lite_endpoint *ept,
+                        uint32_t dst,
+                        char *data,
+                        uint32_t size,
+                        uintptr_t timeout)
+{
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    uint32_t fc_flags;
+    uint16_t fc_gen;
+    int32_t status;
+#endif
+
+    if (ept == RL_NULL)
+    {
+        return RL_ERR_PARAM;
+    }
+
+    if (rpmsg_lite_dev == RL_NULL)
+    {
+        return RL_ERR_PARAM;
+    }
+
+    // FIXME : may be just copy the data size equal to buffer length and Tx it.
+#if defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1)
+    rpmsg_platform_shmem_config_t shmem_config;
+    (void)platform_get_custom_shmem_config(rpmsg_lite_dev->link_id, &shmem_config);
+    if (size > (uint32_t)shmem_config.buffer_payload_size)
+#else
+    if (size > (uint32_t)RL_BUFFER_PAYLOAD_SIZE)
+#endif /* defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1) */
+    {
+        return RL_ERR_BUFF_SIZE;
+    }
+
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    status = rpmsg_lite_fc_take(rpmsg_lite_dev, ept, dst, &timeout, &fc_flags, &fc_gen);
+    if (status != RL_SUCCESS)
+    {
+        return status;
+    }
+    status = rpmsg_lite_format_message(rpmsg_lite_dev, ept, dst, data, size, fc_flags, timeout);
+    rpmsg_lite_fc_sent(rpmsg_lite_dev, ept, status, fc_flags, fc_gen);
+    return status;
+#else
+    return rpmsg_lite_format_message(rpmsg_lite_dev, ept, dst, data, size, RL_NO_FLAGS, timeout);
+#endif
+}
+
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+int32_t rpmsg_lite_set_ept_flow_control(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                        struct rpmsg_lite_endpoint *ept,
+                                        uint32_t peer,
+                                        uint32_t window,
+                                        uintptr_t timeout)
+{
+    char dummy = 0;
+    uint32_t flags;
+    uint16_t gen;
+    int32_t status;
+
+    if ((rpmsg_lite_dev == RL_NULL) || (ept == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+    if ((window > (uint32_t)rpmsg_lite_dev->rvq->vq_nentries) || ((window != 0U) && (peer == RL_ADDR_ANY)))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    rpmsg_lite_fc_enter(rpmsg_lite_dev, ept);
+    ept->fc_gen++;
+    if ((window == 0U) || (ept->fc_peer != peer))
+    {
+        /* The messages sent to a new peer wait for its sync */
+        ept->fc_tx_sent  = 0U;
+        ept->fc_tx_limit = 0U;
+        if ((window != 0U) && (ept->fc_sync_src == peer))
+        {
+            /* The peer has started its window first */
+            ept->fc_tx_limit = ept->fc_sync_limit;
+        }
+        else if (window != 0U)
+        {
+            env_lock_mutex(rpmsg_lite_dev->lock);
+            if ((rpmsg_lite_dev->fc_sync_src == peer) && (rpmsg_lite_dev->fc_sync_dst == ept->addr))
+            {
+                /* The peer has started its window before the endpoint existed */
+                ept->fc_tx_limit            = rpmsg_lite_dev->fc_sync_limit;
+                rpmsg_lite_dev->fc_sync_src = RL_ADDR_ANY;
+            }
+            env_unlock_mutex(rpmsg_lite_dev->lock);
+        }
+        else
+        {
+            /* Flow control disabled */
+        }
+    }
+    ept->fc_peer        = (window != 0U) ? peer : RL_ADDR_ANY;
+    ept->fc_sync_src    = RL_ADDR_ANY;
+    ept->fc_window      = (uint16_t)window;
+    ept->fc_rx_received = 0U;
+    ept->fc_rx_consumed = 0U;
+    ept->fc_rx_granted  = 0U;
+    gen                 = ept->fc_gen;
+    /* Senders waiting for the previous peer or window look again */
+    if (ept->fc_tx_waiters != 0U)
+    {
+        env_release_sync_lock(ept->fc_wait_lock);
+    }
+    rpmsg_lite_fc_leave(rpmsg_lite_dev, ept);
+
+    if (window == 0U)
+    {
+        return RL_SUCCESS;
+    }
+
+    /* The sync restarts the count of the messages of the peer and grants it the whole window */
+    flags  = RL_MSG_FLAG_CREDIT | RL_MSG_FLAG_CREDIT_ONLY | RL_MSG_FLAG_CREDIT_SYNC | (window << 16U);
+    status = rpmsg_lite_format_message(rpmsg_lite_dev, ept, peer, &dummy, 0U, flags, timeout);
+    rpmsg_lite_fc_sent(rpmsg_lite_dev, ept, status, flags, gen);
+    return status;
+}
+
+int32_t rpmsg_lite_get_ept_fc_stats(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                    struct rpmsg_lite_endpoint *ept,
+                                    struct rpmsg_lite_fc_stats *stats)
+{
+    uint16_t outstanding;
+
+    if ((rpmsg_lite_dev == RL_NULL) || (ept == RL_NULL) || (stats == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    rpmsg_lite_fc_enter(rpmsg_lite_dev, ept);
+    /* Messages received before a sync may be released after it */
+    outstanding           = (uint16_t)(ept->fc_rx_received - ept->fc_rx_consumed);
+    stats->tx_credits     = (ept->fc_peer != RL_ADDR_ANY) ? rpmsg_lite_fc_credits(ept) : 0U;
+    stats->tx_blocked     = ept->fc_tx_blocked;
+    stats->rx_outstanding = (outstanding > 0x7FFFU) ? 0U : (uint32_t)outstanding;
+    stats->rx_overruns    = ept->fc_rx_overruns;
+    stats->credit_count   = ept->fc_credit_count;
+    rpmsg_lite_fc_leave(rpmsg_lite_dev, ept);
+
+    return RL_SUCCESS;
+}
+#endif /* RL_ALLOW_CREDIT_FLOW_CONTROL */
+
+#if (defined(RL_ALLOW_ASYNC_SEND) && (RL_ALLOW_ASYNC_SEND == 1)) ||   \
+    (defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)) || \
+    (defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1))
+/*!
+ * @brief
+ * Takes the tx lock and masks the interrupt of the link, the tx callback
+ * does not drain the pending sends nor take back the tx buffers meanwhile,
+ * the rx path does not send the queued credit messages.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ *
+ */
+static void rpmsg_lite_tx_lock(struct rpmsg_lite_instance *rpmsg_lite_dev)
+{
+    env_lock_mutex(rpmsg_lite_dev->tx_lock);
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    env_disable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->tvq->vq_queue_index);
+#else
+    env_disable_interrupt(rpmsg_lite_dev->tvq->vq_queue_index);
+#endif
+}
+
+/*!
+ * @brief
+ * Unmasks the interrupt of the link and releases the tx lock.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ *
+ */
+static void rpmsg_lite_tx_unlock(struct rpmsg_lite_instance *rpmsg_lite_dev)
+{
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    env_enable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->tvq->vq_queue_index);
+#else
+    env_enable_interrupt(rpmsg_lite_dev->tvq->vq_queue_index);
+#endif
+    env_unlock_mutex(rpmsg_lite_dev->tx_lock);
+}
+#endif
+
+#if defined(RL_ALLOW_ASYNC_SEND) && (RL_ALLOW_ASYNC_SEND == 1)
+/*!
+ * @brief
+ * Internal function to enqueue the message of an asynchronous send request
+ * on the tvq when a tx buffer is free, called with the tx lock held.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param req               Request to send
+ * @param tx_queued         Bitmap of the queue pairs to notify, updated
+ *
+ * @return  RL_TRUE when the message is enqueued, RL_FALSE when no tx buffer is free
+ *
+ */
+static uint32_t rpmsg_lite_async_tx(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                    const struct rpmsg_lite_async_req *req,
+                                    uint32_t *tx_queued)
+{
+    struct rpmsg_std_msg *rpmsg_msg;
+    uint32_t buff_len;
+    uint16_t idx;
+    uint32_t queue = rpmsg_lite_ept_queue(req->ept);
+
+    rpmsg_msg = (struct rpmsg_std_msg *)rpmsg_lite_tx_alloc(rpmsg_lite_dev, req->ept, queue, &buff_len, &idx);
+    if (rpmsg_msg == RL_NULL)
+    {
+        return RL_FALSE;
+    }
+
+    /* Initialize RPMSG header. */
+    rpmsg_msg->hdr.dst   = req->dst;
+    rpmsg_msg->hdr.src   = req->ept->addr;
+    rpmsg_msg->hdr.len   = (uint16_t)(req->size & 0xFFFFU);
+    rpmsg_msg->hdr.flags = (uint16_t)(RL_NO_FLAGS & 0xFFFFU);
+
+    /* Copy data to rpmsg buffer. */
+    env_memcpy(rpmsg_msg->data, req->data, req->size);
+
+    /* Enqueue buffer on virtqueue. */
+    rpmsg_lite_dev->vq_ops->vq_tx(rpmsg_lite_dev->tvqs[queue], rpmsg_msg, buff_len, idx);
+    *tx_queued |= 1UL << queue;
+
+    return RL_TRUE;
+}
+
+/*!
+ * @brief
+ * Internal function to notify the other side about the messages
+ * enqueued on the tvqs of the bitmap, called with the tx lock held.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param tx_queued         Bitmap of the queue pairs to notify
+ * @param force             RL_TRUE to notify regardless of the thresholds
+ *
+ */
+static void rpmsg_lite_async_notify(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t tx_queued, uint32_t force)
+{
+    uint32_t queue;
+
+    for (queue = 0U; queue < (uint32_t)RL_QUEUE_PAIR_COUNT; queue++)
+    {
+        if ((tx_queued & (1UL << queue)) != 0U)
+        {
+            rpmsg_lite_notify_tx(rpmsg_lite_dev, queue, force);
+        }
+    }
+}
+
+/*!
+ * @brief
+ * Internal function to call the completion callbacks of a list of requests,
+ * called without the tx lock held. The callback may reuse its request.
+ *
+ * @param req               First request of the list
+ * @param status            Status passed to the callbacks
+ *
+ */
+static void rpmsg_lite_async_complete(struct rpmsg_lite_async_req *req, int32_t status)
+{
+    struct rpmsg_lite_async_req *next;
+
+    while (req != RL_NULL)
+    {
+        next      = req->next;
+        req->next = RL_NULL;
+        req->done_cb(req, status, req->done_cb_data);
+        req = next;
+    }
+}
+
+/*!
+ * @brief
+ * Internal function to send the pending asynchronous requests in order
+ * while tx buffers are free, called with the tx lock held.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param tx_queued         Bitmap of the queue pairs to notify, updated
+ *
+ * @return  List of the sent requests, RL_NULL when none
+ *
+ */
+static struct rpmsg_lite_async_req *rpmsg_lite_async_send_pending(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                                                   uint32_t *tx_queued)
+{
+    struct rpmsg_lite_async_stats *stats   = &rpmsg_lite_dev->async_stats;
+    struct rpmsg_lite_async_req *done      = RL_NULL;
+    struct rpmsg_lite_async_req *done_tail = RL_NULL;
+    struct rpmsg_lite_async_req *req;
+    uint64_t waited;
+    uint64_t now;
+
+    if (rpmsg_lite_dev->async_head == RL_NULL)
+    {
+        return RL_NULL;
+    }
+
+    now = env_get_timestamp();
+    /* In order, the head waits for a buffer of its queue pair or quota and the later requests behind it */
+    while ((rpmsg_lite_dev->async_head != RL_NULL) &&
+           (rpmsg_lite_async_tx(rpmsg_lite_dev, rpmsg_lite_dev->async_head, tx_queued) == RL_TRUE))
+    {
+        req                        = rpmsg_lite_dev->async_head;
+        rpmsg_lite_dev->async_head = req->next;
+        req->next                  = RL_NULL;
+        if (done_tail == RL_NULL)
+        {
+            done = req;
+        }
+        else
+        {
+            done_tail->next = req;
+        }
+        done_tail = req;
+
+        waited = now - req->queued_at;
+        stats->depth--;
+        stats->sent_queued++;
+        stats->wait_total += waited;
+        if (waited > stats->wait_max)
+        {
+            stats->wait_max = waited;
+        }
+    }
+    if (rpmsg_lite_dev->async_head == RL_NULL)
+    {
+        rpmsg_lite_dev->async_tail = RL_NULL;
+    }
+
+    return done;
+}
+
+/*!
+ * @brief
+ * Sends the pending asynchronous requests, called from the
+ * tx callback once the other side returns tx buffers.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ *
+ */
+static void rpmsg_lite_async_drain(struct rpmsg_lite_instance *rpmsg_lite_dev)
+{
+    struct rpmsg_lite_async_req *done;
+    uint32_t tx_queued = 0U;
+
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    done = rpmsg_lite_async_send_pending(rpmsg_lite_dev, &tx_queued);
+    rpmsg_lite_async_notify(rpmsg_lite_dev, tx_queued, RL_FALSE);
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+    rpmsg_lite_async_complete(done, RL_SUCCESS);
+}
+
+/*!
+ * @brief
+ * Drops the pending asynchronous requests of the endpoint, or all of them,
+ * their completion callbacks get RL_NOT_READY.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Endpoint whose requests are dropped, RL_NULL for all requests
+ *
+ */
+static void rpmsg_lite_async_drop(struct rpmsg_lite_instance *rpmsg_lite_dev, const struct rpmsg_lite_endpoint *ept)
+{
+    struct rpmsg_lite_async_req *dropped      = RL_NULL;
+    struct rpmsg_lite_async_req *dropped_tail = RL_NULL;
+    struct rpmsg_lite_async_req *kept_tail    = RL_NULL;
+    struct rpmsg_lite_async_req *req;
+    struct rpmsg_lite_async_req *next;
+
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    req                        = rpmsg_lite_dev->async_head;
+    rpmsg_lite_dev->async_head = RL_NULL;
+    while (req != RL_NULL)
+    {
+        next      = req->next;
+        req->next = RL_NULL;
+        if ((ept == RL_NULL) || (req->ept == ept))
+        {
+            if (dropped_tail == RL_NULL)
+            {
+                dropped = req;
+            }
+            else
+            {
+                dropped_tail->next = req;
+            }
+            dropped_tail = req;
+            rpmsg_lite_dev->async_stats.depth--;
+            rpmsg_lite_dev->async_stats.failed++;
+        }
+        else
+        {
+            if (kept_tail == RL_NULL)
+            {
+                rpmsg_lite_dev->async_head = req;
+            }
+            else
+            {
+                kept_tail->next = req;
+            }
+            kept_tail = req;
+        }
+        req = next;
+    }
+    rpmsg_lite_dev->async_tail = kept_tail;
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+    rpmsg_lite_async_complete(dropped, RL_NOT_READY);
+}
+
+int32_t rpmsg_lite_send_async(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                              struct rpmsg_lite_endpoint *ept,
+                              uint32_t dst,
+                              char *data,
+                              uint32_t size,
+                              struct rpmsg_lite_async_req *req,
+                              rl_async_done_cb_t done_cb,
+                              void *done_cb_data)
+{
+    struct rpmsg_lite_async_stats *stats;
+    struct rpmsg_lite_async_req *done;
+    uint32_t tx_queued = 0U;
+    uint32_t sent      = RL_FALSE;
+    int32_t status     = RL_SUCCESS;
+#if defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1)
+    rpmsg_platform_shmem_config_t shmem_config;
+#endif
+
+    if ((rpmsg_lite_dev == RL_NULL) || (ept == RL_NULL) || (data == RL_NULL) || (req == RL_NULL) ||
+        (done_cb == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+#if defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1)
+    (void)platform_get_custom_shmem_config(rpmsg_lite_dev->link_id, &shmem_config);
+    if (size > (uint32_t)shmem_config.buffer_payload_size)
+#else
+    if (size > (uint32_t)RL_BUFFER_PAYLOAD_SIZE)
+#endif /* defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1) */
+    {
+        return RL_ERR_BUFF_SIZE;
+    }
+
+    if (rpmsg_lite_dev->link_state != RL_TRUE)
+    {
+        return RL_NOT_READY;
+    }
+
+    req->next         = RL_NULL;
+    req->ept          = ept;
+    req->dst          = dst;
+    req->data         = data;
+    req->size         = size;
+    req->done_cb      = done_cb;
+    req->done_cb_data = done_cb_data;
+
+    stats = &rpmsg_lite_dev->async_stats;
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    /* Buffers returned without a notification are taken by the pending requests first */
+    done = rpmsg_lite_async_send_pending(rpmsg_lite_dev, &tx_queued);
+    /* Do not overtake the pending requests, nor the senders waiting for a buffer */
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+    if ((rpmsg_lite_dev->async_head == RL_NULL) &&
+        (rpmsg_lite_tx_must_queue(rpmsg_lite_dev, ept, rpmsg_lite_ept_queue(ept)) == RL_FALSE))
+#else
+    if (rpmsg_lite_dev->async_head == RL_NULL)
+#endif
+    {
+        sent = rpmsg_lite_async_tx(rpmsg_lite_dev, req, &tx_queued);
+    }
+
+    if (sent == RL_TRUE)
+    {
+        stats->sent_direct++;
+    }
+    else if (stats->depth >= (uint32_t)RL_ASYNC_SEND_QUEUE_DEPTH)
+    {
+        /* Queue full, the request is not accepted */
+        status = RL_ERR_NO_MEM;
+    }
+    else
+    {
+#if (RL_ASYNC_SEND_COPY_SIZE > 0)
+        /* Small payloads are owned by the request, the caller may reuse its buffer right away */
+        if (size <= (uint32_t)RL_ASYNC_SEND_COPY_SIZE)
+        {
+            env_memcpy(req->copy, data, size);
+            req->data = req->copy;
+        }
+#endif
+        req->queued_at = env_get_timestamp();
+        if (rpmsg_lite_dev->async_tail == RL_NULL)
+        {
+            rpmsg_lite_dev->async_head = req;
+        }
+        else
+        {
+            rpmsg_lite_dev->async_tail->next = req;
+        }
+        rpmsg_lite_dev->async_tail = req;
+        stats->depth++;
+        if (stats->depth > stats->max_depth)
+        {
+            stats->max_depth = stats->depth;
+        }
+    }
+    rpmsg_lite_async_notify(rpmsg_lite_dev, tx_queued, RL_FALSE);
+    if (sent == RL_FALSE)
+    {
+        /* Buffers are returned only for notified messages, do not wait on deferred ones */
+        rpmsg_lite_async_notify(rpmsg_lite_dev, 1UL << rpmsg_lite_ept_queue(ept), RL_TRUE);
+    }
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+    rpmsg_lite_async_complete(done, RL_SUCCESS);
+    if (sent == RL_TRUE)
+    {
+        done_cb(req, RL_SUCCESS, done_cb_data);
+    }
+
+    return status;
+}
+
+int32_t rpmsg_lite_get_async_stats(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_lite_async_stats *stats)
+{
+    if ((rpmsg_lite_dev == RL_NULL) || (stats == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    *stats = rpmsg_lite_dev->async_stats;
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+    return RL_SUCCESS;
+}
+#endif /* RL_ALLOW_ASYNC_SEND */
+
+/*!
+ * @brief
+ * Internal function to check the batch entries before sending
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param entries           Array of messages to send
+ * @param count             Number of entries in the array
+ *
+ * @return  Status of function execution, RL_SUCCESS when all entries are valid
+ *
+ */
+static int32_t rpmsg_lite_check_batch(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                      const struct rpmsg_lite_batch_entry *entries,
+                                      uint32_t count)
+{
+    uint32_t payload_size;
+    uint32_t i;
+
+#if defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1)
+    rpmsg_platform_shmem_config_t shmem_config;
+    (void)platform_get_custom_shmem_config(rpmsg_lite_dev->link_id, &shmem_config);
+    payload_size = (uint32_t)shmem_config.buffer_payload_size;
+#else
+    payload_size = (uint32_t)RL_BUFFER_PAYLOAD_SIZE;
+#endif /* defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1) */
+
+    for (i = 0U; i < count; i++)
+    {
+        if ((entries[i].ept == RL_NULL) || (entries[i].data == RL_NULL))
+        {
+            return RL_ERR_PARAM;
+        }
+
+        if (entries[i].size > payload_size)
+        {
+            return RL_ERR_BUFF_SIZE;
+        }
+    }
+
+    if (rpmsg_lite_dev->link_state != RL_TRUE)
+    {
+        return RL_NOT_READY;
+    }
+
+    return RL_SUCCESS;
+}
+
+int32_t rpmsg_lite_send_batch(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                              const struct rpmsg_lite_batch_entry *entries,
+                              uint32_t count,
+                              uint32_t *sent)
+{
+    struct rpmsg_std_msg *rpmsg_msg;
+    uint32_t buff_len;
+    uint32_t i;
+    uint16_t idx;
+    uint32_t queue;
+    uint32_t tx_queued = 0U;
+    uint32_t msg_flags = RL_NO_FLAGS;
+    int32_t status;
+#if (RL_VRING_BATCH_SIZE > 0)
+    struct rpmsg_lite_vq_batch tx_batch;
+#endif
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    struct rpmsg_lite_endpoint *fc_ept = RL_NULL;
+    uintptr_t fc_timeout;
+    uint32_t fc_flags = RL_NO_FLAGS;
+    uint16_t fc_gen   = 0U;
+    int32_t fc_status = RL_SUCCESS;
+#endif
+
+#if (RL_VRING_BATCH_SIZE > 0)
+    tx_batch.count = 0U;
+#endif
+
+    if ((rpmsg_lite_dev == RL_NULL) || (entries == RL_NULL) || (sent == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    *sent  = 0U;
+    status = rpmsg_lite_check_batch(rpmsg_lite_dev, entries, count);
+    if (status != RL_SUCCESS)
+    {
+        return status;
+    }
+
+    /* Lock the device to enable exclusive access to virtqueues */
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    for (i = 0U; i < count; i++)
+    {
+        queue = rpmsg_lite_ept_queue(entries[i].ept);
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+        msg_flags = RL_NO_FLAGS;
+        if (entries[i].ept->fc_peer == entries[i].dst)
+        {
+            /* The credit is taken outside of the tx lock, the messages collected so far go first */
+#if (RL_VRING_BATCH_SIZE > 0)
+            rpmsg_lite_batch_flush(rpmsg_lite_dev, &tx_batch);
+#endif
+            RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+            if (fc_ept != RL_NULL)
+            {
+                rpmsg_lite_fc_sent(rpmsg_lite_dev, fc_ept, fc_status, fc_flags, fc_gen);
+            }
+            fc_ept     = entries[i].ept;
+            fc_timeout = RL_DONT_BLOCK;
+            status     = rpmsg_lite_fc_take(rpmsg_lite_dev, fc_ept, entries[i].dst, &fc_timeout, &fc_flags, &fc_gen);
+            fc_status  = RL_ERR_NO_MEM;
+            RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+            if (status != RL_SUCCESS)
+            {
+                fc_ept = RL_NULL;
+                break;
+            }
+            msg_flags = fc_flags;
+        }
+#endif
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+        /* Do not overtake senders already waiting for a buffer */
+        if (rpmsg_lite_tx_must_queue(rpmsg_lite_dev, entries[i].ept, queue) == RL_TRUE)
+        {
+            break;
+        }
+#endif
+        /* Get rpmsg buffer for sending message. */
+        rpmsg_msg =
+            (struct rpmsg_std_msg *)rpmsg_lite_tx_alloc(rpmsg_lite_dev, entries[i].ept, queue, &buff_len, &idx);
+        if (rpmsg_msg == RL_NULL)
+        {
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+            rpmsg_lite_tx_quota_denied(rpmsg_lite_dev, entries[i].ept);
+#endif
+            break;
+        }
+
+        /* Initialize RPMSG header. */
+        rpmsg_msg->hdr.dst   = entries[i].dst;
+        rpmsg_msg->hdr.src   = entries[i].ept->addr;
+        rpmsg_msg->hdr.len   = (uint16_t)(entries[i].size & 0xFFFFU);
+        rpmsg_msg->hdr.flags = (uint16_t)(msg_flags & 0xFFFFU);
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+        if ((msg_flags & RL_MSG_FLAG_CREDIT) != 0U)
+        {
+            /* Credit limit granted to the destination endpoint */
+            rpmsg_msg->hdr.reserved.rfu = (uint16_t)(msg_flags >> 16U);
+            fc_status                   = RL_SUCCESS;
+        }
+#endif
+
+        /* Copy data to rpmsg buffer. */
+        env_memcpy(rpmsg_msg->data, entries[i].data, entries[i].size);
+
+#if (RL_VRING_BATCH_SIZE > 0)
+        /* Enqueue buffers on virtqueue, RL_VRING_BATCH_SIZE at once. */
+        rpmsg_lite_cache_flush_msg(rpmsg_lite_dev->tvqs[queue], rpmsg_msg, buff_len);
+        rpmsg_lite_batch_add(rpmsg_lite_dev, rpmsg_lite_dev->tvqs[queue], &tx_batch, buff_len, idx);
+#else
+        /* Enqueue buffer on virtqueue. */
+        rpmsg_lite_dev->vq_ops->vq_tx(rpmsg_lite_dev->tvqs[queue], rpmsg_msg, buff_len, idx);
+#endif
+        tx_queued |= 1UL << queue;
+    }
+
+#if (RL_VRING_BATCH_SIZE > 0)
+    rpmsg_lite_batch_flush(rpmsg_lite_dev, &tx_batch);
+#endif
+    /* Let the other side know that there is a job to process, once for the whole batch. */
+    for (queue = 0U; queue < (uint32_t)RL_QUEUE_PAIR_COUNT; queue++)
+    {
+        if ((tx_queued & (1UL << queue)) != 0U)
+        {
+            rpmsg_lite_notify_tx(rpmsg_lite_dev, queue, RL_FALSE);
+        }
+    }
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    if (fc_ept != RL_NULL)
+    {
+        /* Accounts the last flow controlled message, gives its credit back when it found no buffer */
+        rpmsg_lite_fc_sent(rpmsg_lite_dev, fc_ept, fc_status, fc_flags, fc_gen);
+    }
+#endif
+
+    *sent = i;
+    if ((status == RL_SUCCESS) && (i != count))
+    {
+        status = RL_ERR_NO_MEM;
+    }
+    return status;
+}
+
+#if defined(RL_ALLOW_FRAGMENTATION) && (RL_ALLOW_FRAGMENTATION == 1)
+/*!
+ * @brief
+ * Internal function to format the next fragment of a message
+ *
+ * @param rpmsg_msg         Tx buffer
+ * @param src               Local endpoint address
+ * @param dst               Remote endpoint address
+ * @param data              Message data
+ * @param size              Size of the message, in bytes
+ * @param offset            Offset of the fragment in the message
+ * @param payload_size      Payload size of the tx buffer
+ * @param seq               Sequence number of the message
+ *
+ * @return  Number of message bytes copied into the fragment
+ *
+ */
+static uint32_t rpmsg_lite_format_fragment(struct rpmsg_std_msg *rpmsg_msg,
+                                           uint32_t src,
+                                           uint32_t dst,
+                                           const char *data,
+                                           uint32_t size,
+                                           uint32_t offset,
+                                           uint32_t payload_size,
+                                           uint32_t seq)
+{
+    struct rpmsg_lite_frag_hdr frag_hdr;
+    uint32_t hdr_len = 0U;
+    uint32_t flags   = RL_MSG_FLAG_FRAG | (seq & RL_MSG_FLAG_FRAG_SEQ_MASK);
+    uint32_t chunk;
+
+    if (offset == 0U)
+    {
+        /* The first fragment carries the length of the whole message */
+        flags |= RL_MSG_FLAG_FRAG_FIRST;
+        frag_hdr.total_len = size;
+        hdr_len            = (uint32_t)sizeof(struct rpmsg_lite_frag_hdr);
+        env_memcpy(rpmsg_msg->data, &frag_hdr, hdr_len);
+    }
+
+    chunk = size - offset;
+    if (chunk > (payload_size - hdr_len))
+    {
+        chunk = payload_size - hdr_len;
+    }
+    if ((offset + chunk) == size)
+    {
+        flags |= RL_MSG_FLAG_FRAG_LAST;
+    }
+
+    /* Initialize RPMSG header. */
+    rpmsg_msg->hdr.dst   = dst;
+    rpmsg_msg->hdr.src   = src;
+    rpmsg_msg->hdr.len   = (uint16_t)((hdr_len + chunk) & 0xFFFFU);
+    rpmsg_msg->hdr.flags = (uint16_t)(flags & 0xFFFFU);
+
+    /* Copy data to rpmsg buffer. */
+    env_memcpy(&rpmsg_msg->data[hdr_len], &data[offset], chunk);
+
+    return chunk;
+}
+
+int32_t rpmsg_lite_send_fragmented(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                   struct rpmsg_lite_endpoint *ept,
+                                   uint32_t dst,
+                                   char *data,
+                                   uint32_t size,
+                                   uintptr_t timeout)
+{
+    struct rpmsg_std_msg *rpmsg_msg;
+    uint32_t payload_size;
+    uint32_t buff_len;
+    uint32_t offset = 0U;
+    uint32_t seq;
+    uint32_t queue;
+    uint16_t idx;
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    uint32_t fc_flags;
+    uint16_t fc_gen;
+    int32_t status;
+#endif
+
+    if ((rpmsg_lite_dev == RL_NULL) || (ept == RL_NULL) || (data == RL_NULL) || (size == 0U))
+    {
+        return RL_ERR_PARAM;
+    }
+
+#if defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1)
+    rpmsg_platform_shmem_config_t shmem_config;
+    (void)platform_get_custom_shmem_config(rpmsg_lite_dev->link_id, &shmem_config);
+    payload_size = (uint32_t)shmem_config.buffer_payload_size;
+#else
+    payload_size = (uint32_t)RL_BUFFER_PAYLOAD_SIZE;
+#endif /* defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1) */
+
+    if (size <= payload_size)
+    {
+        /* Fits into one buffer, the receiving side takes unfragmented messages as they are */
+        return rpmsg_lite_send(rpmsg_lite_dev, ept, dst, data, size, timeout);
+    }
+
+    if (rpmsg_lite_dev->link_state != RL_TRUE)
+    {
+        return RL_NOT_READY;
+    }
+
+    /* Keep the fragments of one message together on the tvq */
+    env_lock_mutex(rpmsg_lite_dev->frag_lock);
+    seq = ept->tx_frag_seq;
+    ept->tx_frag_seq++;
+    queue = rpmsg_lite_ept_queue(ept);
+
+    while (offset < size)
+    {
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+        /* Each fragment counts against the window of a flow control peer */
+        status = rpmsg_lite_fc_take(rpmsg_lite_dev, ept, dst, &timeout, &fc_flags, &fc_gen);
+        if (status != RL_SUCCESS)
+        {
+            env_unlock_mutex(rpmsg_lite_dev->frag_lock);
+            return status;
+        }
+#endif
+        /* Wait for a free buffer, then fill all the buffers available and notify once for the window */
+        rpmsg_msg =
+            (struct rpmsg_std_msg *)rpmsg_lite_get_tx_buffer(rpmsg_lite_dev, ept, queue, &buff_len, &idx, timeout);
+        if (rpmsg_msg == RL_NULL)
+        {
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+            rpmsg_lite_fc_sent(rpmsg_lite_dev, ept, RL_ERR_NO_MEM, fc_flags, fc_gen);
+#endif
+            env_unlock_mutex(rpmsg_lite_dev->frag_lock);
+            return RL_ERR_NO_MEM;
+        }
+
+        RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+        while (rpmsg_msg != RL_NULL)
+        {
+            offset += rpmsg_lite_format_fragment(rpmsg_msg, ept->addr, dst, data, size, offset, payload_size, seq);
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+            if ((fc_flags & RL_MSG_FLAG_CREDIT) != 0U)
+            {
+                /* Credit limit granted to the destination endpoint */
+                rpmsg_msg->hdr.flags |= (uint16_t)(fc_flags & 0xFFFFU);
+                rpmsg_msg->hdr.reserved.rfu = (uint16_t)(fc_flags >> 16U);
+            }
+#endif
+
+            /* Enqueue buffer on virtqueue. */
+            rpmsg_lite_dev->vq_ops->vq_tx(rpmsg_lite_dev->tvqs[queue], rpmsg_msg, buff_len, idx);
+
+            rpmsg_msg = RL_NULL;
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+            if ((fc_flags & RL_MSG_FLAG_CREDIT) != 0U)
+            {
+                /* The next fragment waits for a credit of its own */
+                break;
+            }
+#endif
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+            /* Do not overtake senders already waiting for a buffer */
+            if ((offset < size) && (rpmsg_lite_tx_must_queue(rpmsg_lite_dev, ept, queue) == RL_FALSE))
+#else
+            if (offset < size)
+#endif
+            {
+                rpmsg_msg =
+                    (struct rpmsg_std_msg *)rpmsg_lite_tx_alloc(rpmsg_lite_dev, ept, queue, &buff_len, &idx);
+            }
+        }
+        /* Let the other side know that there is a job to process, once for the window. */
+        rpmsg_lite_notify_tx(rpmsg_lite_dev, queue, RL_FALSE);
+        RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+        rpmsg_lite_fc_sent(rpmsg_lite_dev, ept, RL_SUCCESS, fc_flags, fc_gen);
+#endif
+    }
+    env_unlock_mutex(rpmsg_lite_dev->frag_lock);
+
+    return RL_SUCCESS;
+}
+
+int32_t rpmsg_lite_reassembly_init(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                   struct rpmsg_lite_reassembly *reassembly,
+                                   char *buffer,
+                                   uint32_t buffer_size,
+                                   rl_frag_rx_cb_t rx_cb,
+                                   void *cb_data)
+{
+    if ((rpmsg_lite_dev == RL_NULL) || (reassembly == RL_NULL) || (rx_cb == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    env_memset(reassembly, 0x00, sizeof(struct rpmsg_lite_reassembly));
+    reassembly->rpmsg_lite_dev = rpmsg_lite_dev;
+    reassembly->rx_cb          = rx_cb;
+    reassembly->cb_data        = cb_data;
+    reassembly->buffer         = buffer;
+    reassembly->buffer_size    = (buffer != RL_NULL) ? buffer_size : 0U;
+    reassembly->active         = RL_FALSE;
+
+    return RL_SUCCESS;
+}
+
+#if defined(RL_API_HAS_ZEROCOPY) && (RL_API_HAS_ZEROCOPY == 1)
+int32_t rpmsg_lite_reassembly_init_nocopy(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                          struct rpmsg_lite_reassembly *reassembly,
+                                          struct rpmsg_lite_frag *frags,
+                                          uint32_t frags_size,
+                                          rl_frag_chain_cb_t chain_cb,
+                                          void *cb_data)
+{
+    if ((rpmsg_lite_dev == RL_NULL) || (reassembly == RL_NULL) || (frags == RL_NULL) || (frags_size == 0U) ||
+        (chain_cb == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    env_memset(reassembly, 0x00, sizeof(struct rpmsg_lite_reassembly));
+    reassembly->rpmsg_lite_dev = rpmsg_lite_dev;
+    reassembly->chain_cb       = chain_cb;
+    reassembly->cb_data        = cb_data;
+    reassembly->frags          = frags;
+    reassembly->frags_size     = frags_size;
+    /* Keep a rx buffer free for the fragment overflowing the chain, the sender would stall otherwise */
+    if (reassembly->frags_size >= (uint32_t)rpmsg_lite_dev->rvq->vq_nentries)
+    {
+        reassembly->frags_size = (uint32_t)rpmsg_lite_dev->rvq->vq_nentries - 1U;
+    }
+    reassembly->active         = RL_FALSE;
+
+    return RL_SUCCESS;
+}
+#endif /* RL_API_HAS_ZEROCOPY */
+
+/*!
+ * @brief
+ * Internal function to drop the message being reassembled,
+ * called from the context of the endpoint rx callback.
+ *
+ * @param reassembly        Reassembly context
+ *
+ */
+static void rpmsg_lite_reassembly_abort(struct rpmsg_lite_reassembly *reassembly)
+{
+#if defined(RL_API_HAS_ZEROCOPY) && (RL_API_HAS_ZEROCOPY == 1)
+    struct rpmsg_lite_instance *rpmsg_lite_dev = reassembly->rpmsg_lite_dev;
+    struct rpmsg_std_msg *rpmsg_msg;
+    struct virtqueue *rvq;
+    uint32_t queue;
+    uint32_t rx_freed = 0U;
+    uint32_t i;
+    uint16_t idx;
+
+    if (reassembly->chain_cb != RL_NULL)
+    {
+        /* Return the held buffers the same way the rx dispatch does */
+        for (i = 0U; i < reassembly->count; i++)
+        {
+            rpmsg_msg = RPMSG_STD_MSG_FROM_BUF(reassembly->frags[i].buffer);
+            queue     = rpmsg_lite_buffer_queue(rpmsg_lite_dev, rpmsg_msg);
+            rvq       = rpmsg_lite_dev->rvqs[queue];
+            idx       = rpmsg_lite_rx_unhold(rvq, rpmsg_msg);
+            rpmsg_lite_dev->vq_ops->vq_rx_free(rvq, rpmsg_msg, (uint32_t)virtqueue_get_buffer_length(rvq, idx), idx);
+            rx_freed |= 1UL << queue;
+        }
+#if defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
+        rpmsg_lite_rx_kick(rpmsg_lite_dev, rx_freed);
+#else
+        (void)rx_freed;
+#endif
+    }
+#endif /* RL_API_HAS_ZEROCOPY */
+    if ((reassembly->buffer == RL_NULL) && (reassembly->data != RL_NULL))
+    {
+        env_free_memory(reassembly->data);
+    }
+    reassembly->data   = RL_NULL;
+    reassembly->count  = 0U;
+    reassembly->active = RL_FALSE;
+    reassembly->aborted_count++;
+}
+
+int32_t rpmsg_lite_reassembly_rx_cb(void *payload, uint32_t payload_len, uint32_t src, void *priv)
+{
+    struct rpmsg_lite_reassembly *reassembly = (struct rpmsg_lite_reassembly *)priv;
+    struct rpmsg_lite_frag_hdr frag_hdr;
+    struct rpmsg_std_msg *rpmsg_msg          = RPMSG_STD_MSG_FROM_BUF(payload);
+    uint32_t flags                           = (uint32_t)rpmsg_msg->hdr.flags;
+    char *data                               = (char *)payload;
+    uint32_t len                             = payload_len;
+#if defined(RL_API_HAS_ZEROCOPY) && (RL_API_HAS_ZEROCOPY == 1)
+    struct rpmsg_lite_frag frag;
+#endif
+
+    RL_ASSERT(reassembly != RL_NULL);
+
+    if ((flags & RL_MSG_FLAG_FRAG) == 0U)
+    {
+        /* Unfragmented message */
+#if defined(RL_API_HAS_ZEROCOPY) && (RL_API_HAS_ZEROCOPY == 1)
+        if (reassembly->chain_cb != RL_NULL)
+        {
+            frag.data   = payload;
+            frag.len    = payload_len;
+            frag.buffer = payload;
+            reassembly->chain_cb(&frag, 1U, src, reassembly->cb_data);
+            return RL_HOLD;
+        }
+#endif /* RL_API_HAS_ZEROCOPY */
+        reassembly->rx_cb(payload, payload_len, src, reassembly->cb_data);
+        return RL_RELEASE;
+    }
+
+    if ((flags & RL_MSG_FLAG_FRAG_FIRST) != 0U)
+    {
+        if (reassembly->active == RL_TRUE)
+        {
+            /* The rest of the previous message has been lost */
+            rpmsg_lite_reassembly_abort(reassembly);
+        }
+        if (len < (uint32_t)sizeof(struct rpmsg_lite_frag_hdr))
+        {
+            reassembly->aborted_count++;
+            return RL_RELEASE;
+        }
+        env_memcpy(&frag_hdr, data, sizeof(struct rpmsg_lite_frag_hdr));
+        data = &data[sizeof(struct rpmsg_lite_frag_hdr)];
+        len -= (uint32_t)sizeof(struct rpmsg_lite_frag_hdr);
+
+        if (reassembly->chain_cb == RL_NULL)
+        {
+            if (reassembly->buffer != RL_NULL)
+            {
+                reassembly->data = (frag_hdr.total_len <= reassembly->buffer_size) ? reassembly->buffer : RL_NULL;
+            }
+            else
+            {
+                reassembly->data = env_allocate_memory(frag_hdr.total_len);
+            }
+            if (reassembly->data == RL_NULL)
+            {
+                reassembly->aborted_count++;
+                return RL_RELEASE;
+            }
+        }
+        reassembly->total_len = frag_hdr.total_len;
+        reassembly->offset    = 0U;
+        reassembly->count     = 0U;
+        reassembly->src       = src;
+        reassembly->seq       = flags & RL_MSG_FLAG_FRAG_SEQ_MASK;
+        reassembly->active    = RL_TRUE;
+    }
+    else if ((reassembly->active != RL_TRUE) || (reassembly->src != src) ||
+             (reassembly->seq != (flags & RL_MSG_FLAG_FRAG_SEQ_MASK)))
+    {
+        /* Stray fragment, its message has been dropped already or is interleaved with another one */
+        reassembly->aborted_count++;
+        return RL_RELEASE;
+    }
+    else
+    {
+        /* Middle or last fragment of the message being reassembled */
+    }
+
+    if ((len > (reassembly->total_len - reassembly->offset)) ||
+        ((reassembly->chain_cb != RL_NULL) && (reassembly->count >= reassembly->frags_size)))
+    {
+        /* More data than announced or than the chain can hold */
+        rpmsg_lite_reassembly_abort(reassembly);
+        return RL_RELEASE;
+    }
+
+    if (reassembly->chain_cb != RL_NULL)
+    {
+        reassembly->frags[reassembly->count].data   = data;
+        reassembly->frags[reassembly->count].len    = len;
+        reassembly->frags[reassembly->count].buffer = payload;
+        reassembly->count++;
+    }
+    else
+    {
+        env_memcpy(&reassembly->data[reassembly->offset], data, len);
+    }
+    reassembly->offset += len;
+
+    if ((flags & RL_MSG_FLAG_FRAG_LAST) == 0U)
+    {
+        return (reassembly->chain_cb != RL_NULL) ? RL_HOLD : RL_RELEASE;
+    }
+
+    if (reassembly->offset != reassembly->total_len)
+    {
+        /* Fragments have been lost, a held buffer of this one is returned by the abort */
+        rpmsg_lite_reassembly_abort(reassembly);
+        return (reassembly->chain_cb != RL_NULL) ? RL_HOLD : RL_RELEASE;
+    }
+
+    reassembly->active = RL_FALSE;
+    reassembly->completed_count++;
+    if (reassembly->chain_cb != RL_NULL)
+    {
+        /* The callback takes over the held buffers */
+        reassembly->chain_cb(reassembly->frags, reassembly->count, src, reassembly->cb_data);
+        reassembly->count = 0U;
+        return RL_HOLD;
+    }
+
+    reassembly->rx_cb(reassembly->data, reassembly->total_len, src, reassembly->cb_data);
+    if (reassembly->buffer == RL_NULL)
+    {
+        env_free_memory(reassembly->data);
+    }
+    reassembly->data = RL_NULL;
+    return RL_RELEASE;
+}
+
+int32_t rpmsg_lite_reassembly_deinit(struct rpmsg_lite_reassembly *reassembly)
+{
+#if defined(RL_API_HAS_ZEROCOPY) && (RL_API_HAS_ZEROCOPY == 1)
+    uint32_t i;
+#endif
+
+    if (reassembly == RL_NULL)
+    {
+        return RL_ERR_PARAM;
+    }
+
+#if defined(RL_API_HAS_ZEROCOPY) && (RL_API_HAS_ZEROCOPY == 1)
+    for (i = 0U; i < reassembly->count; i++)
+    {
+        (void)rpmsg_lite_release_rx_buffer(reassembly->rpmsg_lite_dev, reassembly->frags[i].buffer);
+    }
+#endif /* RL_API_HAS_ZEROCOPY */
+    if ((reassembly->buffer == RL_NULL) && (reassembly->data != RL_NULL))
+    {
+        env_free_memory(reassembly->data);
+    }
+    reassembly->data   = RL_NULL;
+    reassembly->count  = 0U;
+    reassembly->active = RL_FALSE;
+
+    return RL_SUCCESS;
+}
+#endif /* RL_ALLOW_FRAGMENTATION */
+
+#if defined(RL_ALLOW_GROUP_ENDPOINTS) && (RL_ALLOW_GROUP_ENDPOINTS == 1)
+/*!
+ * @brief
+ * Returns the slot of a held rx buffer in the rx_group_refs table.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param rpmsg_msg         Held message
+ *
+ * @return Slot of the buffer
+ *
+ */
+static uint32_t rpmsg_lite_rx_group_slot(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_std_msg *rpmsg_msg)
+{
+    uint32_t queue = rpmsg_lite_buffer_queue(rpmsg_lite_dev, rpmsg_msg);
+    uint16_t idx;
+
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+    idx = 0U;
+    (void)virtqueue_get_buffer_index(rpmsg_lite_dev->rvqs[queue], rpmsg_msg, &idx);
+#else
+    /* Stored by the rx dispatch before the callback */
+    idx = rpmsg_msg->hdr.reserved.idx;
+#endif
+    RL_ASSERT(idx < (uint16_t)RL_BUFFER_COUNT);
+
+    return (queue * (uint32_t)RL_BUFFER_COUNT) + (uint32_t)idx;
+}
+
+/*!
+ * @brief
+ * Updates the number of group subscribers holding an rx buffer,
+ * called in the rx ISR or by the rx worker.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param slot              Slot of the buffer, see rpmsg_lite_rx_group_slot()
+ * @param add               RL_TRUE to add a reference, RL_FALSE to drop one
+ *
+ * @return Number of references left
+ *
+ */
+static uint32_t rpmsg_lite_rx_group_ref(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t slot, uint32_t add)
+{
+    uint32_t refs;
+
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+    /* The rx worker runs in a task, exclude rpmsg_lite_release_rx_buffer() */
+    if (rpmsg_lite_dev->rx_deferred == RL_TRUE)
+    {
+        env_lock_mutex(rpmsg_lite_dev->rx_lock);
+    }
+#endif
+    if (add == RL_TRUE)
+    {
+        rpmsg_lite_dev->rx_group_refs[slot]++;
+    }
+    else
+    {
+        rpmsg_lite_dev->rx_group_refs[slot]--;
+    }
+    refs = rpmsg_lite_dev->rx_group_refs[slot];
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+    if (rpmsg_lite_dev->rx_deferred == RL_TRUE)
+    {
+        env_unlock_mutex(rpmsg_lite_dev->rx_lock);
+    }
+#endif
+
+    return refs;
+}
+
+/*!
+ * @brief
+ * Drops the reference of a subscriber releasing a held rx buffer,
+ * called with the rx lock taken.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param rpmsg_msg         Held message
+ *
+ * @return Number of references left, 0 when the buffer goes back to the vring
+ *
+ */
+static uint32_t rpmsg_lite_rx_group_unref(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_std_msg *rpmsg_msg)
+{
+    uint32_t slot = rpmsg_lite_rx_group_slot(rpmsg_lite_dev, rpmsg_msg);
+    uint32_t refs;
+
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    env_disable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->rvq->vq_queue_index);
+#else
+    env_disable_interrupt(rpmsg_lite_dev->rvq->vq_queue_index);
+#endif
+    refs = rpmsg_lite_dev->rx_group_refs[slot];
+    /* Not held by a group when none */
+    if (refs != 0U)
+    {
+        refs--;
+        rpmsg_lite_dev->rx_group_refs[slot] = (uint16_t)refs;
+    }
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    env_enable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->rvq->vq_queue_index);
+#else
+    env_enable_interrupt(rpmsg_lite_dev->rvq->vq_queue_index);
+#endif
 
-#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
-        if (ept_context == RL_NULL)
-        {
-            env_unlock_mutex(rpmsg_lite_dev->lock);
-            return RL_NULL;
-        }
+    return refs;
+}
 
-        rl_ept = &(ept_context->ept);
-        node   = &(ept_context->node);
+/*!
+ * @brief
+ * Takes the rx lock and masks the interrupt of the link, the subscribers
+ * are not called meanwhile.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ *
+ */
+static void rpmsg_lite_group_lock(struct rpmsg_lite_instance *rpmsg_lite_dev)
+{
+    env_lock_mutex(rpmsg_lite_dev->rx_lock);
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    env_disable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->rvq->vq_queue_index);
 #else
-        rl_ept = env_allocate_memory(sizeof(struct rpmsg_lite_endpoint));
-        if (rl_ept == RL_NULL)
-        {
-            env_unlock_mutex(rpmsg_lite_dev->lock);
-            return RL_NULL;
-        }
-        node = env_allocate_memory(sizeof(struct llist));
-        if (node == RL_NULL)
-        {
-            env_free_memory(rl_ept);
-            env_unlock_mutex(rpmsg_lite_dev->lock);
-            return RL_NULL;
-        }
-#endif /* RL_USE_STATIC_API */
+    env_disable_interrupt(rpmsg_lite_dev->rvq->vq_queue_index);
+#endif
+}
 
-        env_memset(rl_ept, 0x00, sizeof(struct rpmsg_lite_endpoint));
+/*!
+ * @brief
+ * Unmasks the interrupt of the link and releases the rx lock.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ *
+ */
+static void rpmsg_lite_group_unlock(struct rpmsg_lite_instance *rpmsg_lite_dev)
+{
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    env_enable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->rvq->vq_queue_index);
+#else
+    env_enable_interrupt(rpmsg_lite_dev->rvq->vq_queue_index);
+#endif
+    env_unlock_mutex(rpmsg_lite_dev->rx_lock);
+}
 
-        rl_ept->addr       = addr;
-        rl_ept->rx_cb      = rx_cb;
-        rl_ept->rx_cb_data = rx_cb_data;
+int32_t rpmsg_lite_group_init(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                              struct rpmsg_lite_group *group,
+                              struct rpmsg_lite_endpoint **subs,
+                              uint32_t subs_size)
+{
+    uint32_t i;
 
-        node->data = rl_ept;
+    /* Each subscriber may hold the buffer once, the count has to fit the references */
+    if ((rpmsg_lite_dev == RL_NULL) || (group == RL_NULL) || (subs == RL_NULL) || (subs_size == 0U) ||
+        (subs_size >= 0xFFFFU))
+    {
+        return RL_ERR_PARAM;
+    }
 
-        add_to_list((struct llist **)&rpmsg_lite_dev->rl_endpoints, node);
+    for (i = 0U; i < subs_size; i++)
+    {
+        subs[i] = RL_NULL;
     }
-    env_unlock_mutex(rpmsg_lite_dev->lock);
+    group->rpmsg_lite_dev = rpmsg_lite_dev;
+    group->subs           = subs;
+    group->subs_size      = subs_size;
+    group->subs_count     = 0U;
 
-    return rl_ept;
+    return RL_SUCCESS;
 }
-/*************************************************
-
- mmmmmm mmmmm mmmmmmm        mmmm   mmmmmm m
- #      #   "#   #           #   "m #      #
- #mmmmm #mmm#"   #           #    # #mmmmm #
- #      #        #           #    # #      #
- #mmmmm #        #           #mmm"  #mmmmm #mmmmm
 
-**************************************************/
-
-int32_t rpmsg_lite_destroy_ept(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_lite_endpoint *rl_ept)
+int32_t rpmsg_lite_group_subscribe(struct rpmsg_lite_group *group, struct rpmsg_lite_endpoint *ept)
 {
-    struct llist *node;
+    int32_t status = RL_ERR_NO_MEM;
+    uint32_t i;
 
-    if (rpmsg_lite_dev == RL_NULL)
+    if ((group == RL_NULL) || (group->rpmsg_lite_dev == RL_NULL) || (ept == RL_NULL))
     {
         return RL_ERR_PARAM;
     }
 
-    if (rl_ept == RL_NULL)
+    rpmsg_lite_group_lock(group->rpmsg_lite_dev);
+    /* The first free slot, subscribers are called in the slot order */
+    for (i = 0U; i < group->subs_size; i++)
+    {
+        if (group->subs[i] == RL_NULL)
+        {
+            group->subs[i] = ept;
+            if (i >= group->subs_count)
+            {
+                group->subs_count = i + 1U;
+            }
+            status = RL_SUCCESS;
+            break;
+        }
+    }
+    rpmsg_lite_group_unlock(group->rpmsg_lite_dev);
+
+    return status;
+}
+
+int32_t rpmsg_lite_group_unsubscribe(struct rpmsg_lite_group *group, struct rpmsg_lite_endpoint *ept)
+{
+    int32_t status = RL_ERR_PARAM;
+    uint32_t i;
+
+    if ((group == RL_NULL) || (group->rpmsg_lite_dev == RL_NULL) || (ept == RL_NULL))
     {
         return RL_ERR_PARAM;
     }
 
-    env_lock_mutex(rpmsg_lite_dev->lock);
-    node = rpmsg_lite_get_endpoint_from_addr(rpmsg_lite_dev, rl_ept->addr);
-    if (node != RL_NULL)
+    rpmsg_lite_group_lock(group->rpmsg_lite_dev);
+    for (i = 0U; i < group->subs_count; i++)
     {
-        remove_from_list((struct llist **)&rpmsg_lite_dev->rl_endpoints, node);
-        env_unlock_mutex(rpmsg_lite_dev->lock);
-#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
-        env_free_memory(node);
-        env_free_memory(rl_ept);
-#endif
-        return RL_SUCCESS;
+        if (group->subs[i] == ept)
+        {
+            group->subs[i] = RL_NULL;
+            status         = RL_SUCCESS;
+            break;
+        }
     }
-    else
+    /* Trim the free slots at the end */
+    while ((group->subs_count > 0U) && (group->subs[group->subs_count - 1U] == RL_NULL))
     {
-        env_unlock_mutex(rpmsg_lite_dev->lock);
-        return RL_ERR_PARAM;
+        group->subs_count--;
     }
+    rpmsg_lite_group_unlock(group->rpmsg_lite_dev);
+
+    return status;
 }
 
-/******************************************
+int32_t rpmsg_lite_group_rx_cb(void *payload, uint32_t payload_len, uint32_t src, void *priv)
+{
+    struct rpmsg_lite_group *group = (struct rpmsg_lite_group *)priv;
+    struct rpmsg_lite_instance *rpmsg_lite_dev;
+    struct rpmsg_std_msg *rpmsg_msg;
+    struct rpmsg_lite_endpoint *ept;
+    uint32_t slot;
+    uint32_t i;
 
-mmmmmmm m    m          mm   mmmmm  mmmmm
-   #     #  #           ##   #   "#   #
-   #      ##           #  #  #mmm#"   #
-   #     m""m          #mm#  #        #
-   #    m"  "m        #    # #      mm#mm
+    if ((group == RL_NULL) || (group->rpmsg_lite_dev == RL_NULL))
+    {
+        return RL_RELEASE;
+    }
 
-*******************************************/
+    rpmsg_lite_dev = group->rpmsg_lite_dev;
+    rpmsg_msg      = RPMSG_STD_MSG_FROM_BUF(payload);
 
-uint32_t rpmsg_lite_is_link_up(struct rpmsg_lite_instance *rpmsg_lite_dev)
-{
-    if (rpmsg_lite_dev == RL_NULL)
+#if defined(RL_ALLOW_MSG_PACKING) && (RL_ALLOW_MSG_PACKING == 1)
+    if ((rpmsg_msg->hdr.flags & RL_MSG_FLAG_PACKED_REC) != 0U)
     {
-        return 0U;
+        /* Packed message, each holding subscriber references the container, the unpacking keeps it meanwhile */
+        struct rpmsg_std_msg *container =
+            (struct rpmsg_std_msg *)(void *)((char *)rpmsg_msg - rpmsg_msg->hdr.reserved.rfu);
+        for (i = 0U; i < group->subs_count; i++)
+        {
+            ept = group->subs[i];
+            if (ept != RL_NULL)
+            {
+                (void)rpmsg_lite_rx_container_ref(rpmsg_lite_dev, container, RL_TRUE);
+                if (ept->rx_cb(payload, payload_len, src, ept->rx_cb_data) != RL_HOLD)
+                {
+                    (void)rpmsg_lite_rx_container_ref(rpmsg_lite_dev, container, RL_FALSE);
+                }
+            }
+        }
+        return RL_RELEASE;
     }
+#endif
 
-    return (RL_TRUE == rpmsg_lite_dev->link_state ? RL_TRUE : RL_FALSE);
+    slot = rpmsg_lite_rx_group_slot(rpmsg_lite_dev, rpmsg_msg);
+    /* Own reference, keeps the buffer until all the subscribers are called */
+    (void)rpmsg_lite_rx_group_ref(rpmsg_lite_dev, slot, RL_TRUE);
+    for (i = 0U; i < group->subs_count; i++)
+    {
+        ept = group->subs[i];
+        if (ept != RL_NULL)
+        {
+            /* Referenced before the callback, a held message can be released before it returns */
+            (void)rpmsg_lite_rx_group_ref(rpmsg_lite_dev, slot, RL_TRUE);
+            if (ept->rx_cb(payload, payload_len, src, ept->rx_cb_data) != RL_HOLD)
+            {
+                (void)rpmsg_lite_rx_group_ref(rpmsg_lite_dev, slot, RL_FALSE);
+            }
+        }
+    }
+
+    return (rpmsg_lite_rx_group_ref(rpmsg_lite_dev, slot, RL_FALSE) != 0U) ? RL_HOLD : RL_RELEASE;
 }
+#endif /* RL_ALLOW_GROUP_ENDPOINTS */
 
-uint32_t rpmsg_lite_wait_for_link_up(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t timeout)
+#if defined(RL_ALLOW_MSG_PACKING) && (RL_ALLOW_MSG_PACKING == 1)
+/*!
+ * @brief
+ * Internal function to send the container open for packing,
+ * called with the lock held. Containers go on queue pair 0.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ *
+ */
+static void rpmsg_lite_pack_close(struct rpmsg_lite_instance *rpmsg_lite_dev)
 {
-    if (rpmsg_lite_dev == RL_NULL)
+    if (rpmsg_lite_dev->pack_msg == RL_NULL)
     {
-        return 0U;
+        return;
     }
 
-    return env_wait_for_link_up(&rpmsg_lite_dev->link_state, rpmsg_lite_dev->link_id, timeout);
+    rpmsg_lite_dev->pack_msg->hdr.len = (uint16_t)(rpmsg_lite_dev->pack_len & 0xFFFFU);
+    /* Enqueue buffer on virtqueue. */
+    rpmsg_lite_dev->vq_ops->vq_tx(rpmsg_lite_dev->tvqs[0], rpmsg_lite_dev->pack_msg, rpmsg_lite_dev->pack_buff_len,
+                                  rpmsg_lite_dev->pack_idx);
+    rpmsg_lite_dev->pack_msg = RL_NULL;
+    /* Let the other side know that there is a job to process. */
+    rpmsg_lite_notify_tx(rpmsg_lite_dev, 0U, RL_FALSE);
 }
 
 /*!
  * @brief
- * Internal function to format a RPMsg compatible
- * message and sends it
+ * Internal function to open a container for packing in the given buffer,
+ * called with the lock held.
  *
  * @param rpmsg_lite_dev    RPMsg Lite instance
- * @param src               Local endpoint address
- * @param dst               Remote endpoint address
- * @param data              Payload buffer
- * @param size              Size of payload, in bytes
- * @param flags             Value of flags field
- * @param timeout           Timeout in ms, 0 if nonblocking
- *
- * @return  Status of function execution, RL_SUCCESS on success
+ * @param rpmsg_msg         Tx buffer
+ * @param buff_len          Length of the tx buffer
+ * @param idx               Index of the tx buffer
  *
  */
-static int32_t rpmsg_lite_format_message(struct rpmsg_lite_instance *rpmsg_lite_dev,
-                                         uint32_t src,
-                                         uint32_t dst,
-                                         char *data,
-                                         uint32_t size,
-                                         uint32_t flags,
-                                         uint32_t timeout)
+static void rpmsg_lite_pack_open(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                 struct rpmsg_std_msg *rpmsg_msg,
+                                 uint32_t buff_len,
+                                 uint16_t idx)
+{
+    rpmsg_msg->hdr.src   = RL_ADDR_ANY;
+    rpmsg_msg->hdr.dst   = RL_ADDR_ANY;
+    rpmsg_msg->hdr.flags = (uint16_t)RL_MSG_FLAG_PACKED;
+
+    rpmsg_lite_dev->pack_msg      = rpmsg_msg;
+    rpmsg_lite_dev->pack_buff_len = buff_len;
+    rpmsg_lite_dev->pack_idx      = idx;
+    rpmsg_lite_dev->pack_len      = 0U;
+    if (rpmsg_lite_dev->pack_deadline_us != 0U)
+    {
+        rpmsg_lite_dev->pack_since = env_get_timestamp();
+    }
+}
+
+int32_t rpmsg_lite_send_packed(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                               struct rpmsg_lite_endpoint *ept,
+                               uint32_t dst,
+                               char *data,
+                               uint32_t size,
+                               uintptr_t timeout)
 {
     struct rpmsg_std_msg *rpmsg_msg;
-    void *buffer;
-    uint16_t idx;
-    uint32_t tick_count = 0U;
+    uint32_t payload_size;
     uint32_t buff_len;
+    uint32_t elapsed_us;
+    uint32_t msg_flags = RL_NO_FLAGS;
+    uint16_t idx;
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    uint16_t fc_gen;
+    int32_t status;
+#endif
 
-    if (data == RL_NULL)
+    if ((rpmsg_lite_dev == RL_NULL) || (ept == RL_NULL) || (data == RL_NULL))
     {
         return RL_ERR_PARAM;
     }
 
+#if defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1)
+    rpmsg_platform_shmem_config_t shmem_config;
+    (void)platform_get_custom_shmem_config(rpmsg_lite_dev->link_id, &shmem_config);
+    payload_size = (uint32_t)shmem_config.buffer_payload_size;
+#else
+    payload_size = (uint32_t)RL_BUFFER_PAYLOAD_SIZE;
+#endif /* defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1) */
+
+    if (size > (payload_size - (uint32_t)sizeof(struct rpmsg_std_hdr)))
+    {
+        return RL_ERR_BUFF_SIZE;
+    }
+
     if (rpmsg_lite_dev->link_state != RL_TRUE)
     {
         return RL_NOT_READY;
     }
 
-    /* Lock the device to enable exclusive access to virtqueues */
-    env_lock_mutex(rpmsg_lite_dev->lock);
-    /* Get rpmsg buffer for sending message. */
-    buffer = rpmsg_lite_dev->vq_ops->vq_tx_alloc(rpmsg_lite_dev->tvq, &buff_len, &idx);
-    env_unlock_mutex(rpmsg_lite_dev->lock);
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    /* Each packed message counts against the window of a flow control peer */
+    status = rpmsg_lite_fc_take(rpmsg_lite_dev, ept, dst, &timeout, &msg_flags, &fc_gen);
+    if (status != RL_SUCCESS)
+    {
+        return status;
+    }
+#endif
 
-    if ((buffer == RL_NULL) && (timeout == RL_FALSE))
+    /* Lock the device to enable exclusive access to virtqueues */
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    if ((rpmsg_lite_dev->pack_msg != RL_NULL) &&
+        ((rpmsg_lite_dev->pack_len + (uint32_t)sizeof(struct rpmsg_std_hdr) + size) > payload_size))
     {
-        return RL_ERR_NO_MEM;
+        rpmsg_lite_pack_close(rpmsg_lite_dev);
     }
 
-    while (buffer == RL_NULL)
+    if (rpmsg_lite_dev->pack_msg == RL_NULL)
     {
-        env_sleep_msec(RL_MS_PER_INTERVAL);
-        env_lock_mutex(rpmsg_lite_dev->lock);
-        buffer = rpmsg_lite_dev->vq_ops->vq_tx_alloc(rpmsg_lite_dev->tvq, &buff_len, &idx);
-        env_unlock_mutex(rpmsg_lite_dev->lock);
-        tick_count += (uint32_t)RL_MS_PER_INTERVAL;
-        if ((tick_count >= timeout) && (buffer == RL_NULL))
+        rpmsg_msg = RL_NULL;
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+        /* Do not overtake senders already waiting for a buffer */
+        if (rpmsg_lite_dev->tx_waiters[0] == 0U)
+#endif
         {
-            return RL_ERR_NO_MEM;
+            rpmsg_msg =
+                (struct rpmsg_std_msg *)rpmsg_lite_tx_alloc(rpmsg_lite_dev, RL_NULL, 0U, &buff_len, &idx);
+        }
+        if (rpmsg_msg == RL_NULL)
+        {
+            RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+            rpmsg_msg =
+                (struct rpmsg_std_msg *)rpmsg_lite_get_tx_buffer(rpmsg_lite_dev, RL_NULL, 0U, &buff_len, &idx, timeout);
+            if (rpmsg_msg == RL_NULL)
+            {
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+                rpmsg_lite_fc_sent(rpmsg_lite_dev, ept, RL_ERR_NO_MEM, msg_flags, fc_gen);
+#endif
+                return RL_ERR_NO_MEM;
+            }
+            RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+            /* Another sender could have opened a container in the meantime */
+            rpmsg_lite_pack_close(rpmsg_lite_dev);
         }
+        rpmsg_lite_pack_open(rpmsg_lite_dev, rpmsg_msg, buff_len, idx);
     }
 
-    rpmsg_msg = (struct rpmsg_std_msg *)buffer;
-
-    /* Initialize RPMSG header. */
+    /* Append the message with its own header, word aligned */
+    rpmsg_msg            = (struct rpmsg_std_msg *)(void *)&rpmsg_lite_dev->pack_msg->data[rpmsg_lite_dev->pack_len];
     rpmsg_msg->hdr.dst   = dst;
-    rpmsg_msg->hdr.src   = src;
+    rpmsg_msg->hdr.src   = ept->addr;
     rpmsg_msg->hdr.len   = (uint16_t)(size & 0xFFFFU);
-    rpmsg_msg->hdr.flags = (uint16_t)(flags & 0xFFFFU);
-
-    /* Copy data to rpmsg buffer. */
+    rpmsg_msg->hdr.flags = (uint16_t)(msg_flags & 0xFFFFU);
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    if ((msg_flags & RL_MSG_FLAG_CREDIT) != 0U)
+    {
+        /* Credit limit granted to the destination endpoint */
+        rpmsg_msg->hdr.reserved.rfu = (uint16_t)(msg_flags >> 16U);
+    }
+#endif
     env_memcpy(rpmsg_msg->data, data, size);
+    rpmsg_lite_dev->pack_len += (uint32_t)RL_WORD_ALIGN_UP(sizeof(struct rpmsg_std_hdr) + size);
 
-    env_lock_mutex(rpmsg_lite_dev->lock);
-    /* Enqueue buffer on virtqueue. */
-    rpmsg_lite_dev->vq_ops->vq_tx(rpmsg_lite_dev->tvq, buffer, buff_len, idx);
-    /* Let the other side know that there is a job to process. */
-    virtqueue_kick(rpmsg_lite_dev->tvq);
-    env_unlock_mutex(rpmsg_lite_dev->lock);
+    if ((rpmsg_lite_dev->pack_len + (uint32_t)sizeof(struct rpmsg_std_hdr)) >= payload_size)
+    {
+        /* No room for another message */
+        rpmsg_lite_dev->pack_len = (rpmsg_lite_dev->pack_len < payload_size) ? rpmsg_lite_dev->pack_len : payload_size;
+        rpmsg_lite_pack_close(rpmsg_lite_dev);
+    }
+    else if (rpmsg_lite_dev->pack_deadline_us != 0U)
+    {
+        elapsed_us = (uint32_t)env_timestamp_to_usec(env_get_timestamp() - rpmsg_lite_dev->pack_since);
+        if (elapsed_us >= rpmsg_lite_dev->pack_deadline_us)
+        {
+            rpmsg_lite_pack_close(rpmsg_lite_dev);
+        }
+    }
+    else
+    {
+        /* Sent once full or flushed */
+    }
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    rpmsg_lite_fc_sent(rpmsg_lite_dev, ept, RL_SUCCESS, msg_flags, fc_gen);
+#endif
 
     return RL_SUCCESS;
 }
 
-int32_t rpmsg_lite_send(struct rpmsg_lite_instance *rpmsg_lite_dev,
-                        struct rpmsg_lite_endpoint *ept,
-                        uint32_t dst,
-                        char *data,
-                        uint32_t size,
-                        uintptr_t timeout)
+int32_t rpmsg_lite_set_pack_deadline(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t deadline_us)
 {
-    if (ept == RL_NULL)
+    if (rpmsg_lite_dev == RL_NULL)
     {
         return RL_ERR_PARAM;
     }
 
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    rpmsg_lite_dev->pack_deadline_us = deadline_us;
+    /* Restart the deadline of the open container */
+    rpmsg_lite_dev->pack_since = env_get_timestamp();
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+    return RL_SUCCESS;
+}
+
+int32_t rpmsg_lite_flush_packed(struct rpmsg_lite_instance *rpmsg_lite_dev)
+{
     if (rpmsg_lite_dev == RL_NULL)
     {
         return RL_ERR_PARAM;
     }
 
-    // FIXME : may be just copy the data size equal to buffer length and Tx it.
-#if defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1)
-    rpmsg_platform_shmem_config_t shmem_config;
-    (void)platform_get_custom_shmem_config(rpmsg_lite_dev->link_id, &shmem_config);
-    if (size > (uint32_t)shmem_config.buffer_payload_size)
-#else
-    if (size > (uint32_t)RL_BUFFER_PAYLOAD_SIZE)
-#endif /* defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1) */
-    {
-        return RL_ERR_BUFF_SIZE;
-    }
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    rpmsg_lite_pack_close(rpmsg_lite_dev);
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
 
-    return rpmsg_lite_format_message(rpmsg_lite_dev, ept->addr, dst, data, size, RL_NO_FLAGS, timeout);
+    return RL_SUCCESS;
 }
+#endif /* RL_ALLOW_MSG_PACKING */
 
 #if defined(RL_API_HAS_ZEROCOPY) && (RL_API_HAS_ZEROCOPY == 1)
 
-void *rpmsg_lite_alloc_tx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t *size, uintptr_t timeout)
+/*!
+ * @brief
+ * Internal function to allocate a tx buffer of the given queue pair
+ * for the zero-copy send.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Sender endpoint, RL_NULL when not known yet
+ * @param queue             Queue pair of the tvq
+ * @param size              Pointer to store maximum payload size available
+ * @param timeout           Timeout in ms, 0 if nonblocking
+ *
+ * @return Payload pointer, RL_NULL when no buffer available within the timeout
+ *
+ */
+static void *rpmsg_lite_alloc_queue_tx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                              struct rpmsg_lite_endpoint *ept,
+                                              uint32_t queue,
+                                              uint32_t *size,
+                                              uintptr_t timeout)
 {
     struct rpmsg_std_msg *rpmsg_msg;
     void *buffer;
     uint16_t idx;
-    uint32_t tick_count = 0U;
 
     if (size == RL_NULL)
     {
@@ -803,32 +5401,14 @@ void *rpmsg_lite_alloc_tx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev, uin
         return RL_NULL;
     }
 
-    /* Lock the device to enable exclusive access to virtqueues */
-    env_lock_mutex(rpmsg_lite_dev->lock);
     /* Get rpmsg buffer for sending message. */
-    buffer = rpmsg_lite_dev->vq_ops->vq_tx_alloc(rpmsg_lite_dev->tvq, size, &idx);
-    env_unlock_mutex(rpmsg_lite_dev->lock);
-
-    if ((buffer == RL_NULL) && (timeout == RL_FALSE))
+    buffer = rpmsg_lite_get_tx_buffer(rpmsg_lite_dev, ept, queue, size, &idx, timeout);
+    if (buffer == RL_NULL)
     {
         *size = 0;
         return RL_NULL;
     }
 
-    while (buffer == RL_NULL)
-    {
-        env_sleep_msec(RL_MS_PER_INTERVAL);
-        env_lock_mutex(rpmsg_lite_dev->lock);
-        buffer = rpmsg_lite_dev->vq_ops->vq_tx_alloc(rpmsg_lite_dev->tvq, size, &idx);
-        env_unlock_mutex(rpmsg_lite_dev->lock);
-        tick_count += (uint32_t)RL_MS_PER_INTERVAL;
-        if ((tick_count >= timeout) && (buffer == RL_NULL))
-        {
-            *size = 0;
-            return RL_NULL;
-        }
-    }
-
     rpmsg_msg = (struct rpmsg_std_msg *)buffer;
 
     /* keep idx and totlen information for nocopy tx function */
@@ -858,14 +5438,58 @@ void *rpmsg_lite_alloc_tx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev, uin
     return rpmsg_msg->data;
 }
 
-int32_t rpmsg_lite_send_nocopy(struct rpmsg_lite_instance *rpmsg_lite_dev,
-                               struct rpmsg_lite_endpoint *ept,
-                               uint32_t dst,
-                               void *data,
-                               uint32_t size)
+void *rpmsg_lite_alloc_tx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev, uint32_t *size, uintptr_t timeout)
+{
+    return rpmsg_lite_alloc_queue_tx_buffer(rpmsg_lite_dev, RL_NULL, 0U, size, timeout);
+}
+
+#if (RL_QUEUE_PAIR_COUNT > 1) || (defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1))
+void *rpmsg_lite_alloc_ept_tx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                     struct rpmsg_lite_endpoint *ept,
+                                     uint32_t *size,
+                                     uintptr_t timeout)
+{
+    if (ept == RL_NULL)
+    {
+        return RL_NULL;
+    }
+
+    return rpmsg_lite_alloc_queue_tx_buffer(rpmsg_lite_dev, ept, rpmsg_lite_ept_queue(ept), size, timeout);
+}
+#endif /* (RL_QUEUE_PAIR_COUNT > 1) || RL_ALLOW_TX_QUOTA */
+
+/*!
+ * @brief
+ * Internal function to send a message in an allocated tx buffer,
+ * see rpmsg_lite_send_nocopy().
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param ept               Sender endpoint
+ * @param dst               Remote endpoint address
+ * @param data              TX buffer with message filled
+ * @param size              Size of payload, in bytes
+ * @param token             Completion token reported with RL_ALLOW_TX_TOKENS, RL_NULL for none
+ *
+ * @return Status of function execution, RL_SUCCESS on success.
+ *
+ */
+static int32_t rpmsg_lite_nocopy_tx(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                    struct rpmsg_lite_endpoint *ept,
+                                    uint32_t dst,
+                                    void *data,
+                                    uint32_t size,
+                                    void *token)
 {
     struct rpmsg_std_msg *rpmsg_msg;
+    struct virtqueue *tvq;
+    uint32_t queue;
     uint32_t src;
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    uintptr_t fc_timeout = RL_DONT_BLOCK;
+    uint32_t fc_flags;
+    uint16_t fc_gen;
+    int32_t status;
+#endif
 
     if ((ept == RL_NULL) || (data == RL_NULL))
     {
@@ -888,14 +5512,26 @@ int32_t rpmsg_lite_send_nocopy(struct rpmsg_lite_instance *rpmsg_lite_dev,
         return RL_NOT_READY;
     }
 
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    /* The buffer is allocated already, do not wait for a credit */
+    status = rpmsg_lite_fc_take(rpmsg_lite_dev, ept, dst, &fc_timeout, &fc_flags, &fc_gen);
+    if (status != RL_SUCCESS)
+    {
+        return status;
+    }
+#endif
+
     src = ept->addr;
 
     rpmsg_msg = RPMSG_STD_MSG_FROM_BUF(data);
+    /* The buffer goes back on the tvq it has been allocated from */
+    queue = rpmsg_lite_buffer_queue(rpmsg_lite_dev, rpmsg_msg);
+    tvq   = rpmsg_lite_dev->tvqs[queue];
 
 #if defined(RL_DEBUG_CHECK_BUFFERS) && (RL_DEBUG_CHECK_BUFFERS == 1)
     /* Check that the to-be-sent buffer is in the VirtIO ring descriptors list */
-    int32_t idx = rpmsg_lite_dev->tvq->vq_nentries - 1;
-    while ((idx >= 0) && (rpmsg_lite_dev->tvq->vq_ring.desc[idx].addr != (uint64_t)rpmsg_msg))
+    int32_t idx = tvq->vq_nentries - 1;
+    while ((idx >= 0) && (tvq->vq_ring.desc[idx].addr != (uint64_t)rpmsg_msg))
     {
         idx--;
     }
@@ -906,18 +5542,206 @@ int32_t rpmsg_lite_send_nocopy(struct rpmsg_lite_instance *rpmsg_lite_dev,
     rpmsg_msg->hdr.dst   = dst;
     rpmsg_msg->hdr.src   = src;
     rpmsg_msg->hdr.len   = (uint16_t)(size & 0xFFFFU);
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    rpmsg_msg->hdr.flags        = (uint16_t)(fc_flags & 0xFFFFU);
+    rpmsg_msg->hdr.reserved.rfu = (uint16_t)(fc_flags >> 16U);
+#else
     rpmsg_msg->hdr.flags = (uint16_t)(RL_NO_FLAGS & 0xFFFFU);
+#endif
 
-    env_lock_mutex(rpmsg_lite_dev->lock);
+    RL_TX_LOCK(rpmsg_lite_dev);
+#if defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)
+    /* Reported once the other side returns the buffer */
+    if (token != RL_NULL)
+    {
+        rpmsg_lite_dev->tx_sent_at[rpmsg_msg->hdr.reserved.idx] = env_get_timestamp();
+    }
+    rpmsg_lite_dev->tx_token[rpmsg_msg->hdr.reserved.idx] = token;
+#else
+    (void)token;
+#endif
     /* Enqueue buffer on virtqueue. */
-    rpmsg_lite_dev->vq_ops->vq_tx(
-        rpmsg_lite_dev->tvq, (void *)rpmsg_msg,
-        (uint32_t)virtqueue_get_buffer_length(rpmsg_lite_dev->tvq, rpmsg_msg->hdr.reserved.idx),
-        rpmsg_msg->hdr.reserved.idx);
+    rpmsg_lite_dev->vq_ops->vq_tx(tvq, (void *)rpmsg_msg,
+                                  (uint32_t)virtqueue_get_buffer_length(tvq, rpmsg_msg->hdr.reserved.idx),
+                                  rpmsg_msg->hdr.reserved.idx);
     /* Let the other side know that there is a job to process. */
-    virtqueue_kick(rpmsg_lite_dev->tvq);
-    env_unlock_mutex(rpmsg_lite_dev->lock);
+    rpmsg_lite_notify_tx(rpmsg_lite_dev, queue, RL_FALSE);
+    RL_TX_UNLOCK(rpmsg_lite_dev);
+
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    rpmsg_lite_fc_sent(rpmsg_lite_dev, ept, RL_SUCCESS, fc_flags, fc_gen);
+#endif
+
+    return RL_SUCCESS;
+}
+
+int32_t rpmsg_lite_send_nocopy(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                               struct rpmsg_lite_endpoint *ept,
+                               uint32_t dst,
+                               void *data,
+                               uint32_t size)
+{
+    return rpmsg_lite_nocopy_tx(rpmsg_lite_dev, ept, dst, data, size, RL_NULL);
+}
+
+#if defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)
+int32_t rpmsg_lite_send_nocopy_token(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                     struct rpmsg_lite_endpoint *ept,
+                                     uint32_t dst,
+                                     void *data,
+                                     uint32_t size,
+                                     void *token)
+{
+    return rpmsg_lite_nocopy_tx(rpmsg_lite_dev, ept, dst, data, size, token);
+}
+
+/*!
+ * @brief
+ * Internal function to take back the tx buffers returned by the other side
+ * and to report their tokens, the callback is called without the tx lock
+ * so that it may send the next message.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ *
+ */
+static void rpmsg_lite_tx_report(struct rpmsg_lite_instance *rpmsg_lite_dev)
+{
+    struct rpmsg_lite_tx_report report;
+    rl_tx_consumed_cb_t cb;
+    void *cb_data;
+
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    rpmsg_lite_tx_reclaim(rpmsg_lite_dev, 0U);
+    while (rpmsg_lite_dev->tx_report_cnt != 0U)
+    {
+        report                         = rpmsg_lite_dev->tx_report[rpmsg_lite_dev->tx_report_head];
+        rpmsg_lite_dev->tx_report_head = (rpmsg_lite_dev->tx_report_head + 1U) % (uint32_t)RL_BUFFER_COUNT;
+        rpmsg_lite_dev->tx_report_cnt--;
+        cb      = rpmsg_lite_dev->tx_consumed_cb;
+        cb_data = rpmsg_lite_dev->tx_consumed_cb_data;
+        RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+        if (cb != RL_NULL)
+        {
+            cb(report.token, report.sent_at, report.consumed_at, cb_data);
+        }
+
+        RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+        /* The buffers left in the tvq while the reports were full */
+        rpmsg_lite_tx_reclaim(rpmsg_lite_dev, 0U);
+    }
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+}
+
+int32_t rpmsg_lite_set_tx_consumed_cb(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                      rl_tx_consumed_cb_t cb,
+                                      void *cb_data)
+{
+    if (rpmsg_lite_dev == RL_NULL)
+    {
+        return RL_ERR_PARAM;
+    }
+
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    rpmsg_lite_dev->tx_consumed_cb      = cb;
+    rpmsg_lite_dev->tx_consumed_cb_data = cb_data;
+    if (cb == RL_NULL)
+    {
+        /* Nobody to report to, the queued reports are dropped */
+        rpmsg_lite_dev->tx_report_cnt = 0U;
+    }
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+    return RL_SUCCESS;
+}
+
+int32_t rpmsg_lite_poll_tx_consumed(struct rpmsg_lite_instance *rpmsg_lite_dev)
+{
+    if (rpmsg_lite_dev == RL_NULL)
+    {
+        return RL_ERR_PARAM;
+    }
+
+    if (rpmsg_lite_dev->link_state != RL_TRUE)
+    {
+        return RL_NOT_READY;
+    }
+
+    rpmsg_lite_tx_report(rpmsg_lite_dev);
+
+    return RL_SUCCESS;
+}
+#endif /* RL_ALLOW_TX_TOKENS */
+
+int32_t rpmsg_lite_send_nocopy_batch(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                     const struct rpmsg_lite_batch_entry *entries,
+                                     uint32_t count,
+                                     uint32_t *sent)
+{
+    struct rpmsg_std_msg *rpmsg_msg;
+    struct virtqueue *tvq;
+    uint32_t queue;
+    uint32_t tx_queued = 0U;
+    uint32_t i;
+    int32_t status;
+
+    if ((rpmsg_lite_dev == RL_NULL) || (entries == RL_NULL) || (sent == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    *sent  = 0U;
+    status = rpmsg_lite_check_batch(rpmsg_lite_dev, entries, count);
+    if ((status != RL_SUCCESS) || (count == 0U))
+    {
+        return status;
+    }
+
+    for (i = 0U; i < count; i++)
+    {
+        rpmsg_msg = RPMSG_STD_MSG_FROM_BUF(entries[i].data);
+
+#if defined(RL_DEBUG_CHECK_BUFFERS) && (RL_DEBUG_CHECK_BUFFERS == 1)
+        /* Check that the to-be-sent buffer is in the VirtIO ring descriptors list */
+        tvq         = rpmsg_lite_dev->tvqs[rpmsg_lite_buffer_queue(rpmsg_lite_dev, rpmsg_msg)];
+        int32_t idx = tvq->vq_nentries - 1;
+        while ((idx >= 0) && (tvq->vq_ring.desc[idx].addr != (uint64_t)rpmsg_msg))
+        {
+            idx--;
+        }
+        RL_ASSERT(idx >= 0);
+#endif
 
+        /* Initialize RPMSG header. */
+        rpmsg_msg->hdr.dst   = entries[i].dst;
+        rpmsg_msg->hdr.src   = entries[i].ept->addr;
+        rpmsg_msg->hdr.len   = (uint16_t)(entries[i].size & 0xFFFFU);
+        rpmsg_msg->hdr.flags = (uint16_t)(RL_NO_FLAGS & 0xFFFFU);
+    }
+
+    RL_TX_MUTEX_LOCK(rpmsg_lite_dev);
+    for (i = 0U; i < count; i++)
+    {
+        rpmsg_msg = RPMSG_STD_MSG_FROM_BUF(entries[i].data);
+        queue     = rpmsg_lite_buffer_queue(rpmsg_lite_dev, rpmsg_msg);
+        tvq       = rpmsg_lite_dev->tvqs[queue];
+        /* Enqueue buffer on virtqueue. */
+        rpmsg_lite_dev->vq_ops->vq_tx(tvq, (void *)rpmsg_msg,
+                                      (uint32_t)virtqueue_get_buffer_length(tvq, rpmsg_msg->hdr.reserved.idx),
+                                      rpmsg_msg->hdr.reserved.idx);
+        tx_queued |= 1UL << queue;
+    }
+    /* Let the other side know that there is a job to process, once for the whole batch. */
+    for (queue = 0U; queue < (uint32_t)RL_QUEUE_PAIR_COUNT; queue++)
+    {
+        if ((tx_queued & (1UL << queue)) != 0U)
+        {
+            rpmsg_lite_notify_tx(rpmsg_lite_dev, queue, RL_FALSE);
+        }
+    }
+    RL_TX_MUTEX_UNLOCK(rpmsg_lite_dev);
+
+    *sent = count;
     return RL_SUCCESS;
 }
 
@@ -934,6 +5758,14 @@ int32_t rpmsg_lite_send_nocopy(struct rpmsg_lite_instance *rpmsg_lite_dev,
 int32_t rpmsg_lite_release_rx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev, void *rxbuf)
 {
     struct rpmsg_std_msg *rpmsg_msg;
+    struct virtqueue *rvq;
+    uint16_t buf_idx;
+#if defined(RL_ALLOW_MSG_PACKING) && (RL_ALLOW_MSG_PACKING == 1)
+    uint32_t refs;
+#endif
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    struct rpmsg_lite_endpoint *fc_ept;
+#endif
 
     if (rpmsg_lite_dev == RL_NULL)
     {
@@ -946,36 +5778,178 @@ int32_t rpmsg_lite_release_rx_buffer(struct rpmsg_lite_instance *rpmsg_lite_dev,
 
     rpmsg_msg = RPMSG_STD_MSG_FROM_BUF(rxbuf);
 
-#if defined(RL_DEBUG_CHECK_BUFFERS) && (RL_DEBUG_CHECK_BUFFERS == 1)
-    /* Check that the to-be-released buffer is in the VirtIO ring descriptors list */
-    int32_t idx = rpmsg_lite_dev->rvq->vq_nentries - 1;
-    while ((idx >= 0) && (rpmsg_lite_dev->rvq->vq_ring.desc[idx].addr != (uint64_t)rpmsg_msg))
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    /* Read before the buffer goes back to the other side */
+    fc_ept = rpmsg_lite_fc_held_ept(rpmsg_lite_dev, &rpmsg_msg->hdr);
+#endif
+
+#if defined(RL_ALLOW_MSG_PACKING) && (RL_ALLOW_MSG_PACKING == 1)
+    if ((rpmsg_msg->hdr.flags & RL_MSG_FLAG_PACKED_REC) != 0U)
+    {
+        /* Packed message, drop its reference to the container and return the container with the last one */
+        rpmsg_msg = (struct rpmsg_std_msg *)(void *)((char *)rpmsg_msg - rpmsg_msg->hdr.reserved.rfu);
+        env_lock_mutex(rpmsg_lite_dev->rx_lock);
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+        env_disable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->rvq->vq_queue_index);
+#else
+        env_disable_interrupt(rpmsg_lite_dev->rvq->vq_queue_index);
+#endif
+        rpmsg_msg->hdr.reserved.rfu--;
+        refs = rpmsg_msg->hdr.reserved.rfu;
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+        env_enable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->rvq->vq_queue_index);
+#else
+        env_enable_interrupt(rpmsg_lite_dev->rvq->vq_queue_index);
+#endif
+        env_unlock_mutex(rpmsg_lite_dev->rx_lock);
+        if (refs != 0U)
+        {
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+            /* Each record counts against the window of its endpoint */
+            rpmsg_lite_fc_released(rpmsg_lite_dev, fc_ept);
+#endif
+            return RL_SUCCESS;
+        }
+    }
+#endif
+
+    /* The buffer goes back on the rvq it has been received from */
+    rvq = rpmsg_lite_dev->rvqs[rpmsg_lite_buffer_queue(rpmsg_lite_dev, rpmsg_msg)];
+
+#if defined(RL_DEBUG_CHECK_BUFFERS) && (RL_DEBUG_CHECK_BUFFERS == 1)
+    /* Check that the to-be-released buffer is in the VirtIO ring descriptors list */
+    int32_t idx = rvq->vq_nentries - 1;
+    while ((idx >= 0) && (rvq->vq_ring.desc[idx].addr != (uint64_t)rpmsg_msg))
+    {
+        idx--;
+    }
+    RL_ASSERT(idx >= 0);
+#endif
+
+    env_lock_mutex(rpmsg_lite_dev->rx_lock);
+
+#if defined(RL_ALLOW_GROUP_ENDPOINTS) && (RL_ALLOW_GROUP_ENDPOINTS == 1)
+    /* A message of a group endpoint goes back with the last subscriber reference */
+    if (rpmsg_lite_rx_group_unref(rpmsg_lite_dev, rpmsg_msg) != 0U)
+    {
+        env_unlock_mutex(rpmsg_lite_dev->rx_lock);
+        return RL_SUCCESS;
+    }
+#endif
+
+    /* Return used buffer, with total length (header length + buffer size). */
+    buf_idx = rpmsg_lite_rx_unhold(rvq, rpmsg_msg);
+    rpmsg_lite_dev->vq_ops->vq_rx_free(rvq, rpmsg_msg, (uint32_t)virtqueue_get_buffer_length(rvq, buf_idx), buf_idx);
+
+#if defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
+    /* Let the remote device know that a buffer has been freed */
+    virtqueue_kick(rvq);
+#endif
+
+    env_unlock_mutex(rpmsg_lite_dev->rx_lock);
+
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    rpmsg_lite_fc_released(rpmsg_lite_dev, fc_ept);
+#endif
+
+    return RL_SUCCESS;
+}
+
+#endif /* RL_API_HAS_ZEROCOPY */
+
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+/*!
+ * @brief
+ * Internal function to create the sync locks the senders
+ * wait on for tx buffers, one per queue pair.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ *
+ * @return  Status of function execution, none of the locks is left created on failure
+ *
+ */
+static int32_t rpmsg_lite_create_tx_wait_locks(struct rpmsg_lite_instance *rpmsg_lite_dev)
+{
+    int32_t status = RL_SUCCESS;
+    uint32_t q;
+
+    for (q = 0U; (q < (uint32_t)RL_QUEUE_PAIR_COUNT) && (status == RL_SUCCESS); q++)
+    {
+        rpmsg_lite_dev->tx_waiters[q] = 0U;
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+        status = env_create_sync_lock((LOCK *)&rpmsg_lite_dev->tx_wait_lock[q], LOCKED,
+                                      &rpmsg_lite_dev->tx_wait_lock_static_ctxt[q]);
+#else
+        status = env_create_sync_lock((LOCK *)&rpmsg_lite_dev->tx_wait_lock[q], LOCKED);
+#endif
+    }
+
+    if (status != RL_SUCCESS)
+    {
+        /* q is one past the lock failed to create */
+        q--;
+        while (q > 0U)
+        {
+            q--;
+            env_delete_sync_lock(rpmsg_lite_dev->tx_wait_lock[q]);
+        }
+    }
+
+    return status;
+}
+
+/*!
+ * @brief
+ * Internal function to delete the sync locks the senders
+ * wait on for tx buffers.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ *
+ */
+static void rpmsg_lite_delete_tx_wait_locks(struct rpmsg_lite_instance *rpmsg_lite_dev)
+{
+    uint32_t q;
+
+    for (q = 0U; q < (uint32_t)RL_QUEUE_PAIR_COUNT; q++)
+    {
+        env_delete_sync_lock(rpmsg_lite_dev->tx_wait_lock[q]);
+    }
+}
+#endif /* defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1) */
+
+/*!
+ * @brief
+ * Internal function to assign the virtqueues of all queue pairs
+ * to the instance and to reset the rx queue policy.
+ *
+ * @param rpmsg_lite_dev    RPMsg Lite instance
+ * @param vqs               Virtqueues, the two of each queue pair in turn
+ * @param rx_index          Index of the rvq within a queue pair, 0 for the master and 1 for the remote
+ *
+ */
+static void rpmsg_lite_init_queues(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                   struct virtqueue **vqs,
+                                   uint32_t rx_index)
+{
+    uint32_t q;
+
+    for (q = 0U; q < (uint32_t)RL_QUEUE_PAIR_COUNT; q++)
     {
-        idx--;
-    }
-    RL_ASSERT(idx >= 0);
+        rpmsg_lite_dev->rvqs[q] = vqs[(2U * q) + rx_index];
+        rpmsg_lite_dev->tvqs[q] = vqs[(2U * q) + (1U - rx_index)];
+#if (RL_QUEUE_PAIR_COUNT > 1)
+        rpmsg_lite_dev->rx_weights[q] = 1U;
 #endif
-
-    env_lock_mutex(rpmsg_lite_dev->lock);
-
-    /* Return used buffer, with total length (header length + buffer size). */
-    rpmsg_lite_dev->vq_ops->vq_rx_free(
-        rpmsg_lite_dev->rvq, rpmsg_msg,
-        (uint32_t)virtqueue_get_buffer_length(rpmsg_lite_dev->rvq, rpmsg_msg->hdr.reserved.idx),
-        rpmsg_msg->hdr.reserved.idx);
-
-#if defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
-    /* Let the remote device know that a buffer has been freed */
-    virtqueue_kick(rpmsg_lite_dev->rvq);
+    }
+    rpmsg_lite_dev->rvq = rpmsg_lite_dev->rvqs[0];
+    rpmsg_lite_dev->tvq = rpmsg_lite_dev->tvqs[0];
+#if (RL_QUEUE_PAIR_COUNT > 1)
+    rpmsg_lite_dev->rx_policy = RL_QUEUE_POLICY_PRIORITY;
+    rpmsg_lite_dev->rx_queue  = 0U;
+    rpmsg_lite_dev->rx_credit = 1U;
 #endif
-
-    env_unlock_mutex(rpmsg_lite_dev->lock);
-
-    return RL_SUCCESS;
 }
 
-#endif /* RL_API_HAS_ZEROCOPY */
-
 /******************************
 
  mmmmm  mm   m mmmmm mmmmmmm
@@ -1005,9 +5979,9 @@ struct rpmsg_lite_instance *rpmsg_lite_master_init(void *shmem_addr,
     void (*callback[2])(struct virtqueue *vq);
     const char *vq_names[2];
     struct vring_alloc_info ring_info;
-    struct virtqueue *vqs[2] = {0};
+    struct virtqueue *vqs[2U * RL_QUEUE_PAIR_COUNT] = {0};
     void *buffer;
-    uint32_t idx, j;
+    uint32_t idx, j, q;
     struct rpmsg_lite_instance *rpmsg_lite_dev = RL_NULL;
 
     if (link_id > RL_PLATFORM_HIGHEST_LINK_ID)
@@ -1083,6 +6057,20 @@ struct rpmsg_lite_instance *rpmsg_lite_master_init(void *shmem_addr,
         return RL_NULL; /* GCOVR_EXCL_LINE */
     }
 
+#if (defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)) || \
+    (defined(RL_ALLOW_TX_LIFO) && (RL_ALLOW_TX_LIFO == 1)) ||                           \
+    (defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)) ||                   \
+    (defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)) ||                         \
+    (defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)) ||                       \
+    (defined(RL_ALLOW_GROUP_ENDPOINTS) && (RL_ALLOW_GROUP_ENDPOINTS == 1))
+    /* The multi producer virtqueue, the tx LIFO, the descriptor shadow, the tx quota,
+       the tx tokens and the group endpoints keep per-buffer state sized by RL_BUFFER_COUNT */
+    if (shmem_config.buffer_count > (uint16_t)RL_BUFFER_COUNT)
+    {
+        return RL_NULL;
+    }
+#endif
+
     /* buffer size must be more than 0 bytes */
     /*
      * $Branch Coverage Justification$
@@ -1119,9 +6107,9 @@ struct rpmsg_lite_instance *rpmsg_lite_master_init(void *shmem_addr,
         return RL_NULL; /* GCOVR_EXCL_LINE */
     }
 #else
-    if ((2U * (uint32_t)RL_BUFFER_COUNT) >
+    if ((2U * (uint32_t)RL_BUFFER_COUNT * (uint32_t)RL_QUEUE_PAIR_COUNT) >
         RL_CALCULATE_BUFFER_COUNT_DOWN_SAFE(shmem_length,
-                                            (uint32_t)RL_VRING_OVERHEAD,
+                                            (uint32_t)RL_QUEUE_PAIR_COUNT * (uint32_t)RL_VRING_OVERHEAD,
                                             (uint32_t)RL_BUFFER_SIZE))
     {
         return RL_NULL;
@@ -1166,6 +6154,9 @@ struct rpmsg_lite_instance *rpmsg_lite_master_init(void *shmem_addr,
     }
 
     rpmsg_lite_dev->link_id = link_id;
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    rpmsg_lite_dev->fc_sync_src = RL_ADDR_ANY;
+#endif
 
     /*
      * Since device is RPMSG Remote so we need to manage the
@@ -1178,10 +6169,12 @@ struct rpmsg_lite_instance *rpmsg_lite_master_init(void *shmem_addr,
                                                                            2U * shmem_config.vring_size,
                                                                            (uint32_t)RL_WORD_ALIGN_UP(shmem_config.buffer_payload_size + 16UL));
 #else
-    rpmsg_lite_dev->sh_mem_base = (char *)RL_WORD_ALIGN_UP((uintptr_t)(char *)shmem_addr + (uint32_t)RL_VRING_OVERHEAD);
-    rpmsg_lite_dev->sh_mem_remaining = RL_CALCULATE_BUFFER_COUNT_DOWN_SAFE(shmem_length,
-                                                                           (uint32_t)RL_VRING_OVERHEAD,
-                                                                           (uint32_t)RL_BUFFER_SIZE);
+    /* The vrings of all queue pairs are placed in front of the buffers */
+    rpmsg_lite_dev->sh_mem_base = (char *)RL_WORD_ALIGN_UP((uintptr_t)(char *)shmem_addr +
+                                                           (uint32_t)RL_QUEUE_PAIR_COUNT * (uint32_t)RL_VRING_OVERHEAD);
+    rpmsg_lite_dev->sh_mem_remaining =
+        RL_CALCULATE_BUFFER_COUNT_DOWN_SAFE(shmem_length, (uint32_t)RL_QUEUE_PAIR_COUNT * (uint32_t)RL_VRING_OVERHEAD,
+                                            (uint32_t)RL_BUFFER_SIZE);
 #endif /* defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1) */
     rpmsg_lite_dev->sh_mem_total = rpmsg_lite_dev->sh_mem_remaining;
 
@@ -1192,8 +6185,8 @@ struct rpmsg_lite_instance *rpmsg_lite_master_init(void *shmem_addr,
     callback[1]            = rpmsg_lite_tx_callback;
     rpmsg_lite_dev->vq_ops = &master_vq_ops;
 
-    /* Create virtqueue for each vring. */
-    for (idx = 0U; idx < 2U; idx++)
+    /* Create virtqueue for each vring, the rx and the tx one of each queue pair in turn. */
+    for (idx = 0U; idx < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); idx++)
     {
 #if defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1)
         ring_info.phy_addr  = (void *)(char *)((uintptr_t)(char *)RL_WORD_ALIGN_UP((uintptr_t)(char *)shmem_addr) +
@@ -1202,7 +6195,8 @@ struct rpmsg_lite_instance *rpmsg_lite_master_init(void *shmem_addr,
         ring_info.num_descs = shmem_config.buffer_count;
 #else
         ring_info.phy_addr  = (void *)(char *)((uintptr_t)(char *)RL_WORD_ALIGN_UP((uintptr_t)(char *)shmem_addr) +
-                                              (uint32_t)((idx == 0U) ? (0U) : (VRING_SIZE)));
+                                              ((idx / 2U) * (uint32_t)RL_VRING_OVERHEAD) +
+                                              (uint32_t)(((idx & 1U) == 0U) ? (0U) : (VRING_SIZE)));
         ring_info.align     = VRING_ALIGN;
         ring_info.num_descs = RL_BUFFER_COUNT;
 #endif /* defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1) */
@@ -1210,12 +6204,12 @@ struct rpmsg_lite_instance *rpmsg_lite_master_init(void *shmem_addr,
         env_memset((void *)ring_info.phy_addr, 0x00, (uint32_t)vring_size(ring_info.num_descs, ring_info.align));
 
 #if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
-        status = virtqueue_create_static((uint16_t)(RL_GET_VQ_ID(link_id, idx)), vq_names[idx], &ring_info,
-                                         callback[idx], virtqueue_notify, &vqs[idx],
+        status = virtqueue_create_static((uint16_t)(RL_GET_VQ_ID(link_id, idx & 1U)), vq_names[idx & 1U], &ring_info,
+                                         callback[idx & 1U], virtqueue_notify, &vqs[idx],
                                          (struct vq_static_context *)&rpmsg_lite_dev->vq_ctxt[idx]);
 #else
-        status = virtqueue_create((uint16_t)(RL_GET_VQ_ID(link_id, idx)), vq_names[idx], &ring_info, callback[idx],
-                                  virtqueue_notify, &vqs[idx]);
+        status = virtqueue_create((uint16_t)(RL_GET_VQ_ID(link_id, idx & 1U)), vq_names[idx & 1U], &ring_info,
+                                  callback[idx & 1U], virtqueue_notify, &vqs[idx]);
 #endif /* RL_USE_STATIC_API */
 
         if (status == RL_SUCCESS)
@@ -1232,7 +6226,7 @@ struct rpmsg_lite_instance *rpmsg_lite_master_init(void *shmem_addr,
         {
 #if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
             /* Free all already allocated memory for virtqueues */
-            for (uint32_t a = 0U; a < 2U; a++)
+            for (uint32_t a = 0U; a < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); a++)
             {
                 if (RL_NULL != vqs[a])
                 {
@@ -1260,7 +6254,155 @@ struct rpmsg_lite_instance *rpmsg_lite_master_init(void *shmem_addr,
     {
 #if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
         /* Free all already allocated memory for virtqueues */
-        for (uint32_t b = 0U; b < 2U; b++)
+        for (uint32_t b = 0U; b < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); b++)
+        {
+            virtqueue_free(vqs[b]);
+        }
+        env_free_memory(rpmsg_lite_dev);
+#endif
+        return RL_NULL;
+    }
+
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    status = env_create_mutex((LOCK *)&rpmsg_lite_dev->tx_lock, 1, &rpmsg_lite_dev->tx_lock_static_ctxt);
+#else
+    status = env_create_mutex((LOCK *)&rpmsg_lite_dev->tx_lock, 1);
+#endif
+    if (status != RL_SUCCESS)
+    {
+        env_delete_mutex(rpmsg_lite_dev->lock);
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+        /* Free all already allocated memory for virtqueues */
+        for (uint32_t b = 0U; b < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); b++)
+        {
+            virtqueue_free(vqs[b]);
+        }
+        env_free_memory(rpmsg_lite_dev);
+#endif
+        return RL_NULL;
+    }
+
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    status = env_create_mutex((LOCK *)&rpmsg_lite_dev->rx_lock, 1, &rpmsg_lite_dev->rx_lock_static_ctxt);
+#else
+    status = env_create_mutex((LOCK *)&rpmsg_lite_dev->rx_lock, 1);
+#endif
+    if (status != RL_SUCCESS)
+    {
+        env_delete_mutex(rpmsg_lite_dev->lock);
+        env_delete_mutex(rpmsg_lite_dev->tx_lock);
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+        /* Free all already allocated memory for virtqueues */
+        for (uint32_t b = 0U; b < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); b++)
+        {
+            virtqueue_free(vqs[b]);
+        }
+        env_free_memory(rpmsg_lite_dev);
+#endif
+        return RL_NULL;
+    }
+
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+    status = rpmsg_lite_create_tx_wait_locks(rpmsg_lite_dev);
+    if (status != RL_SUCCESS)
+    {
+        env_delete_mutex(rpmsg_lite_dev->lock);
+        env_delete_mutex(rpmsg_lite_dev->tx_lock);
+        env_delete_mutex(rpmsg_lite_dev->rx_lock);
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+        /* Free all already allocated memory for virtqueues */
+        for (uint32_t b = 0U; b < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); b++)
+        {
+            virtqueue_free(vqs[b]);
+        }
+        env_free_memory(rpmsg_lite_dev);
+#endif
+        return RL_NULL;
+    }
+#endif
+
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+    rpmsg_lite_dev->rx_deferred  = RL_FALSE;
+    rpmsg_lite_dev->rx_carry_msg = RL_NULL;
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    status = env_create_sync_lock((LOCK *)&rpmsg_lite_dev->rx_worker_lock, LOCKED,
+                                  &rpmsg_lite_dev->rx_worker_lock_static_ctxt);
+#else
+    status = env_create_sync_lock((LOCK *)&rpmsg_lite_dev->rx_worker_lock, LOCKED);
+#endif
+    if (status != RL_SUCCESS)
+    {
+        env_delete_mutex(rpmsg_lite_dev->lock);
+        env_delete_mutex(rpmsg_lite_dev->tx_lock);
+        env_delete_mutex(rpmsg_lite_dev->rx_lock);
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+        rpmsg_lite_delete_tx_wait_locks(rpmsg_lite_dev);
+#endif
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+        /* Free all already allocated memory for virtqueues */
+        for (uint32_t b = 0U; b < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); b++)
+        {
+            virtqueue_free(vqs[b]);
+        }
+        env_free_memory(rpmsg_lite_dev);
+#endif
+        return RL_NULL;
+    }
+#endif
+
+#if defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1)
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    status = env_create_sync_lock((LOCK *)&rpmsg_lite_dev->notify_worker_lock, LOCKED,
+                                  &rpmsg_lite_dev->notify_worker_lock_static_ctxt);
+#else
+    status = env_create_sync_lock((LOCK *)&rpmsg_lite_dev->notify_worker_lock, LOCKED);
+#endif
+    if (status != RL_SUCCESS)
+    {
+        env_delete_mutex(rpmsg_lite_dev->lock);
+        env_delete_mutex(rpmsg_lite_dev->tx_lock);
+        env_delete_mutex(rpmsg_lite_dev->rx_lock);
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+        rpmsg_lite_delete_tx_wait_locks(rpmsg_lite_dev);
+#endif
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+        env_delete_sync_lock(rpmsg_lite_dev->rx_worker_lock);
+#endif
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+        /* Free all already allocated memory for virtqueues */
+        for (uint32_t b = 0U; b < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); b++)
+        {
+            virtqueue_free(vqs[b]);
+        }
+        env_free_memory(rpmsg_lite_dev);
+#endif
+        return RL_NULL;
+    }
+#endif
+
+#if defined(RL_ALLOW_FRAGMENTATION) && (RL_ALLOW_FRAGMENTATION == 1)
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    status = env_create_mutex((LOCK *)&rpmsg_lite_dev->frag_lock, 1, &rpmsg_lite_dev->frag_lock_static_ctxt);
+#else
+    status = env_create_mutex((LOCK *)&rpmsg_lite_dev->frag_lock, 1);
+#endif
+    if (status != RL_SUCCESS)
+    {
+        env_delete_mutex(rpmsg_lite_dev->lock);
+        env_delete_mutex(rpmsg_lite_dev->tx_lock);
+        env_delete_mutex(rpmsg_lite_dev->rx_lock);
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+        rpmsg_lite_delete_tx_wait_locks(rpmsg_lite_dev);
+#endif
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+        env_delete_sync_lock(rpmsg_lite_dev->rx_worker_lock);
+#endif
+#if defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1)
+        env_delete_sync_lock(rpmsg_lite_dev->notify_worker_lock);
+#endif
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+        /* Free all already allocated memory for virtqueues */
+        for (uint32_t b = 0U; b < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); b++)
         {
             virtqueue_free(vqs[b]);
         }
@@ -1268,12 +6410,20 @@ struct rpmsg_lite_instance *rpmsg_lite_master_init(void *shmem_addr,
 #endif
         return RL_NULL;
     }
+#endif
 
     // FIXME - a better way to handle this , tx for master is rx for remote and vice versa.
-    rpmsg_lite_dev->tvq = vqs[1];
-    rpmsg_lite_dev->rvq = vqs[0];
+    rpmsg_lite_init_queues(rpmsg_lite_dev, vqs, 0U);
+#if defined(RL_ALLOW_TX_STASH) && (RL_ALLOW_TX_STASH == 1)
+    /* Keep at least half of the tx buffers out of the endpoint stashes */
+    rpmsg_lite_dev->tx_stash_limit = (uint32_t)rpmsg_lite_dev->tvq->vq_nentries / 2U;
+    if (rpmsg_lite_dev->tx_stash_limit > ((uint32_t)RL_BUFFER_COUNT / 2U))
+    {
+        rpmsg_lite_dev->tx_stash_limit = (uint32_t)RL_BUFFER_COUNT / 2U;
+    }
+#endif
 
-    for (j = 0U; j < 2U; j++)
+    for (j = 0U; j < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); j++)
     {
         for (idx = 0U; ((idx < vqs[j]->vq_nentries) && (idx < rpmsg_lite_dev->sh_mem_total)); idx++)
         {
@@ -1306,7 +6456,7 @@ struct rpmsg_lite_instance *rpmsg_lite_master_init(void *shmem_addr,
             env_memset(buffer, 0x00, buff_size);
             env_cache_flush(buffer, buff_size);
 #endif /* defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1) */
-            if (vqs[j] == rpmsg_lite_dev->rvq)
+            if (vqs[j] == rpmsg_lite_dev->rvqs[j / 2U])
             {
 #if defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1)
                 status =
@@ -1319,7 +6469,7 @@ struct rpmsg_lite_instance *rpmsg_lite_master_init(void *shmem_addr,
              * $Branch Coverage Justification$
              * Not able to reach the false condition unless RAM is corrupted.
              */
-            else if (vqs[j] == rpmsg_lite_dev->tvq) /* GCOVR_EXCL_BR_LINE */
+            else if (vqs[j] == rpmsg_lite_dev->tvqs[j / 2U]) /* GCOVR_EXCL_BR_LINE */
             {
 #if defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1)
                 status =
@@ -1341,8 +6491,22 @@ struct rpmsg_lite_instance *rpmsg_lite_master_init(void *shmem_addr,
             {
                 /* Clean up! */
                 env_delete_mutex(rpmsg_lite_dev->lock);
+                env_delete_mutex(rpmsg_lite_dev->tx_lock);
+                env_delete_mutex(rpmsg_lite_dev->rx_lock);
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+                rpmsg_lite_delete_tx_wait_locks(rpmsg_lite_dev);
+#endif
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+                env_delete_sync_lock(rpmsg_lite_dev->rx_worker_lock);
+#endif
+#if defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1)
+                env_delete_sync_lock(rpmsg_lite_dev->notify_worker_lock);
+#endif
+#if defined(RL_ALLOW_FRAGMENTATION) && (RL_ALLOW_FRAGMENTATION == 1)
+                env_delete_mutex(rpmsg_lite_dev->frag_lock);
+#endif
 #if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
-                for (uint32_t c = 0U; c < 2U; c++)
+                for (uint32_t c = 0U; c < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); c++)
                 {
                     virtqueue_free(vqs[c]);
                 }
@@ -1354,7 +6518,28 @@ struct rpmsg_lite_instance *rpmsg_lite_master_init(void *shmem_addr,
         }
     }
 
-    /* Install ISRs */
+    for (q = 0U; q < (uint32_t)RL_QUEUE_PAIR_COUNT; q++)
+    {
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+        /* The tx buffers are in place, from now on the tvq is shared by the senders without a lock */
+        (void)virtqueue_enable_multi_producer(rpmsg_lite_dev->tvqs[q]);
+#endif
+#if defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1)
+        /* The prefilled tx buffers are no messages, keep them out of the notification threshold and counters */
+        rpmsg_lite_dev->tvqs[q]->vq_queued_cnt = 0U;
+#endif
+
+        /* Initialization completed, let the remote device notify us again */
+        (void)virtqueue_enable_cb(rpmsg_lite_dev->rvqs[q]);
+        (void)virtqueue_enable_cb(rpmsg_lite_dev->tvqs[q]);
+#if defined(RL_ALLOW_VRING_EVENT_IDX) && (RL_ALLOW_VRING_EVENT_IDX == 1)
+        /* Publish our event indexes, the remote notifies only when they are crossed */
+        virtqueue_enable_event_idx(rpmsg_lite_dev->rvqs[q]);
+        virtqueue_enable_event_idx(rpmsg_lite_dev->tvqs[q]);
+#endif
+    }
+
+    /* Install ISRs, the queue pairs share the interrupts of queue pair 0 */
 #if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
     env_init_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->rvq->vq_queue_index, rpmsg_lite_dev->rvq);
     env_init_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->tvq->vq_queue_index, rpmsg_lite_dev->tvq);
@@ -1400,7 +6585,7 @@ struct rpmsg_lite_instance *rpmsg_lite_remote_init(void *shmem_addr, uint32_t li
     void (*callback[2])(struct virtqueue *vq);
     const char *vq_names[2];
     struct vring_alloc_info ring_info;
-    struct virtqueue *vqs[2] = {0};
+    struct virtqueue *vqs[2U * RL_QUEUE_PAIR_COUNT] = {0};
     uint32_t idx;
     struct rpmsg_lite_instance *rpmsg_lite_dev = RL_NULL;
 
@@ -1441,6 +6626,20 @@ struct rpmsg_lite_instance *rpmsg_lite_remote_init(void *shmem_addr, uint32_t li
         return RL_NULL; /* GCOVR_EXCL_LINE */
     }
 
+#if (defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)) || \
+    (defined(RL_ALLOW_TX_LIFO) && (RL_ALLOW_TX_LIFO == 1)) ||                           \
+    (defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)) ||                   \
+    (defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)) ||                         \
+    (defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)) ||                       \
+    (defined(RL_ALLOW_GROUP_ENDPOINTS) && (RL_ALLOW_GROUP_ENDPOINTS == 1))
+    /* The multi producer virtqueue, the tx LIFO, the descriptor shadow, the tx quota,
+       the tx tokens and the group endpoints keep per-buffer state sized by RL_BUFFER_COUNT */
+    if (shmem_config.buffer_count > (uint16_t)RL_BUFFER_COUNT)
+    {
+        return RL_NULL;
+    }
+#endif
+
     /* buffer size must be more than 0 bytes */
     /*
      * $Branch Coverage Justification$
@@ -1498,6 +6697,9 @@ struct rpmsg_lite_instance *rpmsg_lite_remote_init(void *shmem_addr, uint32_t li
     }
 
     rpmsg_lite_dev->link_id = link_id;
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    rpmsg_lite_dev->fc_sync_src = RL_ADDR_ANY;
+#endif
 
     vq_names[0]            = "tx_vq"; /* swapped in case of remote */
     vq_names[1]            = "rx_vq";
@@ -1508,11 +6710,13 @@ struct rpmsg_lite_instance *rpmsg_lite_remote_init(void *shmem_addr, uint32_t li
     rpmsg_lite_dev->sh_mem_base =
         (char *)RL_WORD_ALIGN_UP((uintptr_t)(char *)shmem_addr + 2U * shmem_config.vring_size);
 #else
-    rpmsg_lite_dev->sh_mem_base = (char *)RL_WORD_ALIGN_UP((uintptr_t)(char *)shmem_addr + (uint32_t)RL_VRING_OVERHEAD);
+    /* The vrings of all queue pairs are placed in front of the buffers */
+    rpmsg_lite_dev->sh_mem_base = (char *)RL_WORD_ALIGN_UP((uintptr_t)(char *)shmem_addr +
+                                                           (uint32_t)RL_QUEUE_PAIR_COUNT * (uint32_t)RL_VRING_OVERHEAD);
 #endif /* defined(RL_ALLOW_CUSTOM_VRING_CONFIG) && (RL_ALLOW_CUSTOM_VRING_CONFIG == 1) */
 
-    /* Create virtqueue for each vring. */
-    for (idx = 0U; idx < 2U; idx++)
+    /* Create virtqueue for each vring, the tx and the rx one of each queue pair in turn. */
+    for (idx = 0U; idx < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); idx++)
     {
 #if defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1)
         ring_info.phy_addr  = (void *)(char *)((uintptr_t)(char *)RL_WORD_ALIGN_UP((uintptr_t)(char *)shmem_addr) +
@@ -1521,25 +6725,26 @@ struct rpmsg_lite_instance *rpmsg_lite_remote_init(void *shmem_addr, uint32_t li
         ring_info.num_descs = shmem_config.buffer_count;
 #else
         ring_info.phy_addr  = (void *)(char *)((uintptr_t)(char *)RL_WORD_ALIGN_UP((uintptr_t)(char *)shmem_addr) +
-                                              (uint32_t)((idx == 0U) ? (0U) : (VRING_SIZE)));
+                                              ((idx / 2U) * (uint32_t)RL_VRING_OVERHEAD) +
+                                              (uint32_t)(((idx & 1U) == 0U) ? (0U) : (VRING_SIZE)));
         ring_info.align     = VRING_ALIGN;
         ring_info.num_descs = RL_BUFFER_COUNT;
 #endif /* defined(RL_ALLOW_CUSTOM_VRING_CONFIG) && (RL_ALLOW_CUSTOM_VRING_CONFIG == 1) */
 
 #if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
-        status = virtqueue_create_static((uint16_t)(RL_GET_VQ_ID(link_id, idx)), vq_names[idx], &ring_info,
-                                         callback[idx], virtqueue_notify, &vqs[idx],
+        status = virtqueue_create_static((uint16_t)(RL_GET_VQ_ID(link_id, idx & 1U)), vq_names[idx & 1U], &ring_info,
+                                         callback[idx & 1U], virtqueue_notify, &vqs[idx],
                                          (struct vq_static_context *)&rpmsg_lite_dev->vq_ctxt[idx]);
 #else
-        status = virtqueue_create((uint16_t)(RL_GET_VQ_ID(link_id, idx)), vq_names[idx], &ring_info, callback[idx],
-                                  virtqueue_notify, &vqs[idx]);
+        status = virtqueue_create((uint16_t)(RL_GET_VQ_ID(link_id, idx & 1U)), vq_names[idx & 1U], &ring_info,
+                                  callback[idx & 1U], virtqueue_notify, &vqs[idx]);
 #endif /* RL_USE_STATIC_API */
 
         if (status != RL_SUCCESS)
         {
 #if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
             /* Free all already allocated memory for virtqueues */
-            for (uint32_t a = 0U; a < 2U; a++)
+            for (uint32_t a = 0U; a < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); a++)
             {
                 if (RL_NULL != vqs[a])
                 {
@@ -1555,6 +6760,15 @@ struct rpmsg_lite_instance *rpmsg_lite_remote_init(void *shmem_addr, uint32_t li
         vqs[idx]->priv = (void *)rpmsg_lite_dev;
 #if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
         vqs[idx]->env = rpmsg_lite_dev->env;
+#endif
+        /* Remote consumes the avail ring and fills the used ring of both vrings */
+        vqs[idx]->vq_flags |= VIRTQUEUE_FLAG_DEVICE;
+#if defined(RL_ALLOW_RX_ADAPTIVE_POLLING) && (RL_ALLOW_RX_ADAPTIVE_POLLING == 1)
+        /* A polling master suppresses our notifications, it enables them again at the end of its initialization */
+        vqs[idx]->vq_flags |= VIRTQUEUE_FLAG_DRIVER_NO_INTERRUPT;
+#endif
+#if defined(RL_ALLOW_VRING_EVENT_IDX) && (RL_ALLOW_VRING_EVENT_IDX == 1)
+        virtqueue_enable_event_idx(vqs[idx]);
 #endif
     }
 
@@ -1567,7 +6781,155 @@ struct rpmsg_lite_instance *rpmsg_lite_remote_init(void *shmem_addr, uint32_t li
     {
 #if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
         /* Free all already allocated memory for virtqueues */
-        for (uint32_t b = 0U; b < 2U; b++)
+        for (uint32_t b = 0U; b < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); b++)
+        {
+            virtqueue_free(vqs[b]);
+        }
+        env_free_memory(rpmsg_lite_dev);
+#endif
+        return RL_NULL;
+    }
+
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    status = env_create_mutex((LOCK *)&rpmsg_lite_dev->tx_lock, 1, &rpmsg_lite_dev->tx_lock_static_ctxt);
+#else
+    status = env_create_mutex((LOCK *)&rpmsg_lite_dev->tx_lock, 1);
+#endif
+    if (status != RL_SUCCESS)
+    {
+        env_delete_mutex(rpmsg_lite_dev->lock);
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+        /* Free all already allocated memory for virtqueues */
+        for (uint32_t b = 0U; b < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); b++)
+        {
+            virtqueue_free(vqs[b]);
+        }
+        env_free_memory(rpmsg_lite_dev);
+#endif
+        return RL_NULL;
+    }
+
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    status = env_create_mutex((LOCK *)&rpmsg_lite_dev->rx_lock, 1, &rpmsg_lite_dev->rx_lock_static_ctxt);
+#else
+    status = env_create_mutex((LOCK *)&rpmsg_lite_dev->rx_lock, 1);
+#endif
+    if (status != RL_SUCCESS)
+    {
+        env_delete_mutex(rpmsg_lite_dev->lock);
+        env_delete_mutex(rpmsg_lite_dev->tx_lock);
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+        /* Free all already allocated memory for virtqueues */
+        for (uint32_t b = 0U; b < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); b++)
+        {
+            virtqueue_free(vqs[b]);
+        }
+        env_free_memory(rpmsg_lite_dev);
+#endif
+        return RL_NULL;
+    }
+
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+    status = rpmsg_lite_create_tx_wait_locks(rpmsg_lite_dev);
+    if (status != RL_SUCCESS)
+    {
+        env_delete_mutex(rpmsg_lite_dev->lock);
+        env_delete_mutex(rpmsg_lite_dev->tx_lock);
+        env_delete_mutex(rpmsg_lite_dev->rx_lock);
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+        /* Free all already allocated memory for virtqueues */
+        for (uint32_t b = 0U; b < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); b++)
+        {
+            virtqueue_free(vqs[b]);
+        }
+        env_free_memory(rpmsg_lite_dev);
+#endif
+        return RL_NULL;
+    }
+#endif
+
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+    rpmsg_lite_dev->rx_deferred  = RL_FALSE;
+    rpmsg_lite_dev->rx_carry_msg = RL_NULL;
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    status = env_create_sync_lock((LOCK *)&rpmsg_lite_dev->rx_worker_lock, LOCKED,
+                                  &rpmsg_lite_dev->rx_worker_lock_static_ctxt);
+#else
+    status = env_create_sync_lock((LOCK *)&rpmsg_lite_dev->rx_worker_lock, LOCKED);
+#endif
+    if (status != RL_SUCCESS)
+    {
+        env_delete_mutex(rpmsg_lite_dev->lock);
+        env_delete_mutex(rpmsg_lite_dev->tx_lock);
+        env_delete_mutex(rpmsg_lite_dev->rx_lock);
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+        rpmsg_lite_delete_tx_wait_locks(rpmsg_lite_dev);
+#endif
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+        /* Free all already allocated memory for virtqueues */
+        for (uint32_t b = 0U; b < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); b++)
+        {
+            virtqueue_free(vqs[b]);
+        }
+        env_free_memory(rpmsg_lite_dev);
+#endif
+        return RL_NULL;
+    }
+#endif
+
+#if defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1)
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    status = env_create_sync_lock((LOCK *)&rpmsg_lite_dev->notify_worker_lock, LOCKED,
+                                  &rpmsg_lite_dev->notify_worker_lock_static_ctxt);
+#else
+    status = env_create_sync_lock((LOCK *)&rpmsg_lite_dev->notify_worker_lock, LOCKED);
+#endif
+    if (status != RL_SUCCESS)
+    {
+        env_delete_mutex(rpmsg_lite_dev->lock);
+        env_delete_mutex(rpmsg_lite_dev->tx_lock);
+        env_delete_mutex(rpmsg_lite_dev->rx_lock);
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+        rpmsg_lite_delete_tx_wait_locks(rpmsg_lite_dev);
+#endif
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+        env_delete_sync_lock(rpmsg_lite_dev->rx_worker_lock);
+#endif
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+        /* Free all already allocated memory for virtqueues */
+        for (uint32_t b = 0U; b < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); b++)
+        {
+            virtqueue_free(vqs[b]);
+        }
+        env_free_memory(rpmsg_lite_dev);
+#endif
+        return RL_NULL;
+    }
+#endif
+
+#if defined(RL_ALLOW_FRAGMENTATION) && (RL_ALLOW_FRAGMENTATION == 1)
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+    status = env_create_mutex((LOCK *)&rpmsg_lite_dev->frag_lock, 1, &rpmsg_lite_dev->frag_lock_static_ctxt);
+#else
+    status = env_create_mutex((LOCK *)&rpmsg_lite_dev->frag_lock, 1);
+#endif
+    if (status != RL_SUCCESS)
+    {
+        env_delete_mutex(rpmsg_lite_dev->lock);
+        env_delete_mutex(rpmsg_lite_dev->tx_lock);
+        env_delete_mutex(rpmsg_lite_dev->rx_lock);
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+        rpmsg_lite_delete_tx_wait_locks(rpmsg_lite_dev);
+#endif
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+        env_delete_sync_lock(rpmsg_lite_dev->rx_worker_lock);
+#endif
+#if defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1)
+        env_delete_sync_lock(rpmsg_lite_dev->notify_worker_lock);
+#endif
+#if !(defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1))
+        /* Free all already allocated memory for virtqueues */
+        for (uint32_t b = 0U; b < (2U * (uint32_t)RL_QUEUE_PAIR_COUNT); b++)
         {
             virtqueue_free(vqs[b]);
         }
@@ -1575,12 +6937,20 @@ struct rpmsg_lite_instance *rpmsg_lite_remote_init(void *shmem_addr, uint32_t li
 #endif
         return RL_NULL;
     }
+#endif
 
     // FIXME - a better way to handle this , tx for master is rx for remote and vice versa.
-    rpmsg_lite_dev->tvq = vqs[0];
-    rpmsg_lite_dev->rvq = vqs[1];
+    rpmsg_lite_init_queues(rpmsg_lite_dev, vqs, 1U);
+#if defined(RL_ALLOW_TX_STASH) && (RL_ALLOW_TX_STASH == 1)
+    /* Keep at least half of the tx buffers out of the endpoint stashes */
+    rpmsg_lite_dev->tx_stash_limit = (uint32_t)rpmsg_lite_dev->tvq->vq_nentries / 2U;
+    if (rpmsg_lite_dev->tx_stash_limit > ((uint32_t)RL_BUFFER_COUNT / 2U))
+    {
+        rpmsg_lite_dev->tx_stash_limit = (uint32_t)RL_BUFFER_COUNT / 2U;
+    }
+#endif
 
-    /* Install ISRs */
+    /* Install ISRs, the queue pairs share the interrupts of queue pair 0 */
 #if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
     rpmsg_lite_dev->link_state = 0;
     env_init_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->tvq->vq_queue_index, rpmsg_lite_dev->tvq);
@@ -1614,6 +6984,8 @@ struct rpmsg_lite_instance *rpmsg_lite_remote_init(void *shmem_addr, uint32_t li
 
 int32_t rpmsg_lite_deinit(struct rpmsg_lite_instance *rpmsg_lite_dev)
 {
+    uint32_t q;
+
     if (rpmsg_lite_dev == RL_NULL)
     {
         return RL_ERR_PARAM;
@@ -1634,18 +7006,40 @@ int32_t rpmsg_lite_deinit(struct rpmsg_lite_instance *rpmsg_lite_dev)
     (void)platform_deinit_interrupt(rpmsg_lite_dev->tvq->vq_queue_index);
 #endif
     rpmsg_lite_dev->link_state = 0;
+#if defined(RL_ALLOW_ASYNC_SEND) && (RL_ALLOW_ASYNC_SEND == 1)
+    rpmsg_lite_async_drop(rpmsg_lite_dev, RL_NULL);
+#endif
 
+    for (q = 0U; q < (uint32_t)RL_QUEUE_PAIR_COUNT; q++)
+    {
 #if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
-    virtqueue_free_static(rpmsg_lite_dev->rvq);
-    virtqueue_free_static(rpmsg_lite_dev->tvq);
+        virtqueue_free_static(rpmsg_lite_dev->rvqs[q]);
+        virtqueue_free_static(rpmsg_lite_dev->tvqs[q]);
 #else
-    virtqueue_free(rpmsg_lite_dev->rvq);
-    virtqueue_free(rpmsg_lite_dev->tvq);
+        virtqueue_free(rpmsg_lite_dev->rvqs[q]);
+        virtqueue_free(rpmsg_lite_dev->tvqs[q]);
 #endif /* RL_USE_STATIC_API */
+        rpmsg_lite_dev->rvqs[q] = RL_NULL;
+        rpmsg_lite_dev->tvqs[q] = RL_NULL;
+    }
     rpmsg_lite_dev->rvq = RL_NULL;
     rpmsg_lite_dev->tvq = RL_NULL;
 
     env_delete_mutex(rpmsg_lite_dev->lock);
+    env_delete_mutex(rpmsg_lite_dev->tx_lock);
+    env_delete_mutex(rpmsg_lite_dev->rx_lock);
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1)
+    rpmsg_lite_delete_tx_wait_locks(rpmsg_lite_dev);
+#endif
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+    env_delete_sync_lock(rpmsg_lite_dev->rx_worker_lock);
+#endif
+#if defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1)
+    env_delete_sync_lock(rpmsg_lite_dev->notify_worker_lock);
+#endif
+#if defined(RL_ALLOW_FRAGMENTATION) && (RL_ALLOW_FRAGMENTATION == 1)
+    env_delete_mutex(rpmsg_lite_dev->frag_lock);
+#endif
 #if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
     (void)env_deinit(rpmsg_lite_dev->env);
 #else
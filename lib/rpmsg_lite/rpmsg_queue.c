@@ -2,7 +2,7 @@
  * Copyright (c) 2014, Mentor Graphics Corporation
  * Copyright (c) 2015 Xilinx, Inc.
  * Copyright (c) 2016 Freescale Semiconductor, Inc.
- * Copyright 2016-2025 NXP
+ * Copyright 2016-2026 NXP
  * Copyright 2021 ACRIOS Systems s.r.o.
  * All rights reserved.
  *
@@ -33,9 +33,92 @@
 #include "rpmsg_lite.h"
 #include "rpmsg_queue.h"
 
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+#if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
+#error "RL_ALLOW_QUEUE_BACKPRESSURE is not supported with RL_USE_STATIC_API"
+#endif
+
+/* Queue control block, the rpmsg_queue_handle points to it */
+struct rpmsg_queue
+{
+    void *env_queue;                /* environment queue holding the messages */
+    void *lock;                     /* excludes the rx callback running in the rx worker task */
+    rpmsg_queue_rx_cb_data_t *park; /* FIFO of the messages parked while the queue is full */
+    uint32_t park_size;             /* park FIFO length */
+    uint32_t park_head;             /* index of the oldest parked message */
+    uint32_t park_count;            /* number of parked messages */
+    uint32_t length;                /* environment queue length */
+    uint32_t count;                 /* number of messages in the environment queue */
+    uint32_t depth;                 /* maximum number of messages in the environment queue */
+    uint32_t lossless;              /* park instead of drop when the depth is reached */
+    uint32_t high;                  /* high watermark, 0 when disabled */
+    uint32_t low;                   /* low watermark */
+    uint32_t above_high;            /* high watermark reached, low watermark not yet */
+    rpmsg_queue_watermark_cb wm_cb; /* watermark callback */
+    void *wm_cb_data;               /* watermark callback private data */
+    struct rpmsg_queue_stats stats; /* statistics */
+};
+
+/* Exclude the rx callback, it runs either in the ISR or in the rx worker task */
+static void rpmsg_queue_enter(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_queue *queue)
+{
+    env_lock_mutex(queue->lock);
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    env_disable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->rvq->vq_queue_index);
+#else
+    env_disable_interrupt(rpmsg_lite_dev->rvq->vq_queue_index);
+#endif
+}
+
+static void rpmsg_queue_leave(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_queue *queue)
+{
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    env_enable_interrupt(rpmsg_lite_dev->env, rpmsg_lite_dev->rvq->vq_queue_index);
+#else
+    env_enable_interrupt(rpmsg_lite_dev->rvq->vq_queue_index);
+#endif
+    env_unlock_mutex(queue->lock);
+}
+
+/* Account a message taken out of the queue and refill it from the park FIFO */
+static void rpmsg_queue_drained(struct rpmsg_lite_instance *rpmsg_lite_dev, struct rpmsg_queue *queue)
+{
+    uint32_t low_reached = RL_FALSE;
+
+    rpmsg_queue_enter(rpmsg_lite_dev, queue);
+    RL_ASSERT(queue->count > 0U);
+    queue->count--;
+    while ((queue->park_count > 0U) && (queue->count < queue->depth))
+    {
+        /* The queue has space for the message, the put cannot fail */
+        (void)env_put_queue(queue->env_queue, &queue->park[queue->park_head], 0);
+        queue->park_head = (queue->park_head + 1U) % queue->park_size;
+        queue->park_count--;
+        queue->count++;
+    }
+    if ((queue->above_high == RL_TRUE) && ((queue->count + queue->park_count) <= queue->low))
+    {
+        queue->above_high = RL_FALSE;
+        low_reached       = RL_TRUE;
+    }
+    rpmsg_queue_leave(rpmsg_lite_dev, queue);
+
+    if ((low_reached == RL_TRUE) && (queue->wm_cb != RL_NULL))
+    {
+        queue->wm_cb((rpmsg_queue_handle)queue, RL_FALSE, queue->wm_cb_data);
+    }
+}
+#endif /* RL_ALLOW_QUEUE_BACKPRESSURE */
+
 int32_t rpmsg_queue_rx_cb(void *payload, uint32_t payload_len, uint32_t src, void *priv)
 {
     rpmsg_queue_rx_cb_data_t msg;
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+    struct rpmsg_queue *queue = (struct rpmsg_queue *)priv;
+    uint32_t high_reached     = RL_FALSE;
+    int32_t cb_ret            = RL_RELEASE;
+    uint32_t occupancy;
+#endif
 
     RL_ASSERT(priv != RL_NULL);
 
@@ -43,6 +126,48 @@ int32_t rpmsg_queue_rx_cb(void *payload, uint32_t payload_len, uint32_t src, voi
     msg.len  = payload_len;
     msg.src  = src;
 
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+    /* No-op in the ISR, excludes the receiving task when called from the rx worker task */
+    env_lock_mutex(queue->lock);
+    /* Messages already parked go first, to keep the order */
+    if ((queue->park_count == 0U) && (queue->count < queue->depth) && (0 != env_put_queue(queue->env_queue, &msg, 0)))
+    {
+        queue->count++;
+        cb_ret = RL_HOLD;
+    }
+    else if (queue->lossless == RL_TRUE)
+    {
+        /* Each parked message holds one of the rvq buffers, the park FIFO cannot overflow */
+        RL_ASSERT(queue->park_count < queue->park_size);
+        queue->park[(queue->park_head + queue->park_count) % queue->park_size] = msg;
+        queue->park_count++;
+        queue->stats.parked_count++;
+        cb_ret = RL_HOLD;
+    }
+    else
+    {
+        queue->stats.dropped_count++;
+    }
+
+    occupancy = queue->count + queue->park_count;
+    if (occupancy > queue->stats.max_depth)
+    {
+        queue->stats.max_depth = occupancy;
+    }
+    if ((queue->high > 0U) && (queue->above_high == RL_FALSE) && (occupancy >= queue->high))
+    {
+        queue->above_high = RL_TRUE;
+        high_reached      = RL_TRUE;
+    }
+    env_unlock_mutex(queue->lock);
+
+    if ((high_reached == RL_TRUE) && (queue->wm_cb != RL_NULL))
+    {
+        queue->wm_cb((rpmsg_queue_handle)queue, RL_TRUE, queue->wm_cb_data);
+    }
+
+    return cb_ret;
+#else
     /* if message is successfully added into queue then hold rpmsg buffer */
     if (0 != env_put_queue(priv, &msg, 0))
     {
@@ -51,6 +176,7 @@ int32_t rpmsg_queue_rx_cb(void *payload, uint32_t payload_len, uint32_t src, voi
     }
 
     return RL_RELEASE;
+#endif
 }
 
 #if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
@@ -63,6 +189,9 @@ rpmsg_queue_handle rpmsg_queue_create(struct rpmsg_lite_instance *rpmsg_lite_dev
 {
     int32_t status;
     void *q = RL_NULL;
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+    struct rpmsg_queue *queue;
+#endif
 
     if (rpmsg_lite_dev == RL_NULL)
     {
@@ -86,7 +215,35 @@ rpmsg_queue_handle rpmsg_queue_create(struct rpmsg_lite_instance *rpmsg_lite_dev
         return RL_NULL;
     }
 
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+    queue = env_allocate_memory(sizeof(struct rpmsg_queue));
+    if (queue == RL_NULL)
+    {
+        env_delete_queue(q);
+        return RL_NULL;
+    }
+    env_memset(queue, 0, sizeof(struct rpmsg_queue));
+    queue->env_queue = q;
+    queue->length    = 2U * rpmsg_lite_dev->rvq->vq_nentries;
+    queue->depth     = queue->length;
+    queue->lossless  = RL_FALSE;
+    queue->park_size = rpmsg_lite_dev->rvq->vq_nentries;
+    queue->park      = env_allocate_memory(queue->park_size * sizeof(rpmsg_queue_rx_cb_data_t));
+    if ((queue->park == RL_NULL) || (env_create_mutex(&queue->lock, 1) != 0))
+    {
+        if (queue->park != RL_NULL)
+        {
+            env_free_memory(queue->park);
+        }
+        env_free_memory(queue);
+        env_delete_queue(q);
+        return RL_NULL;
+    }
+
+    return ((rpmsg_queue_handle)queue);
+#else
     return ((rpmsg_queue_handle)q);
+#endif
 }
 
 int32_t rpmsg_queue_destroy(struct rpmsg_lite_instance *rpmsg_lite_dev, rpmsg_queue_handle q)
@@ -100,7 +257,14 @@ int32_t rpmsg_queue_destroy(struct rpmsg_lite_instance *rpmsg_lite_dev, rpmsg_qu
     {
         return RL_ERR_PARAM;
     }
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+    env_delete_queue(((struct rpmsg_queue *)q)->env_queue);
+    env_delete_mutex(((struct rpmsg_queue *)q)->lock);
+    env_free_memory(((struct rpmsg_queue *)q)->park);
+    env_free_memory(q);
+#else
     env_delete_queue((void *)q);
+#endif
     return RL_SUCCESS;
 }
 
@@ -129,8 +293,14 @@ int32_t rpmsg_queue_recv(struct rpmsg_lite_instance *rpmsg_lite_dev,
     }
 
     /* Get an element out of the message queue for the selected endpoint */
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+    if (0 != env_get_queue(((struct rpmsg_queue *)q)->env_queue, &msg, timeout))
+    {
+        rpmsg_queue_drained(rpmsg_lite_dev, (struct rpmsg_queue *)q);
+#else
     if (0 != env_get_queue((void *)q, &msg, timeout))
     {
+#endif
         if (src != RL_NULL)
         {
             *src = msg.src;
@@ -181,8 +351,14 @@ int32_t rpmsg_queue_recv_nocopy(struct rpmsg_lite_instance *rpmsg_lite_dev,
     }
 
     /* Get an element out of the message queue for the selected endpoint */
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+    if (0 != env_get_queue(((struct rpmsg_queue *)q)->env_queue, &msg, timeout))
+    {
+        rpmsg_queue_drained(rpmsg_lite_dev, (struct rpmsg_queue *)q);
+#else
     if (0 != env_get_queue((void *)q, &msg, timeout))
     {
+#endif
         if (src != RL_NULL)
         {
             *src = msg.src;
@@ -228,5 +404,83 @@ int32_t rpmsg_queue_get_current_size(rpmsg_queue_handle q)
     }
 
     /* Return actual queue size. */
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+    return env_get_current_queue_size(((struct rpmsg_queue *)q)->env_queue) +
+           (int32_t)((struct rpmsg_queue *)q)->park_count;
+#else
     return env_get_current_queue_size((void *)q);
+#endif
+}
+
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+int32_t rpmsg_queue_set_depth(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                              rpmsg_queue_handle q,
+                              uint32_t depth,
+                              uint32_t lossless)
+{
+    struct rpmsg_queue *queue = (struct rpmsg_queue *)q;
+
+    if ((rpmsg_lite_dev == RL_NULL) || (queue == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+    if (depth > queue->length)
+    {
+        return RL_ERR_PARAM;
+    }
+
+    rpmsg_queue_enter(rpmsg_lite_dev, queue);
+    queue->depth    = (depth == 0U) ? queue->length : depth;
+    queue->lossless = (lossless != RL_FALSE) ? RL_TRUE : RL_FALSE;
+    rpmsg_queue_leave(rpmsg_lite_dev, queue);
+
+    return RL_SUCCESS;
+}
+
+int32_t rpmsg_queue_set_watermarks(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                                   rpmsg_queue_handle q,
+                                   uint32_t high,
+                                   uint32_t low,
+                                   rpmsg_queue_watermark_cb cb,
+                                   void *cb_data)
+{
+    struct rpmsg_queue *queue = (struct rpmsg_queue *)q;
+
+    if ((rpmsg_lite_dev == RL_NULL) || (queue == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+    if ((high > 0U) && ((low >= high) || (cb == RL_NULL)))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    rpmsg_queue_enter(rpmsg_lite_dev, queue);
+    queue->high       = high;
+    queue->low        = low;
+    queue->wm_cb      = cb;
+    queue->wm_cb_data = cb_data;
+    queue->above_high = RL_FALSE;
+    rpmsg_queue_leave(rpmsg_lite_dev, queue);
+
+    return RL_SUCCESS;
+}
+
+int32_t rpmsg_queue_get_stats(struct rpmsg_lite_instance *rpmsg_lite_dev,
+                              rpmsg_queue_handle q,
+                              struct rpmsg_queue_stats *stats)
+{
+    struct rpmsg_queue *queue = (struct rpmsg_queue *)q;
+
+    if ((rpmsg_lite_dev == RL_NULL) || (queue == RL_NULL) || (stats == RL_NULL))
+    {
+        return RL_ERR_PARAM;
+    }
+
+    rpmsg_queue_enter(rpmsg_lite_dev, queue);
+    *stats = queue->stats;
+    rpmsg_queue_leave(rpmsg_lite_dev, queue);
+
+    return RL_SUCCESS;
 }
+#endif /* RL_ALLOW_QUEUE_BACKPRESSURE */
@@ -32,12 +32,29 @@
 /* Prototype for internal functions. */
 static void vq_ring_update_avail(struct virtqueue *vq, uint16_t desc_idx);
 static void vq_ring_update_used(struct virtqueue *vq, uint16_t head_idx, uint32_t len);
+static void vq_ring_update_batch(struct virtqueue *vq, const struct vring_used_elem *elems, uint16_t count, bool used);
+static uint16_t vq_ring_get_prod_idx(struct virtqueue *vq, bool used);
+static void vq_ring_set_prod_idx(struct virtqueue *vq, bool used, uint16_t prod_idx);
 static uint16_t vq_ring_add_buffer(
     struct virtqueue *vq, struct vring_desc *desc, uint16_t head_idx, void *buffer, uint32_t length);
 static int32_t vq_ring_enable_interrupt(struct virtqueue *vq, uint16_t ndesc);
-static int32_t vq_ring_must_notify_host(struct virtqueue *vq);
+static int32_t vq_ring_must_notify_host(struct virtqueue *vq, uint16_t new_idx, uint16_t prev_idx);
+static void vq_ring_publish_event(struct virtqueue *vq, uint16_t event_idx);
 static void vq_ring_notify_host(struct virtqueue *vq);
 static uint16_t virtqueue_nused(struct virtqueue *vq);
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+static void *vq_ring_claim_mp(struct virtqueue *vq, uint32_t *len, uint16_t *idx);
+static void vq_ring_produce_mp(struct virtqueue *vq, uint16_t head_idx, uint32_t len);
+static void vq_ring_kick_mp(struct virtqueue *vq);
+#endif
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+static struct vq_desc_shadow *vq_ring_shadow(struct virtqueue *vq, uint16_t desc_idx);
+
+/* Fibonacci hashing of the buffer address to the vq_shadow_hash slot */
+#define VQ_SHADOW_HASH_MASK (2U * (uint32_t)RL_BUFFER_COUNT - 1U)
+#define VQ_SHADOW_HASH_SLOT(addr) \
+    (((((uint32_t)((uintptr_t)(addr) >> 4U)) * 0x9E3779B1U) >> 16U) & VQ_SHADOW_HASH_MASK)
+#endif
 
 #if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
 /*!
@@ -78,6 +95,14 @@ int32_t virtqueue_create_static(uint16_t id,
         status = ERROR_VQUEUE_INVLD_PARAM;
     }
 
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+    /* The descriptor shadow is sized by RL_BUFFER_COUNT */
+    if ((status == VQUEUE_SUCCESS) && (ring->num_descs > (uint16_t)RL_BUFFER_COUNT))
+    {
+        status = ERROR_VRING_MAX_DESC;
+    }
+#endif
+
     if (status == VQUEUE_SUCCESS)
     {
         vq_size = sizeof(struct virtqueue);
@@ -143,6 +168,14 @@ int32_t virtqueue_create(uint16_t id,
         status = ERROR_VQUEUE_INVLD_PARAM;
     }
 
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+    /* The descriptor shadow is sized by RL_BUFFER_COUNT */
+    if ((status == VQUEUE_SUCCESS) && (ring->num_descs > (uint16_t)RL_BUFFER_COUNT))
+    {
+        status = ERROR_VRING_MAX_DESC;
+    }
+#endif
+
     if (status == VQUEUE_SUCCESS)
     {
         vq_size = sizeof(struct virtqueue);
@@ -194,6 +227,14 @@ int32_t virtqueue_add_buffer(struct virtqueue *vq, uint16_t head_idx)
 
     VQ_PARAM_CHK(vq == VQ_NULL, status, ERROR_VQUEUE_INVLD_PARAM);
 
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_MULTI_PRODUCER) != 0UL)
+    {
+        vq_ring_produce_mp(vq, head_idx, 0U);
+        return (status);
+    }
+#endif
+
     VQUEUE_BUSY(vq, avail_write);
 
     /*
@@ -218,6 +259,59 @@ int32_t virtqueue_add_buffer(struct virtqueue *vq, uint16_t head_idx)
     return (status);
 }
 
+/*!
+ * virtqueue_add_buffers()  - Enqueues several buffers in vring for consumption
+ *                            by other side, publishes the avail index once.
+ *
+ * @param vq                - Pointer to VirtIO queue control block.
+ * @param elems             - Indexes of buffers to be added to the avail ring,
+ *                            the len member is not used
+ * @param count             - Number of buffers
+ *
+ * @return                  - Function status
+ */
+int32_t virtqueue_add_buffers(struct virtqueue *vq, const struct vring_used_elem *elems, uint16_t count)
+{
+    volatile int32_t status = VQUEUE_SUCCESS;
+    uint16_t i;
+
+    VQ_PARAM_CHK(vq == VQ_NULL, status, ERROR_VQUEUE_INVLD_PARAM);
+    VQ_PARAM_CHK(count > vq->vq_nentries, status, ERROR_VRING_FULL);
+
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_MULTI_PRODUCER) != 0UL)
+    {
+        for (i = 0U; i < count; i++)
+        {
+            vq_ring_produce_mp(vq, (uint16_t)elems[i].id, 0U);
+        }
+        return (status);
+    }
+#endif
+
+    VQUEUE_BUSY(vq, avail_write);
+
+    /*
+     * $Branch Coverage Justification$
+     * Not able to reach the false condition because when VQUEUE_DEBUG
+     * is not set status is not modified and when VQUEUE_DEBUG is set and
+     * incorrect vq param is passed assert in VQUEUE_BUSY is reached.
+     */
+    if ((status == VQUEUE_SUCCESS) && (count > 0U)) /* GCOVR_EXCL_BR_LINE */
+    {
+        for (i = 0U; i < count; i++)
+        {
+            VQ_RING_ASSERT_VALID_IDX(vq, elems[i].id);
+        }
+
+        vq_ring_update_batch(vq, elems, count, false);
+    }
+
+    VQUEUE_IDLE(vq, avail_write);
+
+    return (status);
+}
+
 /*!
  * virtqueue_fill_avail_buffers - Enqueues single buffer in vring, updates avail
  *
@@ -283,6 +377,13 @@ void *virtqueue_get_buffer(struct virtqueue *vq, uint32_t *len, uint16_t *idx)
     struct vring_used_elem *uep;
     uint16_t used_idx, desc_idx;
 
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+    if ((vq != VQ_NULL) && ((vq->vq_flags & VIRTQUEUE_FLAG_MULTI_PRODUCER) != 0UL))
+    {
+        return vq_ring_claim_mp(vq, len, idx);
+    }
+#endif
+
     /* Invalidate used->idx before it is read */
     VQUEUE_INVALIDATE(&vq->vq_ring.used->idx, sizeof(vq->vq_ring.used->idx));
 
@@ -324,9 +425,18 @@ void *virtqueue_get_buffer(struct virtqueue *vq, uint32_t *len, uint16_t *idx)
 
     vq->vq_used_cons_idx++;
 
+    if ((vq->vq_flags & (VIRTQUEUE_FLAG_EVENT_IDX | VIRTQUEUE_FLAG_CB_DISABLED)) == VIRTQUEUE_FLAG_EVENT_IDX)
+    {
+        /* Ask to be notified about the next used buffer, then re-read used->idx on the next call */
+        vq_ring_publish_event(vq, vq->vq_used_cons_idx);
+        env_mb();
+    }
+
     VQUEUE_IDLE(vq, used_read);
 
-#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+    return vq_ring_shadow(vq, desc_idx)->addr;
+#elif defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
     return env_map_patova(vq->env, ((uint32_t)(vq->vq_ring.desc[desc_idx].addr)));
 #else
     return env_map_patova((uint32_t)(vq->vq_ring.desc[desc_idx].addr));
@@ -343,10 +453,61 @@ void *virtqueue_get_buffer(struct virtqueue *vq, uint32_t *len, uint16_t *idx)
  */
 uint32_t virtqueue_get_buffer_length(struct virtqueue *vq, uint16_t idx)
 {
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+    return vq_ring_shadow(vq, idx)->len;
+#else
     /* Invalidate used->ring before it is read */
     VQUEUE_INVALIDATE(&vq->vq_ring.desc[idx].len, sizeof(vq->vq_ring.desc[idx].len));
     return vq->vq_ring.desc[idx].len;
+#endif
+}
+
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+/*!
+ * virtqueue_get_buffer_index - Finds the descriptor of a buffer taken
+ *                              from the VirtIO queue
+ *
+ * @param vq            - Pointer to VirtIO queue control block
+ * @param buffer        - Buffer address as returned by the virtqueue
+ * @param idx           - Index to buffer descriptor pool
+ *
+ * @return              - Function status
+ */
+int32_t virtqueue_get_buffer_index(struct virtqueue *vq, void *buffer, uint16_t *idx)
+{
+    uint32_t slot = VQ_SHADOW_HASH_SLOT(buffer);
+    uint16_t entry;
+
+    /* The table is never more than half full, an empty slot ends the probe sequence */
+    entry = vq->vq_shadow_hash[slot];
+    while (entry != 0U)
+    {
+        if (vq->vq_shadow[entry - 1U].addr == buffer)
+        {
+            *idx = (uint16_t)(entry - 1U);
+            return (VQUEUE_SUCCESS);
+        }
+        slot  = (slot + 1U) & VQ_SHADOW_HASH_MASK;
+        entry = vq->vq_shadow_hash[slot];
+    }
+
+    return (ERROR_INVLD_DESC_IDX);
+}
+
+/*!
+ * virtqueue_reset_desc_shadow - Drops the local copy of the descriptors,
+ *                               they are read again on their next use.
+ *                               Called when the other side re-initialized
+ *                               the vring.
+ *
+ * @param vq            - Pointer to VirtIO queue control block
+ */
+void virtqueue_reset_desc_shadow(struct virtqueue *vq)
+{
+    env_memset(vq->vq_shadow, 0x00, sizeof(vq->vq_shadow));
+    env_memset(vq->vq_shadow_hash, 0x00, sizeof(vq->vq_shadow_hash));
 }
+#endif
 
 #if defined(RL_USE_STATIC_API) && (RL_USE_STATIC_API == 1)
 /*!
@@ -402,6 +563,16 @@ void *virtqueue_get_available_buffer(struct virtqueue *vq, uint16_t *avail_idx,
 {
     uint16_t head_idx = 0;
     void *buffer;
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+    struct vq_desc_shadow *shadow;
+#endif
+
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_MULTI_PRODUCER) != 0UL)
+    {
+        return vq_ring_claim_mp(vq, len, avail_idx);
+    }
+#endif
 
     /* Invalidate avail->idx before it is read */
     VQUEUE_INVALIDATE(&vq->vq_ring.avail->idx, sizeof(vq->vq_ring.avail->idx));
@@ -421,12 +592,25 @@ void *virtqueue_get_available_buffer(struct virtqueue *vq, uint16_t *avail_idx,
 
     env_rmb();
 
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+    shadow = vq_ring_shadow(vq, *avail_idx);
+    buffer = shadow->addr;
+    *len   = shadow->len;
+#else
 #if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
     buffer = env_map_patova(vq->env, ((uint32_t)(vq->vq_ring.desc[*avail_idx].addr)));
 #else
     buffer   = env_map_patova((uint32_t)(vq->vq_ring.desc[*avail_idx].addr));
 #endif
     *len = vq->vq_ring.desc[*avail_idx].len;
+#endif
+
+    if ((vq->vq_flags & (VIRTQUEUE_FLAG_EVENT_IDX | VIRTQUEUE_FLAG_CB_DISABLED)) == VIRTQUEUE_FLAG_EVENT_IDX)
+    {
+        /* Ask to be notified about the next available buffer, then re-read avail->idx on the next call */
+        vq_ring_publish_event(vq, vq->vq_available_idx);
+        env_mb();
+    }
 
     VQUEUE_IDLE(vq, avail_read);
 
@@ -449,6 +633,14 @@ int32_t virtqueue_add_consumed_buffer(struct virtqueue *vq, uint16_t head_idx, u
         return (ERROR_VRING_NO_BUFF);
     }
 
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_MULTI_PRODUCER) != 0UL)
+    {
+        vq_ring_produce_mp(vq, head_idx, len);
+        return (VQUEUE_SUCCESS);
+    }
+#endif
+
     VQUEUE_BUSY(vq, used_write);
     vq_ring_update_used(vq, head_idx, len);
     VQUEUE_IDLE(vq, used_write);
@@ -456,6 +648,55 @@ int32_t virtqueue_add_consumed_buffer(struct virtqueue *vq, uint16_t head_idx, u
     return (VQUEUE_SUCCESS);
 }
 
+/*!
+ * virtqueue_add_consumed_buffers - Returns several consumed buffers back to
+ *                                  VirtIO queue, publishes the used index once
+ *
+ * @param vq                     - Pointer to VirtIO queue control block
+ * @param elems                  - Indexes of vring desc containing used buffers
+ *                                 and lengths of the buffers
+ * @param count                  - Number of buffers
+ *
+ * @return                       - Function status
+ */
+int32_t virtqueue_add_consumed_buffers(struct virtqueue *vq, const struct vring_used_elem *elems, uint16_t count)
+{
+    uint16_t i;
+
+    if (count > vq->vq_nentries)
+    {
+        return (ERROR_VRING_FULL);
+    }
+
+    for (i = 0U; i < count; i++)
+    {
+        if (elems[i].id > vq->vq_nentries)
+        {
+            return (ERROR_VRING_NO_BUFF);
+        }
+    }
+
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_MULTI_PRODUCER) != 0UL)
+    {
+        for (i = 0U; i < count; i++)
+        {
+            vq_ring_produce_mp(vq, (uint16_t)elems[i].id, elems[i].len);
+        }
+        return (VQUEUE_SUCCESS);
+    }
+#endif
+
+    if (count > 0U)
+    {
+        VQUEUE_BUSY(vq, used_write);
+        vq_ring_update_batch(vq, elems, count, true);
+        VQUEUE_IDLE(vq, used_write);
+    }
+
+    return (VQUEUE_SUCCESS);
+}
+
 /*!
  * virtqueue_fill_used_buffers - Fill used buffer ring
  *
@@ -488,13 +729,6 @@ int32_t virtqueue_fill_used_buffers(struct virtqueue *vq, void *buffer, uint32_t
 }
 
 
-/*
- * $Line Coverage Justification$
- * This virtqueue function does not need to be tested because it is not used in rpmsg_lite
- * implementation.
- */
-/* GCOVR_EXCL_START */
-
 /*!
  * virtqueue_enable_cb  - Enables callback generation
  *
@@ -506,7 +740,56 @@ int32_t virtqueue_enable_cb(struct virtqueue *vq)
 {
     return (vq_ring_enable_interrupt(vq, 0));
 }
-/* GCOVR_EXCL_STOP */
+
+/*!
+ * virtqueue_enable_event_idx - Publishes the event index of this side and
+ *                              advertises it to the other side, which then
+ *                              notifies only when the index is crossed.
+ *                              May be called again to re-advertise after
+ *                              the other side re-initialized the vring.
+ *
+ * @param vq                  - Pointer to VirtIO queue control block
+ *
+ */
+void virtqueue_enable_event_idx(struct virtqueue *vq)
+{
+    uint16_t cons_idx;
+
+    vq->vq_flags |= VIRTQUEUE_FLAG_EVENT_IDX;
+
+    cons_idx = ((vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL) ? vq->vq_available_idx : vq->vq_used_cons_idx;
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_MULTI_PRODUCER) != 0UL)
+    {
+        cons_idx = atomic_load(&vq->vq_cons_claim);
+    }
+#endif
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_CB_DISABLED) != 0UL)
+    {
+        vq_ring_publish_event(vq, cons_idx - vq->vq_nentries - 1U);
+    }
+    else
+    {
+        vq_ring_publish_event(vq, cons_idx);
+    }
+
+    /* The event index has to be visible before the other side starts to rely on it */
+    env_wmb();
+
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL)
+    {
+        vq->vq_ring.used->flags |= (uint16_t)VRING_USED_F_EVENT_IDX;
+        VQUEUE_FLUSH(&vq->vq_ring.used->flags, sizeof(vq->vq_ring.used->flags));
+    }
+    else
+    {
+        vq->vq_ring.avail->flags |= (uint16_t)VRING_AVAIL_F_EVENT_IDX;
+        VQUEUE_FLUSH(&vq->vq_ring.avail->flags, sizeof(vq->vq_ring.avail->flags));
+    }
+
+    env_mb();
+}
+
 /*!
  * virtqueue_enable_cb - Disables callback generation
  *
@@ -517,23 +800,27 @@ void virtqueue_disable_cb(struct virtqueue *vq)
 {
     VQUEUE_BUSY(vq, avail_write);
 
-    /*
-     * $Branch Coverage Justification$
-     * Not able to reach the true condition because VIRTQUEUE_FLAG_EVENT_IDX
-     * is not being utilized in rpmsg_lite implementation.
-     */
-    if ((vq->vq_flags & VIRTQUEUE_FLAG_EVENT_IDX) != 0UL) /* GCOVR_EXCL_BR_LINE */
+    vq->vq_flags |= VIRTQUEUE_FLAG_CB_DISABLED;
+
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_EVENT_IDX) != 0UL)
     {
-        /*
-         * $Line Coverage Justification$
-         * This part does not need to be tested because VIRTQUEUE_FLAG_EVENT_IDX is not being
-         * utilized in rpmsg_lite implementation.
-         */
-        /* GCOVR_EXCL_START */
-        vring_used_event(&vq->vq_ring) = vq->vq_used_cons_idx - vq->vq_nentries - 1U;
-        VQUEUE_FLUSH(&vring_used_event(&vq->vq_ring), sizeof(vring_used_event(&vq->vq_ring)));
+        /* Move the event index out of reach, the flags below cover a peer not using it */
+        if ((vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL)
+        {
+            vq_ring_publish_event(vq, vq->vq_available_idx - vq->vq_nentries - 1U);
+        }
+        else
+        {
+            vq_ring_publish_event(vq, vq->vq_used_cons_idx - vq->vq_nentries - 1U);
+        }
+    }
+
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL)
+    {
+        /* Device side asks the driver not to notify it about new available buffers */
+        vq->vq_ring.used->flags |= (uint16_t)VRING_USED_F_NO_NOTIFY;
+        VQUEUE_FLUSH(&vq->vq_ring.used->flags, sizeof(vq->vq_ring.used->flags));
     }
-    /* GCOVR_EXCL_STOP */
     else
     {
         vq->vq_ring.avail->flags |= (uint16_t)VRING_AVAIL_F_NO_INTERRUPT;
@@ -550,17 +837,23 @@ void virtqueue_disable_cb(struct virtqueue *vq)
  */
 void virtqueue_kick(struct virtqueue *vq)
 {
+    uint16_t new_idx;
+
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_MULTI_PRODUCER) != 0UL)
+    {
+        vq_ring_kick_mp(vq);
+        return;
+    }
+#endif
+
     VQUEUE_BUSY(vq, avail_write);
 
     /* Ensure updated avail->idx is visible to host. */
     env_mb();
 
-    /*
-     * $Branch Coverage Justification$
-     * Not able to reach the true condition because VIRTQUEUE_FLAG_EVENT_IDX
-     * is not being utilized in rpmsg_lite implementation.
-     */
-    if (0 != vq_ring_must_notify_host(vq)) /* GCOVR_EXCL_BR_LINE */
+    new_idx = vq_ring_get_prod_idx(vq, (vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL);
+    if (0 != vq_ring_must_notify_host(vq, new_idx, new_idx - vq->vq_queued_cnt))
     {
         vq_ring_notify_host(vq);
     }
@@ -569,6 +862,71 @@ void virtqueue_kick(struct virtqueue *vq)
     VQUEUE_IDLE(vq, avail_write);
 }
 
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+/*!
+ * virtqueue_enable_multi_producer - Lets several producers take buffers from
+ *                                   and add buffers to the virtqueue without
+ *                                   a lock. Buffers are claimed by compare and
+ *                                   swap, ring slots are reserved atomically
+ *                                   and published in order. Called before the
+ *                                   first buffer is taken and again whenever
+ *                                   the other side re-initialized the vring.
+ *
+ * @param vq                       - Pointer to VirtIO queue control block
+ *
+ * @return                         - Function status
+ */
+int32_t virtqueue_enable_multi_producer(struct virtqueue *vq)
+{
+    uint16_t prod_idx;
+    uint16_t mask;
+    uint16_t i;
+
+    /* Ring slot markers are sized by RL_BUFFER_COUNT */
+    if (vq->vq_nentries > (uint16_t)RL_BUFFER_COUNT)
+    {
+        return (ERROR_VQUEUE_INVLD_PARAM);
+    }
+
+    mask = (uint16_t)(vq->vq_nentries - 1U);
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL)
+    {
+        VQUEUE_INVALIDATE(&vq->vq_ring.used->idx, sizeof(vq->vq_ring.used->idx));
+        prod_idx = vq->vq_ring.used->idx;
+        atomic_store(&vq->vq_cons_claim, vq->vq_available_idx);
+    }
+    else
+    {
+        VQUEUE_INVALIDATE(&vq->vq_ring.avail->idx, sizeof(vq->vq_ring.avail->idx));
+        prod_idx = vq->vq_ring.avail->idx;
+        atomic_store(&vq->vq_cons_claim, vq->vq_used_cons_idx);
+    }
+
+    atomic_store(&vq->vq_prod_claim, prod_idx);
+    atomic_store(&vq->vq_prod_idx, prod_idx);
+    atomic_store(&vq->vq_kick_idx, prod_idx);
+    /* Mark the slots as filled in the previous lap, i.e. not ready */
+    for (i = 0U; i < vq->vq_nentries; i++)
+    {
+        atomic_store(&vq->vq_prod_ready[(uint16_t)(prod_idx + i) & mask],
+                     (uint16_t)(prod_idx + i + 1U - vq->vq_nentries));
+    }
+    atomic_flag_clear(&vq->vq_prod_busy);
+
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+    /* Read all the descriptors now, the producers only read the shadow */
+    for (i = 0U; i < vq->vq_nentries; i++)
+    {
+        (void)vq_ring_shadow(vq, i);
+    }
+#endif
+
+    vq->vq_flags |= VIRTQUEUE_FLAG_MULTI_PRODUCER;
+
+    return (VQUEUE_SUCCESS);
+}
+#endif
+
 /*
  * $Line Coverage Justification$
  * This virtqueue function does not need to be tested because it is not used in rpmsg_lite
@@ -636,10 +994,14 @@ uint32_t virtqueue_get_desc_size(struct virtqueue *vq)
 
     avail_idx = vq->vq_ring.avail->ring[head_idx];
 
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+    len = vq_ring_shadow(vq, avail_idx)->len;
+#else
     /* Invalidate len before read */
     VQUEUE_INVALIDATE(&vq->vq_ring.desc[avail_idx].len, sizeof(vq->vq_ring.desc[avail_idx].len));
 
     len = vq->vq_ring.desc[avail_idx].len;
+#endif
 
     return (len);
 }
@@ -719,6 +1081,7 @@ void vq_ring_init(struct virtqueue *vq)
  */
 static void vq_ring_update_avail(struct virtqueue *vq, uint16_t desc_idx)
 {
+    uint16_t prod_idx;
     uint16_t avail_idx;
 
     /*
@@ -728,9 +1091,8 @@ static void vq_ring_update_avail(struct virtqueue *vq, uint16_t desc_idx)
      * currently running on another CPU, we can keep it processing the new
      * descriptor.
      */
-    /* Invalidate avail->idx before read */
-    VQUEUE_INVALIDATE(&vq->vq_ring.avail->idx, sizeof(vq->vq_ring.avail->idx));
-    avail_idx                          = (uint16_t)(vq->vq_ring.avail->idx & ((uint16_t)(vq->vq_nentries - 1U)));
+    prod_idx                           = vq_ring_get_prod_idx(vq, false);
+    avail_idx                          = (uint16_t)(prod_idx & ((uint16_t)(vq->vq_nentries - 1U)));
     vq->vq_ring.avail->ring[avail_idx] = desc_idx;
 
     /* Flush avail->ring after write */
@@ -738,10 +1100,7 @@ static void vq_ring_update_avail(struct virtqueue *vq, uint16_t desc_idx)
 
     env_wmb();
 
-    vq->vq_ring.avail->idx++;
-
-    /* Flush idx after write */
-    VQUEUE_FLUSH(&vq->vq_ring.avail->idx, sizeof(vq->vq_ring.avail->idx));
+    vq_ring_set_prod_idx(vq, false, (uint16_t)(prod_idx + 1U));
 
     /* Keep pending count until virtqueue_notify(). */
     vq->vq_queued_cnt++;
@@ -754,6 +1113,7 @@ static void vq_ring_update_avail(struct virtqueue *vq, uint16_t desc_idx)
  */
 static void vq_ring_update_used(struct virtqueue *vq, uint16_t head_idx, uint32_t len)
 {
+    uint16_t prod_idx;
     uint16_t used_idx;
     struct vring_used_elem *used_desc = VQ_NULL;
 
@@ -764,9 +1124,8 @@ static void vq_ring_update_used(struct virtqueue *vq, uint16_t head_idx, uint32_
      * currently running on another CPU, we can keep it processing the new
      * descriptor.
      */
-    /* Invalidate used->idx before read */
-    VQUEUE_INVALIDATE(&vq->vq_ring.used->idx, sizeof(vq->vq_ring.used->idx));
-    used_idx       = vq->vq_ring.used->idx & (vq->vq_nentries - 1U);
+    prod_idx       = vq_ring_get_prod_idx(vq, true);
+    used_idx       = prod_idx & (vq->vq_nentries - 1U);
     used_desc      = &(vq->vq_ring.used->ring[used_idx]);
     used_desc->id  = head_idx;
     used_desc->len = len;
@@ -776,18 +1135,126 @@ static void vq_ring_update_used(struct virtqueue *vq, uint16_t head_idx, uint32_
 
     env_wmb();
 
-    vq->vq_ring.used->idx++;
+    vq_ring_set_prod_idx(vq, true, (uint16_t)(prod_idx + 1U));
 
-    /* Flush used->idx after write */
-    VQUEUE_FLUSH(&vq->vq_ring.used->idx, sizeof(vq->vq_ring.used->idx));
+    /* Keep pending count until virtqueue_kick(). */
+    vq->vq_queued_cnt++;
 }
 
-/*
- * $Line Coverage Justification$
- * This virtqueue function does not need to be tested because it is not used in rpmsg_lite
- * implementation.
+/*!
+ *
+ * vq_ring_update_batch
+ *
+ * Places several buffers into the avail ring or the used ring,
+ * the touched ring slots are flushed in one go and
+ * the ring index is published once.
+ *
  */
-/* GCOVR_EXCL_START */
+static void vq_ring_update_batch(struct virtqueue *vq, const struct vring_used_elem *elems, uint16_t count, bool used)
+{
+    uint16_t mask = (uint16_t)(vq->vq_nentries - 1U);
+    uint16_t ring_idx;
+    uint16_t first;
+    uint16_t tail;
+    uint16_t i;
+
+    ring_idx = vq_ring_get_prod_idx(vq, used);
+    first    = (uint16_t)(ring_idx & mask);
+    tail     = (uint16_t)(vq->vq_nentries - first);
+    if (tail > count)
+    {
+        tail = count;
+    }
+
+    if (used)
+    {
+        for (i = 0U; i < count; i++)
+        {
+            vq->vq_ring.used->ring[(uint16_t)(ring_idx + i) & mask] = elems[i];
+        }
+
+        /* Flush used->ring after write, in two parts when the batch wraps around */
+        VQUEUE_FLUSH(&vq->vq_ring.used->ring[first], (uint32_t)tail * sizeof(struct vring_used_elem));
+        if (tail < count)
+        {
+            VQUEUE_FLUSH(&vq->vq_ring.used->ring[0], (uint32_t)(count - tail) * sizeof(struct vring_used_elem));
+        }
+    }
+    else
+    {
+        for (i = 0U; i < count; i++)
+        {
+            vq->vq_ring.avail->ring[(uint16_t)(ring_idx + i) & mask] = (uint16_t)elems[i].id;
+        }
+
+        /* Flush avail->ring after write, in two parts when the batch wraps around */
+        VQUEUE_FLUSH(&vq->vq_ring.avail->ring[first], (uint32_t)tail * sizeof(uint16_t));
+        if (tail < count)
+        {
+            VQUEUE_FLUSH(&vq->vq_ring.avail->ring[0], (uint32_t)(count - tail) * sizeof(uint16_t));
+        }
+
+    }
+
+    env_wmb();
+
+    vq_ring_set_prod_idx(vq, used, (uint16_t)(ring_idx + count));
+
+    /* Keep pending count until virtqueue_kick(). */
+    vq->vq_queued_cnt += count;
+}
+
+/*!
+ *
+ * vq_ring_get_prod_idx
+ *
+ * Returns the index of the avail ring or the used ring to be written next.
+ * The index of the ring written by this side is read from the shared memory
+ * on its first use only, it may have been initialized by the other side.
+ *
+ */
+static uint16_t vq_ring_get_prod_idx(struct virtqueue *vq, bool used)
+{
+    uint16_t *ring_idx = used ? &vq->vq_ring.used->idx : &vq->vq_ring.avail->idx;
+
+    if (used != ((vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL))
+    {
+        /* The master fills the used ring of its tvq at the initialization only */
+        VQUEUE_INVALIDATE(ring_idx, sizeof(*ring_idx));
+        return *ring_idx;
+    }
+
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_PROD_IDX_VALID) == 0UL)
+    {
+        VQUEUE_INVALIDATE(ring_idx, sizeof(*ring_idx));
+        vq->vq_prod_shadow_idx = *ring_idx;
+        vq->vq_flags |= VIRTQUEUE_FLAG_PROD_IDX_VALID;
+    }
+
+    return vq->vq_prod_shadow_idx;
+}
+
+/*!
+ *
+ * vq_ring_set_prod_idx
+ *
+ * Publishes the index of the avail ring or the used ring to the other side.
+ *
+ */
+static void vq_ring_set_prod_idx(struct virtqueue *vq, bool used, uint16_t prod_idx)
+{
+    uint16_t *ring_idx = used ? &vq->vq_ring.used->idx : &vq->vq_ring.avail->idx;
+
+    *ring_idx = prod_idx;
+
+    /* Flush idx after write */
+    VQUEUE_FLUSH(ring_idx, sizeof(*ring_idx));
+
+    if (used == ((vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL))
+    {
+        vq->vq_prod_shadow_idx = prod_idx;
+    }
+}
 
 /*!
  *
@@ -796,14 +1263,28 @@ static void vq_ring_update_used(struct virtqueue *vq, uint16_t head_idx, uint32_
  */
 static int32_t vq_ring_enable_interrupt(struct virtqueue *vq, uint16_t ndesc)
 {
+    vq->vq_flags &= ~(uint32_t)VIRTQUEUE_FLAG_CB_DISABLED;
+
     /*
      * Enable interrupts, making sure we get the latest index of
      * what's already been consumed.
      */
     if ((vq->vq_flags & VIRTQUEUE_FLAG_EVENT_IDX) != 0UL)
     {
-        vring_used_event(&vq->vq_ring) = vq->vq_used_cons_idx + ndesc;
-        VQUEUE_FLUSH(&vring_used_event(&vq->vq_ring), sizeof(vring_used_event(&vq->vq_ring)));
+        if ((vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL)
+        {
+            vq_ring_publish_event(vq, vq->vq_available_idx + ndesc);
+        }
+        else
+        {
+            vq_ring_publish_event(vq, vq->vq_used_cons_idx + ndesc);
+        }
+    }
+
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL)
+    {
+        vq->vq_ring.used->flags &= ~(uint16_t)VRING_USED_F_NO_NOTIFY;
+        VQUEUE_FLUSH(&vq->vq_ring.used->flags, sizeof(vq->vq_ring.used->flags));
     }
     else
     {
@@ -825,7 +1306,6 @@ static int32_t vq_ring_enable_interrupt(struct virtqueue *vq, uint16_t ndesc)
 
     return (0);
 }
-/* GCOVR_EXCL_STOP */
 
 /*!
  *
@@ -848,38 +1328,47 @@ void virtqueue_notification(struct virtqueue *vq)
  * vq_ring_must_notify_host
  *
  */
-static int32_t vq_ring_must_notify_host(struct virtqueue *vq)
+static int32_t vq_ring_must_notify_host(struct virtqueue *vq, uint16_t new_idx, uint16_t prev_idx)
 {
-    uint16_t new_idx, prev_idx;
     uint16_t event_idx;
+    uint16_t flags;
 
-    /*
-     * $Branch Coverage Justification$
-     * Not able to reach the true condition because VIRTQUEUE_FLAG_EVENT_IDX
-     * is not being utilized in rpmsg_lite implementation.
-     */
-    if ((vq->vq_flags & VIRTQUEUE_FLAG_EVENT_IDX) != 0UL) /* GCOVR_EXCL_BR_LINE */
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL)
+    {
+        /* Device side interrupts the driver unless suppressed in the avail ring */
+        VQUEUE_INVALIDATE(&vq->vq_ring.avail->flags, sizeof(vq->vq_ring.avail->flags));
+        flags = vq->vq_ring.avail->flags;
+
+        if (((vq->vq_flags & VIRTQUEUE_FLAG_EVENT_IDX) != 0UL) && ((flags & (uint16_t)VRING_AVAIL_F_EVENT_IDX) != 0U))
+        {
+            VQUEUE_INVALIDATE(&vring_used_event(&vq->vq_ring), sizeof(vring_used_event(&vq->vq_ring)));
+            event_idx = vring_used_event(&vq->vq_ring);
+
+            return ((vring_need_event(event_idx, new_idx, prev_idx) != 0) ? 1 : 0);
+        }
+
+        if ((vq->vq_flags & VIRTQUEUE_FLAG_DRIVER_NO_INTERRUPT) == 0UL)
+        {
+            /* The driver may have left the flag set since its initialization */
+            return (1);
+        }
+
+        return (((flags & ((uint16_t)VRING_AVAIL_F_NO_INTERRUPT)) == 0U) ? 1 : 0);
+    }
+
+    /* Invalidate flags before read */
+    VQUEUE_INVALIDATE(&vq->vq_ring.used->flags, sizeof(vq->vq_ring.used->flags));
+    flags = vq->vq_ring.used->flags;
+
+    if (((vq->vq_flags & VIRTQUEUE_FLAG_EVENT_IDX) != 0UL) && ((flags & (uint16_t)VRING_USED_F_EVENT_IDX) != 0U))
     {
-        /*
-         * $Line Coverage Justification$
-         * This part does not need to be tested because VIRTQUEUE_FLAG_EVENT_IDX is not being
-         * utilized in rpmsg_lite implementation.
-         */
-        /* GCOVR_EXCL_START */
-        /* Invalidate avail->idx before read */
-        VQUEUE_INVALIDATE(&vq->vq_ring.avail->idx, sizeof(vq->vq_ring.avail->idx));
-        new_idx  = vq->vq_ring.avail->idx;
-        prev_idx = new_idx - vq->vq_queued_cnt;
         VQUEUE_INVALIDATE(&vring_avail_event(&vq->vq_ring), sizeof(vring_avail_event(&vq->vq_ring)));
         event_idx = (uint16_t)vring_avail_event(&vq->vq_ring);
 
         return ((vring_need_event(event_idx, new_idx, prev_idx) != 0) ? 1 : 0);
     }
-    /* GCOVR_EXCL_STOP */
 
-    /* Invalidate flags before read */
-    VQUEUE_INVALIDATE(&vq->vq_ring.used->flags, sizeof(vq->vq_ring.used->flags));
-    return (((vq->vq_ring.used->flags & ((uint16_t)VRING_USED_F_NO_NOTIFY)) == 0U) ? 1 : 0);
+    return (((flags & ((uint16_t)VRING_USED_F_NO_NOTIFY)) == 0U) ? 1 : 0);
 }
 
 /*!
@@ -895,12 +1384,26 @@ static void vq_ring_notify_host(struct virtqueue *vq)
     }
 }
 
-/*
- * $Line Coverage Justification$
- * This virtqueue function does not need to be tested because it is not used in rpmsg_lite
- * implementation.
+/*!
+ *
+ * vq_ring_publish_event
+ *
  */
-/* GCOVR_EXCL_START */
+static void vq_ring_publish_event(struct virtqueue *vq, uint16_t event_idx)
+{
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL)
+    {
+        /* Device side waits for avail->idx to pass event_idx */
+        vring_avail_event(&vq->vq_ring) = event_idx;
+        VQUEUE_FLUSH(&vring_avail_event(&vq->vq_ring), sizeof(vring_avail_event(&vq->vq_ring)));
+    }
+    else
+    {
+        /* Driver side waits for used->idx to pass event_idx */
+        vring_used_event(&vq->vq_ring) = event_idx;
+        VQUEUE_FLUSH(&vring_used_event(&vq->vq_ring), sizeof(vring_used_event(&vq->vq_ring)));
+    }
+}
 
 /*!
  *
@@ -911,6 +1414,13 @@ static uint16_t virtqueue_nused(struct virtqueue *vq)
 {
     uint16_t used_idx, nused;
 
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL)
+    {
+        /* Device side consumes the avail ring */
+        VQUEUE_INVALIDATE(&vq->vq_ring.avail->idx, sizeof(vq->vq_ring.avail->idx));
+        return (uint16_t)(vq->vq_ring.avail->idx - vq->vq_available_idx);
+    }
+
     /* Invalidate used-idx before read */
     VQUEUE_INVALIDATE(&vq->vq_ring.used->idx, sizeof(vq->vq_ring.used->idx));
     used_idx = vq->vq_ring.used->idx;
@@ -920,4 +1430,218 @@ static uint16_t virtqueue_nused(struct virtqueue *vq)
 
     return (nused);
 }
-/* GCOVR_EXCL_STOP */
+
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+/*!
+ *
+ * vq_ring_claim_mp
+ *
+ */
+static void *vq_ring_claim_mp(struct virtqueue *vq, uint32_t *len, uint16_t *idx)
+{
+    struct vring_used_elem *uep;
+    uint16_t mask = (uint16_t)(vq->vq_nentries - 1U);
+    uint16_t cons_idx;
+    uint16_t slot;
+    uint16_t desc_idx;
+    uint32_t desc_len = 0U;
+
+    cons_idx = atomic_load(&vq->vq_cons_claim);
+    do
+    {
+        slot = (uint16_t)(cons_idx & mask);
+        if ((vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL)
+        {
+            VQUEUE_INVALIDATE(&vq->vq_ring.avail->idx, sizeof(vq->vq_ring.avail->idx));
+            if (cons_idx == vq->vq_ring.avail->idx)
+            {
+                return (VQ_NULL);
+            }
+            env_rmb();
+            VQUEUE_INVALIDATE(&vq->vq_ring.avail->ring[slot], sizeof(vq->vq_ring.avail->ring[slot]));
+            desc_idx = vq->vq_ring.avail->ring[slot];
+        }
+        else
+        {
+            VQUEUE_INVALIDATE(&vq->vq_ring.used->idx, sizeof(vq->vq_ring.used->idx));
+            if (cons_idx == vq->vq_ring.used->idx)
+            {
+                return (VQ_NULL);
+            }
+            env_rmb();
+            uep = &vq->vq_ring.used->ring[slot];
+            VQUEUE_INVALIDATE(uep, sizeof(*uep));
+            desc_idx = (uint16_t)uep->id;
+            desc_len = uep->len;
+        }
+        /* The entry read is valid only if no other producer claimed it in between */
+    } while (!atomic_compare_exchange_weak(&vq->vq_cons_claim, &cons_idx, (uint16_t)(cons_idx + 1U)));
+
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL)
+    {
+        desc_len = vq->vq_shadow[desc_idx].len;
+    }
+#else
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL)
+    {
+        desc_len = vq->vq_ring.desc[desc_idx].len;
+    }
+#endif
+
+    if ((vq->vq_flags & (VIRTQUEUE_FLAG_EVENT_IDX | VIRTQUEUE_FLAG_CB_DISABLED)) == VIRTQUEUE_FLAG_EVENT_IDX)
+    {
+        /* Producers race to publish the event index, repeat until the latest claim is published */
+        do
+        {
+            cons_idx = atomic_load(&vq->vq_cons_claim);
+            vq_ring_publish_event(vq, cons_idx);
+            env_mb();
+        } while (cons_idx != atomic_load(&vq->vq_cons_claim));
+    }
+
+    *len = desc_len;
+    *idx = desc_idx;
+
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+    /* Filled by virtqueue_enable_multi_producer(), the producers never update the shadow concurrently */
+    return vq->vq_shadow[desc_idx].addr;
+#elif defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+    return env_map_patova(vq->env, ((uint32_t)(vq->vq_ring.desc[desc_idx].addr)));
+#else
+    return env_map_patova((uint32_t)(vq->vq_ring.desc[desc_idx].addr));
+#endif
+}
+
+/*!
+ *
+ * vq_ring_produce_mp
+ *
+ */
+static void vq_ring_produce_mp(struct virtqueue *vq, uint16_t head_idx, uint32_t len)
+{
+    uint16_t mask = (uint16_t)(vq->vq_nentries - 1U);
+    uint16_t slot;
+    uint16_t prod_idx;
+    uint16_t pub_idx;
+
+    /* Reserve a ring slot and fill it, no other producer writes this slot */
+    slot = (uint16_t)(atomic_fetch_add(&vq->vq_prod_claim, 1U) & mask);
+    if ((vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL)
+    {
+        vq->vq_ring.used->ring[slot].id  = head_idx;
+        vq->vq_ring.used->ring[slot].len = len;
+        VQUEUE_FLUSH(&vq->vq_ring.used->ring[slot], sizeof(vq->vq_ring.used->ring[slot]));
+    }
+    else
+    {
+        vq->vq_ring.avail->ring[slot] = head_idx;
+        VQUEUE_FLUSH(&vq->vq_ring.avail->ring[slot], sizeof(vq->vq_ring.avail->ring[slot]));
+    }
+    atomic_fetch_add(&vq->vq_prod_ready[slot], (uint16_t)vq->vq_nentries);
+
+    /*
+     * Publish the filled slots in order. One producer at a time advances the
+     * ring index, a producer finding it busy leaves its slot to that one,
+     * which checks the next slot again once it is done. Nobody waits for a
+     * producer preempted between reserving and filling its slot.
+     */
+    do
+    {
+        if (atomic_flag_test_and_set(&vq->vq_prod_busy))
+        {
+            return;
+        }
+        prod_idx = atomic_load(&vq->vq_prod_idx);
+        pub_idx  = prod_idx;
+        while (atomic_load(&vq->vq_prod_ready[pub_idx & mask]) == (uint16_t)(pub_idx + 1U))
+        {
+            pub_idx++;
+        }
+        if (pub_idx != prod_idx)
+        {
+            env_wmb();
+            if ((vq->vq_flags & VIRTQUEUE_FLAG_DEVICE) != 0UL)
+            {
+                vq->vq_ring.used->idx = pub_idx;
+                VQUEUE_FLUSH(&vq->vq_ring.used->idx, sizeof(vq->vq_ring.used->idx));
+            }
+            else
+            {
+                vq->vq_ring.avail->idx = pub_idx;
+                VQUEUE_FLUSH(&vq->vq_ring.avail->idx, sizeof(vq->vq_ring.avail->idx));
+            }
+            atomic_store(&vq->vq_prod_idx, pub_idx);
+        }
+        atomic_flag_clear(&vq->vq_prod_busy);
+    } while (atomic_load(&vq->vq_prod_ready[pub_idx & mask]) == (uint16_t)(pub_idx + 1U));
+}
+
+/*!
+ *
+ * vq_ring_kick_mp
+ *
+ */
+static void vq_ring_kick_mp(struct virtqueue *vq)
+{
+    uint16_t new_idx;
+    uint16_t prev_idx;
+
+    /* Ensure the published ring index is visible to host. */
+    env_mb();
+
+    /* Each published slot is covered by exactly one kick, the older one of two racing kicks has nothing to do */
+    new_idx  = atomic_load(&vq->vq_prod_idx);
+    prev_idx = atomic_exchange(&vq->vq_kick_idx, new_idx);
+    if (((uint16_t)(new_idx - prev_idx) == 0U) || ((uint16_t)(new_idx - prev_idx) > vq->vq_nentries))
+    {
+        return;
+    }
+
+    if (0 != vq_ring_must_notify_host(vq, new_idx, prev_idx))
+    {
+        vq_ring_notify_host(vq);
+    }
+}
+#endif /* RL_LOCKLESS_TX_MULTI_PRODUCER */
+
+#if defined(RL_ALLOW_DESC_SHADOW) && (RL_ALLOW_DESC_SHADOW == 1)
+/*!
+ *
+ * vq_ring_shadow
+ *
+ * Returns the local copy of the descriptor, reads the descriptor
+ * from the shared memory on its first use only.
+ *
+ */
+static struct vq_desc_shadow *vq_ring_shadow(struct virtqueue *vq, uint16_t desc_idx)
+{
+    struct vq_desc_shadow *shadow;
+    uint32_t slot;
+
+    VQ_RING_ASSERT_VALID_IDX(vq, desc_idx);
+
+    shadow = &vq->vq_shadow[desc_idx];
+    if (shadow->addr == VQ_NULL)
+    {
+        /* Invalidate the descriptor before it is read */
+        VQUEUE_INVALIDATE(&vq->vq_ring.desc[desc_idx], sizeof(vq->vq_ring.desc[desc_idx]));
+        shadow->len = vq->vq_ring.desc[desc_idx].len;
+#if defined(RL_USE_ENVIRONMENT_CONTEXT) && (RL_USE_ENVIRONMENT_CONTEXT == 1)
+        shadow->addr = env_map_patova(vq->env, ((uint32_t)(vq->vq_ring.desc[desc_idx].addr)));
+#else
+        shadow->addr = env_map_patova((uint32_t)(vq->vq_ring.desc[desc_idx].addr));
+#endif
+
+        /* Linear probing, for virtqueue_get_buffer_index() */
+        slot = VQ_SHADOW_HASH_SLOT(shadow->addr);
+        while (vq->vq_shadow_hash[slot] != 0U)
+        {
+            slot = (slot + 1U) & VQ_SHADOW_HASH_MASK;
+        }
+        vq->vq_shadow_hash[slot] = (uint16_t)(desc_idx + 1U);
+    }
+
+    return shadow;
+}
+#endif /* RL_ALLOW_DESC_SHADOW */
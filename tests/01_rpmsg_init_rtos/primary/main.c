@@ -248,10 +248,17 @@ void tc_3_env_testing()
     TEST_ASSERT_MESSAGE(0 == env_create_sync_lock(&mutex, 1), "env_create_sync_lock function failed");
     env_delete_sync_lock(mutex);
     env_delete_sync_lock(RL_NULL);
+    TEST_ASSERT_MESSAGE(0 == env_create_sync_lock(&mutex, LOCKED), "env_create_sync_lock function failed");
+    TEST_ASSERT_MESSAGE(-1 == env_acquire_sync_lock(mutex, 0), "env_acquire_sync_lock of locked sync lock failed");
+    TEST_ASSERT_MESSAGE(-1 == env_acquire_sync_lock(mutex, 10), "env_acquire_sync_lock timeout failed");
+    env_release_sync_lock(mutex);
+    TEST_ASSERT_MESSAGE(0 == env_acquire_sync_lock(mutex, 10), "env_acquire_sync_lock function failed");
+    env_delete_sync_lock(mutex);
     env_sleep_msec(1);
     env_map_memory(temp2, temp3, sizeof(uint32_t), 0);
     env_disable_cache();
     TEST_ASSERT_MESSAGE(0 < env_get_timestamp(), "env_get_timestamp function failed");
+    TEST_ASSERT_MESSAGE(0U == env_timestamp_to_msec(0U), "env_timestamp_to_msec function failed");
     TEST_ASSERT_MESSAGE(-1 == env_create_queue(&q, -1, 1), "env_create_queue function with bad params failed");
     TEST_ASSERT_MESSAGE(-1 == env_create_queue(&q, 1, -1), "env_create_queue function with bad params failed");
     // force env_create_queue() call to fail - request to allocate too much memory
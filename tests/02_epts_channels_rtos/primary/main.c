@@ -279,7 +279,7 @@ void tc_1_defchnl_4(void)
             rpmsg_queue_recv_nocopy(my_rpmsg, queues[j], &remote_addr, (char **)&received, &len, RL_BLOCK);
             TEST_ASSERT_MESSAGE(*received == send + 10, "'rpmsg_rtos_recv' failed");
             TEST_ASSERT_MESSAGE(remote_addr == (TC_REMOTE_EPT_ADDR + j), "'rpmsg_rtos_recv' failed");
-            TEST_ASSERT_MESSAGE(len == sizeof(received), "'rpmsg_rtos_recv' failed");
+            TEST_ASSERT_MESSAGE(len == sizeof(*received), "'rpmsg_rtos_recv' failed");
             rpmsg_queue_nocopy_free(my_rpmsg, received);
         }
     }
@@ -193,7 +193,7 @@ void tc_1_defchnl_2(void)
         TEST_ASSERT_MESSAGE(*received == i, "'rpmsg_queue_recv_nocopy' failed");
         TEST_ASSERT_MESSAGE(len == sizeof(int), "'rpmsg_queue_recv_nocopy' failed");
         (*received) += 10;
-        rpmsg_lite_send(my_rpmsg, default_ept, remote_addr, (char *)received, sizeof(received), RL_BLOCK);
+        rpmsg_lite_send(my_rpmsg, default_ept, remote_addr, (char *)received, sizeof(*received), RL_BLOCK);
         rpmsg_queue_nocopy_free(my_rpmsg, received);
     }
 
@@ -275,9 +275,9 @@ void tc_1_defchnl_4(void)
             rpmsg_queue_recv_nocopy(my_rpmsg, queues[j], &remote_addr, (char **)&received, &len, RL_BLOCK);
             TEST_ASSERT_MESSAGE(*received == 0, "'rpmsg_rtos_recv' failed");
             TEST_ASSERT_MESSAGE(remote_addr == (TC_REMOTE_EPT_ADDR + j), "'rpmsg_rtos_recv' failed");
-            TEST_ASSERT_MESSAGE(len == sizeof(received), "'rpmsg_rtos_recv' failed");
+            TEST_ASSERT_MESSAGE(len == sizeof(*received), "'rpmsg_rtos_recv' failed");
             (*received) += 10;
-            rpmsg_lite_send(my_rpmsg, epts[j], remote_addr, (char *)received, sizeof(received), RL_BLOCK);
+            rpmsg_lite_send(my_rpmsg, epts[j], remote_addr, (char *)received, sizeof(*received), RL_BLOCK);
             rpmsg_queue_nocopy_free(my_rpmsg, received);
         }
     }
@@ -15,14 +15,26 @@
 #if defined(SDK_OS_FREE_RTOS)
 #include "FreeRTOS.h"
 #include "task.h"
+#elif (defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)) || \
+    (defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1))
+/* The producer tasks of the test case 17 and the rx worker task run as threads of the host build */
+#include <pthread.h>
 #endif
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
 #define TC_TRANSFER_COUNT 10
+#define TC_NOCOPY_BATCH_COUNT 2
 #define DATA_LEN 45
 #define TC_LOCAL_EPT_ADDR (40)
 #define TC_REMOTE_EPT_ADDR (30)
+/* Receive timeout of the feature test cases, a failure on one side does not block the other one forever */
+#define TC_FEATURE_TIMEOUT_MS (5000)
+#if !(defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1))
+#define TC_BUFFER_COUNT RL_BUFFER_COUNT
+#else
+#define TC_BUFFER_COUNT RL_BUFFER_COUNT(RPMSG_LITE_LINK_ID)
+#endif
 
 #ifndef SH_MEM_NOT_TAKEN_FROM_LINKER
 #define SH_MEM_TOTAL_SIZE (6144)
@@ -58,6 +70,87 @@ rpmsg_ns_handle ns_handle = NULL;
 volatile uint32_t remote_addr = 0U;
 void *aux_mutex = NULL;
 void *aux_q = RL_NULL;
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+volatile uint32_t queue_high_count = 0U;
+volatile uint32_t queue_low_count = 0U;
+
+static void app_queue_watermark_cb(rpmsg_queue_handle q, uint32_t above_high, void *priv)
+{
+    if (above_high == RL_TRUE)
+    {
+        queue_high_count++;
+    }
+    else
+    {
+        queue_low_count++;
+    }
+}
+#endif
+
+#if defined(RL_ALLOW_FRAGMENTATION) && (RL_ALLOW_FRAGMENTATION == 1)
+#define TC_FRAG_LEN 40
+static char frag_rx_data[2 * TC_FRAG_LEN];
+static volatile uint32_t frag_rx_len = 0U;
+static void app_frag_rx_cb(void *data, uint32_t len, uint32_t src, void *priv)
+{
+    if (len <= sizeof(frag_rx_data))
+    {
+        memcpy(frag_rx_data, data, len);
+    }
+    frag_rx_len = len;
+}
+
+/* Feeds a fake fragment to the reassembly, as done by the rx dispatch of a real one */
+static int32_t app_frag_feed(struct rpmsg_lite_reassembly *r, uint32_t flags, uint32_t total_len, char pattern, uint32_t len)
+{
+    static uint32_t msg_buf[(sizeof(struct rpmsg_std_hdr) + sizeof(struct rpmsg_lite_frag_hdr) + TC_FRAG_LEN + 3U) / 4U];
+    struct rpmsg_std_msg *msg = (struct rpmsg_std_msg *)msg_buf;
+    uint32_t hdr_len          = 0U;
+
+    if ((flags & RL_MSG_FLAG_FRAG_FIRST) != 0U)
+    {
+        memcpy(msg->data, &total_len, sizeof(total_len));
+        hdr_len = sizeof(struct rpmsg_lite_frag_hdr);
+    }
+    memset(&msg->data[hdr_len], pattern, len);
+    msg->hdr.src   = TC_REMOTE_EPT_ADDR;
+    msg->hdr.dst   = TC_LOCAL_EPT_ADDR;
+    msg->hdr.len   = (uint16_t)(hdr_len + len);
+    msg->hdr.flags = (uint16_t)flags;
+    return rpmsg_lite_reassembly_rx_cb(msg->data, msg->hdr.len, TC_REMOTE_EPT_ADDR, r);
+}
+#endif
+
+#if defined(RL_ALLOW_ASYNC_SEND) && (RL_ALLOW_ASYNC_SEND == 1) && \
+    defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
+#define TC_ASYNC_QUEUE_DEPTH ((uint32_t)RL_ASYNC_SEND_QUEUE_DEPTH)
+/* One more request than the queue takes */
+static struct rpmsg_lite_async_req async_reqs[TC_ASYNC_QUEUE_DEPTH + 1U];
+static char async_data[TC_ASYNC_QUEUE_DEPTH + 1U][DATA_LEN];
+static volatile uint32_t async_done_count = 0U;
+static volatile uint32_t async_fail_count = 0U;
+static void app_async_done_cb(struct rpmsg_lite_async_req *req, int32_t status, void *priv)
+{
+    if (status != RL_SUCCESS)
+    {
+        async_fail_count++;
+    }
+    async_done_count++;
+}
+#endif
+
+#if defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)
+static volatile uint32_t tx_consumed_count = 0U;
+static volatile uint32_t tx_consumed_bad   = 0U;
+static void app_tx_consumed_cb(void *token, uint64_t sent_at, uint64_t consumed_at, void *priv)
+{
+    if ((token == RL_NULL) || (consumed_at < sent_at))
+    {
+        tx_consumed_bad++;
+    }
+    tx_consumed_count++;
+}
+#endif
 
 static void app_nameservice_isr_cb(uint32_t new_ept, const char *new_ept_name, uint32_t flags, void *user_data)
 {
@@ -74,6 +167,79 @@ static void app_nameservice_isr_cb(uint32_t new_ept, const char *new_ept_name, u
     TEST_ASSERT_MESSAGE(0 == env_get_current_queue_size((void *)aux_q), "env_get_current_queue_size function in ISR failed");
 }
 
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+#define TC_RX_WORKER_BUDGET     (4U)
+#define TC_RX_WORKER_TIMEOUT_MS (10U)
+#define TC_RX_WORKER_STACK_SIZE (512U)
+static volatile uint32_t rx_worker_stop    = 0U;
+static volatile uint32_t rx_worker_running = 0U;
+static volatile uint32_t rx_worker_pause   = 0U;
+static volatile uint32_t rx_worker_paused  = 0U;
+#if !defined(SDK_OS_FREE_RTOS)
+static pthread_t rx_worker_thread;
+#endif
+
+// utility: rx worker task, processes the messages of the endpoints whose rx_cb is not called from the rx ISR
+static void rx_worker_loop(void)
+{
+    while (rx_worker_stop == 0U)
+    {
+        if (rx_worker_pause != 0U)
+        {
+            // test case 18 calls rpmsg_lite_rx_worker() itself meanwhile
+            rx_worker_paused = 1U;
+            env_sleep_msec(1);
+            continue;
+        }
+        rx_worker_paused = 0U;
+        (void)rpmsg_lite_rx_worker(my_rpmsg, TC_RX_WORKER_BUDGET, TC_RX_WORKER_TIMEOUT_MS);
+    }
+    rx_worker_running = 0U;
+}
+
+#if defined(SDK_OS_FREE_RTOS)
+static void rx_worker_task(void *param)
+{
+    rx_worker_loop();
+    vTaskDelete(NULL);
+}
+#else
+static void *rx_worker_task(void *param)
+{
+    rx_worker_loop();
+    return NULL;
+}
+#endif
+
+// utility: start the rx worker task
+static void ts_start_rx_worker(void)
+{
+    rx_worker_stop    = 0U;
+    rx_worker_running = 1U;
+#if defined(SDK_OS_FREE_RTOS)
+    TEST_ASSERT_MESSAGE(pdPASS == xTaskCreate(rx_worker_task, "RX_WORKER_TASK", TC_RX_WORKER_STACK_SIZE, NULL,
+                                              tskIDLE_PRIORITY + 2, NULL),
+                        "'xTaskCreate' failed");
+#else
+    TEST_ASSERT_MESSAGE(0 == pthread_create(&rx_worker_thread, NULL, rx_worker_task, NULL), "'pthread_create' failed");
+#endif
+}
+
+// utility: stop the rx worker task
+static void ts_stop_rx_worker(void)
+{
+    rx_worker_stop = 1U;
+#if defined(SDK_OS_FREE_RTOS)
+    while (rx_worker_running != 0U)
+    {
+        env_sleep_msec(1);
+    }
+#else
+    (void)pthread_join(rx_worker_thread, NULL);
+#endif
+}
+#endif
+
 // utility: initialize rpmsg and environment
 // and wait for default channel
 int32_t ts_init_rpmsg(void)
@@ -88,6 +254,9 @@ int32_t ts_init_rpmsg(void)
                                       RL_NO_FLAGS);
 #endif /* SH_MEM_NOT_TAKEN_FROM_LINKER */
     TEST_ASSERT_MESSAGE(NULL != my_rpmsg, "init function failed");
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+    ts_start_rx_worker();
+#endif
 
     ns_handle = rpmsg_ns_bind(my_rpmsg, app_nameservice_isr_cb, (void *)&remote_addr);
     TEST_ASSERT_MESSAGE(NULL != ns_handle, "'rpmsg_ns_bind' failed");
@@ -97,6 +266,9 @@ int32_t ts_init_rpmsg(void)
 // utility: deinitialize rpmsg and environment
 int32_t ts_deinit_rpmsg(void)
 {
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+    ts_stop_rx_worker();
+#endif
     rpmsg_ns_unbind(my_rpmsg, ns_handle);
     rpmsg_lite_deinit(my_rpmsg);
     return 0;
@@ -167,8 +339,35 @@ void tc_1_send_receive(void)
     void *data_addr = NULL;
     uint32_t src;
     uint32_t len;
+    uint32_t sent;
+    uint32_t batch_sent;
+    struct rpmsg_lite_batch_entry batch[TC_TRANSFER_COUNT];
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+    struct rpmsg_queue_stats queue_stats;
+#endif
     volatile uint32_t i = 0;
 
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+    // lossless queue of depth 1, the echoed messages are parked and received in order
+    result = rpmsg_queue_set_depth(my_rpmsg, my_queue, 1, RL_TRUE);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_set_depth' failed");
+    result = rpmsg_queue_set_watermarks(my_rpmsg, my_queue, 2, 0, app_queue_watermark_cb, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_set_watermarks' failed");
+    // invalid params for the queue flow control functions
+    result = rpmsg_queue_set_depth(RL_NULL, my_queue, 1, RL_TRUE);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_queue_set_depth' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_queue_set_depth(my_rpmsg, RL_NULL, 1, RL_TRUE);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_queue_set_depth' with bad q param failed");
+    result = rpmsg_queue_set_depth(my_rpmsg, my_queue, 0xFFFFFFFFU, RL_TRUE);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_queue_set_depth' with bad depth param failed");
+    result = rpmsg_queue_set_watermarks(my_rpmsg, my_queue, 2, 2, app_queue_watermark_cb, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_queue_set_watermarks' with bad low param failed");
+    result = rpmsg_queue_set_watermarks(my_rpmsg, my_queue, 2, 0, RL_NULL, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_queue_set_watermarks' with bad cb param failed");
+    result = rpmsg_queue_get_stats(my_rpmsg, my_queue, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_queue_get_stats' with bad stats param failed");
+#endif
+
     for (i = 0; i < TC_TRANSFER_COUNT; i++)
     {
         env_memset(data, i, DATA_LEN);
@@ -185,6 +384,39 @@ void tc_1_send_receive(void)
     result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 1, data, DATA_LEN, RL_BLOCK);
     TEST_ASSERT_MESSAGE(0 == result, "negative number");
 
+    // send batch of messages to non-existing endpoint address, more messages than tx buffers to get partial success
+    for (i = 0; i < TC_TRANSFER_COUNT; i++)
+    {
+        batch[i].ept  = my_ept;
+        batch[i].dst  = TC_REMOTE_EPT_ADDR + 1;
+        batch[i].data = data;
+        batch[i].size = DATA_LEN;
+    }
+    batch_sent = 0;
+    while (batch_sent < TC_TRANSFER_COUNT)
+    {
+        result = rpmsg_lite_send_batch(my_rpmsg, &batch[batch_sent], TC_TRANSFER_COUNT - batch_sent, &sent);
+        TEST_ASSERT_MESSAGE((RL_SUCCESS == result) || (RL_ERR_NO_MEM == result), "'rpmsg_lite_send_batch' failed");
+        TEST_ASSERT_MESSAGE((RL_SUCCESS != result) || (sent == TC_TRANSFER_COUNT - batch_sent),
+                            "'rpmsg_lite_send_batch' sent count failed");
+        batch_sent += sent;
+    }
+
+    // invalid params for send_batch
+    result = rpmsg_lite_send_batch(RL_NULL, batch, TC_TRANSFER_COUNT, &sent);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_send_batch' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_lite_send_batch(my_rpmsg, RL_NULL, TC_TRANSFER_COUNT, &sent);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_send_batch' with bad entries param failed");
+    result = rpmsg_lite_send_batch(my_rpmsg, batch, TC_TRANSFER_COUNT, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_send_batch' with bad sent param failed");
+    batch[1].ept = RL_NULL;
+    result = rpmsg_lite_send_batch(my_rpmsg, batch, TC_TRANSFER_COUNT, &sent);
+    TEST_ASSERT_MESSAGE((RL_ERR_PARAM == result) && (0U == sent), "'rpmsg_lite_send_batch' with bad entry ept failed");
+    batch[1].ept  = my_ept;
+    batch[1].size = 0xFFFFFFFF;
+    result = rpmsg_lite_send_batch(my_rpmsg, batch, TC_TRANSFER_COUNT, &sent);
+    TEST_ASSERT_MESSAGE((RL_ERR_BUFF_SIZE == result) && (0U == sent), "'rpmsg_lite_send_batch' with bad entry size failed");
+
     // send - invalid rpmsg_lite_dev
     result = rpmsg_lite_send(RL_NULL, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, RL_BLOCK);
     TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_send' with bad rpmsg_lite_dev param failed");
@@ -249,6 +481,19 @@ void tc_1_send_receive(void)
         TEST_ASSERT_MESSAGE(0 == result, "negative number");
     }
 
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+    result = rpmsg_queue_get_stats(my_rpmsg, my_queue, &queue_stats);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_get_stats' failed");
+    TEST_ASSERT_MESSAGE(0U == queue_stats.dropped_count, "'rpmsg_queue_get_stats' dropped_count failed");
+    TEST_ASSERT_MESSAGE(0U < queue_stats.parked_count, "'rpmsg_queue_get_stats' parked_count failed");
+    TEST_ASSERT_MESSAGE(0 == rpmsg_queue_get_current_size(my_queue), "'rpmsg_queue_get_current_size' failed");
+    TEST_ASSERT_MESSAGE((0U < queue_high_count) && (queue_high_count == queue_low_count), "queue watermark callback failed");
+    result = rpmsg_queue_set_watermarks(my_rpmsg, my_queue, 0, 0, RL_NULL, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_set_watermarks' failed");
+    result = rpmsg_queue_set_depth(my_rpmsg, my_queue, 0, RL_FALSE);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_set_depth' failed");
+#endif
+
     /* for invalid length remote receive */
     result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, RL_BLOCK);
     TEST_ASSERT_MESSAGE(0 == result, "negative number");
@@ -266,8 +511,13 @@ void tc_2_send_receive(void)
     uint32_t buf_size = 0;
     uint32_t src;
     uint32_t len;
+    uint32_t sent;
+    struct rpmsg_lite_batch_entry batch[TC_NOCOPY_BATCH_COUNT];
     volatile uint32_t i = 0;
     my_rpmsg_queue_rx_cb_data_t fake_msg = {0};
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+    struct rpmsg_queue_stats queue_stats;
+#endif
 
     for (i = 0; i < TC_TRANSFER_COUNT; i++)
     {
@@ -303,6 +553,25 @@ void tc_2_send_receive(void)
     data_addr = rpmsg_lite_alloc_tx_buffer(my_rpmsg, NULL, RL_BLOCK);
     TEST_ASSERT_MESSAGE(NULL == data_addr, "negative number");
 
+    // send nocopy batch of messages to non-existing endpoint address, messages will be dropped on the receiver side
+    for (i = 0; i < TC_NOCOPY_BATCH_COUNT; i++)
+    {
+        batch[i].ept  = my_ept;
+        batch[i].dst  = TC_REMOTE_EPT_ADDR + 1;
+        batch[i].data = rpmsg_lite_alloc_tx_buffer(my_rpmsg, &buf_size, RL_BLOCK);
+        batch[i].size = DATA_LEN;
+        TEST_ASSERT_MESSAGE(NULL != batch[i].data, "negative number");
+        env_memset(batch[i].data, i, DATA_LEN);
+    }
+    batch[0].ept = RL_NULL;
+    result = rpmsg_lite_send_nocopy_batch(my_rpmsg, batch, TC_NOCOPY_BATCH_COUNT, &sent);
+    TEST_ASSERT_MESSAGE((RL_ERR_PARAM == result) && (0U == sent), "'rpmsg_lite_send_nocopy_batch' with bad entry ept failed");
+    batch[0].ept = my_ept;
+    result = rpmsg_lite_send_nocopy_batch(my_rpmsg, batch, TC_NOCOPY_BATCH_COUNT, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_send_nocopy_batch' with bad sent param failed");
+    result = rpmsg_lite_send_nocopy_batch(my_rpmsg, batch, TC_NOCOPY_BATCH_COUNT, &sent);
+    TEST_ASSERT_MESSAGE((RL_SUCCESS == result) && (TC_NOCOPY_BATCH_COUNT == sent), "'rpmsg_lite_send_nocopy_batch' failed");
+
     // invalid params for send_nocopy
     result = rpmsg_lite_send_nocopy(my_rpmsg, NULL, TC_REMOTE_EPT_ADDR, data, DATA_LEN);
     TEST_ASSERT_MESSAGE(0 != result, "negative number");
@@ -329,11 +598,18 @@ void tc_2_send_receive(void)
         TEST_ASSERT_MESSAGE(0 == result, "negative number");
     }
     
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+    // limit the queue depth to allow queue full state and incomming messages dropping
+    (void)fake_msg;
+    result = rpmsg_queue_set_depth(my_rpmsg, my_queue, 1, RL_FALSE);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_set_depth' failed");
+#else
     // put fake messages into the queue to allow queue full state and incomming messages dropping
     for (i = 0; i < RL_BUFFER_COUNT + 1; i++)
     {
         TEST_ASSERT_MESSAGE(1 == env_put_queue(my_queue, &fake_msg, 0), "env_put_queue function failed");
     }
+#endif
     // send a message to the secondary side to trigger messages sending from the secondary side to the primary side
     data_addr = rpmsg_lite_alloc_tx_buffer(my_rpmsg, &buf_size, RL_BLOCK);
     TEST_ASSERT_MESSAGE(NULL != data_addr, "negative number");
@@ -344,6 +620,11 @@ void tc_2_send_receive(void)
     data_addr = NULL;
     //wait a while to allow the secondary side to send all messages and made the receive queue full
     env_sleep_msec(5000);
+#if defined(RL_ALLOW_QUEUE_BACKPRESSURE) && (RL_ALLOW_QUEUE_BACKPRESSURE == 1)
+    result = rpmsg_queue_get_stats(my_rpmsg, my_queue, &queue_stats);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_get_stats' failed");
+    TEST_ASSERT_MESSAGE(0U < queue_stats.dropped_count, "'rpmsg_queue_get_stats' dropped_count failed");
+#endif
     // invalid src and len pointer params for receive
     result = rpmsg_queue_recv(my_rpmsg, my_queue, RL_NULL, data, DATA_LEN, RL_NULL, RL_BLOCK);
     TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_queue_recv' with bad src and len pointer param failed");
@@ -351,6 +632,1413 @@ void tc_2_send_receive(void)
     TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv_nocopy' with bad bad src and len pointer param failed");
 }
 
+#if defined(RL_ALLOW_FRAGMENTATION) && (RL_ALLOW_FRAGMENTATION == 1)
+/******************************************************************************
+ * Test case 3
+ * - verify reassembly of fragmented messages into the caller-provided buffer
+ * - verify dropping of incomplete, interleaved and oversized messages
+ *****************************************************************************/
+void tc_3_fragmentation(void)
+{
+    static struct rpmsg_lite_reassembly r;
+    static char reassembly_buf[2 * TC_FRAG_LEN];
+    int32_t result;
+
+    result = rpmsg_lite_reassembly_init(RL_NULL, &r, reassembly_buf, sizeof(reassembly_buf), app_frag_rx_cb, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_reassembly_init' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_lite_reassembly_init(my_rpmsg, &r, reassembly_buf, sizeof(reassembly_buf), RL_NULL, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_reassembly_init' with bad rx_cb param failed");
+    result = rpmsg_lite_reassembly_init(my_rpmsg, &r, reassembly_buf, sizeof(reassembly_buf), app_frag_rx_cb, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_reassembly_init' failed");
+
+    // unfragmented message is passed as it is
+    result = app_frag_feed(&r, RL_NO_FLAGS, 0U, 'a', TC_FRAG_LEN);
+    TEST_ASSERT_MESSAGE((RL_RELEASE == result) && (TC_FRAG_LEN == frag_rx_len), "unfragmented message failed");
+
+    // two fragments reassembled into one message
+    frag_rx_len = 0U;
+    result      = app_frag_feed(&r, RL_MSG_FLAG_FRAG | RL_MSG_FLAG_FRAG_FIRST | 1U, 2U * TC_FRAG_LEN, 'b', TC_FRAG_LEN);
+    TEST_ASSERT_MESSAGE((RL_RELEASE == result) && (0U == frag_rx_len), "first fragment failed");
+    result = app_frag_feed(&r, RL_MSG_FLAG_FRAG | RL_MSG_FLAG_FRAG_LAST | 1U, 0U, 'c', TC_FRAG_LEN);
+    TEST_ASSERT_MESSAGE((RL_RELEASE == result) && (2U * TC_FRAG_LEN == frag_rx_len), "last fragment failed");
+    TEST_ASSERT_MESSAGE((0 == pattern_cmp(frag_rx_data, 'b', TC_FRAG_LEN)) &&
+                            (0 == pattern_cmp(&frag_rx_data[TC_FRAG_LEN], 'c', TC_FRAG_LEN)),
+                        "reassembled data failed");
+    TEST_ASSERT_MESSAGE((1U == r.completed_count) && (0U == r.aborted_count), "reassembly counters failed");
+
+    // fragment of another message and stray last fragment are dropped
+    frag_rx_len = 0U;
+    (void)app_frag_feed(&r, RL_MSG_FLAG_FRAG | RL_MSG_FLAG_FRAG_FIRST | 2U, 2U * TC_FRAG_LEN, 'd', TC_FRAG_LEN);
+    (void)app_frag_feed(&r, RL_MSG_FLAG_FRAG | RL_MSG_FLAG_FRAG_LAST | 3U, 0U, 'e', TC_FRAG_LEN);
+    TEST_ASSERT_MESSAGE((0U == frag_rx_len) && (1U == r.aborted_count), "interleaved fragment failed");
+    // new first fragment drops the incomplete message
+    (void)app_frag_feed(&r, RL_MSG_FLAG_FRAG | RL_MSG_FLAG_FRAG_FIRST | 3U, 2U * TC_FRAG_LEN, 'f', TC_FRAG_LEN);
+    TEST_ASSERT_MESSAGE(2U == r.aborted_count, "incomplete message failed");
+    (void)app_frag_feed(&r, RL_MSG_FLAG_FRAG | RL_MSG_FLAG_FRAG_LAST | 3U, 0U, 'g', TC_FRAG_LEN);
+    TEST_ASSERT_MESSAGE((2U * TC_FRAG_LEN == frag_rx_len) && (2U == r.completed_count), "reassembly after drop failed");
+    (void)app_frag_feed(&r, RL_MSG_FLAG_FRAG | RL_MSG_FLAG_FRAG_LAST | 3U, 0U, 'h', TC_FRAG_LEN);
+    TEST_ASSERT_MESSAGE(3U == r.aborted_count, "stray fragment failed");
+
+    // message larger than the buffer is dropped
+    frag_rx_len = 0U;
+    (void)app_frag_feed(&r, RL_MSG_FLAG_FRAG | RL_MSG_FLAG_FRAG_FIRST | 4U, 3U * TC_FRAG_LEN, 'i', TC_FRAG_LEN);
+    TEST_ASSERT_MESSAGE((0U == frag_rx_len) && (4U == r.aborted_count), "oversized message failed");
+    result = rpmsg_lite_reassembly_deinit(&r);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_reassembly_deinit' failed");
+    result = rpmsg_lite_reassembly_deinit(RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_reassembly_deinit' with bad param failed");
+
+    // invalid params for send_fragmented
+    result = rpmsg_lite_send_fragmented(RL_NULL, my_ept, remote_addr, reassembly_buf, sizeof(reassembly_buf), RL_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_send_fragmented' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_lite_send_fragmented(my_rpmsg, RL_NULL, remote_addr, reassembly_buf, sizeof(reassembly_buf), RL_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_send_fragmented' with bad ept param failed");
+    result = rpmsg_lite_send_fragmented(my_rpmsg, my_ept, remote_addr, RL_NULL, sizeof(reassembly_buf), RL_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_send_fragmented' with bad data param failed");
+    result = rpmsg_lite_send_fragmented(my_rpmsg, my_ept, remote_addr, reassembly_buf, 0U, RL_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_send_fragmented' with bad size param failed");
+}
+#endif
+
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1) && \
+    defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
+#define TC_TX_HOLD_MS (200U)
+/******************************************************************************
+ * Test case 4
+ * - verify a sender waiting for a free tx buffer is woken up when the
+ *   secondary side releases one, well before the timeout expires
+ * - verify a wait for a tx buffer with a short timeout expires
+ *****************************************************************************/
+void tc_4_tx_buffer_wait(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    void *data_addr     = NULL;
+    uint32_t buf_size   = 0;
+    uint32_t src;
+    uint32_t len;
+    uint64_t start;
+    uint32_t elapsed_ms;
+    uint32_t i;
+
+    // the secondary side holds all the tx buffers, then releases one after TC_TX_HOLD_MS
+    for (i = 0; i < TC_BUFFER_COUNT; i++)
+    {
+        data_addr = rpmsg_lite_alloc_tx_buffer(my_rpmsg, &buf_size, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(NULL != data_addr, "'rpmsg_lite_alloc_tx_buffer' failed");
+        env_memset(data_addr, i, DATA_LEN);
+        result = rpmsg_lite_send_nocopy(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data_addr, DATA_LEN);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send_nocopy' failed");
+    }
+
+    start     = env_get_timestamp();
+    data_addr = rpmsg_lite_alloc_tx_buffer(my_rpmsg, &buf_size, 4U * TC_TX_HOLD_MS);
+    elapsed_ms = env_timestamp_to_msec(env_get_timestamp() - start);
+    TEST_ASSERT_MESSAGE(NULL != data_addr, "'rpmsg_lite_alloc_tx_buffer' not woken up by the buffer release");
+    TEST_ASSERT_MESSAGE((TC_TX_HOLD_MS / 2U <= elapsed_ms) && (2U * TC_TX_HOLD_MS > elapsed_ms),
+                        "'rpmsg_lite_alloc_tx_buffer' wake up time failed");
+
+    // the other buffers are still held, a wait shorter than a tick expires
+    TEST_ASSERT_MESSAGE(NULL == rpmsg_lite_alloc_tx_buffer(my_rpmsg, &buf_size, 1U),
+                        "'rpmsg_lite_alloc_tx_buffer' with short timeout failed");
+
+    env_memset(data_addr, TC_BUFFER_COUNT, DATA_LEN);
+    result = rpmsg_lite_send_nocopy(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data_addr, DATA_LEN);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send_nocopy' failed");
+
+    // the secondary side releases the remaining buffers and confirms
+    result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, data, DATA_LEN, &len, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv' failed");
+    TEST_ASSERT_MESSAGE(0 == pattern_cmp(data, TC_BUFFER_COUNT + 1, DATA_LEN), "pattern_cmp failed");
+}
+#endif
+
+#if defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1)
+#define TC_NOTIFY_DEADLINE_US (2000U)
+/******************************************************************************
+ * Test case 5
+ * - verify each message notifies the secondary side without a threshold
+ * - verify messages up to the count threshold share one notification
+ * - verify rpmsg_lite_notify_worker() keeps the deadline when no other message is sent
+ *****************************************************************************/
+void tc_5_deferred_notify(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    uint32_t src;
+    uint32_t len;
+    uint32_t kicks_before;
+    uint32_t msgs_before;
+    uint32_t kicks;
+    uint32_t msgs;
+    uint32_t i;
+
+    result = rpmsg_lite_get_notify_counters(my_rpmsg, &kicks_before, &msgs_before);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_get_notify_counters' failed");
+
+    // one interrupt per message without a threshold
+    for (i = 0; i < TC_BUFFER_COUNT; i++)
+    {
+        env_memset(data, i, DATA_LEN);
+        result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+    }
+    result = rpmsg_lite_get_notify_counters(my_rpmsg, &kicks, &msgs);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_get_notify_counters' failed");
+    TEST_ASSERT_MESSAGE((TC_BUFFER_COUNT == kicks - kicks_before) && (TC_BUFFER_COUNT == msgs - msgs_before),
+                        "notification per message failed");
+    result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, data, DATA_LEN, &len, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv' failed");
+    TEST_ASSERT_MESSAGE(0 == pattern_cmp(data, TC_BUFFER_COUNT, DATA_LEN), "pattern_cmp failed");
+
+    // one interrupt for all the tx buffers with the count threshold
+    result = rpmsg_lite_set_notify_threshold(my_rpmsg, TC_BUFFER_COUNT, 0);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_notify_threshold' failed");
+    kicks_before = kicks;
+    msgs_before  = msgs;
+    for (i = 0; i < TC_BUFFER_COUNT; i++)
+    {
+        env_memset(data, i, DATA_LEN);
+        result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' with deferred notification failed");
+    }
+    result = rpmsg_lite_get_notify_counters(my_rpmsg, &kicks, &msgs);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_get_notify_counters' failed");
+    TEST_ASSERT_MESSAGE((1U == kicks - kicks_before) && (TC_BUFFER_COUNT == msgs - msgs_before),
+                        "notification at the count threshold failed");
+    result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, data, DATA_LEN, &len, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv' failed");
+    TEST_ASSERT_MESSAGE(0 == pattern_cmp(data, TC_BUFFER_COUNT, DATA_LEN), "pattern_cmp failed");
+
+    // messages to non-existing endpoint address are dropped on the receiver side, flushed explicitly
+    result = rpmsg_lite_set_notify_threshold(my_rpmsg, TC_TRANSFER_COUNT, 0);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_notify_threshold' failed");
+    for (i = 0; i < TC_TRANSFER_COUNT; i++)
+    {
+        result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 1, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' with deferred notification failed");
+    }
+    result = rpmsg_lite_flush(my_rpmsg);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_flush' failed");
+
+    // a single message below the threshold is notified by the worker at the deadline, without a flush
+    result = rpmsg_lite_set_notify_threshold(my_rpmsg, TC_TRANSFER_COUNT, TC_NOTIFY_DEADLINE_US);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_notify_threshold' failed");
+    result = rpmsg_lite_notify_worker(my_rpmsg, RL_DONT_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_ERR_NO_BUFF == result, "'rpmsg_lite_notify_worker' without pending message failed");
+    result = rpmsg_lite_get_notify_counters(my_rpmsg, &kicks_before, &msgs_before);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_get_notify_counters' failed");
+    env_memset(data, TC_BUFFER_COUNT + 1, DATA_LEN);
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' with deferred notification failed");
+    result = rpmsg_lite_get_notify_counters(my_rpmsg, &kicks, &msgs);
+    TEST_ASSERT_MESSAGE((RL_SUCCESS == result) && (kicks == kicks_before), "deferred notification failed");
+    result = rpmsg_lite_notify_worker(my_rpmsg, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_notify_worker' failed");
+    result = rpmsg_lite_get_notify_counters(my_rpmsg, &kicks, &msgs);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_get_notify_counters' failed");
+    TEST_ASSERT_MESSAGE((1U == kicks - kicks_before) && (1U == msgs - msgs_before), "notification at the deadline failed");
+    result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, data, DATA_LEN, &len, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv' failed");
+    TEST_ASSERT_MESSAGE(0 == pattern_cmp(data, TC_BUFFER_COUNT + 2, DATA_LEN), "pattern_cmp failed");
+    result = rpmsg_lite_notify_worker(my_rpmsg, RL_DONT_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_ERR_NO_BUFF == result, "'rpmsg_lite_notify_worker' without pending message failed");
+
+    result = rpmsg_lite_set_notify_threshold(my_rpmsg, 0, 0);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_notify_threshold' failed");
+
+    // invalid params for the deferred notification functions
+    result = rpmsg_lite_set_notify_threshold(RL_NULL, TC_TRANSFER_COUNT, 0);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_set_notify_threshold' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_lite_flush(RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_flush' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_lite_notify_worker(RL_NULL, RL_DONT_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_notify_worker' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_lite_get_notify_counters(RL_NULL, &kicks, &msgs);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_get_notify_counters' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_lite_get_notify_counters(my_rpmsg, RL_NULL, &msgs);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_get_notify_counters' with bad kick_count param failed");
+    result = rpmsg_lite_get_notify_counters(my_rpmsg, &kicks, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_get_notify_counters' with bad msg_count param failed");
+}
+#endif
+
+#if !(defined(RL_ALLOW_RX_ADAPTIVE_POLLING) && (RL_ALLOW_RX_ADAPTIVE_POLLING == 1)) && \
+    !(defined(RL_ALLOW_VRING_EVENT_IDX) && (RL_ALLOW_VRING_EVENT_IDX == 1))
+/******************************************************************************
+ * Test case 6
+ * - verify the secondary side keeps notifying a master of an earlier release,
+ *   which left the callbacks of both virtqueues disabled after its
+ *   initialization (VRING_AVAIL_F_NO_INTERRUPT set)
+ *****************************************************************************/
+void tc_6_baseline_master(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    uint32_t src;
+    uint32_t len;
+    uint32_t i;
+
+    virtqueue_disable_cb(my_rpmsg->rvq);
+    virtqueue_disable_cb(my_rpmsg->tvq);
+
+    // more round trips than tx buffers, each reply is notified
+    for (i = 0; i < TC_TRANSFER_COUNT; i++)
+    {
+        env_memset(data, i, DATA_LEN);
+        result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+        result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, data, DATA_LEN, &len, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv' with notifications suppressed failed");
+        TEST_ASSERT_MESSAGE(0 == pattern_cmp(data, i, DATA_LEN), "pattern_cmp failed");
+    }
+
+    (void)virtqueue_enable_cb(my_rpmsg->rvq);
+    (void)virtqueue_enable_cb(my_rpmsg->tvq);
+}
+#endif
+
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+#define TC_FC_EPT_ADDR (TC_REMOTE_EPT_ADDR + 3)
+#if defined(RL_ALLOW_FRAGMENTATION) && (RL_ALLOW_FRAGMENTATION == 1)
+/* Two fragments, the first one carries struct rpmsg_lite_frag_hdr */
+#define TC_FC_FRAG_LEN   (RL_BUFFER_PAYLOAD_SIZE + 1)
+#define TC_FC_FRAG_COUNT (2U)
+static char fc_frag_data[TC_FC_FRAG_LEN];
+#endif
+/******************************************************************************
+ * Test case 7
+ * - verify the sends to a peer granting no credit are held back by
+ *   rpmsg_lite_send(), rpmsg_lite_send_batch(), rpmsg_lite_send_fragmented()
+ *   and rpmsg_lite_send_packed() until the flow control is disabled
+ * - verify a secondary endpoint releasing the messages in its rx callback,
+ *   without a task, grants the credits of a window of one message to all of them
+ *****************************************************************************/
+void tc_7_credit_flow_control(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    struct rpmsg_lite_fc_stats fc_stats;
+    struct rpmsg_lite_batch_entry batch[2];
+    uint32_t report[3];
+    uint32_t expected = 2U * TC_TRANSFER_COUNT;
+    uint32_t blocked  = 2U;
+    uint32_t sent;
+    uint32_t src;
+    uint32_t len;
+    uint32_t i;
+
+    // no endpoint grants credits at the peer address, the sends to it are held back until disabled
+    result = rpmsg_lite_set_ept_flow_control(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 2, 1U, RL_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_ept_flow_control' failed");
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 2, data, DATA_LEN, RL_DONT_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_ERR_NO_BUFF == result, "'rpmsg_lite_send' without a credit failed");
+    for (i = 0; i < 2U; i++)
+    {
+        batch[i].ept  = my_ept;
+        batch[i].dst  = TC_REMOTE_EPT_ADDR + 2;
+        batch[i].data = data;
+        batch[i].size = DATA_LEN;
+    }
+    result = rpmsg_lite_send_batch(my_rpmsg, batch, 2U, &sent);
+    TEST_ASSERT_MESSAGE((RL_ERR_NO_BUFF == result) && (0U == sent), "'rpmsg_lite_send_batch' without a credit failed");
+#if defined(RL_ALLOW_FRAGMENTATION) && (RL_ALLOW_FRAGMENTATION == 1)
+    result = rpmsg_lite_send_fragmented(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 2, fc_frag_data, TC_FC_FRAG_LEN,
+                                        RL_DONT_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_ERR_NO_BUFF == result, "'rpmsg_lite_send_fragmented' without a credit failed");
+    blocked++;
+    expected += TC_FC_FRAG_COUNT;
+#endif
+#if defined(RL_ALLOW_MSG_PACKING) && (RL_ALLOW_MSG_PACKING == 1)
+    result = rpmsg_lite_send_packed(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 2, data, DATA_LEN, RL_DONT_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_ERR_NO_BUFF == result, "'rpmsg_lite_send_packed' without a credit failed");
+    blocked++;
+    expected += TC_TRANSFER_COUNT;
+#endif
+    result = rpmsg_lite_get_ept_fc_stats(my_rpmsg, my_ept, &fc_stats);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_get_ept_fc_stats' failed");
+    TEST_ASSERT_MESSAGE((0U == fc_stats.tx_credits) && (blocked == fc_stats.tx_blocked),
+                        "'rpmsg_lite_get_ept_fc_stats' wrong credit counters");
+    result = rpmsg_lite_set_ept_flow_control(my_rpmsg, my_ept, RL_ADDR_ANY, 0U, RL_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_ept_flow_control' disable failed");
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 2, data, DATA_LEN, RL_DONT_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' with the flow control disabled failed");
+
+    // the secondary side creates its endpoint and starts the window first
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+    result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, data, DATA_LEN, &len, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv' failed");
+    TEST_ASSERT_MESSAGE(0 == pattern_cmp(data, 1, DATA_LEN), "pattern_cmp failed");
+    result = rpmsg_lite_set_ept_flow_control(my_rpmsg, my_ept, TC_FC_EPT_ADDR, 1U, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_ept_flow_control' failed");
+
+    // each message waits for the credit granted by the rx callback of the previous one
+    for (i = 0; i < TC_TRANSFER_COUNT; i++)
+    {
+        result = rpmsg_lite_send(my_rpmsg, my_ept, TC_FC_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' with flow control failed");
+    }
+    // a batch stops at the first message without a credit
+    batch[0].dst = TC_FC_EPT_ADDR;
+    for (i = 0; i < TC_TRANSFER_COUNT; i += sent)
+    {
+        result = rpmsg_lite_send_batch(my_rpmsg, batch, 1U, &sent);
+        TEST_ASSERT_MESSAGE((RL_SUCCESS == result) || (RL_ERR_NO_BUFF == result),
+                            "'rpmsg_lite_send_batch' with flow control failed");
+        if (0U == sent)
+        {
+            env_sleep_msec(1);
+        }
+    }
+#if defined(RL_ALLOW_FRAGMENTATION) && (RL_ALLOW_FRAGMENTATION == 1)
+    result = rpmsg_lite_send_fragmented(my_rpmsg, my_ept, TC_FC_EPT_ADDR, fc_frag_data, TC_FC_FRAG_LEN,
+                                        TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send_fragmented' with flow control failed");
+#endif
+#if defined(RL_ALLOW_MSG_PACKING) && (RL_ALLOW_MSG_PACKING == 1)
+    for (i = 0; i < TC_TRANSFER_COUNT; i++)
+    {
+        result = rpmsg_lite_send_packed(my_rpmsg, my_ept, TC_FC_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send_packed' with flow control failed");
+        // the credit of the next message comes with the release of this one
+        result = rpmsg_lite_flush_packed(my_rpmsg);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_flush_packed' failed");
+    }
+#endif
+    result = rpmsg_lite_set_ept_flow_control(my_rpmsg, my_ept, RL_ADDR_ANY, 0U, RL_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_ept_flow_control' disable failed");
+
+    // the secondary side reports the messages received, the overruns of its window and the credit messages
+    env_memset(data, 2, DATA_LEN);
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+    result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, data, DATA_LEN, &len, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE((RL_SUCCESS == result) && (sizeof(report) == len), "'rpmsg_queue_recv' failed");
+    memcpy(report, data, sizeof(report));
+    TEST_ASSERT_MESSAGE(expected == report[0], "flow controlled message count failed");
+    TEST_ASSERT_MESSAGE(0U == report[1], "flow control window overrun");
+    TEST_ASSERT_MESSAGE(0U != report[2], "no credit message sent by the secondary side");
+
+    // invalid params for set_ept_flow_control and get_ept_fc_stats
+    result = rpmsg_lite_set_ept_flow_control(my_rpmsg, my_ept, RL_ADDR_ANY, 1U, RL_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_set_ept_flow_control' with bad peer param failed");
+    result = rpmsg_lite_set_ept_flow_control(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, 0xFFFFU, RL_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_set_ept_flow_control' with bad window param failed");
+    result = rpmsg_lite_set_ept_flow_control(RL_NULL, my_ept, TC_REMOTE_EPT_ADDR, 1U, RL_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result,
+                        "'rpmsg_lite_set_ept_flow_control' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_lite_get_ept_fc_stats(my_rpmsg, my_ept, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_get_ept_fc_stats' with bad stats param failed");
+}
+#endif
+
+#if defined(RL_ALLOW_MSG_PACKING) && (RL_ALLOW_MSG_PACKING == 1)
+#define TC_PACK_EPT_ADDR     (TC_REMOTE_EPT_ADDR + 4)
+#define TC_PACK_RECORD_COUNT (5U)
+/* Record filling the container up to its last byte after a DATA_LEN one */
+#define TC_PACK_FULL_LEN \
+    (RL_BUFFER_PAYLOAD_SIZE - RL_WORD_ALIGN_UP(sizeof(struct rpmsg_std_hdr) + DATA_LEN) - sizeof(struct rpmsg_std_hdr))
+#define TC_PACK_DEADLINE_US (200U)
+static char pack_data[RL_BUFFER_PAYLOAD_SIZE];
+/******************************************************************************
+ * Test case 8
+ * - verify several records of different sizes packed into one container and
+ *   flushed reach the secondary side one by one, in order and intact
+ * - verify a container filled up to its last byte is sent without a flush
+ *   and its last record is delivered
+ * - verify a container older than a sub-millisecond deadline is sent by the
+ *   next packed message
+ *****************************************************************************/
+void tc_8_msg_packing(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    uint32_t report[3];
+    uint32_t expected_len = 0U;
+    uint32_t src;
+    uint32_t len;
+    uint64_t start;
+    uint32_t i;
+
+    // invalid params for the packing functions
+    result = rpmsg_lite_send_packed(RL_NULL, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, RL_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_send_packed' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_lite_send_packed(my_rpmsg, RL_NULL, TC_REMOTE_EPT_ADDR, data, DATA_LEN, RL_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_send_packed' with bad ept param failed");
+    result = rpmsg_lite_send_packed(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, RL_NULL, DATA_LEN, RL_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_send_packed' with bad data param failed");
+    result = rpmsg_lite_send_packed(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, RL_BUFFER_PAYLOAD_SIZE, RL_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_ERR_BUFF_SIZE == result, "'rpmsg_lite_send_packed' with bad size param failed");
+    result = rpmsg_lite_set_pack_deadline(RL_NULL, 1000U);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_set_pack_deadline' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_lite_flush_packed(RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_flush_packed' with bad rpmsg_lite_dev param failed");
+    // nothing packed, nothing to send
+    result = rpmsg_lite_flush_packed(my_rpmsg);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_flush_packed' failed");
+
+    // the secondary side creates its endpoint first
+    result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, data, DATA_LEN, &len, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv' failed");
+    TEST_ASSERT_MESSAGE(0 == pattern_cmp(data, 0, DATA_LEN), "pattern_cmp failed");
+
+    // records 0..4 of 1..5 bytes, all in one container
+    for (i = 0; i < TC_PACK_RECORD_COUNT; i++)
+    {
+        env_memset(pack_data, i, i + 1U);
+        result = rpmsg_lite_send_packed(my_rpmsg, my_ept, TC_PACK_EPT_ADDR, pack_data, i + 1U, RL_BLOCK);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send_packed' failed");
+        TEST_ASSERT_MESSAGE(RL_NULL != my_rpmsg->pack_msg, "container sent before the flush");
+        expected_len += i + 1U;
+    }
+    result = rpmsg_lite_flush_packed(my_rpmsg);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_flush_packed' failed");
+
+    // records 5 and 6 take the whole payload of the container, sent once the last one is packed
+    env_memset(pack_data, TC_PACK_RECORD_COUNT, DATA_LEN);
+    result = rpmsg_lite_send_packed(my_rpmsg, my_ept, TC_PACK_EPT_ADDR, pack_data, DATA_LEN, RL_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send_packed' failed");
+    env_memset(pack_data, TC_PACK_RECORD_COUNT + 1U, TC_PACK_FULL_LEN);
+    result = rpmsg_lite_send_packed(my_rpmsg, my_ept, TC_PACK_EPT_ADDR, pack_data, TC_PACK_FULL_LEN, RL_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send_packed' failed");
+    TEST_ASSERT_MESSAGE(RL_NULL == my_rpmsg->pack_msg, "full container not sent");
+    expected_len += DATA_LEN + TC_PACK_FULL_LEN;
+
+    // records 7 and 8, the container is older than the deadline when the second one is packed
+    result = rpmsg_lite_set_pack_deadline(my_rpmsg, TC_PACK_DEADLINE_US);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_pack_deadline' failed");
+    for (i = TC_PACK_RECORD_COUNT + 2U; i < TC_PACK_RECORD_COUNT + 4U; i++)
+    {
+        env_memset(pack_data, i, DATA_LEN);
+        result = rpmsg_lite_send_packed(my_rpmsg, my_ept, TC_PACK_EPT_ADDR, pack_data, DATA_LEN, RL_BLOCK);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send_packed' failed");
+        start = env_get_timestamp();
+        while (env_timestamp_to_usec(env_get_timestamp() - start) < (2U * TC_PACK_DEADLINE_US))
+        {
+        }
+        expected_len += DATA_LEN;
+    }
+    TEST_ASSERT_MESSAGE(RL_NULL == my_rpmsg->pack_msg, "container not sent at the deadline");
+    result = rpmsg_lite_set_pack_deadline(my_rpmsg, 0U);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_pack_deadline' failed");
+
+    // the secondary side reports the records received, the damaged ones and their total length
+    env_memset(data, 2, DATA_LEN);
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+    result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, data, DATA_LEN, &len, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE((RL_SUCCESS == result) && (sizeof(report) == len), "'rpmsg_queue_recv' failed");
+    memcpy(report, data, sizeof(report));
+    TEST_ASSERT_MESSAGE((TC_PACK_RECORD_COUNT + 4U) == report[0], "packed record count failed");
+    TEST_ASSERT_MESSAGE(0U == report[1], "packed record content failed");
+    TEST_ASSERT_MESSAGE(expected_len == report[2], "packed record length failed");
+}
+#endif
+
+#if defined(RL_ALLOW_GROUP_ENDPOINTS) && (RL_ALLOW_GROUP_ENDPOINTS == 1)
+#define TC_GROUP_EPT_ADDR     (TC_LOCAL_EPT_ADDR + 5)
+#define TC_GROUP_MEMBER_COUNT (3U)
+static struct rpmsg_lite_group tc_group;
+static struct rpmsg_lite_endpoint *tc_group_subs[TC_GROUP_MEMBER_COUNT];
+
+// utility: rx buffers returned to the vring so far, the primary side is the master
+static uint16_t tc_rx_returned(void)
+{
+    return my_rpmsg->rvq->vq_ring.avail->idx;
+}
+
+/******************************************************************************
+ * Test case 9
+ * - verify a message received on a group endpoint reaches every member from
+ *   the same rx buffer
+ * - verify the rx buffer goes back to the vring with the last release only
+ * - verify a member unsubscribed while holding the buffer still returns it
+ *   and gets no further messages
+ *****************************************************************************/
+void tc_9_group_endpoints(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    struct rpmsg_lite_group group;
+    struct rpmsg_lite_endpoint *group_subs[1];
+    struct rpmsg_lite_endpoint *group_ept;
+    struct rpmsg_lite_endpoint *member_epts[TC_GROUP_MEMBER_COUNT];
+    rpmsg_queue_handle member_queues[TC_GROUP_MEMBER_COUNT];
+    char *member_data[TC_GROUP_MEMBER_COUNT];
+    uint16_t returned;
+    uint32_t src;
+    uint32_t len;
+    uint32_t i;
+
+    result = rpmsg_lite_group_init(my_rpmsg, &tc_group, tc_group_subs, TC_GROUP_MEMBER_COUNT);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_group_init' failed");
+    for (i = 0; i < TC_GROUP_MEMBER_COUNT; i++)
+    {
+        member_queues[i] = rpmsg_queue_create(my_rpmsg);
+        TEST_ASSERT_MESSAGE(RL_NULL != member_queues[i], "'rpmsg_queue_create' failed");
+        member_epts[i] = rpmsg_lite_create_ept(my_rpmsg, TC_GROUP_EPT_ADDR + 1U + i, rpmsg_queue_rx_cb, member_queues[i]);
+        TEST_ASSERT_MESSAGE(RL_NULL != member_epts[i], "'rpmsg_lite_create_ept' failed");
+        result = rpmsg_lite_group_subscribe(&tc_group, member_epts[i]);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_group_subscribe' failed");
+    }
+    result = rpmsg_lite_group_subscribe(&tc_group, my_ept);
+    TEST_ASSERT_MESSAGE(RL_ERR_NO_MEM == result, "'rpmsg_lite_group_subscribe' with a full group failed");
+    result = rpmsg_lite_group_unsubscribe(&tc_group, my_ept);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_group_unsubscribe' with bad ept param failed");
+    group_ept = rpmsg_lite_create_ept(my_rpmsg, TC_GROUP_EPT_ADDR, rpmsg_lite_group_rx_cb, &tc_group);
+    TEST_ASSERT_MESSAGE(RL_NULL != group_ept, "'rpmsg_lite_create_ept' failed");
+
+    // the secondary side sends the first message to the group
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+    for (i = 0; i < TC_GROUP_MEMBER_COUNT; i++)
+    {
+        result = rpmsg_queue_recv_nocopy(my_rpmsg, member_queues[i], &src, &member_data[i], &len, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE((RL_SUCCESS == result) && (DATA_LEN == len), "'rpmsg_queue_recv_nocopy' failed");
+        TEST_ASSERT_MESSAGE(0 == pattern_cmp(member_data[i], 3, DATA_LEN), "pattern_cmp failed");
+        TEST_ASSERT_MESSAGE(member_data[0] == member_data[i], "group message copied");
+    }
+
+    // held by all the members, returned by the last release only
+    returned = tc_rx_returned();
+    for (i = 0; i < (TC_GROUP_MEMBER_COUNT - 1U); i++)
+    {
+        result = rpmsg_queue_nocopy_free(my_rpmsg, member_data[i]);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_nocopy_free' failed");
+        TEST_ASSERT_MESSAGE(returned == tc_rx_returned(), "rx buffer returned before the last release");
+    }
+    result = rpmsg_lite_group_unsubscribe(&tc_group, member_epts[TC_GROUP_MEMBER_COUNT - 1U]);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_group_unsubscribe' failed");
+    TEST_ASSERT_MESSAGE(returned == tc_rx_returned(), "rx buffer returned by the unsubscribe");
+    result = rpmsg_queue_nocopy_free(my_rpmsg, member_data[TC_GROUP_MEMBER_COUNT - 1U]);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_nocopy_free' failed");
+    TEST_ASSERT_MESSAGE((uint16_t)(returned + 1U) == tc_rx_returned(), "rx buffer not returned by the last release");
+
+    // the second message reaches the remaining members only
+    env_memset(data, 1, DATA_LEN);
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+    for (i = 0; i < (TC_GROUP_MEMBER_COUNT - 1U); i++)
+    {
+        result = rpmsg_queue_recv_nocopy(my_rpmsg, member_queues[i], &src, &member_data[i], &len, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE((RL_SUCCESS == result) && (DATA_LEN == len), "'rpmsg_queue_recv_nocopy' failed");
+        TEST_ASSERT_MESSAGE(0 == pattern_cmp(member_data[i], 4, DATA_LEN), "pattern_cmp failed");
+    }
+    TEST_ASSERT_MESSAGE(0 == rpmsg_queue_get_current_size(member_queues[TC_GROUP_MEMBER_COUNT - 1U]),
+                        "unsubscribed member got a message");
+    returned = tc_rx_returned();
+    for (i = 0; i < (TC_GROUP_MEMBER_COUNT - 1U); i++)
+    {
+        result = rpmsg_queue_nocopy_free(my_rpmsg, member_data[i]);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_nocopy_free' failed");
+    }
+    TEST_ASSERT_MESSAGE((uint16_t)(returned + 1U) == tc_rx_returned(), "rx buffer not returned by the last release");
+
+    result = rpmsg_lite_destroy_ept(my_rpmsg, group_ept);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_destroy_ept' failed");
+    for (i = 0; i < TC_GROUP_MEMBER_COUNT; i++)
+    {
+        if (i < (TC_GROUP_MEMBER_COUNT - 1U))
+        {
+            result = rpmsg_lite_group_unsubscribe(&tc_group, member_epts[i]);
+            TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_group_unsubscribe' failed");
+        }
+        (void)rpmsg_lite_destroy_ept(my_rpmsg, member_epts[i]);
+        (void)rpmsg_queue_destroy(my_rpmsg, member_queues[i]);
+    }
+
+    // group subscriptions, the subs array limits the number of subscribers
+    result = rpmsg_lite_group_init(my_rpmsg, &group, group_subs, 1);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_group_init' failed");
+    result = rpmsg_lite_group_subscribe(&group, my_ept);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_group_subscribe' failed");
+    result = rpmsg_lite_group_subscribe(&group, my_ept);
+    TEST_ASSERT_MESSAGE(RL_ERR_NO_MEM == result, "'rpmsg_lite_group_subscribe' with full subs array failed");
+    result = rpmsg_lite_group_unsubscribe(&group, my_ept);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_group_unsubscribe' failed");
+    result = rpmsg_lite_group_unsubscribe(&group, my_ept);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_group_unsubscribe' with not subscribed ept failed");
+
+    // invalid params for group_init, group_subscribe and group_unsubscribe
+    result = rpmsg_lite_group_init(RL_NULL, &group, group_subs, 1);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_group_init' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_lite_group_init(my_rpmsg, &group, RL_NULL, 1);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_group_init' with bad subs param failed");
+    result = rpmsg_lite_group_init(my_rpmsg, &group, group_subs, 0);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_group_init' with bad subs_size param failed");
+    result = rpmsg_lite_group_subscribe(RL_NULL, my_ept);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_group_subscribe' with bad group param failed");
+    result = rpmsg_lite_group_subscribe(&group, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_group_subscribe' with bad ept param failed");
+    result = rpmsg_lite_group_unsubscribe(RL_NULL, my_ept);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_group_unsubscribe' with bad group param failed");
+}
+#endif
+
+#if defined(RL_ALLOW_CACHE_COUNTERS) && (RL_ALLOW_CACHE_COUNTERS == 1)
+/******************************************************************************
+ * Test case 10
+ * - verify the cache maintenance counters of a sent message
+ *****************************************************************************/
+void tc_10_cache_counters(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    struct rpmsg_lite_cache_counters cache_before;
+    struct rpmsg_lite_cache_counters cache_after;
+
+    // cache maintenance of a sent message covers its header and payload only
+    result = rpmsg_lite_get_cache_counters(my_rpmsg, &cache_before);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_get_cache_counters' failed");
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 1, data, DATA_LEN, RL_BLOCK);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+    result = rpmsg_lite_get_cache_counters(my_rpmsg, &cache_after);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_get_cache_counters' failed");
+    TEST_ASSERT_MESSAGE(cache_before.tx_count + 1U == cache_after.tx_count, "'rpmsg_lite_get_cache_counters' tx_count failed");
+    TEST_ASSERT_MESSAGE(cache_before.flushed_bytes + sizeof(struct rpmsg_std_hdr) + DATA_LEN == cache_after.flushed_bytes,
+                        "'rpmsg_lite_get_cache_counters' flushed_bytes failed");
+
+    // invalid params for get_cache_counters
+    result = rpmsg_lite_get_cache_counters(RL_NULL, &cache_after);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_get_cache_counters' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_lite_get_cache_counters(my_rpmsg, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_get_cache_counters' with bad counters param failed");
+}
+#endif
+
+#if defined(RL_ALLOW_TX_STASH) && (RL_ALLOW_TX_STASH == 1)
+/******************************************************************************
+ * Test case 11
+ * - verify messages sent from the tx stash of an endpoint
+ *****************************************************************************/
+void tc_11_tx_stash(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    uint32_t i;
+
+    // messages sent from the tx stash, the stash is returned by the flush
+    result = rpmsg_lite_set_ept_tx_stash(my_rpmsg, my_ept, 2U);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_ept_tx_stash' failed");
+    for (i = 0; i < 4; i++)
+    {
+        result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 1, data, DATA_LEN, RL_BLOCK);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' from the tx stash failed");
+    }
+    result = rpmsg_lite_flush_ept_tx_stash(my_rpmsg, my_ept);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_flush_ept_tx_stash' failed");
+    result = rpmsg_lite_set_ept_tx_stash(my_rpmsg, my_ept, 0U);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_ept_tx_stash' disable failed");
+
+    // invalid params for set_ept_tx_stash and flush_ept_tx_stash
+    result = rpmsg_lite_set_ept_tx_stash(my_rpmsg, my_ept, RL_TX_STASH_SIZE + 1U);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_set_ept_tx_stash' with bad count param failed");
+    result = rpmsg_lite_set_ept_tx_stash(RL_NULL, my_ept, 2U);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_set_ept_tx_stash' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_lite_flush_ept_tx_stash(my_rpmsg, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_flush_ept_tx_stash' with bad ept param failed");
+}
+#endif
+
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+/******************************************************************************
+ * Test case 12
+ * - verify the tx buffers in flight of an endpoint stay within its quota
+ *****************************************************************************/
+void tc_12_tx_quota(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    uint32_t in_flight;
+    uint32_t denied;
+    uint32_t i;
+
+    // one tx buffer reserved and at most one in flight, each message waits for the previous one to be returned
+    result = rpmsg_lite_set_ept_tx_quota(my_rpmsg, my_ept, 1U, 1U);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_ept_tx_quota' failed");
+    for (i = 0; i < 4; i++)
+    {
+        result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 1, data, DATA_LEN, RL_BLOCK);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' within the tx quota failed");
+    }
+    result = rpmsg_lite_get_ept_tx_quota_stats(my_rpmsg, my_ept, &in_flight, &denied);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_get_ept_tx_quota_stats' failed");
+    TEST_ASSERT_MESSAGE(1U >= in_flight, "'rpmsg_lite_get_ept_tx_quota_stats' more buffers in flight than the quota");
+    result = rpmsg_lite_set_ept_tx_quota(my_rpmsg, my_ept, 0U, 0U);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_ept_tx_quota' reset failed");
+
+    // invalid params for set_ept_tx_quota and get_ept_tx_quota_stats
+    result = rpmsg_lite_set_ept_tx_quota(my_rpmsg, my_ept, 2U, 1U);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_set_ept_tx_quota' with bad max_in_flight param failed");
+    result = rpmsg_lite_set_ept_tx_quota(my_rpmsg, my_ept, 0xFFFFFU, 0U);
+    TEST_ASSERT_MESSAGE(RL_ERR_NO_MEM == result, "'rpmsg_lite_set_ept_tx_quota' with bad reserved param failed");
+    result = rpmsg_lite_set_ept_tx_quota(RL_NULL, my_ept, 1U, 0U);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_set_ept_tx_quota' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_lite_get_ept_tx_quota_stats(my_rpmsg, RL_NULL, &in_flight, &denied);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_get_ept_tx_quota_stats' with bad ept param failed");
+}
+#endif
+
+#if defined(RL_ALLOW_ASYNC_SEND) && (RL_ALLOW_ASYNC_SEND == 1) && \
+    defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
+/******************************************************************************
+ * Test case 13
+ * - verify asynchronous sends finding no free tx buffer are queued, refused
+ *   once RL_ASYNC_SEND_QUEUE_DEPTH of them are pending, and sent from the tx
+ *   callback when the secondary side returns the tx buffers
+ * - verify the completion callback is called once for each accepted request
+ *****************************************************************************/
+void tc_13_async_send(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    struct rpmsg_lite_async_stats stats_before;
+    struct rpmsg_lite_async_stats async_stats;
+    void *tx_bufs[TC_BUFFER_COUNT];
+    uint32_t buf_size;
+    uint32_t i;
+
+    async_done_count = 0U;
+    async_fail_count = 0U;
+    result = rpmsg_lite_get_async_stats(my_rpmsg, &stats_before);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_get_async_stats' failed");
+
+    // hold all the tx buffers, the requests find none free
+    for (i = 0; i < TC_BUFFER_COUNT; i++)
+    {
+        tx_bufs[i] = rpmsg_lite_alloc_tx_buffer(my_rpmsg, &buf_size, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(RL_NULL != tx_bufs[i], "'rpmsg_lite_alloc_tx_buffer' failed");
+        env_memset(tx_bufs[i], i, DATA_LEN);
+    }
+    for (i = 0; i < TC_ASYNC_QUEUE_DEPTH; i++)
+    {
+        env_memset(async_data[i], i, DATA_LEN);
+        result = rpmsg_lite_send_async(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 1, async_data[i], DATA_LEN,
+                                       &async_reqs[i], app_async_done_cb, RL_NULL);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send_async' failed");
+    }
+    result = rpmsg_lite_send_async(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 1, async_data[TC_ASYNC_QUEUE_DEPTH],
+                                   DATA_LEN, &async_reqs[TC_ASYNC_QUEUE_DEPTH], app_async_done_cb, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_NO_MEM == result, "'rpmsg_lite_send_async' with a full queue failed");
+    TEST_ASSERT_MESSAGE(0U == async_done_count, "'rpmsg_lite_send_async' completed a queued request");
+    result = rpmsg_lite_get_async_stats(my_rpmsg, &async_stats);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_get_async_stats' failed");
+    TEST_ASSERT_MESSAGE((TC_ASYNC_QUEUE_DEPTH == async_stats.depth) && (stats_before.sent_direct == async_stats.sent_direct),
+                        "'rpmsg_lite_get_async_stats' wrong queued request counters");
+
+    // the secondary side drops these messages and returns the tx buffers, the tx callback sends the queued requests
+    for (i = 0; i < TC_BUFFER_COUNT; i++)
+    {
+        result = rpmsg_lite_send_nocopy(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 1, tx_bufs[i], DATA_LEN);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send_nocopy' failed");
+    }
+    for (i = 0; (i < (uint32_t)TC_FEATURE_TIMEOUT_MS) && (async_done_count < TC_ASYNC_QUEUE_DEPTH); i++)
+    {
+        env_sleep_msec(1);
+    }
+    // a request completed twice would show up by now
+    env_sleep_msec(100);
+    TEST_ASSERT_MESSAGE((TC_ASYNC_QUEUE_DEPTH == async_done_count) && (0U == async_fail_count),
+                        "'rpmsg_lite_send_async' completion callback count failed");
+    result = rpmsg_lite_get_async_stats(my_rpmsg, &async_stats);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_get_async_stats' failed");
+    TEST_ASSERT_MESSAGE((0U == async_stats.depth) &&
+                            (stats_before.sent_queued + TC_ASYNC_QUEUE_DEPTH == async_stats.sent_queued) &&
+                            (stats_before.failed == async_stats.failed),
+                        "'rpmsg_lite_get_async_stats' wrong sent request counters");
+
+    // invalid params for send_async and get_async_stats
+    result = rpmsg_lite_send_async(RL_NULL, my_ept, TC_REMOTE_EPT_ADDR + 1, data, DATA_LEN, &async_reqs[0],
+                                   app_async_done_cb, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_send_async' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_lite_send_async(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 1, data, DATA_LEN, RL_NULL,
+                                   app_async_done_cb, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_send_async' with bad req param failed");
+    result = rpmsg_lite_send_async(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 1, data, 0xFFFFFFFFU, &async_reqs[0],
+                                   app_async_done_cb, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_BUFF_SIZE == result, "'rpmsg_lite_send_async' with bad size param failed");
+    result = rpmsg_lite_get_async_stats(my_rpmsg, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_get_async_stats' with bad stats param failed");
+}
+#endif
+
+#if defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)
+/******************************************************************************
+ * Test case 14
+ * - verify the tokens of nocopy messages are reported once the secondary
+ *   side returns their tx buffers
+ *****************************************************************************/
+void tc_14_tx_tokens(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    void *data_addr = NULL;
+    uint32_t buf_size = 0;
+    uint32_t i;
+
+    tx_consumed_count = 0U;
+    tx_consumed_bad   = 0U;
+    // send nocopy messages with tokens to non-existing endpoint address, the tokens are reported once the buffers are back
+    result = rpmsg_lite_set_tx_consumed_cb(my_rpmsg, app_tx_consumed_cb, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_tx_consumed_cb' failed");
+    for (i = 0; i < TC_NOCOPY_BATCH_COUNT; i++)
+    {
+        data_addr = rpmsg_lite_alloc_tx_buffer(my_rpmsg, &buf_size, RL_BLOCK);
+        TEST_ASSERT_MESSAGE(NULL != data_addr, "negative number");
+        env_memset(data_addr, i, DATA_LEN);
+        result = rpmsg_lite_send_nocopy_token(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 1, data_addr, DATA_LEN,
+                                              (void *)(uintptr_t)(i + 1U));
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send_nocopy_token' failed");
+        data_addr = NULL;
+    }
+    for (i = 0; (i < 100U) && (tx_consumed_count < TC_NOCOPY_BATCH_COUNT); i++)
+    {
+        env_sleep_msec(1);
+        result = rpmsg_lite_poll_tx_consumed(my_rpmsg);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_poll_tx_consumed' failed");
+    }
+    TEST_ASSERT_MESSAGE((TC_NOCOPY_BATCH_COUNT == tx_consumed_count) && (0U == tx_consumed_bad),
+                        "'rpmsg_lite_send_nocopy_token' consumed reports failed");
+    result = rpmsg_lite_set_tx_consumed_cb(my_rpmsg, RL_NULL, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_tx_consumed_cb' failed");
+
+    // invalid params for send_nocopy_token, set_tx_consumed_cb and poll_tx_consumed
+    result = rpmsg_lite_send_nocopy_token(my_rpmsg, NULL, TC_REMOTE_EPT_ADDR, data, DATA_LEN, (void *)1);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_send_nocopy_token' with bad ept param failed");
+    result = rpmsg_lite_send_nocopy_token(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, 0xFFFFFFFF, (void *)1);
+    TEST_ASSERT_MESSAGE(RL_ERR_BUFF_SIZE == result, "'rpmsg_lite_send_nocopy_token' with bad size param failed");
+    result = rpmsg_lite_set_tx_consumed_cb(RL_NULL, app_tx_consumed_cb, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_set_tx_consumed_cb' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_lite_poll_tx_consumed(RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_poll_tx_consumed' with bad rpmsg_lite_dev param failed");
+}
+#endif
+
+#if (RL_QUEUE_PAIR_COUNT > 1)
+#define TC_QUEUE_EPT_ADDR  (TC_LOCAL_EPT_ADDR + 9)
+#define TC_QUEUE_MSG_COUNT (2U)
+#define TC_QUEUE_CONTROL   (1)
+#define TC_QUEUE_BULK      (2)
+static volatile uint32_t queue_rx_count = 0U;
+static volatile char queue_rx_order[2U * TC_QUEUE_MSG_COUNT];
+
+static int32_t queue_rx_isr_cb(void *payload, uint32_t payload_len, uint32_t src, void *priv)
+{
+    if (queue_rx_count < (2U * TC_QUEUE_MSG_COUNT))
+    {
+        queue_rx_order[queue_rx_count] = *(char *)payload;
+    }
+    queue_rx_count++;
+    return RL_RELEASE;
+}
+
+// utility: messages the secondary side has placed on a rvq and not taken yet, the primary side is the master
+static uint16_t tc_rx_pending(uint32_t queue)
+{
+    struct virtqueue *rvq = my_rpmsg->rvqs[queue];
+
+    return (uint16_t)(rvq->vq_ring.used->idx - rvq->vq_used_cons_idx);
+}
+
+/******************************************************************************
+ * Test case 15
+ * - verify the control messages received on queue pair 0 overtake the bulk
+ *   messages received on queue pair 1 before them with the strict priority
+ * - verify the weighted round-robin takes the messages from both queue
+ *   pairs in turns
+ *****************************************************************************/
+void tc_15_queue_pairs(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    struct rpmsg_lite_endpoint *queue_ept;
+    uint32_t weights[RL_QUEUE_PAIR_COUNT];
+    char expected[2U * TC_QUEUE_MSG_COUNT];
+    uint32_t round;
+    uint32_t i;
+
+    for (i = 0; i < (uint32_t)RL_QUEUE_PAIR_COUNT; i++)
+    {
+        weights[i] = 1U;
+    }
+    queue_ept = rpmsg_lite_create_ept(my_rpmsg, TC_QUEUE_EPT_ADDR, queue_rx_isr_cb, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_NULL != queue_ept, "'rpmsg_lite_create_ept' failed");
+
+    for (round = 0; round < 2U; round++)
+    {
+        if (round == 0U)
+        {
+            result = rpmsg_lite_set_rx_queue_policy(my_rpmsg, RL_QUEUE_POLICY_PRIORITY, RL_NULL);
+        }
+        else
+        {
+            result = rpmsg_lite_set_rx_queue_policy(my_rpmsg, RL_QUEUE_POLICY_WRR, weights);
+        }
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_rx_queue_policy' failed");
+        for (i = 0; i < TC_QUEUE_MSG_COUNT; i++)
+        {
+            if (round == 0U)
+            {
+                expected[i]                      = TC_QUEUE_CONTROL;
+                expected[TC_QUEUE_MSG_COUNT + i] = TC_QUEUE_BULK;
+            }
+            else
+            {
+                expected[2U * i]      = TC_QUEUE_CONTROL;
+                expected[2U * i + 1U] = TC_QUEUE_BULK;
+            }
+        }
+        queue_rx_count = 0U;
+
+        // the secondary side sends the bulk messages on queue pair 1, then the control messages on queue pair 0,
+        // all of them are pending on the rvqs once the interrupt is unmasked
+        env_disable_interrupt(my_rpmsg->rvq->vq_queue_index);
+        env_memset(data, (int32_t)round, DATA_LEN);
+        result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+        for (i = 0; (i < (uint32_t)TC_FEATURE_TIMEOUT_MS) &&
+                    ((tc_rx_pending(0U) < TC_QUEUE_MSG_COUNT) || (tc_rx_pending(1U) < TC_QUEUE_MSG_COUNT));
+             i++)
+        {
+            env_sleep_msec(1);
+        }
+        env_enable_interrupt(my_rpmsg->rvq->vq_queue_index);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+
+        for (i = 0; (i < (uint32_t)TC_FEATURE_TIMEOUT_MS) && (queue_rx_count < (2U * TC_QUEUE_MSG_COUNT)); i++)
+        {
+            env_sleep_msec(1);
+        }
+        TEST_ASSERT_MESSAGE((2U * TC_QUEUE_MSG_COUNT) == queue_rx_count, "queue pair messages not received");
+        for (i = 0; i < (2U * TC_QUEUE_MSG_COUNT); i++)
+        {
+            TEST_ASSERT_MESSAGE(expected[i] == queue_rx_order[i], "queue pair messages received out of order");
+        }
+    }
+    result = rpmsg_lite_set_rx_queue_policy(my_rpmsg, RL_QUEUE_POLICY_PRIORITY, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_rx_queue_policy' failed");
+    result = rpmsg_lite_destroy_ept(my_rpmsg, queue_ept);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_destroy_ept' failed");
+
+    // invalid params for set_ept_queue and set_rx_queue_policy
+    result = rpmsg_lite_set_ept_queue(my_rpmsg, my_ept, RL_QUEUE_PAIR_COUNT);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_set_ept_queue' with bad queue param failed");
+    result = rpmsg_lite_set_ept_queue(my_rpmsg, RL_NULL, 0U);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_set_ept_queue' with bad ept param failed");
+    result = rpmsg_lite_set_rx_queue_policy(my_rpmsg, RL_QUEUE_POLICY_WRR, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_set_rx_queue_policy' without weights failed");
+    weights[0] = 0U;
+    result = rpmsg_lite_set_rx_queue_policy(my_rpmsg, RL_QUEUE_POLICY_WRR, weights);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_set_rx_queue_policy' with zero weight failed");
+    result = rpmsg_lite_set_rx_queue_policy(my_rpmsg, RL_QUEUE_POLICY_WRR + 1U, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_set_rx_queue_policy' with bad policy param failed");
+    result = rpmsg_lite_set_rx_queue_policy(RL_NULL, RL_QUEUE_POLICY_PRIORITY, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_set_rx_queue_policy' with bad rpmsg_lite_dev param failed");
+}
+#endif
+
+#if (RL_EPT_TABLE_DIRECT_SIZE > 0) && (RL_EPT_TABLE_HASH_SIZE > 0)
+#define TC_LOOKUP_DIRECT_COUNT (4U)
+/* More than the hash table holds, the last ones are found in the endpoint list */
+#define TC_LOOKUP_HASH_COUNT ((uint32_t)RL_EPT_TABLE_HASH_SIZE + 2U)
+#define TC_LOOKUP_COUNT      (TC_LOOKUP_DIRECT_COUNT + TC_LOOKUP_HASH_COUNT)
+#define TC_LOOKUP_HIGH_ADDR  (1000U)
+static struct rpmsg_lite_endpoint *lookup_epts[TC_LOOKUP_COUNT];
+static volatile uint32_t lookup_rx_count[TC_LOOKUP_COUNT];
+static volatile uint32_t lookup_rx_bad = 0U;
+
+static int32_t lookup_rx_isr_cb(void *payload, uint32_t payload_len, uint32_t src, void *priv)
+{
+    struct rpmsg_lite_endpoint **ept = (struct rpmsg_lite_endpoint **)priv;
+    uint32_t addr;
+
+    // each message carries the address it is sent to
+    memcpy(&addr, payload, sizeof(addr));
+    if ((payload_len != sizeof(addr)) || (addr != (*ept)->addr))
+    {
+        lookup_rx_bad++;
+    }
+    lookup_rx_count[ept - lookup_epts]++;
+    return RL_RELEASE;
+}
+
+// utility: ask the secondary side to send a message to the given address
+static void tc_lookup_request(uint32_t addr)
+{
+    int32_t result;
+
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, (char *)&addr, sizeof(addr), TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+}
+
+// utility: wait until the endpoint has received the given number of messages
+static void tc_lookup_wait(uint32_t index, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0; (i < (uint32_t)TC_FEATURE_TIMEOUT_MS) && (lookup_rx_count[index] < count); i++)
+    {
+        env_sleep_msec(1);
+    }
+    TEST_ASSERT_MESSAGE(count == lookup_rx_count[index], "message not received by its endpoint");
+}
+
+/******************************************************************************
+ * Test case 16
+ * - verify the received messages reach their endpoints in the direct table,
+ *   in the hash table and beyond its capacity in the endpoint list
+ * - verify the endpoints left after destroying some of them, shifted back in
+ *   the hash table, are still found and the destroyed ones are not
+ * - verify RL_ADDR_ANY takes the lowest free direct address
+ *****************************************************************************/
+void tc_16_ept_lookup(void)
+{
+    static const uint32_t destroyed[] = {1U, TC_LOOKUP_DIRECT_COUNT, TC_LOOKUP_DIRECT_COUNT + 3U,
+                                         TC_LOOKUP_DIRECT_COUNT + 5U, TC_LOOKUP_COUNT - 1U};
+    uint32_t addrs[TC_LOOKUP_COUNT];
+    uint32_t expected;
+    uint32_t i;
+    uint32_t k;
+
+    lookup_rx_bad = 0U;
+    for (i = 0; i < TC_LOOKUP_COUNT; i++)
+    {
+        lookup_rx_count[i] = 0U;
+        if (i < TC_LOOKUP_DIRECT_COUNT)
+        {
+            lookup_epts[i] = rpmsg_lite_create_ept(my_rpmsg, RL_ADDR_ANY, lookup_rx_isr_cb, &lookup_epts[i]);
+            TEST_ASSERT_MESSAGE(RL_NULL != lookup_epts[i], "'rpmsg_lite_create_ept' failed");
+            TEST_ASSERT_MESSAGE((uint32_t)RL_EPT_TABLE_DIRECT_SIZE > lookup_epts[i]->addr,
+                                "'rpmsg_lite_create_ept' with RL_ADDR_ANY out of the direct table");
+        }
+        else
+        {
+            lookup_epts[i] = rpmsg_lite_create_ept(my_rpmsg, TC_LOOKUP_HIGH_ADDR + (i * 7U), lookup_rx_isr_cb,
+                                                   &lookup_epts[i]);
+            TEST_ASSERT_MESSAGE(RL_NULL != lookup_epts[i], "'rpmsg_lite_create_ept' failed");
+        }
+        addrs[i] = lookup_epts[i]->addr;
+    }
+    // addresses in use are found in all the tables
+    for (i = 0; i < TC_LOOKUP_COUNT; i++)
+    {
+        TEST_ASSERT_MESSAGE(RL_NULL == rpmsg_lite_create_ept(my_rpmsg, addrs[i], lookup_rx_isr_cb, RL_NULL),
+                            "'rpmsg_lite_create_ept' with address in use failed");
+    }
+
+    for (i = 0; i < TC_LOOKUP_COUNT; i++)
+    {
+        tc_lookup_request(addrs[i]);
+        tc_lookup_wait(i, 1U);
+    }
+
+    for (k = 0; k < (sizeof(destroyed) / sizeof(destroyed[0])); k++)
+    {
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == rpmsg_lite_destroy_ept(my_rpmsg, lookup_epts[destroyed[k]]),
+                            "'rpmsg_lite_destroy_ept' failed");
+        lookup_epts[destroyed[k]] = RL_NULL;
+    }
+    // the messages to the destroyed endpoints are dropped, the last request goes to an endpoint left
+    for (i = 0; i < TC_LOOKUP_COUNT; i++)
+    {
+        tc_lookup_request(addrs[i]);
+        if (lookup_epts[i] != RL_NULL)
+        {
+            tc_lookup_wait(i, 2U);
+        }
+    }
+    tc_lookup_request(addrs[0]);
+    tc_lookup_wait(0U, 3U);
+    for (i = 0; i < TC_LOOKUP_COUNT; i++)
+    {
+        expected = (lookup_epts[i] != RL_NULL) ? ((i == 0U) ? 3U : 2U) : 1U;
+        TEST_ASSERT_MESSAGE(expected == lookup_rx_count[i], "message received by a destroyed endpoint");
+    }
+    TEST_ASSERT_MESSAGE(0U == lookup_rx_bad, "message received by a wrong endpoint");
+
+    // the lowest free direct address is the one of the destroyed endpoint, the destroyed high ones are free
+    lookup_epts[1] = rpmsg_lite_create_ept(my_rpmsg, RL_ADDR_ANY, lookup_rx_isr_cb, &lookup_epts[1]);
+    TEST_ASSERT_MESSAGE((RL_NULL != lookup_epts[1]) && (addrs[1] == lookup_epts[1]->addr),
+                        "'rpmsg_lite_create_ept' with RL_ADDR_ANY did not take the lowest free address");
+    for (k = 1; k < (sizeof(destroyed) / sizeof(destroyed[0])); k++)
+    {
+        lookup_epts[destroyed[k]] =
+            rpmsg_lite_create_ept(my_rpmsg, addrs[destroyed[k]], lookup_rx_isr_cb, &lookup_epts[destroyed[k]]);
+        TEST_ASSERT_MESSAGE(RL_NULL != lookup_epts[destroyed[k]], "'rpmsg_lite_create_ept' of a freed address failed");
+    }
+
+    for (i = 0; i < TC_LOOKUP_COUNT; i++)
+    {
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == rpmsg_lite_destroy_ept(my_rpmsg, lookup_epts[i]),
+                            "'rpmsg_lite_destroy_ept' failed");
+    }
+    // lets the secondary side go on
+    tc_lookup_request(RL_ADDR_ANY);
+}
+#endif
+
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+#define TC_MP_EPT_ADDR        (TC_REMOTE_EPT_ADDR + 7)
+#define TC_MP_PRODUCER_COUNT  (4U)
+#define TC_MP_MSG_COUNT       (64U)
+#define TC_MP_TASK_STACK_SIZE (512U)
+static volatile uint32_t mp_done[TC_MP_PRODUCER_COUNT];
+static volatile uint32_t mp_failures[TC_MP_PRODUCER_COUNT];
+
+// utility: sends the producer index and a sequence number, by copy and zero-copy in turns
+static void mp_produce(uint32_t producer)
+{
+    uint32_t msg[2];
+    uint32_t seq;
+    int32_t result;
+#if defined(RL_API_HAS_ZEROCOPY) && (RL_API_HAS_ZEROCOPY == 1)
+    uint32_t size;
+    void *buf;
+#endif
+
+    msg[0] = producer;
+    for (seq = 0; seq < TC_MP_MSG_COUNT; seq++)
+    {
+        msg[1] = seq;
+        result = RL_ERR_NO_MEM;
+#if defined(RL_API_HAS_ZEROCOPY) && (RL_API_HAS_ZEROCOPY == 1)
+        if ((seq & 1U) != 0U)
+        {
+            buf = rpmsg_lite_alloc_tx_buffer(my_rpmsg, &size, TC_FEATURE_TIMEOUT_MS);
+            if (buf != RL_NULL)
+            {
+                env_memcpy(buf, msg, sizeof(msg));
+                result = rpmsg_lite_send_nocopy(my_rpmsg, my_ept, TC_MP_EPT_ADDR, buf, sizeof(msg));
+            }
+        }
+        else
+#endif
+        {
+            result = rpmsg_lite_send(my_rpmsg, my_ept, TC_MP_EPT_ADDR, (char *)msg, sizeof(msg), TC_FEATURE_TIMEOUT_MS);
+        }
+        if (result != RL_SUCCESS)
+        {
+            mp_failures[producer]++;
+        }
+    }
+    mp_done[producer] = 1U;
+}
+
+#if defined(SDK_OS_FREE_RTOS)
+static void mp_producer_task(void *param)
+{
+    mp_produce((uint32_t)(uintptr_t)param);
+    vTaskDelete(NULL);
+}
+#else
+static void *mp_producer_task(void *param)
+{
+    mp_produce((uint32_t)(uintptr_t)param);
+    return NULL;
+}
+#endif
+
+/******************************************************************************
+ * Test case 17
+ * - verify the messages of several tasks sending on one endpoint at the same
+ *   time without the tx lock are all received, in order for each task
+ *****************************************************************************/
+void tc_17_multi_producer(void)
+{
+    int32_t result;
+    uint32_t received[TC_MP_PRODUCER_COUNT] = {0};
+    uint32_t done;
+    uint32_t src;
+    uint32_t len;
+    uint32_t i;
+    uint32_t k;
+#if !defined(SDK_OS_FREE_RTOS)
+    pthread_t threads[TC_MP_PRODUCER_COUNT];
+#endif
+
+    // the secondary side is ready once its endpoint is created
+    result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, (char *)received, sizeof(received), &len, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv' failed");
+
+    for (k = 0; k < TC_MP_PRODUCER_COUNT; k++)
+    {
+        mp_done[k]     = 0U;
+        mp_failures[k] = 0U;
+#if defined(SDK_OS_FREE_RTOS)
+        TEST_ASSERT_MESSAGE(pdPASS == xTaskCreate(mp_producer_task, "MP_PRODUCER_TASK", TC_MP_TASK_STACK_SIZE,
+                                                  (void *)(uintptr_t)k, tskIDLE_PRIORITY + 1, NULL),
+                            "'xTaskCreate' failed");
+#else
+        TEST_ASSERT_MESSAGE(0 == pthread_create(&threads[k], NULL, mp_producer_task, (void *)(uintptr_t)k),
+                            "'pthread_create' failed");
+#endif
+    }
+    done = 0U;
+    for (i = 0; (i < (uint32_t)TC_FEATURE_TIMEOUT_MS) && (done < TC_MP_PRODUCER_COUNT); i++)
+    {
+        env_sleep_msec(1);
+        for (done = 0U, k = 0; k < TC_MP_PRODUCER_COUNT; k++)
+        {
+            done += mp_done[k];
+        }
+    }
+#if !defined(SDK_OS_FREE_RTOS)
+    for (k = 0; k < TC_MP_PRODUCER_COUNT; k++)
+    {
+        (void)pthread_join(threads[k], NULL);
+    }
+#endif
+    TEST_ASSERT_MESSAGE(TC_MP_PRODUCER_COUNT == done, "producer tasks not finished");
+    for (k = 0; k < TC_MP_PRODUCER_COUNT; k++)
+    {
+        TEST_ASSERT_MESSAGE(0U == mp_failures[k], "'rpmsg_lite_send' of a producer task failed");
+    }
+
+    // the secondary side reports the messages it received in order from each producer
+    result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, (char *)received, sizeof(received), &len, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE((RL_SUCCESS == result) && (sizeof(received) == len), "'rpmsg_queue_recv' failed");
+    for (k = 0; k < TC_MP_PRODUCER_COUNT; k++)
+    {
+        TEST_ASSERT_MESSAGE(TC_MP_MSG_COUNT == received[k], "producer messages lost or received out of order");
+    }
+}
+#endif
+
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+#define TC_DEFER_ISR_EPT_ADDR    (TC_LOCAL_EPT_ADDR + 10)
+#define TC_DEFER_WORKER_EPT_ADDR (TC_LOCAL_EPT_ADDR + 11)
+#define TC_DEFER_MSG_COUNT       (4U)
+static volatile uint32_t defer_isr_count    = 0U;
+static volatile uint32_t defer_worker_count = 0U;
+static volatile uint32_t defer_rx_count     = 0U;
+static volatile char defer_rx_order[TC_DEFER_MSG_COUNT];
+
+static int32_t defer_rx_isr_cb(void *payload, uint32_t payload_len, uint32_t src, void *priv)
+{
+    (*(volatile uint32_t *)priv)++;
+    if (defer_rx_count < TC_DEFER_MSG_COUNT)
+    {
+        defer_rx_order[defer_rx_count] = *(char *)payload;
+    }
+    defer_rx_count++;
+    return RL_RELEASE;
+}
+
+// utility: messages the secondary side has placed on the rvq and not taken yet, the primary side is the master
+static uint16_t tc_defer_rx_pending(void)
+{
+    return (uint16_t)(my_rpmsg->rvq->vq_ring.used->idx - my_rpmsg->rvq->vq_used_cons_idx);
+}
+
+// utility: asks the secondary side for the messages of a round of the test case 18
+static void tc_defer_request(char round)
+{
+    int32_t result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, &round, 1, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+}
+
+/******************************************************************************
+ * Test case 18
+ * - verify the rx ISR calls the rx_cb of the endpoints selected by
+ *   rpmsg_lite_set_ept_rx_in_isr() and hands the first message for another
+ *   endpoint and the rest of the rvq over to the rx worker
+ * - verify rpmsg_lite_rx_worker() keeps the message order, processes at most
+ *   the budget and returns the rvq to the ISR once empty
+ * - verify rpmsg_lite_get_rx_isr_stats() reports the messages processed by
+ *   one rx ISR since the last call
+ *****************************************************************************/
+void tc_18_rx_deferred(void)
+{
+    int32_t result;
+    struct rpmsg_lite_endpoint *isr_ept;
+    struct rpmsg_lite_endpoint *worker_ept;
+    uint32_t max_count;
+    uint64_t max_time;
+    uint32_t i;
+
+    isr_ept = rpmsg_lite_create_ept(my_rpmsg, TC_DEFER_ISR_EPT_ADDR, defer_rx_isr_cb, (void *)&defer_isr_count);
+    TEST_ASSERT_MESSAGE(RL_NULL != isr_ept, "'rpmsg_lite_create_ept' failed");
+    result = rpmsg_lite_set_ept_rx_in_isr(my_rpmsg, isr_ept, RL_TRUE);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_ept_rx_in_isr' failed");
+    worker_ept =
+        rpmsg_lite_create_ept(my_rpmsg, TC_DEFER_WORKER_EPT_ADDR, defer_rx_isr_cb, (void *)&defer_worker_count);
+    TEST_ASSERT_MESSAGE(RL_NULL != worker_ept, "'rpmsg_lite_create_ept' failed");
+
+    // the test case runs the rx worker itself
+    rx_worker_pause = 1U;
+    for (i = 0; (i < (uint32_t)TC_FEATURE_TIMEOUT_MS) && (rx_worker_paused == 0U); i++)
+    {
+        env_sleep_msec(1);
+    }
+    TEST_ASSERT_MESSAGE(0U != rx_worker_paused, "rx worker task not paused");
+    result = rpmsg_lite_get_rx_isr_stats(my_rpmsg, &max_count, &max_time);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_get_rx_isr_stats' failed");
+
+    // the secondary side sends 1 to the ISR endpoint, 2 to the worker endpoint and 3 to the ISR endpoint again,
+    // the rx ISR stops at 2 and leaves 3 on the rvq, this takes two buffers only
+    tc_defer_request(1);
+    for (i = 0; (i < (uint32_t)TC_FEATURE_TIMEOUT_MS) && ((defer_rx_count < 1U) || (tc_defer_rx_pending() < 1U)); i++)
+    {
+        env_sleep_msec(1);
+    }
+    TEST_ASSERT_MESSAGE(1U == defer_isr_count, "message of the ISR endpoint not received in the rx ISR");
+    TEST_ASSERT_MESSAGE(0U == defer_worker_count, "message of the worker endpoint received in the rx ISR");
+    TEST_ASSERT_MESSAGE(1U == tc_defer_rx_pending(), "message behind the deferred one taken by the rx ISR");
+    result = rpmsg_lite_get_rx_isr_stats(my_rpmsg, &max_count, &max_time);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_get_rx_isr_stats' failed");
+    TEST_ASSERT_MESSAGE(1U == max_count, "'rpmsg_lite_get_rx_isr_stats' max. count wrong");
+
+    // the rx ISR ignores the rvq while the rx worker owns it
+    env_sleep_msec(10);
+    TEST_ASSERT_MESSAGE(1U == defer_rx_count, "message received while the rx worker owns the rvq");
+
+    result = rpmsg_lite_rx_worker(my_rpmsg, 1U, 0U);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_rx_worker' failed");
+    TEST_ASSERT_MESSAGE(1U == defer_worker_count, "'rpmsg_lite_rx_worker' did not process the deferred message");
+    TEST_ASSERT_MESSAGE(1U == defer_isr_count, "'rpmsg_lite_rx_worker' processed more than the budget");
+    result = rpmsg_lite_rx_worker(my_rpmsg, 0U, 0U);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_rx_worker' failed");
+    TEST_ASSERT_MESSAGE(2U == defer_isr_count, "'rpmsg_lite_rx_worker' did not process the ISR endpoint message");
+    result = rpmsg_lite_rx_worker(my_rpmsg, 0U, 0U);
+    TEST_ASSERT_MESSAGE(RL_ERR_NO_BUFF == result, "'rpmsg_lite_rx_worker' did not return the empty rvq");
+    for (i = 0; i < 3U; i++)
+    {
+        TEST_ASSERT_MESSAGE((char)(i + 1U) == defer_rx_order[i], "messages received out of order");
+    }
+
+    // the rx ISR processes the rvq again
+    result = rpmsg_lite_get_rx_isr_stats(my_rpmsg, &max_count, &max_time);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_get_rx_isr_stats' failed");
+    TEST_ASSERT_MESSAGE(0U == max_count, "'rpmsg_lite_get_rx_isr_stats' not reset");
+    tc_defer_request(2);
+    for (i = 0; (i < (uint32_t)TC_FEATURE_TIMEOUT_MS) && (defer_isr_count < 3U); i++)
+    {
+        env_sleep_msec(1);
+    }
+    TEST_ASSERT_MESSAGE(3U == defer_isr_count, "message of the ISR endpoint not received in the rx ISR");
+    TEST_ASSERT_MESSAGE(4 == defer_rx_order[3], "message received out of order");
+    result = rpmsg_lite_get_rx_isr_stats(my_rpmsg, &max_count, &max_time);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_get_rx_isr_stats' failed");
+    TEST_ASSERT_MESSAGE(1U == max_count, "'rpmsg_lite_get_rx_isr_stats' max. count wrong");
+
+    // invalid params
+    result = rpmsg_lite_rx_worker(RL_NULL, 0U, 0U);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_rx_worker' with bad rpmsg_lite_dev param failed");
+    result = rpmsg_lite_set_ept_rx_in_isr(my_rpmsg, RL_NULL, RL_TRUE);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_set_ept_rx_in_isr' with bad ept param failed");
+    result = rpmsg_lite_get_rx_isr_stats(my_rpmsg, RL_NULL, &max_time);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_get_rx_isr_stats' with bad max_count param failed");
+    result = rpmsg_lite_get_rx_isr_stats(my_rpmsg, &max_count, RL_NULL);
+    TEST_ASSERT_MESSAGE(RL_ERR_PARAM == result, "'rpmsg_lite_get_rx_isr_stats' with bad max_time param failed");
+
+    // lets the secondary side go on
+    tc_defer_request(0);
+    rx_worker_pause = 0U;
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == rpmsg_lite_destroy_ept(my_rpmsg, isr_ept), "'rpmsg_lite_destroy_ept' failed");
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == rpmsg_lite_destroy_ept(my_rpmsg, worker_ept), "'rpmsg_lite_destroy_ept' failed");
+}
+#endif
+
 void run_tests(void *unused)
 {
     int32_t result = 0;
@@ -383,8 +2071,60 @@ void run_tests(void *unused)
         __coveragescanner_testname("03_send_receive_rtos");
         __coveragescanner_install("03_send_receive_rtos.csexe");
 #endif /*__COVERAGESCANNER__*/
+        /* The feature test cases run first, while no buffer is held by the test cases 1 and 2 */
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1) && \
+    defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
+        RUN_EXAMPLE(tc_4_tx_buffer_wait, MAKE_UNITY_NUM(k_unity_rpmsg, 3));
+#endif
+#if defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1)
+        RUN_EXAMPLE(tc_5_deferred_notify, MAKE_UNITY_NUM(k_unity_rpmsg, 4));
+#endif
+#if !(defined(RL_ALLOW_RX_ADAPTIVE_POLLING) && (RL_ALLOW_RX_ADAPTIVE_POLLING == 1)) && \
+    !(defined(RL_ALLOW_VRING_EVENT_IDX) && (RL_ALLOW_VRING_EVENT_IDX == 1))
+        RUN_EXAMPLE(tc_6_baseline_master, MAKE_UNITY_NUM(k_unity_rpmsg, 5));
+#endif
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+        RUN_EXAMPLE(tc_7_credit_flow_control, MAKE_UNITY_NUM(k_unity_rpmsg, 6));
+#endif
+#if defined(RL_ALLOW_MSG_PACKING) && (RL_ALLOW_MSG_PACKING == 1)
+        RUN_EXAMPLE(tc_8_msg_packing, MAKE_UNITY_NUM(k_unity_rpmsg, 7));
+#endif
+#if defined(RL_ALLOW_GROUP_ENDPOINTS) && (RL_ALLOW_GROUP_ENDPOINTS == 1)
+        RUN_EXAMPLE(tc_9_group_endpoints, MAKE_UNITY_NUM(k_unity_rpmsg, 8));
+#endif
+#if defined(RL_ALLOW_CACHE_COUNTERS) && (RL_ALLOW_CACHE_COUNTERS == 1)
+        RUN_EXAMPLE(tc_10_cache_counters, MAKE_UNITY_NUM(k_unity_rpmsg, 9));
+#endif
+#if defined(RL_ALLOW_TX_STASH) && (RL_ALLOW_TX_STASH == 1)
+        RUN_EXAMPLE(tc_11_tx_stash, MAKE_UNITY_NUM(k_unity_rpmsg, 10));
+#endif
+#if defined(RL_ALLOW_TX_QUOTA) && (RL_ALLOW_TX_QUOTA == 1)
+        RUN_EXAMPLE(tc_12_tx_quota, MAKE_UNITY_NUM(k_unity_rpmsg, 11));
+#endif
+#if defined(RL_ALLOW_ASYNC_SEND) && (RL_ALLOW_ASYNC_SEND == 1) && \
+    defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
+        RUN_EXAMPLE(tc_13_async_send, MAKE_UNITY_NUM(k_unity_rpmsg, 12));
+#endif
+#if defined(RL_ALLOW_TX_TOKENS) && (RL_ALLOW_TX_TOKENS == 1)
+        RUN_EXAMPLE(tc_14_tx_tokens, MAKE_UNITY_NUM(k_unity_rpmsg, 13));
+#endif
+#if (RL_QUEUE_PAIR_COUNT > 1)
+        RUN_EXAMPLE(tc_15_queue_pairs, MAKE_UNITY_NUM(k_unity_rpmsg, 14));
+#endif
+#if (RL_EPT_TABLE_DIRECT_SIZE > 0) && (RL_EPT_TABLE_HASH_SIZE > 0)
+        RUN_EXAMPLE(tc_16_ept_lookup, MAKE_UNITY_NUM(k_unity_rpmsg, 15));
+#endif
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+        RUN_EXAMPLE(tc_17_multi_producer, MAKE_UNITY_NUM(k_unity_rpmsg, 16));
+#endif
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+        RUN_EXAMPLE(tc_18_rx_deferred, MAKE_UNITY_NUM(k_unity_rpmsg, 17));
+#endif
         RUN_EXAMPLE(tc_1_send_receive, MAKE_UNITY_NUM(k_unity_rpmsg, 0));
         RUN_EXAMPLE(tc_2_send_receive, MAKE_UNITY_NUM(k_unity_rpmsg, 1));
+#if defined(RL_ALLOW_FRAGMENTATION) && (RL_ALLOW_FRAGMENTATION == 1)
+        RUN_EXAMPLE(tc_3_fragmentation, MAKE_UNITY_NUM(k_unity_rpmsg, 2));
+#endif
     }
     env_delete_mutex(aux_mutex);    
     env_delete_queue(aux_q);
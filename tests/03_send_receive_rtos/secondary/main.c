@@ -15,6 +15,9 @@
 #if defined(SDK_OS_FREE_RTOS)
 #include "FreeRTOS.h"
 #include "task.h"
+#elif defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+/* The rx worker task runs as a thread of the host build */
+#include <pthread.h>
 #endif
 
 #include "fsl_common.h"
@@ -30,6 +33,13 @@
 #define TC_LOCAL_EPT_ADDR (30)
 #define TC_REMOTE_EPT_ADDR (40)
 #define TEST_RL_NS_ANNOUNCE_STRING "rpmsg-test-channel"
+/* Receive timeout of the feature test cases, a failure on one side does not block the other one forever */
+#define TC_FEATURE_TIMEOUT_MS (5000)
+#if !(defined(RL_ALLOW_CUSTOM_SHMEM_CONFIG) && (RL_ALLOW_CUSTOM_SHMEM_CONFIG == 1))
+#define TC_BUFFER_COUNT RL_BUFFER_COUNT
+#else
+#define TC_BUFFER_COUNT RL_BUFFER_COUNT(RPMSG_LITE_LINK_ID)
+#endif
 
 #ifndef SH_MEM_NOT_TAKEN_FROM_LINKER
 #define SH_MEM_TOTAL_SIZE (6144)
@@ -101,6 +111,69 @@ static void app_nameservice_isr_cb(uint32_t new_ept, const char *new_ept_name, u
 {
 }
 
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+#define TC_RX_WORKER_BUDGET     (4U)
+#define TC_RX_WORKER_TIMEOUT_MS (10U)
+#define TC_RX_WORKER_STACK_SIZE (512U)
+static volatile uint32_t rx_worker_stop    = 0U;
+static volatile uint32_t rx_worker_running = 0U;
+#if !defined(SDK_OS_FREE_RTOS)
+static pthread_t rx_worker_thread;
+#endif
+
+// utility: rx worker task, processes the messages of the endpoints whose rx_cb is not called from the rx ISR
+static void rx_worker_loop(void)
+{
+    while (rx_worker_stop == 0U)
+    {
+        (void)rpmsg_lite_rx_worker(my_rpmsg, TC_RX_WORKER_BUDGET, TC_RX_WORKER_TIMEOUT_MS);
+    }
+    rx_worker_running = 0U;
+}
+
+#if defined(SDK_OS_FREE_RTOS)
+static void rx_worker_task(void *param)
+{
+    rx_worker_loop();
+    vTaskDelete(NULL);
+}
+#else
+static void *rx_worker_task(void *param)
+{
+    rx_worker_loop();
+    return NULL;
+}
+#endif
+
+// utility: start the rx worker task
+static void ts_start_rx_worker(void)
+{
+    rx_worker_stop    = 0U;
+    rx_worker_running = 1U;
+#if defined(SDK_OS_FREE_RTOS)
+    TEST_ASSERT_MESSAGE(pdPASS == xTaskCreate(rx_worker_task, "RX_WORKER_TASK", TC_RX_WORKER_STACK_SIZE, NULL,
+                                              tskIDLE_PRIORITY + 2, NULL),
+                        "'xTaskCreate' failed");
+#else
+    TEST_ASSERT_MESSAGE(0 == pthread_create(&rx_worker_thread, NULL, rx_worker_task, NULL), "'pthread_create' failed");
+#endif
+}
+
+// utility: stop the rx worker task
+static void ts_stop_rx_worker(void)
+{
+    rx_worker_stop = 1U;
+#if defined(SDK_OS_FREE_RTOS)
+    while (rx_worker_running != 0U)
+    {
+        env_sleep_msec(1);
+    }
+#else
+    (void)pthread_join(rx_worker_thread, NULL);
+#endif
+}
+#endif
+
 // utility: initialize rpmsg and environment
 // and wait for default channel
 int32_t ts_init_rpmsg(void)
@@ -116,6 +189,9 @@ int32_t ts_init_rpmsg(void)
 #endif
 #endif /* SH_MEM_NOT_TAKEN_FROM_LINKER */
     TEST_ASSERT_MESSAGE(NULL != my_rpmsg, "init function failed");
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+    ts_start_rx_worker();
+#endif
     rpmsg_lite_wait_for_link_up(my_rpmsg, RL_BLOCK);
     
     /* wait for a while to allow the primary side to bind_ns and register the NS callback */
@@ -129,6 +205,9 @@ int32_t ts_init_rpmsg(void)
 // utility: deinitialize rpmsg and environment
 int32_t ts_deinit_rpmsg(void)
 {
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+    ts_stop_rx_worker();
+#endif
     rpmsg_ns_unbind(my_rpmsg, ns_handle);
     rpmsg_lite_deinit(my_rpmsg);
     return 0;
@@ -390,6 +469,415 @@ void tc_2_receive_send(void)
     }
 }
 
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1) && \
+    defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
+#define TC_TX_HOLD_MS (200U)
+/******************************************************************************
+ * Test case 4
+ * - hold all the tx buffers of the primary side, release one of them after
+ *   a while to wake up the waiting sender
+ *****************************************************************************/
+void tc_4_tx_buffer_wait(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    void *data_addr[TC_BUFFER_COUNT + 1];
+    uint32_t src;
+    uint32_t len;
+    uint32_t i;
+
+    for (i = 0; i < TC_BUFFER_COUNT; i++)
+    {
+        result = rpmsg_queue_recv_nocopy(my_rpmsg, my_queue, &src, (char **)&data_addr[i], &len, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv_nocopy' failed");
+        TEST_ASSERT_MESSAGE(0 == pattern_cmp(data_addr[i], i, DATA_LEN), "pattern_cmp failed");
+    }
+    env_sleep_msec(TC_TX_HOLD_MS);
+    result = rpmsg_queue_nocopy_free(my_rpmsg, data_addr[0]);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_nocopy_free' failed");
+
+    // the released buffer comes back with the message of the woken up sender
+    result = rpmsg_queue_recv_nocopy(my_rpmsg, my_queue, &src, (char **)&data_addr[TC_BUFFER_COUNT], &len,
+                                     TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv_nocopy' failed");
+    TEST_ASSERT_MESSAGE(0 == pattern_cmp(data_addr[TC_BUFFER_COUNT], TC_BUFFER_COUNT, DATA_LEN), "pattern_cmp failed");
+    for (i = 1; i <= TC_BUFFER_COUNT; i++)
+    {
+        result = rpmsg_queue_nocopy_free(my_rpmsg, data_addr[i]);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_nocopy_free' failed");
+    }
+
+    env_memset(data, TC_BUFFER_COUNT + 1, DATA_LEN);
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+}
+#endif
+
+#if defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1)
+/******************************************************************************
+ * Test case 5
+ * - receive the messages of the primary side sent with and without a
+ *   deferred notification and confirm each group of them
+ *****************************************************************************/
+void tc_5_deferred_notify(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    uint32_t src;
+    uint32_t len;
+    uint32_t round;
+    uint32_t i;
+
+    // one round without a threshold, one round with the count threshold
+    for (round = 0; round < 2U; round++)
+    {
+        for (i = 0; i < TC_BUFFER_COUNT; i++)
+        {
+            result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, data, DATA_LEN, &len, TC_FEATURE_TIMEOUT_MS);
+            TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv' failed");
+            TEST_ASSERT_MESSAGE(0 == pattern_cmp(data, i, DATA_LEN), "pattern_cmp failed");
+        }
+        env_memset(data, TC_BUFFER_COUNT, DATA_LEN);
+        result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+    }
+
+    // the message notified at the deadline
+    result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, data, DATA_LEN, &len, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv' failed");
+    TEST_ASSERT_MESSAGE(0 == pattern_cmp(data, TC_BUFFER_COUNT + 1, DATA_LEN), "pattern_cmp failed");
+    env_memset(data, TC_BUFFER_COUNT + 2, DATA_LEN);
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+}
+#endif
+
+#if !(defined(RL_ALLOW_RX_ADAPTIVE_POLLING) && (RL_ALLOW_RX_ADAPTIVE_POLLING == 1)) && \
+    !(defined(RL_ALLOW_VRING_EVENT_IDX) && (RL_ALLOW_VRING_EVENT_IDX == 1))
+/******************************************************************************
+ * Test case 6
+ * - echo the messages of the primary side, which suppresses the notifications
+ *   the way a master of an earlier release does
+ *****************************************************************************/
+void tc_6_baseline_master(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    uint32_t src;
+    uint32_t len;
+    uint32_t i;
+
+    for (i = 0; i < TC_TRANSFER_COUNT; i++)
+    {
+        result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, data, DATA_LEN, &len, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv' failed");
+        TEST_ASSERT_MESSAGE(0 == pattern_cmp(data, i, DATA_LEN), "pattern_cmp failed");
+        result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+    }
+}
+#endif
+
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+static volatile uint32_t fc_rx_count = 0U;
+
+static int32_t fc_rx_isr_cb(void *payload, uint32_t payload_len, uint32_t src, void *priv)
+{
+    fc_rx_count++;
+    return RL_RELEASE;
+}
+
+/******************************************************************************
+ * Test case 7
+ * - release the flow controlled messages of the primary side in the rx
+ *   callback of an endpoint without a task, which grants the credits, and
+ *   report the count of messages, window overruns and credit messages
+ *****************************************************************************/
+void tc_7_credit_flow_control(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    struct rpmsg_lite_endpoint *fc_ept;
+    struct rpmsg_lite_fc_stats fc_stats;
+    uint32_t report[3];
+    uint32_t src;
+    uint32_t len;
+
+    fc_rx_count = 0U;
+    fc_ept      = rpmsg_lite_create_ept(my_rpmsg, TC_LOCAL_EPT_ADDR + 3, fc_rx_isr_cb, RL_NULL);
+    TEST_ASSERT_MESSAGE(NULL != fc_ept, "'rpmsg_lite_create_ept' failed");
+
+    result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, data, DATA_LEN, &len, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv' failed");
+    TEST_ASSERT_MESSAGE(0 == pattern_cmp(data, 0, DATA_LEN), "pattern_cmp failed");
+    result = rpmsg_lite_set_ept_flow_control(my_rpmsg, fc_ept, TC_REMOTE_EPT_ADDR, 1U, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_ept_flow_control' failed");
+    env_memset(data, 1, DATA_LEN);
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+
+    // nothing to do here until the primary side is done, the rx callback grants the credits
+    result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, data, DATA_LEN, &len, TC_FEATURE_TIMEOUT_MS * 4U);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv' failed");
+    TEST_ASSERT_MESSAGE(0 == pattern_cmp(data, 2, DATA_LEN), "pattern_cmp failed");
+    result = rpmsg_lite_get_ept_fc_stats(my_rpmsg, fc_ept, &fc_stats);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_get_ept_fc_stats' failed");
+    report[0] = fc_rx_count;
+    report[1] = fc_stats.rx_overruns;
+    report[2] = fc_stats.credit_count;
+    memcpy(data, report, sizeof(report));
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, sizeof(report), TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+
+    result = rpmsg_lite_destroy_ept(my_rpmsg, fc_ept);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_destroy_ept' failed");
+}
+#endif
+
+#if defined(RL_ALLOW_MSG_PACKING) && (RL_ALLOW_MSG_PACKING == 1)
+static volatile uint32_t pack_rx_count = 0U;
+static volatile uint32_t pack_rx_bad   = 0U;
+static volatile uint32_t pack_rx_len   = 0U;
+
+static int32_t pack_rx_isr_cb(void *payload, uint32_t payload_len, uint32_t src, void *priv)
+{
+    // record n is filled with n
+    if ((payload_len == 0U) || (0 != pattern_cmp((char *)payload, (char)pack_rx_count, (int32_t)payload_len)))
+    {
+        pack_rx_bad++;
+    }
+    pack_rx_count++;
+    pack_rx_len += payload_len;
+    return RL_RELEASE;
+}
+
+/******************************************************************************
+ * Test case 8
+ * - check the packed records of the primary side one by one in the rx
+ *   callback and report their count, the damaged ones and their length
+ *****************************************************************************/
+void tc_8_msg_packing(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    struct rpmsg_lite_endpoint *pack_ept;
+    uint32_t report[3];
+    uint32_t src;
+    uint32_t len;
+
+    pack_rx_count = 0U;
+    pack_rx_bad   = 0U;
+    pack_rx_len   = 0U;
+    pack_ept      = rpmsg_lite_create_ept(my_rpmsg, TC_LOCAL_EPT_ADDR + 4, pack_rx_isr_cb, RL_NULL);
+    TEST_ASSERT_MESSAGE(NULL != pack_ept, "'rpmsg_lite_create_ept' failed");
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+
+    // the containers are received before the message sent after them
+    result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, data, DATA_LEN, &len, TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv' failed");
+    TEST_ASSERT_MESSAGE(0 == pattern_cmp(data, 2, DATA_LEN), "pattern_cmp failed");
+    report[0] = pack_rx_count;
+    report[1] = pack_rx_bad;
+    report[2] = pack_rx_len;
+    memcpy(data, report, sizeof(report));
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, data, sizeof(report), TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+
+    result = rpmsg_lite_destroy_ept(my_rpmsg, pack_ept);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_destroy_ept' failed");
+}
+#endif
+
+#if defined(RL_ALLOW_GROUP_ENDPOINTS) && (RL_ALLOW_GROUP_ENDPOINTS == 1)
+/******************************************************************************
+ * Test case 9
+ * - send one message to the group endpoint of the primary side each time
+ *   the primary side asks for it
+ *****************************************************************************/
+void tc_9_group_endpoints(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    uint32_t src;
+    uint32_t len;
+    uint32_t i;
+
+    for (i = 0; i < 2U; i++)
+    {
+        result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, data, DATA_LEN, &len, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv' failed");
+        TEST_ASSERT_MESSAGE(0 == pattern_cmp(data, i, DATA_LEN), "pattern_cmp failed");
+        env_memset(data, 3 + i, DATA_LEN);
+        result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 5, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+    }
+}
+#endif
+
+#if (RL_QUEUE_PAIR_COUNT > 1)
+#define TC_QUEUE_MSG_COUNT (2U)
+/******************************************************************************
+ * Test case 15
+ * - send bulk messages on queue pair 1, then control messages on queue
+ *   pair 0 to the primary side each time the primary side asks for it
+ *****************************************************************************/
+void tc_15_queue_pairs(void)
+{
+    int32_t result;
+    char data[DATA_LEN] = {0};
+    struct rpmsg_lite_endpoint *bulk_ept;
+    uint32_t src;
+    uint32_t len;
+    uint32_t round;
+    uint32_t i;
+
+    bulk_ept = rpmsg_lite_create_ept(my_rpmsg, TC_LOCAL_EPT_ADDR + 6, rpmsg_queue_rx_cb, my_queue);
+    TEST_ASSERT_MESSAGE(NULL != bulk_ept, "'rpmsg_lite_create_ept' failed");
+    result = rpmsg_lite_set_ept_queue(my_rpmsg, bulk_ept, 1U);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_set_ept_queue' failed");
+
+    for (round = 0; round < 2U; round++)
+    {
+        result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, data, DATA_LEN, &len, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv' failed");
+        TEST_ASSERT_MESSAGE(0 == pattern_cmp(data, round, DATA_LEN), "pattern_cmp failed");
+        env_memset(data, 2, DATA_LEN);
+        for (i = 0; i < TC_QUEUE_MSG_COUNT; i++)
+        {
+            result = rpmsg_lite_send(my_rpmsg, bulk_ept, TC_REMOTE_EPT_ADDR + 9, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+            TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+        }
+        env_memset(data, 1, DATA_LEN);
+        for (i = 0; i < TC_QUEUE_MSG_COUNT; i++)
+        {
+            result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 9, data, DATA_LEN, TC_FEATURE_TIMEOUT_MS);
+            TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+        }
+    }
+
+    result = rpmsg_lite_destroy_ept(my_rpmsg, bulk_ept);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_destroy_ept' failed");
+}
+#endif
+
+#if (RL_EPT_TABLE_DIRECT_SIZE > 0) && (RL_EPT_TABLE_HASH_SIZE > 0)
+/******************************************************************************
+ * Test case 16
+ * - send a message carrying the address to each endpoint address the
+ *   primary side asks for, until it asks for RL_ADDR_ANY
+ *****************************************************************************/
+void tc_16_ept_lookup(void)
+{
+    int32_t result;
+    uint32_t addr = 0U;
+    uint32_t src;
+    uint32_t len;
+
+    for (;;)
+    {
+        result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, (char *)&addr, sizeof(addr), &len, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE((RL_SUCCESS == result) && (sizeof(addr) == len), "'rpmsg_queue_recv' failed");
+        if (addr == RL_ADDR_ANY)
+        {
+            break;
+        }
+        result = rpmsg_lite_send(my_rpmsg, my_ept, addr, (char *)&addr, sizeof(addr), TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+    }
+}
+#endif
+
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+#define TC_MP_PRODUCER_COUNT (4U)
+#define TC_MP_MSG_COUNT      (64U)
+/******************************************************************************
+ * Test case 17
+ * - receive the messages of the producer tasks of the primary side and send
+ *   back the number of messages received in order from each of them
+ *****************************************************************************/
+void tc_17_multi_producer(void)
+{
+    int32_t result;
+    struct rpmsg_lite_endpoint *mp_ept;
+    rpmsg_queue_handle mp_queue;
+    uint32_t received[TC_MP_PRODUCER_COUNT] = {0};
+    uint32_t msg[2];
+    uint32_t src;
+    uint32_t len;
+    uint32_t n;
+
+    mp_queue = rpmsg_queue_create(my_rpmsg);
+    TEST_ASSERT_MESSAGE(NULL != mp_queue, "'rpmsg_queue_create' failed");
+    mp_ept = rpmsg_lite_create_ept(my_rpmsg, TC_LOCAL_EPT_ADDR + 7, rpmsg_queue_rx_cb, mp_queue);
+    TEST_ASSERT_MESSAGE(NULL != mp_ept, "'rpmsg_lite_create_ept' failed");
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, (char *)received, sizeof(received), TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+
+    for (n = 0; n < (TC_MP_PRODUCER_COUNT * TC_MP_MSG_COUNT); n++)
+    {
+        result = rpmsg_queue_recv(my_rpmsg, mp_queue, &src, (char *)msg, sizeof(msg), &len, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE((RL_SUCCESS == result) && (sizeof(msg) == len), "'rpmsg_queue_recv' failed");
+        TEST_ASSERT_MESSAGE(TC_REMOTE_EPT_ADDR == src, "message received from a wrong endpoint");
+        // only the messages following the last one in order of the same producer are counted
+        if ((msg[0] < TC_MP_PRODUCER_COUNT) && (msg[1] == received[msg[0]]))
+        {
+            received[msg[0]]++;
+        }
+    }
+    result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR, (char *)received, sizeof(received), TC_FEATURE_TIMEOUT_MS);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+
+    result = rpmsg_lite_destroy_ept(my_rpmsg, mp_ept);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_destroy_ept' failed");
+    result = rpmsg_queue_destroy(my_rpmsg, mp_queue);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_destroy' failed");
+}
+#endif
+
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+/******************************************************************************
+ * Test case 18
+ * - send the messages of each round the primary side asks for to its rx ISR
+ *   and rx worker endpoints, until it asks for round 0
+ *****************************************************************************/
+void tc_18_rx_deferred(void)
+{
+    static const char msgs[]      = {1, 2, 3};
+    static const uint32_t addrs[] = {TC_REMOTE_EPT_ADDR + 10, TC_REMOTE_EPT_ADDR + 11, TC_REMOTE_EPT_ADDR + 10};
+    int32_t result;
+    char round = 0;
+    char msg;
+    uint32_t src;
+    uint32_t len;
+    uint32_t i;
+
+    for (;;)
+    {
+        result = rpmsg_queue_recv(my_rpmsg, my_queue, &src, &round, 1, &len, TC_FEATURE_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_queue_recv' failed");
+        if (round == 0)
+        {
+            break;
+        }
+        if (round == 1)
+        {
+            for (i = 0; i < sizeof(msgs); i++)
+            {
+                result = rpmsg_lite_send(my_rpmsg, my_ept, addrs[i], (char *)&msgs[i], 1, TC_FEATURE_TIMEOUT_MS);
+                TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+            }
+        }
+        else
+        {
+            msg    = 4;
+            result = rpmsg_lite_send(my_rpmsg, my_ept, TC_REMOTE_EPT_ADDR + 10, &msg, 1, TC_FEATURE_TIMEOUT_MS);
+            TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_lite_send' failed");
+        }
+    }
+}
+#endif
+
 void run_tests(void *unused)
 {
     int32_t result = 0;
@@ -417,6 +905,39 @@ void run_tests(void *unused)
         __coveragescanner_testname("03_send_receive_rtos_sec_core");
         __coveragescanner_install("03_send_receive_rtos_sec_core.csexe");
 #endif /*__COVERAGESCANNER__*/
+        /* The feature test cases run first, while no buffer is held by the test cases 1 and 2 */
+#if defined(RL_USE_TX_BUFFER_WAIT_EVENT) && (RL_USE_TX_BUFFER_WAIT_EVENT == 1) && \
+    defined(RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION) && (RL_ALLOW_CONSUMED_BUFFERS_NOTIFICATION == 1)
+        RUN_EXAMPLE(tc_4_tx_buffer_wait, MAKE_UNITY_NUM(k_unity_rpmsg, 3));
+#endif
+#if defined(RL_ALLOW_DEFERRED_NOTIFY) && (RL_ALLOW_DEFERRED_NOTIFY == 1)
+        RUN_EXAMPLE(tc_5_deferred_notify, MAKE_UNITY_NUM(k_unity_rpmsg, 4));
+#endif
+#if !(defined(RL_ALLOW_RX_ADAPTIVE_POLLING) && (RL_ALLOW_RX_ADAPTIVE_POLLING == 1)) && \
+    !(defined(RL_ALLOW_VRING_EVENT_IDX) && (RL_ALLOW_VRING_EVENT_IDX == 1))
+        RUN_EXAMPLE(tc_6_baseline_master, MAKE_UNITY_NUM(k_unity_rpmsg, 5));
+#endif
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+        RUN_EXAMPLE(tc_7_credit_flow_control, MAKE_UNITY_NUM(k_unity_rpmsg, 6));
+#endif
+#if defined(RL_ALLOW_MSG_PACKING) && (RL_ALLOW_MSG_PACKING == 1)
+        RUN_EXAMPLE(tc_8_msg_packing, MAKE_UNITY_NUM(k_unity_rpmsg, 7));
+#endif
+#if defined(RL_ALLOW_GROUP_ENDPOINTS) && (RL_ALLOW_GROUP_ENDPOINTS == 1)
+        RUN_EXAMPLE(tc_9_group_endpoints, MAKE_UNITY_NUM(k_unity_rpmsg, 8));
+#endif
+#if (RL_QUEUE_PAIR_COUNT > 1)
+        RUN_EXAMPLE(tc_15_queue_pairs, MAKE_UNITY_NUM(k_unity_rpmsg, 14));
+#endif
+#if (RL_EPT_TABLE_DIRECT_SIZE > 0) && (RL_EPT_TABLE_HASH_SIZE > 0)
+        RUN_EXAMPLE(tc_16_ept_lookup, MAKE_UNITY_NUM(k_unity_rpmsg, 15));
+#endif
+#if defined(RL_LOCKLESS_TX_MULTI_PRODUCER) && (RL_LOCKLESS_TX_MULTI_PRODUCER == 1)
+        RUN_EXAMPLE(tc_17_multi_producer, MAKE_UNITY_NUM(k_unity_rpmsg, 16));
+#endif
+#if defined(RL_ALLOW_RX_DEFERRED_PROCESSING) && (RL_ALLOW_RX_DEFERRED_PROCESSING == 1)
+        RUN_EXAMPLE(tc_18_rx_deferred, MAKE_UNITY_NUM(k_unity_rpmsg, 17));
+#endif
         RUN_EXAMPLE(tc_1_receive_send, MAKE_UNITY_NUM(k_unity_rpmsg, 0));
         RUN_EXAMPLE(tc_2_receive_send, MAKE_UNITY_NUM(k_unity_rpmsg, 1));
     }
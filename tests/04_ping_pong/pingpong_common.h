@@ -37,6 +37,12 @@
 
 #define CMD_RECV_TIMEOUT_MS (2000)
 
+/* event index notification suppression test */
+#define EVENT_IDX_ECHO_EPT_ADDR (50)
+#define EVENT_IDX_PING_PONG_CNT (100)
+#define EVENT_IDX_STREAM_CNT (1000)
+#define EVENT_IDX_WAIT_LOOPS (10000000)
+
 #define DESTROY_ALL_EPT (0xFFFFFFFF)
 
 #define EP_SIGNATURE (('H' << 24) | ('D' << 16) | ('O' << 8) | ('D' << 0))
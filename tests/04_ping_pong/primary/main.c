@@ -382,6 +382,91 @@ end:
     TEST_ASSERT_MESSAGE(0 == result, "system clean up error");
 }
 
+#if defined(RL_ALLOW_VRING_EVENT_IDX) && (RL_ALLOW_VRING_EVENT_IDX == 1)
+volatile uint32_t echo_received = 0U;
+volatile uint32_t echo_out_of_order = 0U;
+
+// echo ept callback, every sequence number has to come back exactly once and in order
+int32_t echo_cb(void *payload, uint32_t payload_len, uint32_t src, void *priv)
+{
+    uint32_t seq;
+
+    env_memcpy((void *)&seq, payload, sizeof(uint32_t));
+    if (seq != echo_received)
+    {
+        echo_out_of_order = 1U;
+    }
+    echo_received++;
+    return RL_RELEASE;
+}
+
+// utility: wait until the given number of echoes is received, 0 when a notification got lost
+static int32_t ts_wait_for_echo(uint32_t count)
+{
+    uint32_t loops = 0U;
+
+    while ((echo_received < count) && (loops < EVENT_IDX_WAIT_LOOPS))
+    {
+        loops++;
+    }
+    return (echo_received == count) ? 1 : 0;
+}
+
+// this test case is to test that the notification suppression by event index never loses a notification
+void tc_3_event_idx_ping_pong_stream(void)
+{
+    int32_t result = 0;
+    uint32_t seq;
+    struct rpmsg_lite_endpoint *my_ept = {0};
+    struct rpmsg_lite_ept_static_context my_ept_ctxt;
+
+    echo_received = 0U;
+    echo_out_of_order = 0U;
+
+    result = ts_init_rpmsg();
+    TEST_ASSERT_MESSAGE((0 == result ? 1 : (0 != ts_deinit_rpmsg())), "error! failed to init");
+    if (result)
+        goto end;
+
+    my_ept = rpmsg_lite_create_ept(my_rpmsg, RL_ADDR_ANY, echo_cb, NULL, &my_ept_ctxt);
+    TEST_ASSERT_MESSAGE((NULL != my_ept ? 1 : (0 != ts_deinit_rpmsg())), "error! creation of an endpoint failed");
+
+    /* the remote has answered the link up, it has to advertise its event index by now */
+    env_cache_invalidate((void *)&my_rpmsg->rvq->vq_ring.used->flags, sizeof(uint16_t));
+    TEST_ASSERT_MESSAGE((0U != (my_rpmsg->rvq->vq_ring.used->flags & VRING_USED_F_EVENT_IDX) ? 1 :
+                                                                                           (0 != ts_deinit_rpmsg())),
+                        "error! remote event index not advertised");
+
+    // ping-pong, each message waits for its echo, every single notification is needed
+    for (seq = 0U; seq < EVENT_IDX_PING_PONG_CNT; seq++)
+    {
+        result = rpmsg_lite_send(my_rpmsg, my_ept, EVENT_IDX_ECHO_EPT_ADDR, (char *)&seq, sizeof(uint32_t),
+                                 RL_BLOCK);
+        TEST_ASSERT_MESSAGE((0 == result ? 1 : (0 != ts_deinit_rpmsg())), "error! send message failed");
+        TEST_ASSERT_MESSAGE((1 == ts_wait_for_echo(seq + 1U) ? 1 : (0 != ts_deinit_rpmsg())),
+                            "error! ping-pong notification lost");
+    }
+
+    // streaming, back-to-back messages, most of the notifications are suppressed
+    for (seq = EVENT_IDX_PING_PONG_CNT; seq < (EVENT_IDX_PING_PONG_CNT + EVENT_IDX_STREAM_CNT); seq++)
+    {
+        result = rpmsg_lite_send(my_rpmsg, my_ept, EVENT_IDX_ECHO_EPT_ADDR, (char *)&seq, sizeof(uint32_t),
+                                 CMD_RECV_TIMEOUT_MS);
+        TEST_ASSERT_MESSAGE((0 == result ? 1 : (0 != ts_deinit_rpmsg())),
+                            "error! send message failed, tx buffer notification lost");
+    }
+    TEST_ASSERT_MESSAGE(
+        (1 == ts_wait_for_echo(EVENT_IDX_PING_PONG_CNT + EVENT_IDX_STREAM_CNT) ? 1 : (0 != ts_deinit_rpmsg())),
+        "error! streaming notification lost");
+    TEST_ASSERT_MESSAGE((0U == echo_out_of_order ? 1 : (0 != ts_deinit_rpmsg())), "error! echo out of order");
+
+    rpmsg_lite_destroy_ept(my_rpmsg, my_ept);
+end:
+    result = ts_deinit_rpmsg();
+    TEST_ASSERT_MESSAGE(0 == result, "system clean up error");
+}
+#endif /* RL_ALLOW_VRING_EVENT_IDX */
+
 void run_tests(void *unused)
 {
 #ifdef __COVERAGESCANNER__
@@ -390,6 +475,9 @@ void run_tests(void *unused)
 #endif /*__COVERAGESCANNER__*/
     RUN_EXAMPLE(tc_1_create_delete_ep_cmd_sender, MAKE_UNITY_NUM(k_unity_rpmsg, 0));
     RUN_EXAMPLE(tc_2_send_cmd_sender, MAKE_UNITY_NUM(k_unity_rpmsg, 1));
+#if defined(RL_ALLOW_VRING_EVENT_IDX) && (RL_ALLOW_VRING_EVENT_IDX == 1)
+    RUN_EXAMPLE(tc_3_event_idx_ping_pong_stream, MAKE_UNITY_NUM(k_unity_rpmsg, 2));
+#endif
 }
 
 /* EOF */
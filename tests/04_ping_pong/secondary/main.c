@@ -406,6 +406,64 @@ end:
     TEST_ASSERT_MESSAGE(0 == result, "system clean up error");
 }
 
+#if defined(RL_ALLOW_VRING_EVENT_IDX) && (RL_ALLOW_VRING_EVENT_IDX == 1)
+void *volatile echo_data[RL_BUFFER_COUNT];
+volatile uint32_t echo_src[RL_BUFFER_COUNT];
+volatile uint32_t echo_head = 0U;
+
+// echo ept callback, hold the rx buffer until the main loop sends it back
+int32_t echo_cb(void *payload, uint32_t payload_len, uint32_t src, void *priv)
+{
+    echo_data[echo_head % RL_BUFFER_COUNT] = payload;
+    echo_src[echo_head % RL_BUFFER_COUNT]  = src;
+    echo_head++;
+    return RL_HOLD;
+}
+
+// this test case is to test that the notification suppression by event index never loses a notification
+void tc_3_event_idx_echo_responder(void)
+{
+    int32_t result = 0;
+    uint32_t echo_tail = 0U;
+    struct rpmsg_lite_endpoint *echo_ept = {0};
+    struct rpmsg_lite_ept_static_context echo_ept_ctxt;
+
+    echo_head = 0U;
+
+    result = ts_init_rpmsg();
+    TEST_ASSERT_MESSAGE((0 == result ? 1 : (0 != ts_deinit_rpmsg())), "error! failed to init");
+    if (result)
+        goto end;
+
+    echo_ept = rpmsg_lite_create_ept(my_rpmsg, EVENT_IDX_ECHO_EPT_ADDR, echo_cb, NULL, &echo_ept_ctxt);
+    TEST_ASSERT_MESSAGE((NULL != echo_ept ? 1 : (0 != ts_deinit_rpmsg())), "error! creation of an endpoint failed");
+
+    // send NS message
+    result = rpmsg_ns_announce(my_rpmsg, ctrl_ept, TEST_RL_NS_ANNOUNCE_STRING, (uint32_t)RL_NS_CREATE);
+    TEST_ASSERT_MESSAGE(RL_SUCCESS == result, "'rpmsg_ns_announce' failed");
+
+    // echo the ping-pong messages and the stream, the primary detects lost notifications
+    while (echo_tail < (EVENT_IDX_PING_PONG_CNT + EVENT_IDX_STREAM_CNT))
+    {
+        if (echo_tail == echo_head)
+        {
+            continue;
+        }
+        result = rpmsg_lite_send(my_rpmsg, echo_ept, echo_src[echo_tail % RL_BUFFER_COUNT],
+                                 (char *)echo_data[echo_tail % RL_BUFFER_COUNT], sizeof(uint32_t), RL_BLOCK);
+        TEST_ASSERT_MESSAGE((0 == result ? 1 : (0 != ts_deinit_rpmsg())), "error! send message failed");
+        result = rpmsg_lite_release_rx_buffer(my_rpmsg, echo_data[echo_tail % RL_BUFFER_COUNT]);
+        TEST_ASSERT_MESSAGE((0 == result ? 1 : (0 != ts_deinit_rpmsg())), "error! release rx buffer failed");
+        echo_tail++;
+    }
+
+    rpmsg_lite_destroy_ept(my_rpmsg, echo_ept);
+end:
+    result = ts_deinit_rpmsg();
+    TEST_ASSERT_MESSAGE(0 == result, "system clean up error");
+}
+#endif /* RL_ALLOW_VRING_EVENT_IDX */
+
 void run_tests(void *unused)
 {
 #ifdef __COVERAGESCANNER__
@@ -414,6 +472,9 @@ void run_tests(void *unused)
 #endif /*__COVERAGESCANNER__*/
     RUN_EXAMPLE(tc_1_create_delete_ep_cmd_responder, MAKE_UNITY_NUM(k_unity_rpmsg, 0));
     RUN_EXAMPLE(tc_2_send_cmd_responder, MAKE_UNITY_NUM(k_unity_rpmsg, 1));
+#if defined(RL_ALLOW_VRING_EVENT_IDX) && (RL_ALLOW_VRING_EVENT_IDX == 1)
+    RUN_EXAMPLE(tc_3_event_idx_echo_responder, MAKE_UNITY_NUM(k_unity_rpmsg, 2));
+#endif
 }
 
 /* EOF */
@@ -15,6 +15,8 @@
 #define CTR_CMD_CREATE_CHANNEL (15)
 #define CTR_CMD_DESTROY_CHANNEL (16)
 #define CTR_CMD_FINISH (17)
+#define CTR_CMD_STREAM (18)
+#define CTR_CMD_SLOW_CONSUMER (19)
 
 /* recv command modes */
 #define CMD_RECV_MODE_COPY (1)
@@ -38,6 +40,17 @@
 
 #define CMD_RECV_TIMEOUT_MS (2000)
 
+/* concurrent send and receive throughput test */
+#define STREAM_EPT_ADDR (50)
+#define STREAM_MSG_CNT (1000)
+#define STREAM_MSG_SIZE (32)
+#define STREAM_WAIT_LOOPS (10000000)
+
+/* slow consumer under credit-based flow control */
+#define FC_SLOW_EPT_ADDR (51)
+#define FC_WINDOW (1)
+#define FC_SLOW_MSG_CNT (10)
+
 #define DESTROY_ALL_EPT (0xFFFFFFFF)
 
 #define EP_SIGNATURE (('H' << 24) | ('D' << 16) | ('O' << 8) | ('D' << 0))
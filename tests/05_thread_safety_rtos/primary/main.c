@@ -55,6 +55,17 @@ struct rpmsg_lite_instance *volatile my_rpmsg = NULL;
 struct rpmsg_lite_endpoint *volatile ctrl_ept = NULL;
 rpmsg_queue_handle ctrl_q;
 
+struct rpmsg_lite_endpoint *volatile stream_ept = NULL;
+volatile uint32_t stream_received = 0U;
+char stream_buffer[STREAM_MSG_SIZE];
+
+// stream ept callback, count the messages and release the rx buffer right away
+int32_t stream_cb(void *payload, uint32_t payload_len, uint32_t src, void *priv)
+{
+    stream_received++;
+    return RL_RELEASE;
+}
+
 /*
  * utility: initialize rpmsg and environment
  * and wait for default channel
@@ -77,6 +88,9 @@ int32_t ts_init_rpmsg(void)
     ctrl_ept = rpmsg_lite_create_ept(my_rpmsg, TC_LOCAL_EPT_ADDR, rpmsg_queue_rx_cb, ctrl_q);
     TEST_ASSERT_MESSAGE(NULL != ctrl_ept, "'rpmsg_lite_create_ept' failed");
 
+    stream_ept = rpmsg_lite_create_ept(my_rpmsg, STREAM_EPT_ADDR, stream_cb, NULL);
+    TEST_ASSERT_MESSAGE(NULL != stream_ept, "'rpmsg_lite_create_ept' failed");
+
     rpmsg_lite_wait_for_link_up(my_rpmsg, RL_BLOCK);
     return 0;
 }
@@ -86,6 +100,7 @@ int32_t ts_init_rpmsg(void)
  */
 int32_t ts_deinit_rpmsg(void)
 {
+    rpmsg_lite_destroy_ept(my_rpmsg, stream_ept);
     rpmsg_lite_destroy_ept(my_rpmsg, ctrl_ept);
     rpmsg_queue_destroy(my_rpmsg, ctrl_q);
     rpmsg_lite_deinit(my_rpmsg);
@@ -109,6 +124,7 @@ void responder_task(void)
     void *data_addr = NULL;
     uint32_t num_of_received_control_bytes;
     uint32_t i;
+    uint32_t loops;
     uint32_t src = 0;
     rpmsg_queue_handle q;
     struct rpmsg_lite_endpoint *my_ept;
@@ -122,6 +138,11 @@ void responder_task(void)
     void *nocopy_buffer_ptr = NULL; // pointer to receive data in no-copy mode
     uint32_t buf_size = 0;     /* use to store size of buffer for
                                        rpmsg_rtos_alloc_tx_buffer() */
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+    struct rpmsg_lite_endpoint *slow_ept;
+    struct rpmsg_lite_fc_stats fc_stats;
+    uint32_t slow_sent;
+#endif
 
     ret_value = ts_init_rpmsg();
     TEST_ASSERT_MESSAGE(0 == ret_value, "Testing function init rpmsg");
@@ -415,6 +436,89 @@ void responder_task(void)
                     }
 
                     break;
+                case CTR_CMD_STREAM:
+                    env_memcpy((void *)&data_send_param, (void *)msg.DATA,
+                               (uint32_t)(sizeof(CONTROL_MESSAGE_DATA_SEND_PARAM)));
+
+                    /* Stream at the sender while its stream is received in the rx path */
+                    ret_value = 0;
+                    for (i = 0; (i < data_send_param.repeat_count) && (0 == ret_value); i++)
+                    {
+                        ret_value = rpmsg_lite_send(my_rpmsg, stream_ept, data_send_param.dest_addr, stream_buffer,
+                                                    data_send_param.msg_size, RL_BLOCK);
+                    }
+
+                    loops = 0U;
+                    while ((stream_received < data_send_param.repeat_count) && (loops < STREAM_WAIT_LOOPS))
+                    {
+                        loops++;
+                    }
+                    if (stream_received != data_send_param.repeat_count)
+                    {
+                        ret_value = -1;
+                    }
+                    stream_received = 0U;
+
+                    if (ACK_REQUIRED_YES == msg.ACK_REQUIRED)
+                    {
+                        ack_msg.CMD_ACK = CTR_CMD_STREAM;
+                        ack_msg.RETURN_VALUE = ret_value;
+                        ret_value = rpmsg_lite_send(my_rpmsg, ctrl_ept, data_send_param.ept_to_ack_addr,
+                                                    (char *)&ack_msg, sizeof(ACKNOWLEDGE_MESSAGE), RL_BLOCK);
+                    }
+                    break;
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+                case CTR_CMD_SLOW_CONSUMER:
+                    env_memcpy((void *)&data_send_param, (void *)msg.DATA,
+                               (uint32_t)(sizeof(CONTROL_MESSAGE_DATA_SEND_PARAM)));
+
+                    /* Flood the slow endpoint of the other side while streaming to its fast one,
+                       the window holds the flood back as the other side does not read it yet */
+                    ret_value = -1;
+                    slow_ept = rpmsg_lite_create_ept(my_rpmsg, FC_SLOW_EPT_ADDR, stream_cb, NULL);
+                    if (NULL != slow_ept)
+                    {
+                        ret_value =
+                            rpmsg_lite_set_ept_flow_control(my_rpmsg, slow_ept, FC_SLOW_EPT_ADDR, FC_WINDOW, RL_BLOCK);
+                    }
+                    slow_sent = 0U;
+                    for (i = 0; (i < STREAM_MSG_CNT) && (0 == ret_value); i++)
+                    {
+                        ret_value = rpmsg_lite_send(my_rpmsg, stream_ept, data_send_param.dest_addr, stream_buffer,
+                                                    data_send_param.msg_size, RL_BLOCK);
+                        if ((slow_sent < data_send_param.repeat_count) &&
+                            (RL_SUCCESS == rpmsg_lite_send(my_rpmsg, slow_ept, FC_SLOW_EPT_ADDR, stream_buffer,
+                                                           data_send_param.msg_size, RL_DONT_BLOCK)))
+                        {
+                            slow_sent++;
+                        }
+                    }
+                    /* The rest waits for the other side to read the slow endpoint */
+                    for (; (slow_sent < data_send_param.repeat_count) && (0 == ret_value); slow_sent++)
+                    {
+                        ret_value = rpmsg_lite_send(my_rpmsg, slow_ept, FC_SLOW_EPT_ADDR, stream_buffer,
+                                                    data_send_param.msg_size, RL_BLOCK);
+                    }
+                    if ((0 == ret_value) &&
+                        ((RL_SUCCESS != rpmsg_lite_get_ept_fc_stats(my_rpmsg, slow_ept, &fc_stats)) ||
+                         (0U == fc_stats.tx_blocked)))
+                    {
+                        ret_value = -1; /* The flood has not been held back */
+                    }
+                    if (NULL != slow_ept)
+                    {
+                        rpmsg_lite_destroy_ept(my_rpmsg, slow_ept);
+                    }
+
+                    if (ACK_REQUIRED_YES == msg.ACK_REQUIRED)
+                    {
+                        ack_msg.CMD_ACK = CTR_CMD_SLOW_CONSUMER;
+                        ack_msg.RETURN_VALUE = ret_value;
+                        ret_value = rpmsg_lite_send(my_rpmsg, ctrl_ept, data_send_param.ept_to_ack_addr,
+                                                    (char *)&ack_msg, sizeof(ACKNOWLEDGE_MESSAGE), RL_BLOCK);
+                    }
+                    break;
+#endif
                 case CTR_CMD_FINISH:
                     goto end;
                     break;
@@ -85,6 +85,9 @@ struct rpmsg_lite_endpoint *volatile ctrl_ept = NULL;
 rpmsg_queue_handle ctrl_q;
 struct rpmsg_lite_instance *volatile my_rpmsg = NULL;
 
+volatile uint32_t stream_received = 0U;
+char stream_buffer[STREAM_MSG_SIZE];
+
 #if defined(FSL_RTOS_THREADX)
 VOID sendRecvTestTask(ULONG arg);
 #else
@@ -165,6 +168,170 @@ int32_t ts_destroy_ept(int32_t addr, struct rpmsg_lite_endpoint *ack_ept, rpmsg_
     return 0;
 }
 
+// stream ept callback, count the messages and release the rx buffer right away
+int32_t stream_cb(void *payload, uint32_t payload_len, uint32_t src, void *priv)
+{
+    stream_received++;
+    return RL_RELEASE;
+}
+
+/*
+ * Concurrent send and receive throughput, both sides stream at each other
+ * so that the tx and the rx path of each instance run at the same time
+ */
+void ts_stream(void)
+{
+    CONTROL_MESSAGE msg = {0};
+    ACKNOWLEDGE_MESSAGE ack_msg = {0};
+    CONTROL_MESSAGE_DATA_SEND_PARAM data_send_param;
+    struct rpmsg_lite_endpoint *stream_ept;
+    uint32_t num_of_received_bytes = 0;
+    uint32_t src;
+    uint32_t loops = 0U;
+    uint32_t elapsed_ms;
+    uint64_t start;
+    int32_t ret_value = 0;
+    int32_t i;
+
+    stream_received = 0U;
+    stream_ept = rpmsg_lite_create_ept(my_rpmsg, STREAM_EPT_ADDR, stream_cb, NULL);
+    TEST_ASSERT_MESSAGE(NULL != stream_ept, "error! failed to create endpoint");
+
+    data_send_param.dest_addr = STREAM_EPT_ADDR;
+    data_send_param.msg_size = STREAM_MSG_SIZE;
+    data_send_param.repeat_count = STREAM_MSG_CNT;
+    data_send_param.mode = CMD_SEND_MODE_COPY;
+    data_send_param.ept_to_ack_addr = ctrl_ept->addr;
+
+    msg.CMD = CTR_CMD_STREAM;
+    msg.ACK_REQUIRED = ACK_REQUIRED_YES;
+    env_memcpy((void *)msg.DATA, (void *)&data_send_param, (uint32_t)(sizeof(CONTROL_MESSAGE_DATA_SEND_PARAM)));
+
+    start = env_get_timestamp();
+    ret_value = rpmsg_lite_send(my_rpmsg, ctrl_ept, TC_REMOTE_EPT_ADDR, (char *)&msg, sizeof(CONTROL_MESSAGE),
+                                RL_BLOCK);
+    TEST_ASSERT_MESSAGE(0 == ret_value, "error! failed to send CTR_CMD_STREAM command to other side");
+
+    for (i = 0; (i < STREAM_MSG_CNT) && (0 == ret_value); i++)
+    {
+        ret_value = rpmsg_lite_send(my_rpmsg, stream_ept, STREAM_EPT_ADDR, stream_buffer, STREAM_MSG_SIZE, RL_BLOCK);
+    }
+    TEST_ASSERT_MESSAGE(0 == ret_value, "error! failed to stream to other side");
+
+    while ((stream_received < STREAM_MSG_CNT) && (loops < STREAM_WAIT_LOOPS))
+    {
+        loops++;
+    }
+    elapsed_ms = env_timestamp_to_msec(env_get_timestamp() - start);
+    TEST_ASSERT_MESSAGE(STREAM_MSG_CNT == stream_received, "error! stream from other side incomplete");
+
+    ret_value = rpmsg_queue_recv(my_rpmsg, ctrl_q, &src, (char *)&ack_msg, sizeof(ACKNOWLEDGE_MESSAGE),
+                                 &num_of_received_bytes, RL_BLOCK);
+    TEST_ASSERT_MESSAGE(0 == ret_value, "error! failed to receive acknowledge message from other side");
+    TEST_ASSERT_MESSAGE(CTR_CMD_STREAM == ack_msg.CMD_ACK, "error! expecting acknowledge of CTR_CMD_STREAM command");
+    TEST_ASSERT_MESSAGE(0 == ack_msg.RETURN_VALUE, "error! other side failed to stream");
+
+    /* Messages per second in both directions together */
+    if (0U == elapsed_ms)
+    {
+        elapsed_ms = 1U;
+    }
+    UnityPrint(" stream msg/s: ");
+    UnityPrintNumber((UNITY_INT)((2U * STREAM_MSG_CNT * 1000U) / elapsed_ms));
+
+    rpmsg_lite_destroy_ept(my_rpmsg, stream_ept);
+}
+
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+/*
+ * Slow consumer under credit-based flow control, the other side floods an endpoint
+ * left unread until its stream to another endpoint is complete, the stream must not
+ * be stalled by the rx buffers held for the slow endpoint
+ */
+void ts_slow_consumer(void)
+{
+    CONTROL_MESSAGE msg = {0};
+    ACKNOWLEDGE_MESSAGE ack_msg = {0};
+    CONTROL_MESSAGE_DATA_SEND_PARAM data_send_param;
+    struct rpmsg_lite_endpoint *stream_ept;
+    struct rpmsg_lite_endpoint *slow_ept;
+    rpmsg_queue_handle slow_q;
+    struct rpmsg_lite_fc_stats fc_stats;
+    uint32_t num_of_received_bytes = 0;
+    uint32_t src;
+    uint32_t loops = 0U;
+    uint32_t elapsed_ms;
+    uint64_t start;
+    int32_t ret_value = 0;
+    int32_t i;
+
+    stream_received = 0U;
+    slow_q = rpmsg_queue_create(my_rpmsg);
+    TEST_ASSERT_MESSAGE(NULL != slow_q, "'rpmsg_queue_create' failed");
+    slow_ept = rpmsg_lite_create_ept(my_rpmsg, FC_SLOW_EPT_ADDR, rpmsg_queue_rx_cb, slow_q);
+    TEST_ASSERT_MESSAGE(NULL != slow_ept, "error! failed to create endpoint");
+    /* The other side creates its endpoint on the command, the sync is kept until then */
+    ret_value = rpmsg_lite_set_ept_flow_control(my_rpmsg, slow_ept, FC_SLOW_EPT_ADDR, FC_WINDOW, RL_BLOCK);
+    TEST_ASSERT_MESSAGE(0 == ret_value, "error! failed to enable the flow control");
+    stream_ept = rpmsg_lite_create_ept(my_rpmsg, STREAM_EPT_ADDR, stream_cb, NULL);
+    TEST_ASSERT_MESSAGE(NULL != stream_ept, "error! failed to create endpoint");
+
+    data_send_param.dest_addr = STREAM_EPT_ADDR;
+    data_send_param.msg_size = STREAM_MSG_SIZE;
+    data_send_param.repeat_count = FC_SLOW_MSG_CNT;
+    data_send_param.mode = CMD_SEND_MODE_COPY;
+    data_send_param.ept_to_ack_addr = ctrl_ept->addr;
+
+    msg.CMD = CTR_CMD_SLOW_CONSUMER;
+    msg.ACK_REQUIRED = ACK_REQUIRED_YES;
+    env_memcpy((void *)msg.DATA, (void *)&data_send_param, (uint32_t)(sizeof(CONTROL_MESSAGE_DATA_SEND_PARAM)));
+
+    start = env_get_timestamp();
+    ret_value = rpmsg_lite_send(my_rpmsg, ctrl_ept, TC_REMOTE_EPT_ADDR, (char *)&msg, sizeof(CONTROL_MESSAGE),
+                                RL_BLOCK);
+    TEST_ASSERT_MESSAGE(0 == ret_value, "error! failed to send CTR_CMD_SLOW_CONSUMER command to other side");
+
+    /* The slow endpoint is not read before the stream is complete */
+    while ((stream_received < STREAM_MSG_CNT) && (loops < STREAM_WAIT_LOOPS))
+    {
+        loops++;
+    }
+    elapsed_ms = env_timestamp_to_msec(env_get_timestamp() - start);
+    TEST_ASSERT_MESSAGE(STREAM_MSG_CNT == stream_received, "error! stream stalled by the slow endpoint");
+    TEST_ASSERT_MESSAGE(FC_WINDOW >= rpmsg_queue_get_current_size(slow_q),
+                        "error! slow endpoint holds more messages than its window");
+
+    for (i = 0; (i < FC_SLOW_MSG_CNT) && (0 == ret_value); i++)
+    {
+        ret_value = rpmsg_queue_recv(my_rpmsg, slow_q, &src, stream_buffer, STREAM_MSG_SIZE, &num_of_received_bytes,
+                                     CMD_RECV_TIMEOUT_MS);
+    }
+    TEST_ASSERT_MESSAGE(0 == ret_value, "error! messages of the slow endpoint missing");
+
+    ret_value = rpmsg_queue_recv(my_rpmsg, ctrl_q, &src, (char *)&ack_msg, sizeof(ACKNOWLEDGE_MESSAGE),
+                                 &num_of_received_bytes, RL_BLOCK);
+    TEST_ASSERT_MESSAGE(0 == ret_value, "error! failed to receive acknowledge message from other side");
+    TEST_ASSERT_MESSAGE(CTR_CMD_SLOW_CONSUMER == ack_msg.CMD_ACK,
+                        "error! expecting acknowledge of CTR_CMD_SLOW_CONSUMER command");
+    TEST_ASSERT_MESSAGE(0 == ack_msg.RETURN_VALUE, "error! flood of the other side not held back by the window");
+
+    ret_value = rpmsg_lite_get_ept_fc_stats(my_rpmsg, slow_ept, &fc_stats);
+    TEST_ASSERT_MESSAGE(0 == ret_value, "error! failed to get the flow control counters");
+    TEST_ASSERT_MESSAGE(0U == fc_stats.rx_overruns, "error! window exceeded");
+
+    if (0U == elapsed_ms)
+    {
+        elapsed_ms = 1U;
+    }
+    UnityPrint(" stream msg/s with a slow consumer: ");
+    UnityPrintNumber((UNITY_INT)((STREAM_MSG_CNT * 1000U) / elapsed_ms));
+
+    rpmsg_lite_destroy_ept(my_rpmsg, stream_ept);
+    rpmsg_lite_destroy_ept(my_rpmsg, slow_ept);
+    rpmsg_queue_destroy(my_rpmsg, slow_q);
+}
+#endif /* RL_ALLOW_CREDIT_FLOW_CONTROL */
+
 /*
  * Thread safety testing
  */
@@ -223,6 +390,11 @@ void tc_1_main_task(void)
 #endif
         }
 
+        ts_stream();
+#if defined(RL_ALLOW_CREDIT_FLOW_CONTROL) && (RL_ALLOW_CREDIT_FLOW_CONTROL == 1)
+        ts_slow_consumer();
+#endif
+
         /* Send command to end to the other core to finish testing */
         msg.CMD = CTR_CMD_FINISH;
         msg.ACK_REQUIRED = ACK_REQUIRED_NO;
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2026 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef _APP_H_
+#define _APP_H_
+
+/*${header:start}*/
+#include "rpmsg_platform.h"
+/*${header:end}*/
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*${macro:start}*/
+/* The primary and the secondary are two processes sharing the RL_LINUX_SHM_NAME object */
+#define SH_MEM_NOT_TAKEN_FROM_LINKER
+#define RPMSG_LITE_LINK_ID    (RL_PLATFORM_LINUX_SHM_LINK_ID)
+#define RPMSG_LITE_SHMEM_BASE (platform_get_shmem())
+#define RPMSG_LITE_SHMEM_SIZE (RL_LINUX_SHM_SIZE)
+
+/* Test case registration of the target Unity build */
+#define k_unity_rpmsg (0)
+#define MAKE_UNITY_NUM(module, num) ((module) + (num))
+#define RUN_EXAMPLE(func, num)      host_run_test((func), #func, __LINE__)
+/*${macro:end}*/
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/*${prototype:start}*/
+void host_run_test(void (*func)(void), const char *name, int line);
+/*${prototype:end}*/
+
+#endif /* _APP_H_ */
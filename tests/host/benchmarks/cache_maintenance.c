@@ -0,0 +1,151 @@
+/*
+ * Copyright 2026 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Counts the cache maintenance calls made per nocopy round trip, built with RL_USE_DCACHE=1 and the
+ * env_cache_invalidate(), env_cache_flush() and env_map_patova() calls of the library wrapped by the linker.
+ * The primary (master) sends and receives back, the secondary (remote) echoes.
+ *
+ * usage: <benchmark> [round trips] [message size]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rpmsg_lite.h"
+#include "rpmsg_queue.h"
+#include "rpmsg_platform.h"
+
+#define BENCH_ROUND_TRIPS (20000U)
+#define BENCH_MSG_SIZE    (64U)
+#define BENCH_MASTER_ADDR (30U)
+#define BENCH_REMOTE_ADDR (40U)
+
+static volatile uint32_t bench_counting = 0U;
+static char *bench_desc[2];
+static uint32_t bench_desc_size;
+static uint32_t bench_invalidate_count;
+static uint32_t bench_invalidate_desc_count;
+static uint32_t bench_flush_count;
+static uint32_t bench_patova_count;
+
+void __real_env_cache_invalidate(void *data, uint32_t len);
+void __real_env_cache_flush(void *data, uint32_t len);
+void *__real_env_map_patova(uint32_t address);
+
+static uint32_t bench_is_desc(void *data)
+{
+    char *addr = (char *)data;
+    uint32_t i;
+
+    for (i = 0U; i < 2U; i++)
+    {
+        if ((addr >= bench_desc[i]) && (addr < &bench_desc[i][bench_desc_size]))
+        {
+            return 1U;
+        }
+    }
+    return 0U;
+}
+
+void __wrap_env_cache_invalidate(void *data, uint32_t len)
+{
+    if (bench_counting != 0U)
+    {
+        bench_invalidate_count++;
+        bench_invalidate_desc_count += bench_is_desc(data);
+    }
+    __real_env_cache_invalidate(data, len);
+}
+
+void __wrap_env_cache_flush(void *data, uint32_t len)
+{
+    if (bench_counting != 0U)
+    {
+        bench_flush_count++;
+    }
+    __real_env_cache_flush(data, len);
+}
+
+void *__wrap_env_map_patova(uint32_t address)
+{
+    if (bench_counting != 0U)
+    {
+        bench_patova_count++;
+    }
+    return __real_env_map_patova(address);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t count = (argc > 1) ? (uint32_t)atoi(argv[1]) : BENCH_ROUND_TRIPS;
+    uint32_t size  = (argc > 2) ? (uint32_t)atoi(argv[2]) : BENCH_MSG_SIZE;
+    struct rpmsg_lite_instance *inst;
+    struct rpmsg_lite_endpoint *ept;
+    rpmsg_queue_handle queue;
+    uint64_t start;
+    uint64_t elapsed = 0U;
+    uint32_t src;
+    uint32_t len;
+    char *data;
+    uint32_t n;
+#if RL_LINUX_SHM_SIDE == 0
+    uint32_t buf_size;
+    char *buf;
+
+    inst = rpmsg_lite_master_init(platform_get_shmem(), RL_LINUX_SHM_SIZE, RL_PLATFORM_LINUX_SHM_LINK_ID, RL_NO_FLAGS);
+#else
+    inst = rpmsg_lite_remote_init(platform_get_shmem(), RL_PLATFORM_LINUX_SHM_LINK_ID, RL_NO_FLAGS);
+#endif
+    if (inst == RL_NULL)
+    {
+        return 1;
+    }
+    queue = rpmsg_queue_create(inst);
+    ept   = rpmsg_lite_create_ept(inst, (RL_LINUX_SHM_SIDE == 0) ? BENCH_MASTER_ADDR : BENCH_REMOTE_ADDR,
+                                  rpmsg_queue_rx_cb, queue);
+    (void)rpmsg_lite_wait_for_link_up(inst, 0xFFFFFFFFU);
+    bench_desc[0]   = (char *)inst->rvq->vq_ring.desc;
+    bench_desc[1]   = (char *)inst->tvq->vq_ring.desc;
+    bench_desc_size = (uint32_t)inst->rvq->vq_nentries * (uint32_t)sizeof(struct vring_desc);
+    /* Let the other side create its endpoint */
+    env_sleep_msec(50U);
+
+    bench_counting = 1U;
+    for (n = 0U; n < count; n++)
+    {
+#if RL_LINUX_SHM_SIDE == 0
+        start = env_get_timestamp();
+        buf   = (char *)rpmsg_lite_alloc_tx_buffer(inst, &buf_size, RL_BLOCK);
+        memset(buf, (int)n, size);
+        (void)rpmsg_lite_send_nocopy(inst, ept, BENCH_REMOTE_ADDR, buf, size);
+        (void)rpmsg_queue_recv_nocopy(inst, queue, &src, &data, &len, RL_BLOCK);
+        (void)rpmsg_queue_nocopy_free(inst, data);
+        elapsed += env_get_timestamp() - start;
+#else
+        (void)rpmsg_queue_recv_nocopy(inst, queue, &src, &data, &len, RL_BLOCK);
+        (void)rpmsg_lite_send(inst, ept, src, data, len, RL_BLOCK);
+        (void)rpmsg_queue_nocopy_free(inst, data);
+#endif
+    }
+    bench_counting = 0U;
+
+    printf("%s: per round trip: invalidates %.2f (descriptors %.2f), flushes %.2f, patova %.2f",
+           (RL_LINUX_SHM_SIDE == 0) ? "master" : "remote", (double)bench_invalidate_count / count,
+           (double)bench_invalidate_desc_count / count, (double)bench_flush_count / count,
+           (double)bench_patova_count / count);
+#if RL_LINUX_SHM_SIDE == 0
+    printf(", %llu ns", (unsigned long long)(env_timestamp_to_usec(elapsed) * 1000U / count));
+#endif
+    printf("\n");
+
+    /* The last message of the other side may still be in flight */
+    env_sleep_msec(300U);
+    (void)rpmsg_queue_destroy(inst, queue);
+    (void)rpmsg_lite_destroy_ept(inst, ept);
+    (void)rpmsg_lite_deinit(inst);
+    return 0;
+}
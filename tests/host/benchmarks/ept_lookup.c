@@ -0,0 +1,89 @@
+/*
+ * Copyright 2026 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Measures the endpoint lookup of the library, built once with the linked list only and once with the
+ * RL_EPT_TABLE_DIRECT_SIZE and RL_EPT_TABLE_HASH_SIZE tables. The primary (master) creates half of the endpoints
+ * with RL_ADDR_ANY and half at high addresses, then times rpmsg_lite_create_ept() with addresses in use, which
+ * looks the address up and returns RL_NULL. The secondary (remote) only brings the link up.
+ *
+ * usage: <benchmark> [endpoints] [lookups]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "rpmsg_lite.h"
+#include "rpmsg_platform.h"
+
+#define BENCH_EPT_COUNT     (150U)
+#define BENCH_MAX_EPT_COUNT (1024U)
+#define BENCH_LOOKUP_COUNT  (1000000U)
+#define BENCH_HIGH_ADDR     (1000U)
+
+static int32_t bench_rx_cb(void *payload, uint32_t payload_len, uint32_t src, void *priv)
+{
+    return RL_RELEASE;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t count   = (argc > 1) ? (uint32_t)atoi(argv[1]) : BENCH_EPT_COUNT;
+    uint32_t lookups = (argc > 2) ? (uint32_t)atoi(argv[2]) : BENCH_LOOKUP_COUNT;
+    struct rpmsg_lite_instance *inst;
+#if RL_LINUX_SHM_SIDE == 0
+    static struct rpmsg_lite_endpoint *epts[BENCH_MAX_EPT_COUNT];
+    uint32_t found = 0U;
+    uint64_t start;
+    uint64_t create_time;
+    uint64_t lookup_time;
+    uint32_t n;
+    uint32_t i;
+
+    count = (count < BENCH_MAX_EPT_COUNT) ? count : BENCH_MAX_EPT_COUNT;
+    inst  = rpmsg_lite_master_init(platform_get_shmem(), RL_LINUX_SHM_SIZE, RL_PLATFORM_LINUX_SHM_LINK_ID, RL_NO_FLAGS);
+#else
+    inst = rpmsg_lite_remote_init(platform_get_shmem(), RL_PLATFORM_LINUX_SHM_LINK_ID, RL_NO_FLAGS);
+#endif
+    if (inst == RL_NULL)
+    {
+        return 1;
+    }
+    (void)rpmsg_lite_wait_for_link_up(inst, 0xFFFFFFFFU);
+
+#if RL_LINUX_SHM_SIDE == 0
+    start = env_get_timestamp();
+    for (i = 0U; i < count; i++)
+    {
+        epts[i] = rpmsg_lite_create_ept(inst, ((i & 1U) != 0U) ? BENCH_HIGH_ADDR + (i * 7U) : RL_ADDR_ANY,
+                                        bench_rx_cb, RL_NULL);
+    }
+    create_time = env_get_timestamp() - start;
+
+    start = env_get_timestamp();
+    for (n = 0U; n < lookups; n++)
+    {
+        /* Walks the endpoints in a scattered order, the found ones are not created again */
+        found += (rpmsg_lite_create_ept(inst, epts[(n * 31U) % count]->addr, bench_rx_cb, RL_NULL) == RL_NULL) ? 1U : 0U;
+    }
+    lookup_time = env_get_timestamp() - start;
+
+    printf("direct %u, hash %u: %u endpoints: create %.1f ns, lookup %.1f ns (%u of %u found)\n",
+           (uint32_t)RL_EPT_TABLE_DIRECT_SIZE, (uint32_t)RL_EPT_TABLE_HASH_SIZE, count,
+           (double)env_timestamp_to_usec(create_time) * 1000.0 / count,
+           (double)env_timestamp_to_usec(lookup_time) * 1000.0 / lookups, found, lookups);
+
+    for (i = 0U; i < count; i++)
+    {
+        (void)rpmsg_lite_destroy_ept(inst, epts[i]);
+    }
+#else
+    /* Keep the link up until the primary is done */
+    env_sleep_msec(50U);
+#endif
+
+    (void)rpmsg_lite_deinit(inst);
+    return 0;
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright 2026 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Compares two ways of handing each received message over to several consumer threads: copying it into one
+ * heap buffer per consumer in the rx callback, and a group endpoint passing the same rx buffer to one rpmsg_queue
+ * endpoint per consumer, released by each of them with rpmsg_queue_nocopy_free(). Built with
+ * RL_ALLOW_GROUP_ENDPOINTS=1. The secondary (remote) sends the messages of both rounds, the primary (master)
+ * consumes them and prints the throughput and the rx callback time of each round.
+ *
+ * usage: <benchmark> [consumers] [messages per round] [message size]
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rpmsg_lite.h"
+#include "rpmsg_queue.h"
+#include "rpmsg_platform.h"
+
+#define BENCH_CONSUMERS     (4U)
+#define BENCH_MAX_CONSUMERS (8U)
+#define BENCH_MSG_COUNT     (20000U)
+#define BENCH_MSG_SIZE      (64U)
+#define BENCH_MASTER_ADDR   (30U)
+#define BENCH_REMOTE_ADDR   (40U)
+#define BENCH_SUB_ADDR      (100U)
+
+static struct rpmsg_lite_instance *bench_inst;
+static uint32_t bench_consumers;
+static uint32_t bench_count;
+static volatile uint32_t bench_group_mode = 0U;
+static struct rpmsg_lite_group bench_group;
+static struct rpmsg_lite_endpoint *bench_subs[BENCH_MAX_CONSUMERS];
+static rpmsg_queue_handle bench_sub_queue[BENCH_MAX_CONSUMERS];
+static void *bench_copy_queue[BENCH_MAX_CONSUMERS];
+static uint64_t bench_cb_time;
+static uint32_t bench_sum[BENCH_MAX_CONSUMERS];
+
+/* Message in the copy queue of a consumer */
+struct bench_copy
+{
+    char *data;
+    uint32_t len;
+};
+
+static int32_t bench_rx_cb(void *payload, uint32_t payload_len, uint32_t src, void *priv)
+{
+    uint64_t start = env_get_timestamp();
+    struct bench_copy copy;
+    int32_t ret = RL_RELEASE;
+    uint32_t k;
+
+    if (bench_group_mode != 0U)
+    {
+        ret = rpmsg_lite_group_rx_cb(payload, payload_len, src, priv);
+    }
+    else
+    {
+        for (k = 0U; k < bench_consumers; k++)
+        {
+            copy.data = env_allocate_memory(payload_len);
+            copy.len  = payload_len;
+            memcpy(copy.data, payload, payload_len);
+            (void)env_put_queue(bench_copy_queue[k], &copy, RL_BLOCK);
+        }
+    }
+    bench_cb_time += env_get_timestamp() - start;
+    return ret;
+}
+
+static void *bench_consumer(void *arg)
+{
+    uint32_t k   = (uint32_t)(uintptr_t)arg;
+    uint32_t sum = 0U;
+    struct bench_copy copy;
+    uint32_t src;
+    uint32_t len;
+    char *data;
+    uint32_t n;
+    uint32_t i;
+
+    for (n = 0U; n < bench_count; n++)
+    {
+        if (bench_group_mode != 0U)
+        {
+            (void)rpmsg_queue_recv_nocopy(bench_inst, bench_sub_queue[k], &src, &data, &len, RL_BLOCK);
+        }
+        else
+        {
+            (void)env_get_queue(bench_copy_queue[k], &copy, RL_BLOCK);
+            data = copy.data;
+            len  = copy.len;
+        }
+        for (i = 0U; i < len; i++)
+        {
+            sum += (uint8_t)data[i];
+        }
+        if (bench_group_mode != 0U)
+        {
+            (void)rpmsg_queue_nocopy_free(bench_inst, data);
+        }
+        else
+        {
+            env_free_memory(data);
+        }
+    }
+    bench_sum[k] = sum;
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t size = (argc > 3) ? (uint32_t)atoi(argv[3]) : BENCH_MSG_SIZE;
+    struct rpmsg_lite_endpoint *ept;
+    rpmsg_queue_handle queue;
+    char buf[RL_BUFFER_PAYLOAD_SIZE];
+    uint32_t round;
+#if RL_LINUX_SHM_SIDE == 0
+    pthread_t threads[BENCH_MAX_CONSUMERS];
+    uint64_t start;
+    uint64_t elapsed;
+    uint32_t k;
+#else
+    uint32_t src;
+    uint32_t len;
+    uint32_t n;
+#endif
+
+    bench_consumers = (argc > 1) ? (uint32_t)atoi(argv[1]) : BENCH_CONSUMERS;
+    bench_count     = (argc > 2) ? (uint32_t)atoi(argv[2]) : BENCH_MSG_COUNT;
+    bench_consumers = (bench_consumers < BENCH_MAX_CONSUMERS) ? bench_consumers : BENCH_MAX_CONSUMERS;
+    size            = (size < RL_BUFFER_PAYLOAD_SIZE) ? size : RL_BUFFER_PAYLOAD_SIZE;
+#if RL_LINUX_SHM_SIDE == 0
+    bench_inst =
+        rpmsg_lite_master_init(platform_get_shmem(), RL_LINUX_SHM_SIZE, RL_PLATFORM_LINUX_SHM_LINK_ID, RL_NO_FLAGS);
+#else
+    bench_inst = rpmsg_lite_remote_init(platform_get_shmem(), RL_PLATFORM_LINUX_SHM_LINK_ID, RL_NO_FLAGS);
+#endif
+    if (bench_inst == RL_NULL)
+    {
+        return 1;
+    }
+    queue = rpmsg_queue_create(bench_inst);
+    ept   = rpmsg_lite_create_ept(bench_inst, (RL_LINUX_SHM_SIDE == 0) ? BENCH_MASTER_ADDR + 1U : BENCH_REMOTE_ADDR,
+                                  rpmsg_queue_rx_cb, queue);
+#if RL_LINUX_SHM_SIDE == 0
+    (void)rpmsg_lite_group_init(bench_inst, &bench_group, bench_subs, BENCH_MAX_CONSUMERS);
+    for (k = 0U; k < bench_consumers; k++)
+    {
+        /* Large enough for all the messages of a round, the rx callback never waits for a consumer */
+        (void)env_create_queue(&bench_copy_queue[k], (int32_t)bench_count, (int32_t)sizeof(struct bench_copy));
+        bench_sub_queue[k] = rpmsg_queue_create(bench_inst);
+        (void)rpmsg_lite_group_subscribe(
+            &bench_group, rpmsg_lite_create_ept(bench_inst, BENCH_SUB_ADDR + k, rpmsg_queue_rx_cb, bench_sub_queue[k]));
+    }
+    (void)rpmsg_lite_create_ept(bench_inst, BENCH_MASTER_ADDR, bench_rx_cb, &bench_group);
+#endif
+    (void)rpmsg_lite_wait_for_link_up(bench_inst, 0xFFFFFFFFU);
+    /* Let the other side create its endpoint */
+    env_sleep_msec(50U);
+
+    for (round = 0U; round < 2U; round++)
+    {
+#if RL_LINUX_SHM_SIDE == 0
+        /* The remote starts sending the round once asked for it */
+        bench_group_mode = round;
+        bench_cb_time    = 0U;
+        start            = env_get_timestamp();
+        (void)rpmsg_lite_send(bench_inst, ept, BENCH_REMOTE_ADDR, buf, 1U, RL_BLOCK);
+        for (k = 0U; k < bench_consumers; k++)
+        {
+            (void)pthread_create(&threads[k], NULL, bench_consumer, (void *)(uintptr_t)k);
+        }
+        for (k = 0U; k < bench_consumers; k++)
+        {
+            (void)pthread_join(threads[k], NULL);
+        }
+        elapsed = env_timestamp_to_usec(env_get_timestamp() - start);
+        for (k = 1U; k < bench_consumers; k++)
+        {
+            if (bench_sum[k] != bench_sum[0])
+            {
+                printf("checksum mismatch\n");
+            }
+        }
+        printf("%s: %u consumers, size %u: %.0f msgs/s, %.0f deliveries/s, rx callback %.2f us per message\n",
+               (round != 0U) ? "group" : "copy ", bench_consumers, size, (double)bench_count * 1e6 / elapsed,
+               (double)bench_count * bench_consumers * 1e6 / elapsed,
+               (double)env_timestamp_to_usec(bench_cb_time) / bench_count);
+#else
+        (void)rpmsg_queue_recv(bench_inst, queue, &src, buf, sizeof(buf), &len, RL_BLOCK);
+        for (n = 0U; n < bench_count; n++)
+        {
+            memset(buf, (int)n, size);
+            (void)rpmsg_lite_send(bench_inst, ept, BENCH_MASTER_ADDR, buf, size, RL_BLOCK);
+        }
+#endif
+    }
+
+    /* The last message of the other side may still be in flight */
+    env_sleep_msec(300U);
+    (void)rpmsg_queue_destroy(bench_inst, queue);
+    (void)rpmsg_lite_destroy_ept(bench_inst, ept);
+    (void)rpmsg_lite_deinit(bench_inst);
+    return 0;
+}
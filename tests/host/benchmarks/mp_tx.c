@@ -0,0 +1,145 @@
+/*
+ * Copyright 2026 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Measures the send throughput of several producer threads sharing one endpoint, built once with the tx lock and
+ * once with RL_ALLOW_LOCKLESS_TX=1 and RL_LOCKLESS_TX_MULTI_PRODUCER=1. The primary (master) starts the producers,
+ * each of them sends its index and a sequence number. The secondary (remote) receives all the messages, checks the
+ * order of each producer and prints the throughput. Both sides have to be given the same arguments.
+ *
+ * usage: <benchmark> [producers] [messages per producer]
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rpmsg_lite.h"
+#include "rpmsg_queue.h"
+#include "rpmsg_platform.h"
+
+#define BENCH_PRODUCERS     (4U)
+#define BENCH_MAX_PRODUCERS (16U)
+#define BENCH_MSG_COUNT     (20000U)
+#define BENCH_MSG_SIZE      (32U)
+#define BENCH_MASTER_ADDR   (30U)
+#define BENCH_REMOTE_ADDR   (40U)
+
+static struct rpmsg_lite_instance *bench_inst;
+static struct rpmsg_lite_endpoint *bench_ept;
+static uint32_t bench_count;
+
+#if RL_LINUX_SHM_SIDE == 0
+static uint32_t bench_failures;
+
+static void *bench_producer(void *arg)
+{
+    uint32_t msg[BENCH_MSG_SIZE / sizeof(uint32_t)] = {0U};
+    uint32_t n;
+
+    msg[0] = (uint32_t)(uintptr_t)arg;
+    for (n = 0U; n < bench_count; n++)
+    {
+        msg[1] = n;
+        if (rpmsg_lite_send(bench_inst, bench_ept, BENCH_REMOTE_ADDR, (char *)msg, BENCH_MSG_SIZE, 5000U) !=
+            RL_SUCCESS)
+        {
+            bench_failures++;
+        }
+    }
+    return NULL;
+}
+#endif
+
+int main(int argc, char **argv)
+{
+    uint32_t producers = (argc > 1) ? (uint32_t)atoi(argv[1]) : BENCH_PRODUCERS;
+    rpmsg_queue_handle queue;
+#if RL_LINUX_SHM_SIDE == 0
+    pthread_t threads[BENCH_MAX_PRODUCERS];
+    uint32_t k;
+#else
+    uint32_t next[BENCH_MAX_PRODUCERS] = {0U};
+    uint32_t received                  = 0U;
+    uint32_t out_of_order              = 0U;
+    uint32_t msg[2];
+    uint64_t start = 0U;
+    uint64_t elapsed;
+    uint32_t src;
+    uint32_t len;
+    char *data;
+#endif
+
+    bench_count = (argc > 2) ? (uint32_t)atoi(argv[2]) : BENCH_MSG_COUNT;
+    producers   = (producers < BENCH_MAX_PRODUCERS) ? producers : BENCH_MAX_PRODUCERS;
+#if RL_LINUX_SHM_SIDE == 0
+    bench_inst =
+        rpmsg_lite_master_init(platform_get_shmem(), RL_LINUX_SHM_SIZE, RL_PLATFORM_LINUX_SHM_LINK_ID, RL_NO_FLAGS);
+#else
+    bench_inst = rpmsg_lite_remote_init(platform_get_shmem(), RL_PLATFORM_LINUX_SHM_LINK_ID, RL_NO_FLAGS);
+#endif
+    if (bench_inst == RL_NULL)
+    {
+        return 1;
+    }
+    queue     = rpmsg_queue_create(bench_inst);
+    bench_ept = rpmsg_lite_create_ept(bench_inst, (RL_LINUX_SHM_SIDE == 0) ? BENCH_MASTER_ADDR : BENCH_REMOTE_ADDR,
+                                      rpmsg_queue_rx_cb, queue);
+    (void)rpmsg_lite_wait_for_link_up(bench_inst, 0xFFFFFFFFU);
+    /* Let the other side create its endpoint */
+    env_sleep_msec(50U);
+
+#if RL_LINUX_SHM_SIDE == 0
+    for (k = 0U; k < producers; k++)
+    {
+        (void)pthread_create(&threads[k], NULL, bench_producer, (void *)(uintptr_t)k);
+    }
+    for (k = 0U; k < producers; k++)
+    {
+        (void)pthread_join(threads[k], NULL);
+    }
+    if (bench_failures != 0U)
+    {
+        printf("%u sends failed\n", bench_failures);
+    }
+#else
+    while (received < (producers * bench_count))
+    {
+        if (rpmsg_queue_recv_nocopy(bench_inst, queue, &src, &data, &len, 3000U) != RL_SUCCESS)
+        {
+            printf("rx timeout after %u messages\n", received);
+            break;
+        }
+        if (received == 0U)
+        {
+            start = env_get_timestamp();
+        }
+        memcpy(msg, data, sizeof(msg));
+        if ((msg[0] >= producers) || (msg[1] != next[msg[0]]))
+        {
+            out_of_order++;
+        }
+        else
+        {
+            next[msg[0]]++;
+        }
+        received++;
+        (void)rpmsg_queue_nocopy_free(bench_inst, data);
+    }
+    elapsed = env_timestamp_to_usec(env_get_timestamp() - start);
+    printf("lockless tx %u, multi producer %u: %u producers: %.0f msgs/s, %u of %u received, %u out of order\n",
+           (uint32_t)RL_ALLOW_LOCKLESS_TX, (uint32_t)RL_LOCKLESS_TX_MULTI_PRODUCER, producers,
+           (elapsed != 0U) ? ((double)received * 1e6 / elapsed) : 0.0, received, producers * bench_count,
+           out_of_order);
+#endif
+
+    /* The last message of the other side may still be in flight */
+    env_sleep_msec(300U);
+    (void)rpmsg_queue_destroy(bench_inst, queue);
+    (void)rpmsg_lite_destroy_ept(bench_inst, bench_ept);
+    (void)rpmsg_lite_deinit(bench_inst);
+    return 0;
+}
@@ -0,0 +1,11 @@
+/*
+ * Copyright 2026 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef _FSL_COMMON_H_
+#define _FSL_COMMON_H_
+
+/* The tests include the SDK common header, nothing of it is needed on the host */
+
+#endif /* _FSL_COMMON_H_ */
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2026 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host counterpart of core_util.c, runs the run_tests() of a primary or
+ * secondary test main.c as a Linux process on the POSIX environment and the
+ * linux_shm platform. The exit status is the number of failed test cases.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "rpmsg_lite.h"
+#include "unity.h"
+
+#include "app.h"
+
+extern void run_tests(void *unused);
+
+/* Non-zero when an assertion failed outside of a test case (in run_tests() itself) */
+static volatile int run_tests_aborted = 0;
+
+#if defined(HOST_HEAP_SIZE)
+void *__real_malloc(size_t size);
+
+/* Linked with --wrap=malloc, requests larger than the RTOS heap of the target (configTOTAL_HEAP_SIZE) fail */
+void *__wrap_malloc(size_t size)
+{
+    return (size > (size_t)HOST_HEAP_SIZE) ? NULL : __real_malloc(size);
+}
+#endif
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/*!
+ * @brief Runs one test case like RUN_TEST() and keeps the abort frame of the caller, so that a failed
+ *        assertion in run_tests() after the test case returns to main() instead of a finished test case frame.
+ */
+void host_run_test(void (*func)(void), const char *name, int line)
+{
+    jmp_buf caller_frame;
+
+    (void)memcpy(caller_frame, Unity.AbortFrame, sizeof(jmp_buf));
+    UnityDefaultTestRun(func, name, line);
+    (void)memcpy(Unity.AbortFrame, caller_frame, sizeof(jmp_buf));
+}
+
+int main(void)
+{
+    int failures;
+
+    UnityBegin(HOST_TEST_SOURCE);
+    if (TEST_PROTECT())
+    {
+        run_tests(NULL);
+    }
+    else
+    {
+        run_tests_aborted = 1;
+    }
+    failures = UNITY_END();
+
+    return failures + run_tests_aborted;
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright 2026 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef RPMSG_CONFIG_H_
+#define RPMSG_CONFIG_H_
+
+/*!
+ * @addtogroup config
+ * @{
+ * @file
+ */
+
+/* Host configuration of the tests, the per-test options (CONFIG_RL_* of the
+   test prj.conf and the host variants) are passed by CMake as -D options,
+   RL_LINUX_SHM_SIDE is 0 for the primary and 1 for the secondary process. */
+
+//! @def RL_USE_STATIC_API
+//!
+//! The POSIX environment does not support the static API.
+#define RL_USE_STATIC_API (0)
+
+//! @def RL_ASSERT
+//!
+//! Abort the test process on failed internal checks.
+#include <assert.h>
+#define RL_ASSERT(x) assert(x)
+
+//! @}
+
+#endif /* RPMSG_CONFIG_H_ */
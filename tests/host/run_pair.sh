@@ -0,0 +1,39 @@
+#!/bin/sh
+#
+# Copyright 2026 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# usage: run_pair.sh <primary> <secondary> <shm name>
+#
+# Runs the secondary process in the background and the primary process in the
+# foreground on a fresh shared memory object, fails when either one fails.
+
+primary=$1
+secondary=$2
+shm=/dev/shm$3
+
+rm -f "$shm"
+"$secondary" &
+secondary_pid=$!
+"$primary"
+primary_status=$?
+
+# The secondary runs its test cases along with the primary, give it a while to finish them
+i=0
+while kill -0 "$secondary_pid" 2>/dev/null && [ "$i" -lt 100 ]; do
+    sleep 0.1
+    i=$((i + 1))
+done
+if kill -0 "$secondary_pid" 2>/dev/null; then
+    echo "secondary process did not finish"
+    kill "$secondary_pid"
+    wait "$secondary_pid"
+    secondary_status=1
+else
+    wait "$secondary_pid"
+    secondary_status=$?
+fi
+rm -f "$shm"
+
+[ "$primary_status" -eq 0 ] && [ "$secondary_status" -eq 0 ]